@@ -16,9 +16,13 @@ const pkg = require(path.resolve(__dirname, 'package.json'));
 
 esbuild
   .build({
-    entryPoints: ['packages/cli/index.ts'],
+    entryPoints: {
+      gemini: 'packages/cli/index.ts',
+      // Loaded by the grep worker pool from next to the bundle.
+      grepWorker: 'packages/core/src/utils/grepWorker.ts',
+    },
     bundle: true,
-    outfile: 'bundle/gemini.js',
+    outdir: 'bundle',
     platform: 'node',
     target: 'node18',
     format: 'esm',
@@ -4,26 +4,25 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+import type { Content } from '@google/genai';
 import type { RouteHandler, HttpContext, GenerateRequest } from '../types/index.js';
 import { HttpUtils } from '../utils/http.js';
+import { SseWriter } from '../utils/sseWriter.js';
 import { GenerationService } from '../services/generation.service.js';
 
 export class GenerateHandler implements RouteHandler {
   constructor(private generationService: GenerationService) {}
 
   async handle(context: HttpContext): Promise<void> {
-    const { req, res, enableCors } = context;
+    const { req, res, enableCors, sseCompression, maxBodyBytes } = context;
 
     let body: GenerateRequest;
     try {
-      body = await HttpUtils.readJsonBody<GenerateRequest>(req);
+      body = await HttpUtils.readJsonBody<GenerateRequest>(req, {
+        maxBytes: maxBodyBytes,
+      });
     } catch (e) {
-      return HttpUtils.sendJson(
-        res,
-        400,
-        { error: (e as Error).message },
-        enableCors,
-      );
+      return HttpUtils.sendBodyError(req, res, e, enableCors);
     }
 
     const input = (body?.input ?? '').toString();
@@ -56,6 +55,7 @@ export class GenerateHandler implements RouteHandler {
           abortController.signal,
           res,
           enableCors,
+          Boolean(sseCompression) && HttpUtils.acceptsGzip(req),
           model,
           apiKey,
           baseUrl,
@@ -92,61 +92,73 @@ export class GenerateHandler implements RouteHandler {
     signal: AbortSignal,
     res: any,
     enableCors: boolean,
+    gzip: boolean,
     model?: string,
     apiKey?: string,
     baseUrl?: string,
     workingDirectory?: string,
   ): Promise<void> {
     HttpUtils.setupSseHeaders(res, enableCors);
+    // Token chunks are coalesced per tick and the generation loop waits
+    // whenever a slow client lets the buffer fill up.
+    const writer = new SseWriter(res, { gzip });
 
     // Track state to filter unwanted newline chunks
     let lastEventType: string | null = null;
     let previousContentEmpty = true;
 
-    const { history: updatedHistory } = await this.generationService.generateResponse(
-      input,
-      promptId,
-      signal,
-      {
-        onContentChunk: (chunk) => {
-          // Filter out leading newlines if previous content is empty or after tool results
-          let filteredChunk = chunk;
-          if (previousContentEmpty || lastEventType === 'tool_result') {
-            filteredChunk = chunk.replace(/^\n+/, '');
-          }
+    let updatedHistory: Content[];
+    try {
+      const result = await this.generationService.generateResponse(
+        input,
+        promptId,
+        signal,
+        {
+          onContentChunk: (chunk) => {
+            // Filter out leading newlines if previous content is empty or after tool results
+            let filteredChunk = chunk;
+            if (previousContentEmpty || lastEventType === 'tool_result') {
+              filteredChunk = chunk.replace(/^\n+/, '');
+            }
           
-          // Limit consecutive newlines to maximum of 2
-          filteredChunk = filteredChunk.replace(/\n{3,}/g, '\n\n');
+            // Limit consecutive newlines to maximum of 2
+            filteredChunk = filteredChunk.replace(/\n{3,}/g, '\n\n');
           
-          // Skip if chunk becomes empty after filtering
-          if (filteredChunk === '') {
-            return;
-          }
+            // Skip if chunk becomes empty after filtering
+            if (filteredChunk === '') {
+              return;
+            }
           
-          HttpUtils.writeSse(res, 'content', filteredChunk);
-          previousContentEmpty = filteredChunk.trim() === '';
-          lastEventType = 'content';
-        },
-        onEvent: (item) => {
-          HttpUtils.writeSse(res, item.type, JSON.stringify(item));
-          lastEventType = item.type;
-          // Reset content state after tool events
-          if (item.type === 'tool_call' || item.type === 'tool_result') {
-            previousContentEmpty = true;
-          }
+            previousContentEmpty = filteredChunk.trim() === '';
+            lastEventType = 'content';
+            return writer.send('content', filteredChunk);
+          },
+          onEvent: (item) => {
+            lastEventType = item.type;
+            // Reset content state after tool events
+            if (item.type === 'tool_call' || item.type === 'tool_result') {
+              previousContentEmpty = true;
+            }
+            return writer.send(item.type, JSON.stringify(item));
+          },
+          conversationHistory: history,
+          model,
+          apiKey,
+          baseUrl,
+          workingDirectory,
         },
-        conversationHistory: history,
-        model,
-        apiKey,
-        baseUrl,
-        workingDirectory,
-      },
-    );
+      );
+      updatedHistory = result.history;
+    } catch (e) {
+      writer.send('error', JSON.stringify({ message: (e as Error).message }));
+      writer.end();
+      return;
+    }
 
     // Send the updated conversation history so client can maintain state
-    HttpUtils.writeSse(res, 'history', JSON.stringify(updatedHistory));
-    HttpUtils.writeSse(res, 'done', 'true');
-    res.end();
+    writer.send('history', JSON.stringify(updatedHistory));
+    writer.send('done', 'true');
+    writer.end();
   }
 
   private async handleNonStreamingResponse(
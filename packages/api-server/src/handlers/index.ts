@@ -6,4 +6,5 @@
 
 export { HealthHandler } from './health.handler.js';
 export { StatusHandler } from './status.handler.js';
-export { GenerateHandler } from './generate.handler.js';
\ No newline at end of file
+export { GenerateHandler } from './generate.handler.js';
+export { MetricsHandler } from './metrics.handler.js';
\ No newline at end of file
@@ -0,0 +1,318 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { monitorEventLoopDelay } from 'perf_hooks';
+import type { IntervalHistogram } from 'perf_hooks';
+import {
+  httpPool,
+  uiTelemetryService,
+  INTER_TOKEN_LATENCY_BUCKETS_MS,
+} from '@kolosal-ai/kolosal-ai-core';
+import type { RouteHandler, HttpContext } from '../types/index.js';
+import type { GenerationService } from '../services/generation.service.js';
+import { HttpUtils } from '../utils/http.js';
+import {
+  OpenMetricsWriter,
+  OPENMETRICS_CONTENT_TYPE,
+} from '../utils/openMetrics.js';
+import {
+  getInFlightRequests,
+  getRequestMetrics,
+  getRequestTiming,
+  REQUEST_DURATION_BUCKETS_MS,
+} from '../utils/requestTiming.js';
+import { getSseTotals } from '../utils/sseWriter.js';
+
+const MS_PER_SECOND = 1000;
+const NS_PER_SECOND = 1e9;
+
+const toSeconds = (ms: number) => ms / MS_PER_SECOND;
+
+/**
+ * Serves server and model metrics in OpenMetrics text format. Every value is
+ * read from counters and histograms that are updated as requests run, so a
+ * scrape only formats numbers; it never walks requests or history.
+ */
+export class MetricsHandler implements RouteHandler {
+  private readonly eventLoopDelay: IntervalHistogram;
+
+  constructor(private readonly generationService: GenerationService) {
+    // Sampled by Node.js itself; reading it costs nothing per request.
+    this.eventLoopDelay = monitorEventLoopDelay({ resolution: 20 });
+    this.eventLoopDelay.enable();
+  }
+
+  async handle(context: HttpContext): Promise<void> {
+    const { res, enableCors } = context;
+    const body = this.collect();
+
+    HttpUtils.writeCors(res, enableCors);
+    res.statusCode = 200;
+    res.setHeader('Content-Type', OPENMETRICS_CONTENT_TYPE);
+    res.setHeader('Cache-Control', 'no-store');
+    const timing = getRequestTiming(res);
+    if (timing) {
+      timing.measure('write', () => res.end(body));
+    } else {
+      res.end(body);
+    }
+  }
+
+  private collect(): string {
+    const writer = new OpenMetricsWriter();
+    this.writeServerMetrics(writer);
+    this.writeProcessMetrics(writer);
+    this.writeModelMetrics(writer);
+    return writer.toString();
+  }
+
+  private writeServerMetrics(writer: OpenMetricsWriter): void {
+    const routes = Object.entries(getRequestMetrics());
+    const sse = getSseTotals();
+    const pool = httpPool.getStats();
+
+    writer
+      .counter(
+        'kolosal_api_http_requests',
+        'HTTP requests handled, by route.',
+        routes.map(([route, m]) => ({ labels: { route }, value: m.requests })),
+      )
+      .counter(
+        'kolosal_api_http_request_errors',
+        'HTTP requests answered with a 4xx or 5xx status, by route.',
+        routes.map(([route, m]) => ({ labels: { route }, value: m.errors })),
+      )
+      .histogram(
+        'kolosal_api_http_request_duration_seconds',
+        'Time from routing a request to finishing its response.',
+        routes.map(([route, m]) => ({
+          labels: { route },
+          bounds: REQUEST_DURATION_BUCKETS_MS.map(toSeconds),
+          counts: m.durationBuckets,
+          sum: toSeconds(m.totalDurationMs),
+        })),
+        'seconds',
+      )
+      .counter(
+        'kolosal_api_http_request_phase_seconds',
+        'Time spent reading, parsing, handling and writing requests.',
+        routes.flatMap(([route, m]) =>
+          Object.entries(m.phases).map(([phase, stats]) => ({
+            labels: { route, phase },
+            value: toSeconds(stats.totalMs),
+          })),
+        ),
+        'seconds',
+      )
+      .gauge(
+        'kolosal_api_http_requests_in_flight',
+        'Requests not yet answered.',
+        [{ value: getInFlightRequests() }],
+      )
+      .gauge(
+        'kolosal_api_generations_in_flight',
+        'Generations currently running.',
+        [{ value: this.generationService.getActiveGenerations() }],
+      )
+      .gauge('kolosal_api_sse_connections', 'Open server-sent event streams.', [
+        { value: sse.open },
+      ])
+      .counter('kolosal_api_sse_events', 'Server-sent events queued.', [
+        { value: sse.events },
+      ])
+      .counter(
+        'kolosal_api_sse_bytes',
+        'Server-sent event bytes written, after compression.',
+        [{ value: sse.bytes }],
+        'bytes',
+      )
+      .counter(
+        'kolosal_api_sse_stall_seconds',
+        'Time streams waited for slow clients to drain.',
+        [{ value: toSeconds(sse.stallMs) }],
+        'seconds',
+      )
+      .counter(
+        'kolosal_http_pool_requests',
+        'Outbound requests sent through the shared connection pool.',
+        [{ value: pool.requests }],
+      )
+      .counter(
+        'kolosal_http_pool_reused_connections',
+        'Outbound requests that reused an idle connection.',
+        [{ value: pool.reusedConnections }],
+      )
+      .gauge(
+        'kolosal_http_pool_open_connections',
+        'Open outbound connections.',
+        [{ value: pool.openConnections }],
+      )
+      .gauge(
+        'kolosal_http_pool_queue_depth',
+        'Outbound requests waiting for a free connection.',
+        [{ value: Math.max(0, pool.inFlight - pool.openConnections) }],
+      );
+  }
+
+  private writeProcessMetrics(writer: OpenMetricsWriter): void {
+    const memory = process.memoryUsage();
+    const delay = this.eventLoopDelay;
+
+    writer
+      .gauge(
+        'kolosal_process_memory_bytes',
+        'Process memory usage by kind.',
+        [
+          { labels: { kind: 'rss' }, value: memory.rss },
+          { labels: { kind: 'heap_used' }, value: memory.heapUsed },
+          { labels: { kind: 'heap_total' }, value: memory.heapTotal },
+          { labels: { kind: 'external' }, value: memory.external },
+        ],
+        'bytes',
+      )
+      .summary(
+        'kolosal_process_event_loop_lag_seconds',
+        'Event loop delay since the server started.',
+        [0.5, 0.9, 0.99].map((quantile) => ({
+          quantile,
+          value: delay.percentile(quantile * 100) / NS_PER_SECOND,
+        })),
+        delay.count,
+        // The monitor keeps no sum, so it is derived from the mean.
+        (delay.count * (Number.isNaN(delay.mean) ? 0 : delay.mean)) /
+          NS_PER_SECOND,
+        'seconds',
+      );
+  }
+
+  private writeModelMetrics(writer: OpenMetricsWriter): void {
+    const { models, tools } = uiTelemetryService.getMetrics();
+    const modelEntries = Object.entries(models);
+    const toolEntries = Object.entries(tools.byName);
+    const streamed = modelEntries.filter(([, m]) => m.streaming);
+
+    writer
+      .counter(
+        'kolosal_model_requests',
+        'Model API requests, by model.',
+        modelEntries.map(([model, m]) => ({
+          labels: { model },
+          value: m.api.totalRequests,
+        })),
+      )
+      .counter(
+        'kolosal_model_request_errors',
+        'Failed model API requests, by model.',
+        modelEntries.map(([model, m]) => ({
+          labels: { model },
+          value: m.api.totalErrors,
+        })),
+      )
+      .counter(
+        'kolosal_model_request_latency_seconds',
+        'Total latency of model API requests, by model.',
+        modelEntries.map(([model, m]) => ({
+          labels: { model },
+          value: toSeconds(m.api.totalLatencyMs),
+        })),
+        'seconds',
+      )
+      .counter(
+        'kolosal_model_tokens',
+        'Tokens used, by model and type.',
+        modelEntries.flatMap(([model, m]) =>
+          Object.entries(m.tokens).map(([type, value]) => ({
+            labels: { model, type },
+            value,
+          })),
+        ),
+      )
+      .counter(
+        'kolosal_model_stream_ttft_seconds',
+        'Total time to first token of streamed requests, by model.',
+        streamed.map(([model, m]) => ({
+          labels: { model, engine: m.streaming!.engine },
+          value: toSeconds(m.streaming!.totalTtftMs),
+        })),
+        'seconds',
+      )
+      .counter(
+        'kolosal_model_stream_requests',
+        'Streamed requests that produced tokens, by model.',
+        streamed.map(([model, m]) => ({
+          labels: { model, engine: m.streaming!.engine },
+          value: m.streaming!.requests,
+        })),
+      )
+      .histogram(
+        'kolosal_model_stream_inter_token_latency_seconds',
+        'Time between consecutive token chunks, by model.',
+        streamed.map(([model, m]) => ({
+          labels: { model, engine: m.streaming!.engine },
+          bounds: INTER_TOKEN_LATENCY_BUCKETS_MS.map(toSeconds),
+          counts: m.streaming!.interTokenBuckets,
+          // Only bucket counts are kept; the sum uses each bucket's bound.
+          sum: toSeconds(
+            m.streaming!.interTokenBuckets.reduce(
+              (total, count, index) =>
+                total +
+                count *
+                  (INTER_TOKEN_LATENCY_BUCKETS_MS[index] ??
+                    INTER_TOKEN_LATENCY_BUCKETS_MS.at(-1)!),
+              0,
+            ),
+          ),
+        })),
+        'seconds',
+      )
+      .counter(
+        'kolosal_model_stream_phase_tokens',
+        'Prompt-eval and generated tokens of streamed requests.',
+        streamed.flatMap(([model, m]) => [
+          {
+            labels: { model, phase: 'prompt' },
+            value: m.streaming!.promptTokens,
+          },
+          {
+            labels: { model, phase: 'generation' },
+            value: m.streaming!.generationTokens,
+          },
+        ]),
+      )
+      .counter(
+        'kolosal_model_stream_phase_seconds',
+        'Time spent in prompt evaluation and generation; divide tokens by it for throughput.',
+        streamed.flatMap(([model, m]) => [
+          {
+            labels: { model, phase: 'prompt' },
+            value: toSeconds(m.streaming!.promptEvalMs),
+          },
+          {
+            labels: { model, phase: 'generation' },
+            value: toSeconds(m.streaming!.generationMs),
+          },
+        ]),
+        'seconds',
+      )
+      .counter(
+        'kolosal_tool_calls',
+        'Tool calls, by tool and outcome.',
+        toolEntries.flatMap(([tool, t]) => [
+          { labels: { tool, outcome: 'success' }, value: t.success },
+          { labels: { tool, outcome: 'failure' }, value: t.fail },
+        ]),
+      )
+      .counter(
+        'kolosal_tool_call_duration_seconds',
+        'Total duration of tool calls, by tool.',
+        toolEntries.map(([tool, t]) => ({
+          labels: { tool },
+          value: toSeconds(t.durationMs),
+        })),
+        'seconds',
+      );
+  }
+}
@@ -22,7 +22,8 @@ export class StatusHandler implements RouteHandler {
         endpoints: {
           generate: '/v1/generate',
           health: '/healthz',
-          status: '/status'
+          status: '/status',
+          metrics: '/metrics'
         },
         features: {
           streaming: true,
@@ -7,6 +7,7 @@
 import { URL } from 'url';
 import type { RouteHandler, HttpContext, Middleware } from './types/index.js';
 import { HttpUtils } from './utils/http.js';
+import { startRequestTiming } from './utils/requestTiming.js';
 
 export interface Route {
   method: string;
@@ -14,12 +15,28 @@ export interface Route {
   handler: RouteHandler;
 }
 
+/**
+ * Extracts the path of a request target. Origin-form targets ("/path?query"),
+ * which is what clients send, are sliced without constructing a URL.
+ */
+export function getRequestPath(target: string): string {
+  if (target.startsWith('/') && !target.startsWith('//')) {
+    const end = target.search(/[?#]/);
+    return end === -1 ? target : target.slice(0, end);
+  }
+  return new URL(target, 'http://localhost').pathname;
+}
+
 export class Router {
-  private routes: Route[] = [];
+  // Keyed by "METHOD path"; the first route registered for a key wins.
+  private routes = new Map<string, Route>();
   private middlewares: Middleware[] = [];
 
   addRoute(method: string, path: string, handler: RouteHandler): void {
-    this.routes.push({ method, path, handler });
+    const key = `${method} ${path}`;
+    if (!this.routes.has(key)) {
+      this.routes.set(key, { method, path, handler });
+    }
   }
 
   addMiddleware(middleware: Middleware): void {
@@ -33,11 +50,11 @@ export class Router {
       return HttpUtils.sendJson(res, 400, { error: 'Missing URL' }, enableCors);
     }
 
-    const url = new URL(req.url, 'http://localhost');
     const method = req.method || 'GET';
-
-    // Find matching route
-    const route = this.routes.find(r => r.method === method && r.path === url.pathname);
+    const key = `${method} ${getRequestPath(req.url)}`;
+    const route = this.routes.get(key);
+    // Unknown paths share one metrics entry so scanners cannot grow the table.
+    startRequestTiming(req, res, route ? key : 'unmatched');
 
     if (!route) {
       return HttpUtils.sendJson(res, 404, { error: 'Not Found' }, enableCors);
@@ -65,4 +82,4 @@ export class Router {
 
     await next();
   }
-}
\ No newline at end of file
+}
@@ -9,7 +9,12 @@ import type { Config } from '@kolosal-ai/kolosal-ai-core';
 import type { ApiServerOptions, ApiServer, HttpContext } from './types/index.js';
 import { Router } from './router.js';
 import { CorsMiddleware } from './middleware/cors.middleware.js';
-import { HealthHandler, StatusHandler, GenerateHandler } from './handlers/index.js';
+import {
+  HealthHandler,
+  StatusHandler,
+  GenerateHandler,
+  MetricsHandler,
+} from './handlers/index.js';
 import { GenerationService } from './services/generation.service.js';
 import { HttpUtils } from './utils/http.js';
 
@@ -25,6 +30,8 @@ export class ApiServerFactory {
           res,
           config,
           enableCors,
+          sseCompression: options.sseCompression ?? false,
+          maxBodyBytes: options.maxBodyBytes,
         };
 
         await router.handle(context);
@@ -69,6 +76,7 @@ export class ApiServerFactory {
     router.addRoute('GET', '/healthz', new HealthHandler());
     router.addRoute('GET', '/status', new StatusHandler());
     router.addRoute('POST', '/v1/generate', new GenerateHandler(generationService));
+    router.addRoute('GET', '/metrics', new MetricsHandler(generationService));
 
     return router;
   }
@@ -16,8 +16,15 @@ import type {
 } from '../types/index.js';
 
 export class GenerationService {
+  private activeGenerations = 0;
+
   constructor(private config: Config) {}
 
+  /** Generations started and not yet finished. */
+  getActiveGenerations(): number {
+    return this.activeGenerations;
+  }
+
   async generateResponse(
     input: string,
     promptId: string,
@@ -74,6 +81,7 @@ export class GenerationService {
       }
     }
 
+    this.activeGenerations++;
     try {
       let geminiClient = this.config.getGeminiClient();
 
@@ -121,6 +129,8 @@ export class GenerationService {
         onEvent,
       );
     } finally {
+      this.activeGenerations--;
+
       // Restore original workspace context if it was changed
       if (originalWorkspaceContext && workingDirectory) {
         this.config.setWorkspaceContext(originalWorkspaceContext);
@@ -266,7 +276,8 @@ export class GenerationService {
       
       if (event.type === GeminiEventType.Content) {
         turnText += event.value;
-        onContentChunk?.(event.value);
+        const backpressure = onContentChunk?.(event.value);
+        if (backpressure) await backpressure;
       } else if (event.type === GeminiEventType.ToolCallRequest) {
         toolCallRequests.push(event.value);
       }
@@ -278,7 +289,7 @@ export class GenerationService {
       
       // Only emit assistant event if we're NOT streaming content chunks
       if (!onContentChunk) {
-        onEvent?.(assistantEvent);
+        await onEvent?.(assistantEvent);
       }
       
       // Add assistant message to conversation history
@@ -304,14 +315,14 @@ export class GenerationService {
       // Record and stream the tool call
       const toolCallEvent = this.createToolCallEvent(requestInfo);
       transcript.push(toolCallEvent);
-      onEvent?.(toolCallEvent);
+      await onEvent?.(toolCallEvent);
 
       const toolResponse = await executeToolCall(this.config, requestInfo, signal);
 
       // Record and stream result
       const toolResultEvent = this.createToolResultEvent(requestInfo, toolResponse);
       transcript.push(toolResultEvent);
-      onEvent?.(toolResultEvent);
+      await onEvent?.(toolResultEvent);
 
       if (toolResponse.responseParts) {
         toolResponseParts.push(...toolResponse.responseParts);
@@ -18,6 +18,9 @@ async function main() {
     const corsEnabled = process.env['KOLOSAL_CLI_API_CORS'] ? 
       ['1', 'true', 'yes'].includes(String(process.env['KOLOSAL_CLI_API_CORS']).toLowerCase()) : 
       true;
+    const maxBodyBytes = process.env['KOLOSAL_CLI_API_MAX_BODY_BYTES']
+      ? Number(process.env['KOLOSAL_CLI_API_MAX_BODY_BYTES'])
+      : undefined;
 
     // Create a basic configuration
     // Note: For a fully functional server, you'll need to provide proper config
@@ -48,12 +51,14 @@ async function main() {
     const server = await startApiServer(config, {
       port: Number(port),
       host: String(host),
-      enableCors: corsEnabled
+      enableCors: corsEnabled,
+      maxBodyBytes,
     });
 
     console.log(`Server running on http://${host}:${server.port}`);
     console.log(`Health check: http://${host}:${server.port}/healthz`);
     console.log(`Status: http://${host}:${server.port}/status`);
+    console.log(`Metrics: http://${host}:${server.port}/metrics`);
     console.log(`Generate: POST http://${host}:${server.port}/v1/generate`);
 
     // Graceful shutdown
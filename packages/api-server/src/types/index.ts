@@ -12,6 +12,10 @@ export interface ApiServerOptions {
   port: number;
   host?: string;
   enableCors?: boolean;
+  /** Gzip SSE streams for clients that accept it. */
+  sseCompression?: boolean;
+  /** Largest accepted request body in bytes; defaults to 32 MiB. */
+  maxBodyBytes?: number;
 }
 
 export interface ApiServer {
@@ -24,6 +28,8 @@ export interface HttpContext {
   res: ServerResponse;
   config: Config;
   enableCors: boolean;
+  sseCompression?: boolean;
+  maxBodyBytes?: number;
 }
 
 export interface RouteHandler {
@@ -63,8 +69,10 @@ export interface GenerationResult {
   history: Content[];
 }
 
-export type StreamEventCallback = (event: TranscriptItem) => void;
-export type ContentStreamCallback = (text: string) => void;
+// Callbacks may return a promise to slow the producer down while the client
+// catches up.
+export type StreamEventCallback = (event: TranscriptItem) => void | Promise<void>;
+export type ContentStreamCallback = (text: string) => void | Promise<void>;
 
 // Types needed for @-command processing
 export enum ToolCallStatus {
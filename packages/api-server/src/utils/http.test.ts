@@ -0,0 +1,111 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import http from 'http';
+import type { AddressInfo } from 'net';
+import type { IncomingMessage } from 'http';
+import { Readable } from 'stream';
+import { HttpError, HttpUtils } from './http.js';
+
+function request(
+  chunks: Array<string | Buffer>,
+  headers: Record<string, string> = {},
+): IncomingMessage {
+  return Object.assign(Readable.from(chunks), {
+    headers,
+  }) as unknown as IncomingMessage;
+}
+
+describe('HttpUtils.readJsonBody', () => {
+  it('should parse a buffered body and treat an empty one as {}', async () => {
+    await expect(
+      HttpUtils.readJsonBody(request(['{"input":', '"hi"}'])),
+    ).resolves.toEqual({ input: 'hi' });
+    await expect(HttpUtils.readJsonBody(request([]))).resolves.toEqual({});
+  });
+
+  it('should reject an oversized Content-Length before reading', async () => {
+    const req = request(['{}'], { 'content-length': '2048' });
+    const error = await HttpUtils.readJsonBody(req, { maxBytes: 1024 }).catch(
+      (e) => e,
+    );
+    expect(error).toBeInstanceOf(HttpError);
+    expect(error.status).toBe(413);
+    expect(req.readableDidRead).toBe(false);
+  });
+
+  it('should stop reading once an undeclared body passes the limit', async () => {
+    const chunks = Array.from({ length: 10 }, () => 'x'.repeat(512));
+    await expect(
+      HttpUtils.readJsonBody(request(chunks), { maxBytes: 1024 }),
+    ).rejects.toMatchObject({ status: 413 });
+  });
+
+  it('should parse large bodies incrementally', async () => {
+    const text = 'é'.repeat(3 * 1024 * 1024);
+    // Chunks split the two-byte character to exercise UTF-8 decoding.
+    const bytes = Buffer.from(JSON.stringify({ input: text }));
+    const chunks: Buffer[] = [];
+    for (let i = 0; i < bytes.length; i += 65_537) {
+      chunks.push(bytes.subarray(i, i + 65_537));
+    }
+    const body = await HttpUtils.readJsonBody<{ input: string }>(
+      request(chunks),
+    );
+    expect(body.input).toBe(text);
+  });
+
+  it('should report malformed JSON as a 400', async () => {
+    await expect(
+      HttpUtils.readJsonBody(request(['{"input":'])),
+    ).rejects.toMatchObject({ status: 400 });
+  });
+});
+
+describe('HttpUtils.sendBodyError', () => {
+  it('should deliver a 413 for an oversized body on a real connection', async () => {
+    const server = http.createServer(async (req, res) => {
+      try {
+        await HttpUtils.readJsonBody(req, { maxBytes: 1024 });
+        HttpUtils.sendJson(res, 200, {});
+      } catch (e) {
+        HttpUtils.sendBodyError(req, res, e);
+      }
+    });
+    await new Promise<void>((resolve) => server.listen(0, resolve));
+    const { port } = server.address() as AddressInfo;
+
+    try {
+      const response = await new Promise<{ status?: number; body: string }>(
+        (resolve, reject) => {
+          // Chunked and never ended, like a client streaming a huge upload.
+          const req = http.request(
+            { port, method: 'POST', path: '/v1/generate' },
+            (res) => {
+              let body = '';
+              res.setEncoding('utf8');
+              res.on('data', (chunk) => (body += chunk));
+              res.on('end', () => resolve({ status: res.statusCode, body }));
+            },
+          );
+          req.on('error', reject);
+          for (let i = 0; i < 4; i++) {
+            req.write('x'.repeat(512));
+          }
+        },
+      );
+
+      expect(response.status).toBe(413);
+      expect(JSON.parse(response.body)).toEqual({
+        error: 'Request body exceeds 1024 bytes',
+      });
+    } finally {
+      server.closeAllConnections();
+      await new Promise((resolve) => server.close(resolve));
+    }
+  });
+});
@@ -5,6 +5,29 @@
  */
 
 import type { IncomingMessage, ServerResponse } from 'http';
+import { StringDecoder } from 'string_decoder';
+import { performance } from 'perf_hooks';
+import { JsonStreamParser } from './jsonStreamParser.js';
+import { getRequestTiming } from './requestTiming.js';
+
+export const DEFAULT_MAX_BODY_BYTES = 32 * 1024 * 1024;
+// Bodies past this size are parsed while they arrive rather than buffered
+const STREAM_PARSE_THRESHOLD_BYTES = 4 * 1024 * 1024;
+
+export interface ReadBodyOptions {
+  maxBytes?: number;
+}
+
+/** Error carrying the HTTP status the request should be answered with. */
+export class HttpError extends Error {
+  constructor(
+    readonly status: number,
+    message: string,
+  ) {
+    super(message);
+    this.name = 'HttpError';
+  }
+}
 
 export class HttpUtils {
   static writeCors(res: ServerResponse, enableCors: boolean): void {
@@ -23,27 +46,151 @@ export class HttpUtils {
     this.writeCors(res, enableCors);
     res.statusCode = status;
     res.setHeader('Content-Type', 'application/json; charset=utf-8');
-    res.end(JSON.stringify(body));
+    const timing = getRequestTiming(res);
+    if (timing) {
+      timing.measure('write', () => res.end(JSON.stringify(body)));
+    } else {
+      res.end(JSON.stringify(body));
+    }
   }
 
-  static async readJsonBody<T = any>(req: IncomingMessage): Promise<T> {
-    const chunks: Buffer[] = [];
-    for await (const chunk of req) {
-      chunks.push(Buffer.isBuffer(chunk) ? chunk : Buffer.from(chunk));
+  /**
+   * Answers a request whose body could not be read with the status of
+   * `error`. When the body was not read to the end, the connection is closed
+   * once the response has been sent, since it cannot be reused.
+   */
+  static sendBodyError(
+    req: IncomingMessage,
+    res: ServerResponse,
+    error: unknown,
+    enableCors = false,
+  ): void {
+    const status = error instanceof HttpError ? error.status : 400;
+    if (!req.complete) {
+      res.setHeader('Connection', 'close');
+      res.once('finish', () => req.destroy());
     }
-    const text = Buffer.concat(chunks).toString('utf8');
-    if (!text) return {} as T;
+    this.sendJson(res, status, { error: (error as Error).message }, enableCors);
+  }
+
+  /**
+   * Reads and parses a JSON request body of at most `maxBytes`. A declared
+   * Content-Length over the limit is rejected before anything is read, and
+   * reading stops as soon as an undeclared body passes it; the socket is left
+   * open so the rejection can still be answered with `sendBodyError()`. Large
+   * bodies are parsed incrementally, so they are never buffered whole.
+   */
+  static async readJsonBody<T = any>(
+    req: IncomingMessage,
+    options: ReadBodyOptions = {},
+  ): Promise<T> {
+    const maxBytes = options.maxBytes ?? DEFAULT_MAX_BODY_BYTES;
+    const tooLarge = () =>
+      new HttpError(413, `Request body exceeds ${maxBytes} bytes`);
+    const declared = Number(req.headers['content-length']);
+    if (declared > maxBytes) {
+      throw tooLarge();
+    }
+
+    const timing = getRequestTiming(req);
+    const decoder = new StringDecoder('utf8');
+    const parts: string[] = [];
+    let parser: JsonStreamParser | undefined;
+    let received = 0;
+    let parseMs = 0;
+    const readStart = performance.now();
+
+    const consume = (chunk: Buffer | string) => {
+      const buffer = Buffer.isBuffer(chunk) ? chunk : Buffer.from(chunk);
+      received += buffer.length;
+      if (received > maxBytes) {
+        throw tooLarge();
+      }
+      const text = decoder.write(buffer);
+      if (parser) {
+        const start = performance.now();
+        parser.write(text);
+        parseMs += performance.now() - start;
+        return;
+      }
+      parts.push(text);
+      if (received > STREAM_PARSE_THRESHOLD_BYTES) {
+        const start = performance.now();
+        parser = new JsonStreamParser();
+        parser.write(parts.join(''));
+        parts.length = 0;
+        parseMs += performance.now() - start;
+      }
+    };
+
     try {
-      return JSON.parse(text) as T;
+      // Not `for await`: leaving that loop early destroys the socket, and
+      // with it the chance to answer the request.
+      await new Promise<void>((resolve, reject) => {
+        const cleanup = () => {
+          req.off('data', onData);
+          req.off('end', onEnd);
+          req.off('error', onError);
+        };
+        const onData = (chunk: Buffer | string) => {
+          try {
+            consume(chunk);
+          } catch (e) {
+            cleanup();
+            req.pause();
+            // The unread rest may still fail, e.g. when the client gives up.
+            req.on('error', () => {});
+            reject(e);
+          }
+        };
+        const onEnd = () => {
+          cleanup();
+          resolve();
+        };
+        const onError = (e: Error) => {
+          cleanup();
+          reject(e);
+        };
+        req.on('data', onData);
+        req.on('end', onEnd);
+        req.on('error', onError);
+      });
+
+      const start = performance.now();
+      try {
+        const rest = decoder.end();
+        if (parser) {
+          parser.write(rest);
+          return parser.end() as T;
+        }
+        const text = parts.join('') + rest;
+        if (!text) return {} as T;
+        return JSON.parse(text) as T;
+      } finally {
+        parseMs += performance.now() - start;
+      }
     } catch (e) {
+      if (e instanceof HttpError) throw e;
       const err = e as Error;
-      throw new Error(`Invalid JSON body: ${err.message}`);
+      throw new HttpError(400, `Invalid JSON body: ${err.message}`);
+    } finally {
+      timing?.add('parse', parseMs);
+      timing?.add('read', performance.now() - readStart - parseMs);
     }
   }
 
-  static writeSse(res: ServerResponse, event: string, data: string): void {
-    res.write(`event: ${event}\n`);
-    res.write(`data: ${data.replace(/\n/g, '\\n')}\n\n`);
+  /**
+   * Writes a single event immediately. Streams should prefer SseWriter, which
+   * coalesces events and honours backpressure.
+   */
+  static writeSse(res: ServerResponse, event: string, data: string): boolean {
+    const escaped = data.includes('\n') ? data.replaceAll('\n', '\\n') : data;
+    return res.write(`event: ${event}\ndata: ${escaped}\n\n`);
+  }
+
+  static acceptsGzip(req: IncomingMessage): boolean {
+    const header = req.headers['accept-encoding'];
+    return typeof header === 'string' && /\bgzip\b/.test(header);
   }
 
   static setupSseHeaders(res: ServerResponse, enableCors: boolean): void {
@@ -0,0 +1,67 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import { JsonStreamParser } from './jsonStreamParser.js';
+
+function parseInChunks(text: string, size: number): unknown {
+  const parser = new JsonStreamParser();
+  for (let i = 0; i < text.length; i += size) {
+    parser.write(text.slice(i, i + size));
+  }
+  return parser.end();
+}
+
+describe('JsonStreamParser', () => {
+  const document = JSON.stringify({
+    input: 'Summarise "this"\n\tplease é 😀',
+    stream: true,
+    history: [
+      { role: 'user', parts: [{ text: 'hi' }] },
+      { role: 'model', parts: [] },
+    ],
+    numbers: [0, -1, 2.5, 1e21, -3.25e-7],
+    empty: {},
+    nothing: null,
+    escaped: '\\u0041 \u0000 \u001f /',
+  });
+
+  it.each([1, 2, 3, 7, 64, document.length])(
+    'should match JSON.parse when fed %i characters at a time',
+    (size) => {
+      expect(parseInChunks(document, size)).toEqual(JSON.parse(document));
+    },
+  );
+
+  it('should parse top-level scalars', () => {
+    expect(parseInChunks(' 42 ', 1)).toBe(42);
+    expect(parseInChunks('"x"', 1)).toBe('x');
+    expect(parseInChunks('false', 2)).toBe(false);
+  });
+
+  it('should keep __proto__ as an own property', () => {
+    const value = parseInChunks('{"__proto__":{"polluted":true}}', 5) as Record<
+      string,
+      unknown
+    >;
+    expect(Object.keys(value)).toEqual(['__proto__']);
+    expect(({} as Record<string, unknown>)['polluted']).toBeUndefined();
+  });
+
+  it.each([
+    '{"a":1,}',
+    '[1 2]',
+    '{"a" 1}',
+    '01',
+    'tru',
+    '"unterminated',
+    '"bad \\x escape"',
+    '{"a":1}}',
+    '',
+  ])('should reject %j', (text) => {
+    expect(() => parseInChunks(text, 3)).toThrow(SyntaxError);
+  });
+});
@@ -0,0 +1,315 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+type Container = Record<string, unknown> | unknown[];
+
+enum State {
+  Value,
+  ArrayValueOrEnd,
+  ObjectKeyOrEnd,
+  ObjectKey,
+  Colon,
+  AfterValue,
+  String,
+  Number,
+  Literal,
+  Done,
+}
+
+const NUMBER_PATTERN = /^-?(0|[1-9]\d*)(\.\d+)?([eE][+-]?\d+)?$/;
+const LITERALS: Record<string, unknown> = {
+  true: true,
+  false: false,
+  null: null,
+};
+const ESCAPES: Record<string, string> = {
+  '"': '"',
+  '\\': '\\',
+  '/': '/',
+  b: '\b',
+  f: '\f',
+  n: '\n',
+  r: '\r',
+  t: '\t',
+};
+
+function isWhitespace(code: number): boolean {
+  return code === 0x20 || code === 0x0a || code === 0x0d || code === 0x09;
+}
+
+// Characters of numbers and literals: letters, digits, '.', '+' and '-'
+function isTokenChar(code: number): boolean {
+  return (
+    (code >= 0x30 && code <= 0x39) ||
+    (code >= 0x61 && code <= 0x7a) ||
+    (code >= 0x41 && code <= 0x5a) ||
+    code === 0x2e ||
+    code === 0x2b ||
+    code === 0x2d
+  );
+}
+
+/**
+ * Incremental JSON parser. Text is fed chunk by chunk as it arrives and
+ * values are built on the fly, so a large request body is never held as one
+ * string next to its parsed form.
+ */
+export class JsonStreamParser {
+  private state = State.Value;
+  private readonly stack: Container[] = [];
+  private readonly keys: Array<string | undefined> = [];
+  private root: unknown;
+  // Token being read across chunk boundaries
+  private token = '';
+  private stringParts: string[] = [];
+  private stringIsKey = false;
+  private escape: 'none' | 'backslash' | 'unicode' = 'none';
+  private unicodeDigits = '';
+  private position = 0;
+
+  write(text: string): void {
+    let i = 0;
+    const length = text.length;
+    while (i < length) {
+      switch (this.state) {
+        case State.String:
+          i = this.readString(text, i);
+          continue;
+        case State.Number:
+        case State.Literal: {
+          const start = i;
+          while (i < length && isTokenChar(text.charCodeAt(i))) i++;
+          this.token += text.slice(start, i);
+          if (i < length) this.finishToken();
+          continue;
+        }
+        default:
+          break;
+      }
+
+      const code = text.charCodeAt(i);
+      if (isWhitespace(code)) {
+        i++;
+        continue;
+      }
+      const char = text[i];
+      this.position += 1;
+      i++;
+
+      switch (this.state) {
+        case State.Value:
+          this.startValue(char);
+          break;
+        case State.ArrayValueOrEnd:
+          if (char === ']') {
+            this.closeContainer();
+          } else {
+            this.startValue(char);
+          }
+          break;
+        case State.ObjectKeyOrEnd:
+          if (char === '}') {
+            this.closeContainer();
+            break;
+          }
+        // falls through
+        case State.ObjectKey:
+          if (char !== '"') this.fail(`Expected property name, got '${char}'`);
+          this.startString(true);
+          break;
+        case State.Colon:
+          if (char !== ':') this.fail(`Expected ':', got '${char}'`);
+          this.state = State.Value;
+          break;
+        case State.AfterValue:
+          this.afterValue(char);
+          break;
+        case State.Done:
+          this.fail(`Unexpected '${char}' after JSON value`);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  /** Completes parsing and returns the parsed value. */
+  end(): unknown {
+    if (this.state === State.Number || this.state === State.Literal) {
+      this.finishToken();
+    }
+    if (this.state !== State.Done) {
+      this.fail('Unexpected end of JSON input');
+    }
+    return this.root;
+  }
+
+  private startValue(char: string): void {
+    switch (char) {
+      case '{':
+        this.stack.push({});
+        this.keys.push(undefined);
+        this.state = State.ObjectKeyOrEnd;
+        return;
+      case '[':
+        this.stack.push([]);
+        this.keys.push(undefined);
+        this.state = State.ArrayValueOrEnd;
+        return;
+      case '"':
+        this.startString(false);
+        return;
+      default:
+        if (char === '-' || (char >= '0' && char <= '9')) {
+          this.token = char;
+          this.state = State.Number;
+        } else if (char === 't' || char === 'f' || char === 'n') {
+          this.token = char;
+          this.state = State.Literal;
+        } else {
+          this.fail(`Unexpected '${char}'`);
+        }
+    }
+  }
+
+  private startString(isKey: boolean): void {
+    this.stringParts = [];
+    this.stringIsKey = isKey;
+    this.escape = 'none';
+    this.state = State.String;
+  }
+
+  // Reads string content from `i`; returns the index after what was consumed.
+  private readString(text: string, i: number): number {
+    const length = text.length;
+    while (i < length) {
+      if (this.escape === 'backslash') {
+        const char = text[i++];
+        if (char === 'u') {
+          this.escape = 'unicode';
+          this.unicodeDigits = '';
+        } else if (Object.hasOwn(ESCAPES, char)) {
+          this.stringParts.push(ESCAPES[char]);
+          this.escape = 'none';
+        } else {
+          this.fail(`Bad escape '\\${char}'`);
+        }
+        continue;
+      }
+      if (this.escape === 'unicode') {
+        const take = Math.min(4 - this.unicodeDigits.length, length - i);
+        this.unicodeDigits += text.slice(i, i + take);
+        i += take;
+        if (this.unicodeDigits.length === 4) {
+          if (!/^[0-9a-fA-F]{4}$/.test(this.unicodeDigits)) {
+            this.fail(`Bad unicode escape '\\u${this.unicodeDigits}'`);
+          }
+          this.stringParts.push(
+            String.fromCharCode(parseInt(this.unicodeDigits, 16)),
+          );
+          this.escape = 'none';
+        }
+        continue;
+      }
+
+      // Copy the run up to the next quote or backslash in one slice.
+      let end = i;
+      while (end < length) {
+        const code = text.charCodeAt(end);
+        if (code === 0x22 || code === 0x5c) break;
+        if (code < 0x20) this.fail('Control character in string');
+        end++;
+      }
+      if (end > i) {
+        this.stringParts.push(text.slice(i, end));
+        this.position += end - i;
+      }
+      if (end === length) {
+        return end;
+      }
+      i = end + 1;
+      if (text.charCodeAt(end) === 0x5c) {
+        this.escape = 'backslash';
+        continue;
+      }
+      const value =
+        this.stringParts.length === 1
+          ? this.stringParts[0]
+          : this.stringParts.join('');
+      this.stringParts = [];
+      if (this.stringIsKey) {
+        this.keys[this.keys.length - 1] = value;
+        this.state = State.Colon;
+      } else {
+        this.emit(value);
+      }
+      return i;
+    }
+    return i;
+  }
+
+  private finishToken(): void {
+    const token = this.token;
+    this.token = '';
+    if (this.state === State.Number) {
+      if (!NUMBER_PATTERN.test(token)) this.fail(`Bad number '${token}'`);
+      this.emit(Number(token));
+      return;
+    }
+    if (!Object.hasOwn(LITERALS, token)) {
+      this.fail(`Unexpected token '${token}'`);
+    }
+    this.emit(LITERALS[token]);
+  }
+
+  private emit(value: unknown): void {
+    if (this.stack.length === 0) {
+      this.root = value;
+      this.state = State.Done;
+      return;
+    }
+    const container = this.stack[this.stack.length - 1];
+    if (Array.isArray(container)) {
+      container.push(value);
+    } else {
+      const key = this.keys[this.keys.length - 1] as string;
+      if (key === '__proto__') {
+        // Same result as JSON.parse: an own property, not a prototype.
+        Object.defineProperty(container, key, {
+          value,
+          enumerable: true,
+          writable: true,
+          configurable: true,
+        });
+      } else {
+        container[key] = value;
+      }
+    }
+    this.state = State.AfterValue;
+  }
+
+  private afterValue(char: string): void {
+    const container = this.stack[this.stack.length - 1];
+    const isArray = Array.isArray(container);
+    if (char === ',') {
+      this.state = isArray ? State.Value : State.ObjectKey;
+    } else if ((char === ']' && isArray) || (char === '}' && !isArray)) {
+      this.closeContainer();
+    } else {
+      this.fail(`Unexpected '${char}'`);
+    }
+  }
+
+  private closeContainer(): void {
+    const container = this.stack.pop();
+    this.keys.pop();
+    this.emit(container);
+  }
+
+  private fail(message: string): never {
+    throw new SyntaxError(`${message} at position ${this.position}`);
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import { OpenMetricsWriter } from './openMetrics.js';
+
+describe('OpenMetricsWriter', () => {
+  it('should write counters and gauges with their metadata', () => {
+    const text = new OpenMetricsWriter()
+      .counter('app_requests', 'Requests handled.', [
+        { labels: { route: 'GET /status' }, value: 3 },
+      ])
+      .gauge('app_memory_bytes', 'Memory in use.', [{ value: 1024 }], 'bytes')
+      .toString();
+
+    expect(text).toBe(
+      [
+        '# TYPE app_requests counter',
+        '# HELP app_requests Requests handled.',
+        'app_requests_total{route="GET /status"} 3',
+        '# TYPE app_memory_bytes gauge',
+        '# UNIT app_memory_bytes bytes',
+        '# HELP app_memory_bytes Memory in use.',
+        'app_memory_bytes 1024',
+        '# EOF',
+        '',
+      ].join('\n'),
+    );
+  });
+
+  it('should write histogram buckets cumulatively with an overflow bucket', () => {
+    const text = new OpenMetricsWriter()
+      .histogram('app_duration_seconds', 'Durations.', [
+        {
+          labels: { route: 'a' },
+          bounds: [0.1, 1],
+          counts: [2, 3, 1],
+          sum: 4.5,
+        },
+      ])
+      .toString();
+
+    expect(text).toContain(
+      'app_duration_seconds_bucket{route="a",le="0.1"} 2',
+    );
+    expect(text).toContain('app_duration_seconds_bucket{route="a",le="1"} 5');
+    expect(text).toContain(
+      'app_duration_seconds_bucket{route="a",le="+Inf"} 6',
+    );
+    expect(text).toContain('app_duration_seconds_sum{route="a"} 4.5');
+    expect(text).toContain('app_duration_seconds_count{route="a"} 6');
+  });
+
+  it('should write summaries with quantile labels', () => {
+    const text = new OpenMetricsWriter()
+      .summary(
+        'app_lag_seconds',
+        'Lag.',
+        [{ quantile: 0.5, value: 0.01 }],
+        10,
+        0.2,
+      )
+      .toString();
+
+    expect(text).toContain('app_lag_seconds{quantile="0.5"} 0.01');
+    expect(text).toContain('app_lag_seconds_sum 0.2');
+    expect(text).toContain('app_lag_seconds_count 10');
+  });
+
+  it('should escape label values', () => {
+    const text = new OpenMetricsWriter()
+      .gauge('app_info', 'Info.', [
+        { labels: { model: 'a"b\\c\nd' }, value: 1 },
+      ])
+      .toString();
+
+    expect(text).toContain('app_info{model="a\\"b\\\\c\\nd"} 1');
+  });
+
+  it('should end an empty exposition with EOF', () => {
+    expect(new OpenMetricsWriter().toString()).toBe('# EOF\n');
+  });
+});
@@ -0,0 +1,138 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+export const OPENMETRICS_CONTENT_TYPE =
+  'application/openmetrics-text; version=1.0.0; charset=utf-8';
+
+export type Labels = Record<string, string>;
+
+export interface Sample {
+  labels?: Labels;
+  value: number;
+}
+
+export interface HistogramSample {
+  labels?: Labels;
+  /** Upper bounds of the finite buckets. */
+  bounds: number[];
+  /**
+   * Non-cumulative counts per bucket: one per bound plus a final bucket for
+   * values above the last bound.
+   */
+  counts: number[];
+  sum: number;
+}
+
+function escapeLabelValue(value: string): string {
+  return value
+    .replaceAll('\\', '\\\\')
+    .replaceAll('\n', '\\n')
+    .replaceAll('"', '\\"');
+}
+
+function formatLabels(labels: Labels | undefined, extra?: Labels): string {
+  const entries = Object.entries({ ...labels, ...extra });
+  if (entries.length === 0) return '';
+  return `{${entries
+    .map(([name, value]) => `${name}="${escapeLabelValue(value)}"`)
+    .join(',')}}`;
+}
+
+function formatValue(value: number): string {
+  if (Number.isNaN(value)) return 'NaN';
+  if (value === Infinity) return '+Inf';
+  if (value === -Infinity) return '-Inf';
+  return String(value);
+}
+
+/**
+ * Builds an OpenMetrics text exposition. Every metric family is written once
+ * with all of its samples, and the output is terminated by `# EOF`.
+ */
+export class OpenMetricsWriter {
+  private readonly lines: string[] = [];
+
+  counter(name: string, help: string, samples: Sample[], unit?: string): this {
+    this.header(name, 'counter', help, unit);
+    for (const sample of samples) {
+      this.lines.push(
+        `${name}_total${formatLabels(sample.labels)} ${formatValue(sample.value)}`,
+      );
+    }
+    return this;
+  }
+
+  gauge(name: string, help: string, samples: Sample[], unit?: string): this {
+    this.header(name, 'gauge', help, unit);
+    for (const sample of samples) {
+      this.lines.push(
+        `${name}${formatLabels(sample.labels)} ${formatValue(sample.value)}`,
+      );
+    }
+    return this;
+  }
+
+  histogram(
+    name: string,
+    help: string,
+    samples: HistogramSample[],
+    unit?: string,
+  ): this {
+    this.header(name, 'histogram', help, unit);
+    for (const sample of samples) {
+      let cumulative = 0;
+      sample.bounds.forEach((bound, index) => {
+        cumulative += sample.counts[index] ?? 0;
+        this.lines.push(
+          `${name}_bucket${formatLabels(sample.labels, { le: formatValue(bound) })} ${cumulative}`,
+        );
+      });
+      const count = sample.counts.reduce((total, value) => total + value, 0);
+      this.lines.push(
+        `${name}_bucket${formatLabels(sample.labels, { le: '+Inf' })} ${count}`,
+        `${name}_sum${formatLabels(sample.labels)} ${formatValue(sample.sum)}`,
+        `${name}_count${formatLabels(sample.labels)} ${count}`,
+      );
+    }
+    return this;
+  }
+
+  /** Quantiles precomputed elsewhere, such as by a Node.js delay monitor. */
+  summary(
+    name: string,
+    help: string,
+    quantiles: Array<{ quantile: number; value: number }>,
+    count: number,
+    sum: number,
+    unit?: string,
+  ): this {
+    this.header(name, 'summary', help, unit);
+    for (const { quantile, value } of quantiles) {
+      this.lines.push(
+        `${name}{quantile="${quantile}"} ${formatValue(value)}`,
+      );
+    }
+    this.lines.push(`${name}_sum ${formatValue(sum)}`, `${name}_count ${count}`);
+    return this;
+  }
+
+  toString(): string {
+    return [...this.lines, '# EOF', ''].join('\n');
+  }
+
+  private header(
+    name: string,
+    type: string,
+    help: string,
+    unit: string | undefined,
+  ): void {
+    this.lines.push(`# TYPE ${name} ${type}`);
+    if (unit) {
+      this.lines.push(`# UNIT ${name} ${unit}`);
+    }
+    this.lines.push(`# HELP ${name} ${help}`);
+  }
+}
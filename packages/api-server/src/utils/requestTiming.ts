@@ -0,0 +1,174 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import type { IncomingMessage, ServerResponse } from 'http';
+import { performance } from 'perf_hooks';
+
+export type RequestPhase = 'read' | 'parse' | 'handle' | 'write';
+
+export interface PhaseStats {
+  count: number;
+  totalMs: number;
+  maxMs: number;
+}
+
+/** Upper bounds, in milliseconds, of the request duration histogram. */
+export const REQUEST_DURATION_BUCKETS_MS = [
+  5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000, 60000,
+];
+
+export interface RouteMetrics {
+  requests: number;
+  /** Requests answered with a 4xx or 5xx status. */
+  errors: number;
+  phases: Record<RequestPhase, PhaseStats>;
+  /**
+   * Request counts per REQUEST_DURATION_BUCKETS_MS bucket, with one extra
+   * bucket for longer requests.
+   */
+  durationBuckets: number[];
+  totalDurationMs: number;
+}
+
+const PHASES: RequestPhase[] = ['read', 'parse', 'handle', 'write'];
+
+const routeMetrics = new Map<string, RouteMetrics>();
+const timings = new WeakMap<IncomingMessage | ServerResponse, RequestTiming>();
+let inFlightRequests = 0;
+
+/** Requests received whose response has not finished yet. */
+export function getInFlightRequests(): number {
+  return inFlightRequests;
+}
+
+/**
+ * Time spent by one request in each phase. The body reader adds `read` and
+ * `parse`, responses add `write`, and `handle` is whatever remains.
+ */
+export class RequestTiming {
+  private readonly startedAt = performance.now();
+  private readonly phases: Record<Exclude<RequestPhase, 'handle'>, number> = {
+    read: 0,
+    parse: 0,
+    write: 0,
+  };
+
+  add(phase: Exclude<RequestPhase, 'handle'>, ms: number): void {
+    this.phases[phase] += ms;
+  }
+
+  /** Runs `fn` and adds its duration to `phase`. */
+  measure<T>(phase: Exclude<RequestPhase, 'handle'>, fn: () => T): T {
+    const start = performance.now();
+    try {
+      return fn();
+    } finally {
+      this.add(phase, performance.now() - start);
+    }
+  }
+
+  finish(): Record<RequestPhase, number> {
+    const total = performance.now() - this.startedAt;
+    const { read, parse, write } = this.phases;
+    return {
+      read,
+      parse,
+      write,
+      handle: Math.max(0, total - read - parse - write),
+    };
+  }
+}
+
+/**
+ * Starts timing a request and records it under `route` once the response is
+ * finished or the connection closes.
+ */
+export function startRequestTiming(
+  req: IncomingMessage,
+  res: ServerResponse,
+  route: string,
+): RequestTiming {
+  const timing = new RequestTiming();
+  timings.set(req, timing);
+  timings.set(res, timing);
+  inFlightRequests++;
+  let recorded = false;
+  const record = () => {
+    if (recorded) return;
+    recorded = true;
+    inFlightRequests--;
+    recordRequest(route, res.statusCode, timing.finish());
+  };
+  res.once('finish', record);
+  res.once('close', record);
+  return timing;
+}
+
+export function getRequestTiming(
+  reqOrRes: IncomingMessage | ServerResponse,
+): RequestTiming | undefined {
+  return timings.get(reqOrRes);
+}
+
+function recordRequest(
+  route: string,
+  status: number,
+  durations: Record<RequestPhase, number>,
+): void {
+  let metrics = routeMetrics.get(route);
+  if (!metrics) {
+    metrics = {
+      requests: 0,
+      errors: 0,
+      phases: Object.fromEntries(
+        PHASES.map((phase) => [phase, { count: 0, totalMs: 0, maxMs: 0 }]),
+      ) as Record<RequestPhase, PhaseStats>,
+      durationBuckets: new Array(REQUEST_DURATION_BUCKETS_MS.length + 1).fill(
+        0,
+      ),
+      totalDurationMs: 0,
+    };
+    routeMetrics.set(route, metrics);
+  }
+  metrics.requests++;
+  if (status >= 400) {
+    metrics.errors++;
+  }
+  const duration = PHASES.reduce((sum, phase) => sum + durations[phase], 0);
+  const bucket = REQUEST_DURATION_BUCKETS_MS.findIndex(
+    (bound) => duration <= bound,
+  );
+  metrics.durationBuckets[
+    bucket === -1 ? REQUEST_DURATION_BUCKETS_MS.length : bucket
+  ]++;
+  metrics.totalDurationMs += duration;
+  for (const phase of PHASES) {
+    const stats = metrics.phases[phase];
+    stats.count++;
+    stats.totalMs += durations[phase];
+    stats.maxMs = Math.max(stats.maxMs, durations[phase]);
+  }
+}
+
+/** Per-route request counts and phase timings since the server started. */
+export function getRequestMetrics(): Record<string, RouteMetrics> {
+  return Object.fromEntries(
+    [...routeMetrics].map(([route, metrics]) => [
+      route,
+      {
+        ...metrics,
+        durationBuckets: [...metrics.durationBuckets],
+        phases: Object.fromEntries(
+          PHASES.map((phase) => [phase, { ...metrics.phases[phase] }]),
+        ) as Record<RequestPhase, PhaseStats>,
+      },
+    ]),
+  );
+}
+
+export function resetRequestMetrics(): void {
+  routeMetrics.clear();
+}
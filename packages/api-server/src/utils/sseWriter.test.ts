@@ -0,0 +1,163 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import type { ServerResponse } from 'http';
+import { Writable } from 'stream';
+import zlib from 'zlib';
+import { SseWriter } from './sseWriter.js';
+
+// Response stand-in that can hold writes to simulate a slow client
+class FakeResponse extends Writable {
+  readonly chunks: Buffer[] = [];
+  readonly headers: Record<string, unknown> = {};
+  writes = 0;
+  hold = false;
+  private held: Array<() => void> = [];
+
+  constructor() {
+    super({ highWaterMark: 64 });
+  }
+
+  setHeader(name: string, value: unknown) {
+    this.headers[name] = value;
+  }
+
+  override _write(chunk: Buffer, _encoding: string, callback: () => void) {
+    this.writes++;
+    this.chunks.push(chunk);
+    if (this.hold) {
+      this.held.push(callback);
+    } else {
+      callback();
+    }
+  }
+
+  release() {
+    this.hold = false;
+    this.held.splice(0).forEach((callback) => callback());
+  }
+
+  text() {
+    return Buffer.concat(this.chunks).toString('utf8');
+  }
+
+  asResponse() {
+    return this as unknown as ServerResponse;
+  }
+}
+
+const nextTick = () => new Promise((resolve) => setImmediate(resolve));
+
+describe('SseWriter', () => {
+  it('should coalesce events sent in the same tick into one write', async () => {
+    const res = new FakeResponse();
+    const writer = new SseWriter(res.asResponse(), { heartbeatIntervalMs: 0 });
+
+    writer.send('content', 'Hello');
+    writer.send('content', ' world\nagain');
+    await nextTick();
+
+    expect(res.writes).toBe(1);
+    expect(res.text()).toBe(
+      'event: content\ndata: Hello\n\n' +
+        'event: content\ndata:  world\\nagain\n\n',
+    );
+    expect(writer.getStats()).toMatchObject({ events: 2, flushes: 1 });
+  });
+
+  it('should make producers wait while a slow client is not draining', async () => {
+    const res = new FakeResponse();
+    res.hold = true;
+    const writer = new SseWriter(res.asResponse(), {
+      heartbeatIntervalMs: 0,
+      flushThresholdBytes: 16,
+      maxBufferedBytes: 100,
+    });
+
+    expect(writer.send('content', 'a'.repeat(80))).toBeUndefined();
+    expect(writer.send('content', 'b'.repeat(40))).toBeUndefined();
+    const blocked = writer.send('content', 'c'.repeat(40));
+    expect(blocked).toBeInstanceOf(Promise);
+
+    res.release();
+    await blocked;
+
+    expect(res.text()).toContain('c'.repeat(40));
+    expect(writer.getStats().stalls).toBeGreaterThanOrEqual(1);
+    writer.end();
+  });
+
+  it('should release waiting producers when the client disconnects', async () => {
+    const res = new FakeResponse();
+    res.hold = true;
+    const writer = new SseWriter(res.asResponse(), {
+      heartbeatIntervalMs: 0,
+      flushThresholdBytes: 16,
+      maxBufferedBytes: 16,
+    });
+    writer.send('content', 'a'.repeat(80));
+    const blocked = writer.send('content', 'b'.repeat(80));
+
+    res.emit('close');
+
+    await expect(blocked).resolves.toBeUndefined();
+  });
+
+  it('should measure the buffer in bytes, not characters', () => {
+    const res = new FakeResponse();
+    res.hold = true;
+    const writer = new SseWriter(res.asResponse(), {
+      heartbeatIntervalMs: 0,
+      maxBufferedBytes: 100,
+    });
+
+    // 62 characters, but 102 bytes in UTF-8.
+    expect(writer.send('content', 'é'.repeat(40))).toBeInstanceOf(Promise);
+    writer.end();
+  });
+
+  it('should send heartbeat comments on idle streams', async () => {
+    const res = new FakeResponse();
+    const writer = new SseWriter(res.asResponse(), { heartbeatIntervalMs: 5 });
+
+    await new Promise((resolve) => setTimeout(resolve, 30));
+    writer.end();
+
+    expect(res.text()).toContain(': heartbeat\n\n');
+  });
+
+  it('should gzip the stream when enabled', async () => {
+    const res = new FakeResponse();
+    const writer = new SseWriter(res.asResponse(), {
+      heartbeatIntervalMs: 0,
+      gzip: true,
+    });
+
+    writer.send('done', 'true');
+    writer.end();
+    await new Promise((resolve) => res.on('finish', resolve));
+
+    expect(res.headers['Content-Encoding']).toBe('gzip');
+    expect(zlib.gunzipSync(Buffer.concat(res.chunks)).toString()).toBe(
+      'event: done\ndata: true\n\n',
+    );
+  });
+
+  it('should destroy the gzip stream when the client disconnects', () => {
+    const res = new FakeResponse();
+    const writer = new SseWriter(res.asResponse(), {
+      heartbeatIntervalMs: 0,
+      gzip: true,
+    });
+    writer.send('content', 'partial');
+
+    res.emit('close');
+
+    const { gzip } = writer as unknown as { gzip: zlib.Gzip };
+    expect(gzip.destroyed).toBe(true);
+  });
+});
@@ -0,0 +1,273 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import type { ServerResponse } from 'http';
+import type { Writable } from 'stream';
+import zlib from 'zlib';
+import { performance } from 'perf_hooks';
+import type { RequestTiming } from './requestTiming.js';
+import { getRequestTiming } from './requestTiming.js';
+
+export interface SseWriterOptions {
+  /** Delay before pending events are flushed; 0 flushes on the next tick. */
+  flushIntervalMs?: number;
+  /** Pending bytes that trigger an immediate flush. */
+  flushThresholdBytes?: number;
+  /**
+   * Pending bytes allowed while the client is not draining. Past this, send()
+   * returns a promise that resolves once the socket drains.
+   */
+  maxBufferedBytes?: number;
+  /** Interval of keep-alive comments; 0 disables them. */
+  heartbeatIntervalMs?: number;
+  /** Compress the stream with gzip (the client must accept it). */
+  gzip?: boolean;
+}
+
+export interface SseWriterStats {
+  events: number;
+  /** Bytes handed to the connection, after compression. */
+  bytes: number;
+  flushes: number;
+  /** Times a write had to wait for the client to drain. */
+  stalls: number;
+  stallMs: number;
+}
+
+const DEFAULT_OPTIONS: Required<SseWriterOptions> = {
+  flushIntervalMs: 0,
+  flushThresholdBytes: 16 * 1024,
+  maxBufferedBytes: 1024 * 1024,
+  heartbeatIntervalMs: 15_000,
+  gzip: false,
+};
+
+const totals: SseWriterStats & { connections: number; open: number } = {
+  connections: 0,
+  open: 0,
+  events: 0,
+  bytes: 0,
+  flushes: 0,
+  stalls: 0,
+  stallMs: 0,
+};
+
+/**
+ * Totals over every SSE connection served by this process, plus the number
+ * of streams currently open.
+ */
+export function getSseTotals(): SseWriterStats & {
+  connections: number;
+  open: number;
+} {
+  return { ...totals };
+}
+
+function escapeData(data: string): string {
+  // Most token chunks contain no newline, so skip the replace for them.
+  return data.includes('\n') ? data.replaceAll('\n', '\\n') : data;
+}
+
+/**
+ * Server-sent events writer for one response. Events sent in the same tick
+ * are coalesced into a single write, the client's drain backpressure is
+ * honoured with a bounded buffer, and idle streams get heartbeat comments.
+ */
+export class SseWriter {
+  private readonly options: Required<SseWriterOptions>;
+  private readonly out: Writable;
+  private readonly gzip: zlib.Gzip | undefined;
+  private readonly timing: RequestTiming | undefined;
+  private pending: string[] = [];
+  private pendingBytes = 0;
+  private flushTimer: NodeJS.Timeout | NodeJS.Immediate | undefined;
+  private heartbeatTimer: NodeJS.Timeout | undefined;
+  private stalledSince: number | undefined;
+  private drainWaiters: Array<() => void> = [];
+  private closed = false;
+  private readonly stats: SseWriterStats = {
+    events: 0,
+    bytes: 0,
+    flushes: 0,
+    stalls: 0,
+    stallMs: 0,
+  };
+
+  constructor(res: ServerResponse, options: SseWriterOptions = {}) {
+    this.options = { ...DEFAULT_OPTIONS, ...options };
+    totals.connections++;
+    totals.open++;
+    this.timing = getRequestTiming(res);
+
+    if (this.options.gzip) {
+      res.setHeader('Content-Encoding', 'gzip');
+      this.gzip = zlib.createGzip();
+      this.gzip.on('data', (chunk: Buffer) => this.countBytes(chunk.length));
+      this.gzip.pipe(res);
+      this.out = this.gzip;
+    } else {
+      this.out = res;
+    }
+
+    res.on('close', () => {
+      this.dispose();
+      // Frees zlib's native buffers when the client leaves before end().
+      this.gzip?.destroy();
+    });
+    this.scheduleHeartbeat();
+  }
+
+  /**
+   * Queues an event. Returns a promise only when the buffer is full, so
+   * producers can await it to slow down without paying for it otherwise.
+   */
+  send(event: string, data: string): Promise<void> | undefined {
+    return this.enqueue(`event: ${event}\ndata: ${escapeData(data)}\n\n`, true);
+  }
+
+  /** Queues a comment line, ignored by clients. */
+  comment(text: string): Promise<void> | undefined {
+    return this.enqueue(`: ${text}\n\n`, false);
+  }
+
+  /** Flushes pending events and ends the response. */
+  end(): void {
+    if (this.closed) return;
+    // Whatever is still pending is handed over even if the client is slow;
+    // the response buffers it until the socket drains.
+    this.flush(true);
+    this.dispose();
+    this.out.end();
+  }
+
+  getStats(): SseWriterStats {
+    return { ...this.stats };
+  }
+
+  private enqueue(frame: string, isEvent: boolean): Promise<void> | undefined {
+    if (this.closed) return undefined;
+    if (isEvent) {
+      this.stats.events++;
+      totals.events++;
+    }
+    this.pending.push(frame);
+    this.pendingBytes += Buffer.byteLength(frame);
+    this.scheduleHeartbeat();
+
+    if (this.stalledSince === undefined) {
+      if (this.pendingBytes >= this.options.flushThresholdBytes) {
+        this.flush();
+      } else {
+        this.scheduleFlush();
+      }
+    }
+    if (this.pendingBytes > this.options.maxBufferedBytes) {
+      return new Promise((resolve) => this.drainWaiters.push(resolve));
+    }
+    return undefined;
+  }
+
+  private scheduleFlush(): void {
+    if (this.flushTimer) return;
+    this.flushTimer =
+      this.options.flushIntervalMs > 0
+        ? setTimeout(() => this.flush(), this.options.flushIntervalMs)
+        : setImmediate(() => this.flush());
+  }
+
+  private flush(force = false): void {
+    this.clearFlushTimer();
+    if (this.closed || this.pending.length === 0) return;
+    if (this.stalledSince !== undefined && !force) return;
+
+    const chunk =
+      this.pending.length === 1 ? this.pending[0] : this.pending.join('');
+    this.pending = [];
+    this.pendingBytes = 0;
+    this.stats.flushes++;
+    totals.flushes++;
+
+    if (!this.gzip) {
+      this.countBytes(Buffer.byteLength(chunk));
+    }
+    const writeStart = performance.now();
+    const writable = this.out.write(chunk);
+    // Push compressed bytes out now instead of when zlib's window fills.
+    this.gzip?.flush(zlib.constants.Z_SYNC_FLUSH);
+    this.timing?.add('write', performance.now() - writeStart);
+
+    if (writable || force) {
+      this.releaseWaiters();
+      return;
+    }
+    this.stalledSince = Date.now();
+    this.stats.stalls++;
+    totals.stalls++;
+    this.out.once('drain', () => {
+      if (this.stalledSince !== undefined) {
+        const stalledMs = Date.now() - this.stalledSince;
+        this.stats.stallMs += stalledMs;
+        totals.stallMs += stalledMs;
+        // Time blocked on the client counts as writing, not handling.
+        this.timing?.add('write', stalledMs);
+        this.stalledSince = undefined;
+      }
+      this.flush();
+      if (this.stalledSince === undefined) {
+        this.releaseWaiters();
+      }
+    });
+  }
+
+  private countBytes(bytes: number): void {
+    this.stats.bytes += bytes;
+    totals.bytes += bytes;
+  }
+
+  private releaseWaiters(): void {
+    if (this.drainWaiters.length === 0) return;
+    const waiters = this.drainWaiters;
+    this.drainWaiters = [];
+    waiters.forEach((resolve) => resolve());
+  }
+
+  private scheduleHeartbeat(): void {
+    if (this.options.heartbeatIntervalMs <= 0 || this.closed) return;
+    // Restarted on every event, so only idle streams get heartbeats.
+    if (this.heartbeatTimer) {
+      this.heartbeatTimer.refresh();
+      return;
+    }
+    this.heartbeatTimer = setTimeout(() => {
+      this.heartbeatTimer = undefined;
+      this.comment('heartbeat');
+    }, this.options.heartbeatIntervalMs);
+    this.heartbeatTimer.unref?.();
+  }
+
+  private clearFlushTimer(): void {
+    if (!this.flushTimer) return;
+    if (this.options.flushIntervalMs > 0) {
+      clearTimeout(this.flushTimer as NodeJS.Timeout);
+    } else {
+      clearImmediate(this.flushTimer as NodeJS.Immediate);
+    }
+    this.flushTimer = undefined;
+  }
+
+  private dispose(): void {
+    if (this.closed) return;
+    this.closed = true;
+    totals.open--;
+    this.clearFlushTimer();
+    if (this.heartbeatTimer) {
+      clearTimeout(this.heartbeatTimer);
+      this.heartbeatTimer = undefined;
+    }
+    // Producers blocked on a client that went away must not hang.
+    this.releaseWaiters();
+  }
+}
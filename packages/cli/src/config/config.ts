@@ -651,6 +651,7 @@ export async function loadCliConfig(
     model: argv.model || settings.model?.name || DEFAULT_GEMINI_MODEL,
     extensionContextFilePaths,
     sessionTokenLimit: settings.sessionTokenLimit ?? -1,
+    subagentTokenBudget: settings.subagentTokenBudget,
     maxSessionTurns: settings.model?.maxSessionTurns ?? -1,
     experimentalZedIntegration: argv.experimentalAcp || false,
     listExtensions: argv.listExtensions || false,
@@ -8,7 +8,7 @@ import type {
   MCPServerConfig,
   GeminiCLIExtension,
 } from '@kolosal-ai/kolosal-ai-core';
-import { Storage } from '@kolosal-ai/kolosal-ai-core';
+import { FileMetadataCache, Storage } from '@kolosal-ai/kolosal-ai-core';
 import * as fs from 'node:fs';
 import * as path from 'node:path';
 import * as os from 'node:os';
@@ -16,6 +16,7 @@ import { simpleGit } from 'simple-git';
 import { SettingScope, loadSettings } from '../config/settings.js';
 import { getErrorMessage } from '../utils/errors.js';
 import { recursivelyHydrateStrings } from './extensions/variables.js';
+import type { JsonValue } from './extensions/variables.js';
 
 export const EXTENSIONS_DIRECTORY_NAME = path.join('.kolosal', 'extensions');
 export const EXTENSIONS_CONFIG_FILENAME = 'kolosal-extension.json';
@@ -42,6 +43,12 @@ export interface ExtensionInstallMetadata {
   type: 'git' | 'local';
 }
 
+/**
+ * Parsed extension config files, reused across runs while the file's mtime and
+ * size are unchanged.
+ */
+const extensionConfigCache = new FileMetadataCache<JsonValue>('extensions');
+
 export interface ExtensionUpdateInfo {
   originalVersion: string;
   updatedVersion: string;
@@ -156,6 +163,7 @@ export function loadExtensionsFromDir(dir: string): Extension[] {
       extensions.push(extension);
     }
   }
+  extensionConfigCache.saveSync();
   return extensions;
 }
 
@@ -183,8 +191,7 @@ export function loadExtension(extensionDir: string): Extension | null {
   }
 
   try {
-    const configContent = fs.readFileSync(configFilePath, 'utf-8');
-    const config = recursivelyHydrateStrings(JSON.parse(configContent), {
+    const config = recursivelyHydrateStrings(readConfigFile(configFilePath), {
       extensionPath: extensionDir,
       '/': path.sep,
       pathSeparator: path.sep,
@@ -216,6 +223,17 @@ export function loadExtension(extensionDir: string): Extension | null {
   }
 }
 
+function readConfigFile(configFilePath: string): JsonValue {
+  const stats = fs.statSync(configFilePath);
+  const cached = extensionConfigCache.get(configFilePath, stats);
+  if (cached !== undefined) {
+    return cached;
+  }
+  const config = JSON.parse(fs.readFileSync(configFilePath, 'utf-8'));
+  extensionConfigCache.set(configFilePath, stats, config);
+  return config;
+}
+
 function loadInstallMetadata(
   extensionDir: string,
 ): ExtensionInstallMetadata | undefined {
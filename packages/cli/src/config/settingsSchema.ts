@@ -986,6 +986,16 @@ export const SETTINGS_SCHEMA = {
     description: 'The maximum number of tokens allowed in a session.',
     showInDialog: false,
   },
+  subagentTokenBudget: {
+    type: 'number',
+    label: 'Subagent Token Budget',
+    category: 'General',
+    requiresRestart: true,
+    default: undefined as number | undefined,
+    description:
+      'The maximum number of tokens that concurrently running subagents may consume together before new ones are queued. Defaults to four context windows of the model; 0 disables the budget.',
+    showInDialog: false,
+  },
   systemPromptMappings: {
     type: 'object',
     label: 'System Prompt Mappings',
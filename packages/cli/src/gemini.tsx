@@ -241,6 +241,7 @@ export async function startServerOnly(
   
   // CRITICAL: Initialize the config - this sets up contentGeneratorConfig
   await config.initialize();
+  registerCleanup(() => config.getSubagentManager().dispose());
   
   // Get authType from current model (needed for client initialization)
   const { getCurrentModelAuthType, getSavedModelEntry } = await import('./config/savedModels.js');
@@ -432,6 +433,8 @@ export async function main() {
   }
 
   await config.initialize();
+  // Stops watching the subagent directories.
+  registerCleanup(() => config.getSubagentManager().dispose());
 
   // Optionally start lightweight HTTP API server to expose generation endpoints
   const apiEnabledEnv = process.env['KOLOSAL_CLI_API'];
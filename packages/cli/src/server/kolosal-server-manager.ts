@@ -7,14 +7,24 @@
  */
 
 import { spawn } from 'node:child_process';
-import type { ChildProcess } from 'node:child_process';
-import { existsSync } from 'node:fs';
+import type { ChildProcess, StdioOptions } from 'node:child_process';
+import { closeSync, existsSync, mkdirSync, openSync } from 'node:fs';
 import { join, dirname } from 'node:path';
 import { fileURLToPath } from 'node:url';
-import http from 'node:http';
 import { setTimeout } from 'node:timers/promises';
-import { detectGPUs, getGPUSummary } from '../utils/gpu-detector.js';
+import {
+  Storage,
+  clearContextWindowCache,
+  httpPool,
+  registerInferenceEngine,
+} from '@kolosal-ai/kolosal-ai-core';
+import { detectGPUsCached, getGPUSummary } from '../utils/gpu-detector.js';
 import type { GPUDetectionResult } from '../utils/gpu-detector.js';
+import { ServerRegistry, isProcessAlive } from './server-registry.js';
+import type {
+  InstanceClaim,
+  ServerInstanceRecord,
+} from './server-registry.js';
 
 const __dirname = dirname(fileURLToPath(import.meta.url));
 
@@ -25,10 +35,12 @@ export interface ServerConfig {
   host: string;
   /** Maximum startup time in milliseconds */
   startupTimeoutMs: number;
-  /** Health check interval in milliseconds */
+  /** Health check interval in milliseconds; also caps the readiness backoff */
   healthCheckIntervalMs: number;
-  /** Maximum health check retries */
+  /** Maximum readiness probes while the server starts */
   maxHealthCheckRetries: number;
+  /** Consecutive failed health checks before a running server is restarted */
+  maxHealthCheckFailures: number;
   /** Enable debug logging */
   debug: boolean;
   /** Server arguments */
@@ -37,6 +49,22 @@ export interface ServerConfig {
   autoStart: boolean;
   /** Graceful shutdown timeout */
   shutdownTimeoutMs: number;
+  /**
+   * Reuse a kolosal-server already started by another CLI session. A shared
+   * server runs detached and outlives the session that spawned it while
+   * other sessions use it. Off by default; KOLOSAL_SERVER_SHARED=1 enables it.
+   */
+  shared: boolean;
+  /** Leave a shared server running after the last session exits */
+  keepWarm: boolean;
+  /** Maximum automatic restarts after the server crashes */
+  maxRestarts: number;
+  /** Delay before the first restart; doubles with each further attempt */
+  restartBackoffMs: number;
+}
+
+function isEnvEnabled(name: string): boolean {
+  return ['1', 'true'].includes(process.env[name]?.toLowerCase() ?? '');
 }
 
 export const DEFAULT_SERVER_CONFIG: ServerConfig = {
@@ -45,12 +73,22 @@ export const DEFAULT_SERVER_CONFIG: ServerConfig = {
   startupTimeoutMs: 30000,
   healthCheckIntervalMs: 1000,
   maxHealthCheckRetries: 30,
+  maxHealthCheckFailures: 3,
   debug: false,
   serverArgs: [],
   autoStart: false, // Disabled by default, can be enabled via settings
   shutdownTimeoutMs: 5000,
+  shared: isEnvEnabled('KOLOSAL_SERVER_SHARED'),
+  keepWarm: isEnvEnabled('KOLOSAL_SERVER_KEEP_WARM'),
+  maxRestarts: 5,
+  restartBackoffMs: 1000,
 };
 
+// First readiness probe delay; doubles up to healthCheckIntervalMs
+const READINESS_INITIAL_DELAY_MS = 50;
+// Uptime after which the server is considered stable and restarts are reset
+const STABLE_UPTIME_MS = 60000;
+
 export enum ServerStatus {
   STOPPED = 'stopped',
   STARTING = 'starting',
@@ -59,6 +97,18 @@ export enum ServerStatus {
   ERROR = 'error',
 }
 
+/**
+ * Time spent in each phase of the last start, in milliseconds
+ */
+export interface StartupTimings {
+  /** `attached` when a server started by another session was reused */
+  mode: 'spawned' | 'attached';
+  gpuDetectionMs: number;
+  spawnMs: number;
+  readyMs: number;
+  totalMs: number;
+}
+
 export interface ServerHealth {
   status: ServerStatus;
   pid?: number;
@@ -66,6 +116,9 @@ export interface ServerHealth {
   uptime?: number;
   lastHealthCheck?: Date;
   error?: string;
+  attached?: boolean;
+  restarts?: number;
+  startup?: StartupTimings;
 }
 
 /**
@@ -80,10 +133,20 @@ export class KolosalServerManager {
   private shutdownPromise: Promise<void> | null = null;
   private serverExecutablePath: string;
   private gpuInfo: GPUDetectionResult | null = null;
+  private registry: ServerRegistry;
+  // Pid of the server, whether spawned here or by another session
+  private serverPid: number | undefined;
+  // True when using a server started by another session
+  private attached = false;
+  private restartCount = 0;
+  private restartTimer: NodeJS.Timeout | null = null;
+  private consecutiveHealthFailures = 0;
+  private startupTimings: StartupTimings | null = null;
 
   constructor(config: Partial<ServerConfig> = {}) {
     this.config = { ...DEFAULT_SERVER_CONFIG, ...config };
     this.serverExecutablePath = this.findServerExecutable();
+    this.registry = new ServerRegistry(getRegistryDir(), this.config.port);
   }
 
   /**
@@ -182,7 +245,7 @@ export class KolosalServerManager {
 
     if (this.gpuInfo === null) {
       this.debug('Detecting GPU capabilities...');
-      this.gpuInfo = await detectGPUs();
+      this.gpuInfo = await detectGPUsCached();
       const summary = getGPUSummary(this.gpuInfo);
       this.debug(`GPU detection complete: ${summary}`);
 
@@ -295,7 +358,8 @@ export class KolosalServerManager {
   }
 
   /**
-   * Start the kolosal-server process
+   * Start the kolosal-server process, or attach to one already started by
+   * another CLI session
    */
   async start(): Promise<void> {
     if (this.status !== ServerStatus.STOPPED) {
@@ -305,27 +369,78 @@ export class KolosalServerManager {
     this.debug('Starting kolosal-server...');
     this.status = ServerStatus.STARTING;
     this.startTime = Date.now();
+    const timings: StartupTimings = {
+      mode: 'spawned',
+      gpuDetectionMs: 0,
+      spawnMs: 0,
+      readyMs: 0,
+      totalMs: 0,
+    };
 
+    // Without a registry (sharing disabled or its directory unusable) this
+    // session simply spawns a private server.
+    let claim: InstanceClaim | null = null;
     try {
-      // Detect GPU capabilities before starting server
-      await this.detectGPUCapabilities();
+      if (this.config.shared) {
+        claim = await this.registry
+          .claim(process.pid, this.config.host)
+          .catch((error) => {
+            this.debug(`Server registry unavailable: ${error}`);
+            return null;
+          });
+      }
+
+      if (claim?.kind === 'attach') {
+        timings.mode = 'attached';
+        await this.attach(claim.record, timings);
+      } else {
+        // Detect GPU capabilities before starting server
+        let phaseStart = Date.now();
+        await this.detectGPUCapabilities();
+        timings.gpuDetectionMs = Date.now() - phaseStart;
+
+        phaseStart = Date.now();
+        await this.spawnServerProcess();
+        timings.spawnMs = Date.now() - phaseStart;
+
+        phaseStart = Date.now();
+        await this.waitForServerReady();
+        timings.readyMs = Date.now() - phaseStart;
+
+        if (claim) {
+          await this.registry.markRunning(process.pid, this.serverPid!);
+        }
+        // A fresh process may serve another context size than the last one.
+        clearContextWindowCache(this.getServerUrl());
+      }
 
-      await this.spawnServerProcess();
-      await this.waitForServerReady();
       this.startHealthChecking();
       this.status = ServerStatus.RUNNING;
+      timings.totalMs = Date.now() - this.startTime;
+      this.startupTimings = timings;
       this.debug(
-        `kolosal-server started successfully on ${this.config.host}:${this.config.port}`,
+        `kolosal-server ${timings.mode} on ${this.config.host}:${this.config.port} ` +
+          `in ${timings.totalMs}ms (gpu ${timings.gpuDetectionMs}ms, spawn ${timings.spawnMs}ms, ready ${timings.readyMs}ms)`,
       );
     } catch (error) {
       this.status = ServerStatus.ERROR;
+      if (this.process) {
+        this.process.kill('SIGKILL');
+      }
+      if (this.attached) {
+        await this.registry.release(process.pid).catch(() => {});
+      } else if (claim) {
+        // Drop the `starting` record so other sessions do not wait on it.
+        await this.registry.remove(process.pid).catch(() => {});
+      }
       this.cleanup();
       throw new Error(`Failed to start kolosal-server: ${error}`);
     }
   }
 
   /**
-   * Stop the kolosal-server process
+   * Stop the kolosal-server process. A shared server is left running while
+   * other sessions still use it, or when it is kept warm.
    */
   async stop(): Promise<void> {
     if (this.status === ServerStatus.STOPPED) {
@@ -347,21 +462,34 @@ export class KolosalServerManager {
   getHealth(): ServerHealth {
     return {
       status: this.status,
-      pid: this.process?.pid,
+      pid: this.serverPid,
       port: this.status === ServerStatus.RUNNING ? this.config.port : undefined,
       uptime:
         this.status === ServerStatus.RUNNING
           ? Date.now() - this.startTime
           : undefined,
       lastHealthCheck: new Date(),
+      attached: this.attached,
+      restarts: this.restartCount,
+      startup: this.startupTimings ?? undefined,
     };
   }
 
+  /**
+   * Get the phase timings of the last successful start
+   */
+  getStartupTimings(): StartupTimings | null {
+    return this.startupTimings;
+  }
+
   /**
    * Check if the server is running and healthy
    */
   async isHealthy(): Promise<boolean> {
-    if (this.status !== ServerStatus.RUNNING || !this.process) {
+    if (
+      this.status !== ServerStatus.RUNNING ||
+      (!this.process && !this.attached)
+    ) {
       return false;
     }
 
@@ -410,6 +538,12 @@ export class KolosalServerManager {
       recommendedEngine,
       ...this.config.serverArgs,
     ];
+    // Extra server args may override the engine; the last occurrence wins.
+    const engineIndex = args.lastIndexOf('--default-inference-engine');
+    registerInferenceEngine(
+      this.getServerUrl(),
+      args[engineIndex + 1] ?? recommendedEngine,
+    );
 
     // Set library path for macOS
     const env = { ...process.env };
@@ -426,148 +560,256 @@ export class KolosalServerManager {
       `Server executable exists: ${existsSync(this.serverExecutablePath)}`,
     );
 
-    this.process = spawn(this.serverExecutablePath, args, {
+    // Output goes to a log file rather than an unread pipe, which would stall
+    // the server once the pipe buffer fills up.
+    let logFd: number | undefined;
+    let stdio: StdioOptions = 'inherit';
+    if (!this.config.debug) {
+      mkdirSync(dirname(this.registry.logPath), { recursive: true });
+      logFd = openSync(this.registry.logPath, 'a');
+      stdio = ['ignore', logFd, logFd];
+    }
+
+    // A shared server runs in its own process group so it outlives this
+    // session (and is not hit by its Ctrl+C) while other sessions use it.
+    // If every session using it dies without stopping it, the next session
+    // reaps it through reapAbandonedServers().
+    const child = spawn(this.serverExecutablePath, args, {
       env,
-      stdio: this.config.debug ? 'inherit' : 'pipe',
-      detached: false,
+      stdio,
+      detached: this.config.shared,
+      // Detached processes get their own console window on Windows.
+      windowsHide: true,
     });
+    this.process = child;
+    if (logFd !== undefined) {
+      closeSync(logFd);
+    }
 
-    let processErrorOccurred = false;
-
-    this.process.on('error', (error) => {
-      processErrorOccurred = true;
+    child.on('error', (error) => {
       this.debug(`Server process error: ${error}`);
-      this.status = ServerStatus.ERROR;
-      this.cleanup();
+      if (this.process === child) {
+        this.status = ServerStatus.ERROR;
+        this.cleanup();
+      }
     });
 
-    this.process.on('exit', (code, signal) => {
+    child.on('exit', (code, signal) => {
       this.debug(`Server process exited with code ${code}, signal ${signal}`);
-      if (this.status === ServerStatus.RUNNING) {
+      if (this.process !== child) {
+        // Already replaced or deliberately killed
+        return;
+      }
+      const crashed = this.status === ServerStatus.RUNNING;
+      if (crashed) {
         this.status = ServerStatus.ERROR;
       } else if (this.status === ServerStatus.STOPPING) {
         this.status = ServerStatus.STOPPED;
       }
       this.cleanup();
+      if (crashed) {
+        this.handleCrash(`exited with code ${code}, signal ${signal}`);
+      }
     });
 
-    // Give the process a moment to start
-    await setTimeout(500);
+    await new Promise<void>((resolve, reject) => {
+      child.once('spawn', resolve);
+      child.once('error', (error) =>
+        reject(new Error(`Server process failed to spawn: ${error.message}`)),
+      );
+    });
 
-    if (processErrorOccurred) {
-      throw new Error('Server process failed to spawn');
+    if (this.config.shared) {
+      child.unref();
     }
+    this.serverPid = child.pid;
+  }
 
-    if (
-      !this.process ||
-      this.process.killed ||
-      this.process.exitCode !== null
-    ) {
-      throw new Error(
-        `Server process failed to start - killed: ${this.process?.killed}, exitCode: ${this.process?.exitCode}`,
-      );
+  /**
+   * Use a server started by another session, waiting for it to become ready
+   * if that session is still booting it
+   */
+  private async attach(
+    record: ServerInstanceRecord,
+    timings: StartupTimings,
+  ): Promise<void> {
+    this.debug(
+      `Attaching to ${record.status} kolosal-server (pid ${record.pid}) on port ${record.port}`,
+    );
+    this.attached = true;
+    this.serverPid = record.status === 'running' ? record.pid : undefined;
+
+    const phaseStart = Date.now();
+    await this.waitForServerReady();
+    timings.readyMs = Date.now() - phaseStart;
+
+    if (this.serverPid === undefined) {
+      const current = await this.registry.read();
+      if (current?.status === 'running') {
+        this.serverPid = current.pid;
+      }
     }
   }
 
   /**
-   * Wait for the server to be ready to accept connections
+   * Wait for the server to be ready to accept connections. Probes back off
+   * exponentially, and a server process exiting fails the wait immediately
+   * instead of running into the timeout.
    */
   private async waitForServerReady(): Promise<void> {
-    const startTime = Date.now();
-    let retries = 0;
-
-    while (retries < this.config.maxHealthCheckRetries) {
-      if (Date.now() - startTime > this.config.startupTimeoutMs) {
-        throw new Error(
-          `Server startup timeout after ${this.config.startupTimeoutMs}ms`,
-        );
-      }
+    const deadline = Date.now() + this.config.startupTimeoutMs;
+    const child = this.process;
+    const exited = new AbortController();
+    let exitError: Error | null = null;
+    const onExit = (code: number | null, signal: string | null) => {
+      exitError = new Error(
+        `Server process exited during startup with code ${code}, signal ${signal}`,
+      );
+      exited.abort();
+    };
+    child?.once('exit', onExit);
 
-      try {
-        const isReady = await this.makeHealthRequest();
-        if (isReady) {
+    try {
+      let delay = READINESS_INITIAL_DELAY_MS;
+      let attempts = 0;
+      for (;;) {
+        attempts++;
+        if (await this.makeHealthRequest()) {
+          this.debug(`Server ready after ${attempts} probe(s)`);
           return;
         }
-      } catch (_error) {
-        // Expected during startup
+        if (exitError) {
+          throw exitError;
+        }
+        if (this.serverPid !== undefined && !isProcessAlive(this.serverPid)) {
+          throw new Error(`Server process ${this.serverPid} is not running`);
+        }
+        if (Date.now() + delay > deadline) {
+          throw new Error(
+            `Server startup timeout after ${this.config.startupTimeoutMs}ms`,
+          );
+        }
+        if (attempts >= this.config.maxHealthCheckRetries) {
+          throw new Error(`Server not ready after ${attempts} health checks`);
+        }
+        await setTimeout(delay, undefined, { signal: exited.signal }).catch(
+          () => {},
+        );
+        if (exitError) {
+          throw exitError;
+        }
+        delay = Math.min(delay * 2, this.config.healthCheckIntervalMs);
       }
-
-      retries++;
-      await setTimeout(this.config.healthCheckIntervalMs);
+    } finally {
+      child?.off('exit', onExit);
     }
-
-    throw new Error(`Server failed to become ready after ${retries} attempts`);
   }
 
   /**
    * Make a health check request to the server
    */
   private async makeHealthRequest(): Promise<boolean> {
-    return new Promise((resolve) => {
-      const request = http.request(
-        {
-          hostname: this.config.host,
-          port: this.config.port,
-          path: '/health',
-          method: 'GET',
-          timeout: 3000,
-        },
-        (response) => {
-          if (response.statusCode === 200) {
-            let data = '';
-            response.on('data', (chunk) => {
-              data += chunk;
-            });
-            response.on('end', () => {
-              try {
-                const healthData = JSON.parse(data);
-                const isHealthy = healthData.status === 'healthy';
-                this.debug(
-                  `Health check response: ${isHealthy ? 'healthy' : 'unhealthy'} - ${data.substring(0, 100)}`,
-                );
-                resolve(isHealthy);
-              } catch (error) {
-                this.debug(`Health check JSON parse error: ${error}`);
-                resolve(false);
-              }
-            });
-          } else {
-            this.debug(
-              `Health check failed with status ${response.statusCode}`,
-            );
-            resolve(false);
-          }
-        },
-      );
-
-      request.on('error', (error) => {
-        this.debug(`Health check request error: ${error.message}`);
-        resolve(false);
-      });
-      request.on('timeout', () => {
-        this.debug('Health check request timeout');
-        request.destroy();
-        resolve(false);
+    try {
+      // Goes through the shared keep-alive pool, so periodic probes reuse
+      // the connection used by the model requests.
+      const response = await httpPool.fetch(`${this.getServerUrl()}/health`, {
+        signal: AbortSignal.timeout(3000),
       });
-
-      request.end();
-    });
+      const data = await response.text();
+      if (response.status !== 200) {
+        this.debug(`Health check failed with status ${response.status}`);
+        return false;
+      }
+      try {
+        const healthData = JSON.parse(data);
+        const isHealthy = healthData.status === 'healthy';
+        this.debug(
+          `Health check response: ${isHealthy ? 'healthy' : 'unhealthy'} - ${data.substring(0, 100)}`,
+        );
+        return isHealthy;
+      } catch (error) {
+        this.debug(`Health check JSON parse error: ${error}`);
+        return false;
+      }
+    } catch (error) {
+      this.debug(
+        `Health check request error: ${error instanceof Error ? error.message : error}`,
+      );
+      return false;
+    }
   }
 
   /**
-   * Start periodic health checking
+   * Start periodic health checking. A server that stops responding is
+   * treated like a crash.
    */
   private startHealthChecking(): void {
+    this.consecutiveHealthFailures = 0;
     this.healthCheckTimer = setInterval(async () => {
       const healthy = await this.isHealthy();
-      if (!healthy && this.status === ServerStatus.RUNNING) {
-        this.debug('Server health check failed, marking as error');
-        this.status = ServerStatus.ERROR;
-        this.cleanup();
+      if (this.status !== ServerStatus.RUNNING) {
+        return;
+      }
+      if (healthy) {
+        this.consecutiveHealthFailures = 0;
+        if (Date.now() - this.startTime > STABLE_UPTIME_MS) {
+          this.restartCount = 0;
+        }
+        return;
+      }
+
+      this.consecutiveHealthFailures++;
+      const processGone =
+        this.serverPid !== undefined && !isProcessAlive(this.serverPid);
+      if (
+        !processGone &&
+        this.consecutiveHealthFailures < this.config.maxHealthCheckFailures
+      ) {
+        return;
       }
+
+      this.debug('Server health check failed, restarting');
+      this.status = ServerStatus.ERROR;
+      // Only the session that spawned the server kills a hung one.
+      const hungProcess = this.process;
+      this.cleanup();
+      hungProcess?.kill('SIGKILL');
+      this.handleCrash(
+        processGone ? 'is no longer running' : 'stopped responding',
+      );
     }, this.config.healthCheckIntervalMs * 5); // Check every 5 seconds
   }
 
+  /**
+   * Restart the server after a crash, backing off exponentially
+   */
+  private handleCrash(reason: string): void {
+    if (this.restartCount >= this.config.maxRestarts) {
+      this.debug(
+        `kolosal-server ${reason}; giving up after ${this.restartCount} restarts`,
+      );
+      return;
+    }
+
+    const delay = this.config.restartBackoffMs * 2 ** this.restartCount;
+    this.restartCount++;
+    this.debug(
+      `kolosal-server ${reason}; restarting in ${delay}ms (attempt ${this.restartCount}/${this.config.maxRestarts})`,
+    );
+    this.restartTimer = globalThis.setTimeout(() => {
+      this.restartTimer = null;
+      if (this.status !== ServerStatus.ERROR) {
+        return;
+      }
+      this.status = ServerStatus.STOPPED;
+      this.start().catch((error) => {
+        this.debug(`Restart failed: ${error}`);
+        this.handleCrash('failed to restart');
+      });
+    }, delay);
+    this.restartTimer.unref();
+  }
+
   /**
    * Perform graceful shutdown
    */
@@ -579,25 +821,28 @@ export class KolosalServerManager {
       clearInterval(this.healthCheckTimer);
       this.healthCheckTimer = null;
     }
+    if (this.restartTimer) {
+      clearTimeout(this.restartTimer);
+      this.restartTimer = null;
+    }
 
-    if (this.process && !this.process.killed) {
-      // Try graceful shutdown first
-      this.process.kill('SIGTERM');
-
-      // Wait for graceful shutdown
-      const shutdownStart = Date.now();
-      while (
-        this.process &&
-        !this.process.killed &&
-        Date.now() - shutdownStart < this.config.shutdownTimeoutMs
-      ) {
-        await setTimeout(100);
-      }
+    const pid = this.serverPid;
+    const otherSessions = this.config.shared
+      ? await this.registry
+          .release(process.pid, this.config.keepWarm)
+          .catch(() => [])
+      : [];
 
-      // Force kill if still running
-      if (this.process && !this.process.killed) {
-        this.debug('Forcing server shutdown...');
-        this.process.kill('SIGKILL');
+    if (otherSessions.length > 0) {
+      this.debug(
+        `Leaving kolosal-server running for ${otherSessions.length} other session(s)`,
+      );
+    } else if (this.config.shared && this.config.keepWarm) {
+      this.debug('Keeping kolosal-server warm for the next session');
+    } else if (pid !== undefined) {
+      await this.terminate(pid);
+      if (this.config.shared) {
+        await this.registry.remove(pid).catch(() => {});
       }
     }
 
@@ -606,6 +851,15 @@ export class KolosalServerManager {
     this.debug('kolosal-server stopped');
   }
 
+  /**
+   * Terminate the server, escalating to SIGKILL after the shutdown timeout
+   */
+  private async terminate(pid: number): Promise<void> {
+    if (!(await terminateProcess(pid, this.config.shutdownTimeoutMs))) {
+      this.debug('Forced server shutdown');
+    }
+  }
+
   /**
    * Clean up resources
    */
@@ -615,6 +869,8 @@ export class KolosalServerManager {
       this.healthCheckTimer = null;
     }
     this.process = null;
+    this.serverPid = undefined;
+    this.attached = false;
   }
 
   /**
@@ -627,6 +883,67 @@ export class KolosalServerManager {
   }
 }
 
+function getRegistryDir(): string {
+  return join(Storage.getGlobalGeminiDir(), 'server');
+}
+
+/**
+ * Sends SIGTERM, escalating to SIGKILL after `timeoutMs`. Resolves to false
+ * when the process had to be killed.
+ */
+async function terminateProcess(
+  pid: number,
+  timeoutMs: number,
+): Promise<boolean> {
+  try {
+    // Try graceful shutdown first
+    process.kill(pid, 'SIGTERM');
+  } catch {
+    return true; // Already gone
+  }
+
+  const shutdownStart = Date.now();
+  while (isProcessAlive(pid) && Date.now() - shutdownStart < timeoutMs) {
+    await setTimeout(100);
+  }
+
+  // Force kill if still running
+  if (isProcessAlive(pid)) {
+    try {
+      process.kill(pid, 'SIGKILL');
+    } catch {
+      // Exited in the meantime
+    }
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Stops shared servers left running by sessions that exited without stopping
+ * them, e.g. because they were killed or crashed. A shared server runs
+ * detached so it can outlive the session that spawned it, which leaves its
+ * cleanup to whichever session starts next. Servers kept warm on purpose,
+ * and the one on `exceptPort` that this session is about to attach to, are
+ * left alone.
+ */
+export async function reapAbandonedServers(
+  exceptPort?: number,
+): Promise<void> {
+  const dir = getRegistryDir();
+  for (const port of await ServerRegistry.listPorts(dir)) {
+    if (port === exceptPort) {
+      continue;
+    }
+    const record = await new ServerRegistry(dir, port)
+      .takeAbandoned()
+      .catch(() => null);
+    if (record) {
+      await terminateProcess(record.pid, DEFAULT_SERVER_CONFIG.shutdownTimeoutMs);
+    }
+  }
+}
+
 // Global server manager instance
 let globalServerManager: KolosalServerManager | null = null;
 
@@ -654,6 +971,11 @@ export async function startServerIfEnabled(
     return null;
   }
 
+  // A server on the port this session uses is adopted rather than reaped.
+  void reapAbandonedServers(
+    finalConfig.shared ? finalConfig.port : undefined,
+  ).catch(() => {});
+
   const manager = getServerManager(finalConfig);
 
   try {
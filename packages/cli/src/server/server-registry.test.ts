@@ -0,0 +1,181 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import * as fs from 'node:fs/promises';
+import http from 'node:http';
+import type { AddressInfo } from 'node:net';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import {
+  ServerRegistry,
+  isProcessAlive,
+  isRecordedServer,
+} from './server-registry.js';
+
+// A pid that is practically never in use
+const DEAD_PID = 2 ** 22 - 1;
+
+describe('ServerRegistry', () => {
+  let tmpDir: string;
+  let registry: ServerRegistry;
+
+  beforeEach(async () => {
+    tmpDir = await fs.mkdtemp(path.join(os.tmpdir(), 'server-registry-'));
+    // Only a live pid is required here; isRecordedServer is tested below.
+    registry = new ServerRegistry(tmpDir, 8087, async (record) =>
+      isProcessAlive(record.pid),
+    );
+  });
+
+  afterEach(async () => {
+    await fs.rm(tmpDir, { recursive: true, force: true });
+  });
+
+  it('should ask the first session to spawn and later ones to attach', async () => {
+    expect(await registry.claim(process.pid, '127.0.0.1')).toEqual({
+      kind: 'spawn',
+    });
+    expect((await registry.read())?.status).toBe('starting');
+
+    await registry.markRunning(process.pid, process.pid);
+    const claim = await registry.claim(process.ppid, '127.0.0.1');
+
+    expect(claim.kind).toBe('attach');
+    expect(claim.kind === 'attach' && claim.record).toMatchObject({
+      status: 'running',
+      pid: process.pid,
+      port: 8087,
+    });
+    expect((await registry.read())?.clients.sort()).toEqual(
+      [process.pid, process.ppid].sort(),
+    );
+  });
+
+  it('should replace records of servers that are no longer running', async () => {
+    await registry.claim(process.pid, '127.0.0.1');
+    await registry.markRunning(process.pid, DEAD_PID);
+
+    expect(await registry.claim(process.pid, '127.0.0.1')).toEqual({
+      kind: 'spawn',
+    });
+  });
+
+  it('should report the sessions still using the server on release', async () => {
+    await registry.claim(process.pid, '127.0.0.1');
+    await registry.markRunning(process.pid, process.pid);
+    await registry.claim(process.ppid, '127.0.0.1');
+
+    expect(await registry.release(process.ppid)).toEqual([process.pid]);
+    expect(await registry.release(process.pid)).toEqual([]);
+  });
+
+  it('should only remove the record of the given server', async () => {
+    await registry.claim(process.pid, '127.0.0.1');
+    await registry.markRunning(process.pid, process.pid);
+
+    await registry.remove(DEAD_PID);
+    expect(await registry.read()).not.toBeNull();
+
+    await registry.remove(process.pid);
+    expect(await registry.read()).toBeNull();
+  });
+
+  it('should hand over servers whose sessions all exited without stopping them', async () => {
+    await registry.claim(DEAD_PID, '127.0.0.1');
+    await registry.markRunning(DEAD_PID, process.pid);
+
+    expect(await registry.takeAbandoned()).toMatchObject({ pid: process.pid });
+    expect(await registry.read()).toBeNull();
+    expect(await ServerRegistry.listPorts(tmpDir)).toEqual([]);
+  });
+
+  it('should not reap servers in use or kept warm', async () => {
+    await registry.claim(process.pid, '127.0.0.1');
+    await registry.markRunning(process.pid, process.pid);
+    expect(await registry.takeAbandoned()).toBeNull();
+
+    await registry.release(process.pid, true);
+    expect(await registry.takeAbandoned()).toBeNull();
+    expect(await ServerRegistry.listPorts(tmpDir)).toEqual([8087]);
+  });
+
+  it('should drop records whose pid no longer runs the server without reaping it', async () => {
+    // The default check finds no server answering on this port.
+    registry = new ServerRegistry(tmpDir, 1);
+    await registry.claim(DEAD_PID, '127.0.0.1');
+    await registry.markRunning(DEAD_PID, process.pid);
+
+    expect(await registry.takeAbandoned()).toBeNull();
+    expect(await registry.read()).toBeNull();
+  });
+
+  it('should break locks left behind by dead processes', async () => {
+    await fs.writeFile(
+      path.join(tmpDir, 'kolosal-server-8087.lock'),
+      String(DEAD_PID),
+    );
+
+    expect(await registry.claim(process.pid, '127.0.0.1')).toEqual({
+      kind: 'spawn',
+    });
+  });
+
+  it('should detect whether a process is alive', () => {
+    expect(isProcessAlive(process.pid)).toBe(true);
+    expect(isProcessAlive(DEAD_PID)).toBe(false);
+  });
+});
+
+describe('isRecordedServer', () => {
+  let server: http.Server;
+  let port: number;
+
+  beforeEach(async () => {
+    server = http.createServer((_req, res) =>
+      res.end('{"status":"healthy"}'),
+    );
+    await new Promise<void>((resolve) =>
+      server.listen(0, '127.0.0.1', resolve),
+    );
+    port = (server.address() as AddressInfo).port;
+  });
+
+  afterEach(async () => {
+    await new Promise((resolve) => server.close(resolve));
+  });
+
+  const record = (overrides: object = {}) => ({
+    status: 'running' as const,
+    pid: process.pid,
+    host: '127.0.0.1',
+    port,
+    startedAt: Date.now(),
+    clients: [],
+    ...overrides,
+  });
+
+  it('should require the server to answer its health check', async () => {
+    expect(await isRecordedServer(record())).toBe(true);
+    expect(await isRecordedServer(record({ pid: DEAD_PID }))).toBe(false);
+
+    await new Promise((resolve) => server.close(resolve));
+    server = http.createServer();
+    expect(await isRecordedServer(record())).toBe(false);
+  });
+
+  it.skipIf(process.platform !== 'linux')(
+    'should require the pid to run the recorded executable',
+    async () => {
+      const executable = await fs.readlink(`/proc/${process.pid}/exe`);
+
+      expect(await isRecordedServer(record({ executable }))).toBe(true);
+      expect(
+        await isRecordedServer(record({ executable: '/usr/bin/other' })),
+      ).toBe(false);
+    },
+  );
+});
@@ -0,0 +1,320 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { promises as fs } from 'node:fs';
+import { join } from 'node:path';
+import { setTimeout } from 'node:timers/promises';
+
+const LOCK_RETRY_MS = 25;
+const LOCK_TIMEOUT_MS = 5000;
+// A lock older than this is assumed to be left behind by a crashed process
+const STALE_LOCK_MS = 10000;
+// A server still starting after this long was abandoned by its booting session
+const STALE_STARTING_MS = 120000;
+const HEALTH_TIMEOUT_MS = 2000;
+
+export interface ServerInstanceRecord {
+  /** `starting` while the owner is booting the server, then `running`. */
+  status: 'starting' | 'running';
+  /** Server pid once running; the booting CLI's pid while starting. */
+  pid: number;
+  host: string;
+  port: number;
+  startedAt: number;
+  /** Pids of the CLI sessions using this instance. */
+  clients: number[];
+  /** Executable the server pid ran when recorded, where known (Linux). */
+  executable?: string;
+  /** Set when the last session left the server running on purpose. */
+  keptWarm?: boolean;
+}
+
+export type InstanceClaim =
+  | { kind: 'attach'; record: ServerInstanceRecord }
+  | { kind: 'spawn' };
+
+export function isProcessAlive(pid: number): boolean {
+  try {
+    process.kill(pid, 0);
+    return true;
+  } catch (error) {
+    // EPERM means the process exists but belongs to another user.
+    return (error as NodeJS.ErrnoException).code === 'EPERM';
+  }
+}
+
+/** Returns the executable `pid` runs, or undefined where procfs is absent. */
+async function executableOf(pid: number): Promise<string | undefined> {
+  try {
+    return await fs.readlink(`/proc/${pid}/exe`);
+  } catch {
+    return undefined;
+  }
+}
+
+/**
+ * Whether the running instance described by `record` is still there. Records
+ * outlive reboots and pids are reused, so a live pid alone proves nothing:
+ * the server must answer its health check, and where the system exposes it
+ * (Linux), the pid must still run the recorded executable.
+ */
+export async function isRecordedServer(
+  record: ServerInstanceRecord,
+): Promise<boolean> {
+  if (!isProcessAlive(record.pid)) {
+    return false;
+  }
+  if (
+    record.executable &&
+    (await executableOf(record.pid)) !== record.executable
+  ) {
+    return false;
+  }
+  try {
+    const response = await fetch(
+      `http://${record.host}:${record.port}/health`,
+      { signal: AbortSignal.timeout(HEALTH_TIMEOUT_MS) },
+    );
+    await response.body?.cancel();
+    return response.ok;
+  } catch {
+    return false;
+  }
+}
+
+/**
+ * Port file shared by all CLI sessions on this machine, recording the
+ * kolosal-server instance listening on a port and the sessions using it.
+ * Every read-modify-write happens under a lock file, so concurrent sessions
+ * agree on which one boots the server and which ones attach to it.
+ */
+export class ServerRegistry {
+  /** Returns the ports that have an instance record in `dir`. */
+  static async listPorts(dir: string): Promise<number[]> {
+    let names: string[];
+    try {
+      names = await fs.readdir(dir);
+    } catch {
+      return [];
+    }
+    return names.flatMap((name) => {
+      const match = /^kolosal-server-(\d+)\.json$/.exec(name);
+      return match ? [Number(match[1])] : [];
+    });
+  }
+
+  /**
+   * `isServer` confirms that a running instance's record still describes
+   * that server before anyone attaches to it or signals its pid.
+   */
+  constructor(
+    private readonly dir: string,
+    private readonly port: number,
+    private readonly isServer: (
+      record: ServerInstanceRecord,
+    ) => Promise<boolean> = isRecordedServer,
+  ) {}
+
+  get recordPath(): string {
+    return join(this.dir, `kolosal-server-${this.port}.json`);
+  }
+
+  get logPath(): string {
+    return join(this.dir, `kolosal-server-${this.port}.log`);
+  }
+
+  private get lockPath(): string {
+    return join(this.dir, `kolosal-server-${this.port}.lock`);
+  }
+
+  /**
+   * Registers `clientPid` with a live instance if there is one; otherwise
+   * records that `clientPid` is starting a new instance and asks it to spawn.
+   */
+  async claim(clientPid: number, host: string): Promise<InstanceClaim> {
+    return this.withLock(async () => {
+      const record = await this.readLive();
+      if (record) {
+        record.clients = this.liveClients(record.clients, clientPid);
+        delete record.keptWarm;
+        await this.write(record);
+        return { kind: 'attach', record };
+      }
+      await this.write({
+        status: 'starting',
+        pid: clientPid,
+        host,
+        port: this.port,
+        startedAt: Date.now(),
+        clients: [clientPid],
+      });
+      return { kind: 'spawn' };
+    });
+  }
+
+  /** Marks the instance booted by `clientPid` as running under `serverPid`. */
+  async markRunning(clientPid: number, serverPid: number): Promise<void> {
+    const executable = await executableOf(serverPid);
+    await this.withLock(async () => {
+      const record = await this.read();
+      await this.write({
+        status: 'running',
+        pid: serverPid,
+        host: record?.host ?? '127.0.0.1',
+        port: this.port,
+        startedAt: record?.startedAt ?? Date.now(),
+        clients: this.liveClients(record?.clients ?? [], clientPid),
+        executable,
+      });
+    });
+  }
+
+  /**
+   * Removes `clientPid` from the instance and returns the sessions still
+   * using it. With `keepWarm`, a server left without sessions is marked as
+   * kept running on purpose, so it is not reaped as abandoned.
+   */
+  async release(clientPid: number, keepWarm = false): Promise<number[]> {
+    return this.withLock(async () => {
+      const record = await this.read();
+      if (!record) {
+        return [];
+      }
+      record.clients = this.liveClients(record.clients).filter(
+        (pid) => pid !== clientPid,
+      );
+      if (keepWarm && record.clients.length === 0) {
+        record.keptWarm = true;
+      }
+      await this.write(record);
+      return record.clients;
+    });
+  }
+
+  /**
+   * Deletes and returns the record of a running instance whose sessions all
+   * exited without stopping it, e.g. because they were killed, so that the
+   * caller can stop the orphaned server. Servers kept warm are left alone,
+   * and records that no longer describe a server are deleted without being
+   * returned, so an unrelated process that reused the pid is never signalled.
+   */
+  async takeAbandoned(): Promise<ServerInstanceRecord | null> {
+    return this.withLock(async () => {
+      const record = await this.readLive();
+      if (
+        !record ||
+        record.status !== 'running' ||
+        record.keptWarm ||
+        this.liveClients(record.clients).length > 0
+      ) {
+        return null;
+      }
+      await fs.rm(this.recordPath, { force: true });
+      return record;
+    });
+  }
+
+  /** Deletes the record if it still describes the instance `pid`. */
+  async remove(pid: number): Promise<void> {
+    await this.withLock(async () => {
+      const record = await this.read();
+      if (record && record.pid === pid) {
+        await fs.rm(this.recordPath, { force: true });
+      }
+    });
+  }
+
+  async read(): Promise<ServerInstanceRecord | null> {
+    try {
+      const record = JSON.parse(
+        await fs.readFile(this.recordPath, 'utf-8'),
+      ) as ServerInstanceRecord;
+      return typeof record?.pid === 'number' ? record : null;
+    } catch {
+      return null;
+    }
+  }
+
+  /** Reads the record, deleting it unless it describes a live instance. */
+  private async readLive(): Promise<ServerInstanceRecord | null> {
+    const record = await this.read();
+    const live =
+      record?.status === 'starting'
+        ? isProcessAlive(record.pid) &&
+          Date.now() - record.startedAt < STALE_STARTING_MS
+        : record !== null && (await this.isServer(record));
+    if (record && live) {
+      return record;
+    }
+    if (record) {
+      await fs.rm(this.recordPath, { force: true });
+    }
+    return null;
+  }
+
+  private liveClients(clients: number[], add?: number): number[] {
+    const live = new Set(clients.filter(isProcessAlive));
+    if (add !== undefined) {
+      live.add(add);
+    }
+    return [...live];
+  }
+
+  private async write(record: ServerInstanceRecord): Promise<void> {
+    // Written to a temporary file and renamed so readers never see a
+    // partially written record.
+    const tmpPath = `${this.recordPath}.${process.pid}.tmp`;
+    await fs.writeFile(tmpPath, JSON.stringify(record), 'utf-8');
+    await fs.rename(tmpPath, this.recordPath);
+  }
+
+  private async withLock<T>(fn: () => Promise<T>): Promise<T> {
+    await fs.mkdir(this.dir, { recursive: true });
+    const deadline = Date.now() + LOCK_TIMEOUT_MS;
+    for (;;) {
+      try {
+        const handle = await fs.open(this.lockPath, 'wx');
+        await handle.writeFile(String(process.pid));
+        await handle.close();
+        break;
+      } catch (error) {
+        if ((error as NodeJS.ErrnoException).code !== 'EEXIST') {
+          throw error;
+        }
+        if (await this.isLockStale()) {
+          await fs.rm(this.lockPath, { force: true });
+          continue;
+        }
+        if (Date.now() > deadline) {
+          throw new Error(`Timed out waiting for ${this.lockPath}`);
+        }
+        await setTimeout(LOCK_RETRY_MS);
+      }
+    }
+    try {
+      return await fn();
+    } finally {
+      await fs.rm(this.lockPath, { force: true });
+    }
+  }
+
+  private async isLockStale(): Promise<boolean> {
+    try {
+      const [content, stats] = await Promise.all([
+        fs.readFile(this.lockPath, 'utf-8'),
+        fs.stat(this.lockPath),
+      ]);
+      const owner = Number(content);
+      return (
+        (owner > 0 && !isProcessAlive(owner)) ||
+        Date.now() - stats.mtimeMs > STALE_LOCK_MS
+      );
+    } catch {
+      // The lock disappeared in the meantime; just retry.
+      return false;
+    }
+  }
+}
@@ -0,0 +1,562 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { promises as fs } from 'node:fs';
+import { dirname, join } from 'node:path';
+import { Storage } from '@kolosal-ai/kolosal-ai-core';
+
+// First range request; most headers without a large vocabulary fit in it.
+const INITIAL_WINDOW_BYTES = 1 << 20;
+// Each further request doubles the window up to this size, so a header with
+// a multi-megabyte tokenizer takes a handful of requests instead of dozens.
+const MAX_WINDOW_BYTES = 32 << 20;
+const MAX_STRING_BYTES = 1 << 20;
+const CACHE_VERSION = 1;
+const DEFAULT_CACHE_ENTRIES = 500;
+
+const GGUF_MAGIC = 0x46554747; // "GGUF" in little-endian
+
+// GGUF metadata value types
+const ValueType = {
+  U8: 0,
+  I8: 1,
+  U16: 2,
+  I16: 3,
+  U32: 4,
+  I32: 5,
+  F32: 6,
+  BOOL: 7,
+  STRING: 8,
+  ARRAY: 9,
+  U64: 10,
+  I64: 11,
+  F64: 12,
+} as const;
+
+const FIXED_VALUE_SIZES: Record<number, number> = {
+  [ValueType.U8]: 1,
+  [ValueType.I8]: 1,
+  [ValueType.U16]: 2,
+  [ValueType.I16]: 2,
+  [ValueType.U32]: 4,
+  [ValueType.I32]: 4,
+  [ValueType.F32]: 4,
+  [ValueType.BOOL]: 1,
+  [ValueType.U64]: 8,
+  [ValueType.I64]: 8,
+  [ValueType.F64]: 8,
+};
+
+// ggml tensor types: [name, elements per block, bytes per block]
+const TENSOR_TYPES: Record<number, [string, number, number]> = {
+  0: ['F32', 1, 4],
+  1: ['F16', 1, 2],
+  2: ['Q4_0', 32, 18],
+  3: ['Q4_1', 32, 20],
+  6: ['Q5_0', 32, 22],
+  7: ['Q5_1', 32, 24],
+  8: ['Q8_0', 32, 34],
+  9: ['Q8_1', 32, 36],
+  10: ['Q2_K', 256, 84],
+  11: ['Q3_K', 256, 110],
+  12: ['Q4_K', 256, 144],
+  13: ['Q5_K', 256, 176],
+  14: ['Q6_K', 256, 210],
+  15: ['Q8_K', 256, 292],
+  16: ['IQ2_XXS', 256, 66],
+  17: ['IQ2_XS', 256, 74],
+  18: ['IQ3_XXS', 256, 98],
+  19: ['IQ1_S', 256, 50],
+  20: ['IQ4_NL', 32, 18],
+  21: ['IQ3_S', 256, 110],
+  22: ['IQ2_S', 256, 82],
+  23: ['IQ4_XS', 256, 136],
+  24: ['I8', 1, 1],
+  25: ['I16', 1, 2],
+  26: ['I32', 1, 4],
+  27: ['I64', 1, 8],
+  28: ['F64', 1, 8],
+  29: ['IQ1_M', 256, 56],
+  30: ['BF16', 1, 2],
+  34: ['TQ1_0', 256, 54],
+  35: ['TQ2_0', 256, 66],
+  39: ['MXFP4', 32, 17],
+};
+
+export interface GGUFMetadata {
+  architecture?: string;
+  attentionHeads: number;
+  /** KV heads per layer, averaged when the model varies them by layer. */
+  kvHeads: number;
+  hiddenLayers: number;
+  hiddenSize: number;
+  /** Per-head key and value dimensions. */
+  keyLength: number;
+  valueLength: number;
+  tensorCount: number;
+  /** Bytes of tensor data in this file; unset if a tensor type is unknown. */
+  tensorBytes?: number;
+  parameterCount?: number;
+  /** Tensor bytes by ggml type, e.g. `{ Q4_K: ..., F32: ... }`. */
+  tensorTypeBytes?: Record<string, number>;
+}
+
+/**
+ * Reads a remote file sequentially through HTTP range requests. Windows start
+ * at 1 MiB and grow with every request, and skipped regions past the buffer
+ * are never downloaded.
+ */
+export class RangeReader {
+  private buf: Uint8Array = new Uint8Array(0);
+  private bufStart = 0;
+  private pos = 0;
+  private eof = false;
+  private window: number;
+  /** Number of HTTP requests issued so far. */
+  requests = 0;
+
+  constructor(
+    private readonly url: string,
+    private readonly headers: Headers,
+    initialWindow = INITIAL_WINDOW_BYTES,
+  ) {
+    this.window = initialWindow;
+  }
+
+  private get available(): number {
+    return this.bufStart + this.buf.length - this.pos;
+  }
+
+  private async fetchRange(start: number, endExclusive: number): Promise<void> {
+    const headers = new Headers(this.headers);
+    headers.set('Range', `bytes=${start}-${endExclusive - 1}`);
+    this.requests++;
+
+    const res = await fetch(this.url, { headers });
+    if (!res.ok && res.status !== 206) {
+      throw new Error(`Range request failed: ${res.status}`);
+    }
+    const data = new Uint8Array(await res.arrayBuffer());
+
+    // Servers that ignore ranges answer 200 with the whole file.
+    if (res.status === 200) {
+      this.buf = data;
+      this.bufStart = 0;
+      this.eof = true;
+      return;
+    }
+
+    if (data.length < endExclusive - start) {
+      this.eof = true;
+    }
+    const merged = new Uint8Array(this.buf.length + data.length);
+    merged.set(this.buf);
+    merged.set(data, this.buf.length);
+    this.buf = merged;
+  }
+
+  private async ensure(n: number): Promise<void> {
+    while (this.available < n && !this.eof) {
+      // Drop consumed bytes before growing the buffer
+      const consumed = this.pos - this.bufStart;
+      if (consumed > 0) {
+        this.buf = this.buf.subarray(consumed);
+        this.bufStart = this.pos;
+      }
+      const start = this.bufStart + this.buf.length;
+      const size = Math.max(this.window, n - this.available);
+      this.window = Math.min(this.window * 2, MAX_WINDOW_BYTES);
+      await this.fetchRange(start, start + size);
+    }
+    if (this.available < n) {
+      throw new Error('Unexpected EOF');
+    }
+  }
+
+  async readExact(n: number): Promise<Uint8Array> {
+    await this.ensure(n);
+    const offset = this.pos - this.bufStart;
+    this.pos += n;
+    return this.buf.subarray(offset, offset + n);
+  }
+
+  async skip(n: number): Promise<void> {
+    if (n <= this.available) {
+      this.pos += n;
+      return;
+    }
+    // Jump past the buffer; the next read starts a new range there.
+    this.pos += n;
+    this.buf = new Uint8Array(0);
+    this.bufStart = this.pos;
+  }
+
+  async readU32(): Promise<number> {
+    const bytes = await this.readExact(4);
+    return new DataView(bytes.buffer, bytes.byteOffset, 4).getUint32(0, true);
+  }
+
+  async readU64(): Promise<number> {
+    const bytes = await this.readExact(8);
+    return Number(
+      new DataView(bytes.buffer, bytes.byteOffset, 8).getBigUint64(0, true),
+    );
+  }
+
+  async readString(): Promise<string> {
+    const length = await this.readU64();
+    if (length > MAX_STRING_BYTES) {
+      throw new Error('String too long');
+    }
+    return new TextDecoder().decode(await this.readExact(length));
+  }
+}
+
+async function readScalar(
+  reader: RangeReader,
+  type: number,
+): Promise<number | undefined> {
+  const size = FIXED_VALUE_SIZES[type];
+  if (size === undefined) {
+    return undefined;
+  }
+  const bytes = await reader.readExact(size);
+  const view = new DataView(bytes.buffer, bytes.byteOffset, size);
+  switch (type) {
+    case ValueType.U8:
+    case ValueType.BOOL:
+      return view.getUint8(0);
+    case ValueType.I8:
+      return view.getInt8(0);
+    case ValueType.U16:
+      return view.getUint16(0, true);
+    case ValueType.I16:
+      return view.getInt16(0, true);
+    case ValueType.U32:
+      return view.getUint32(0, true);
+    case ValueType.I32:
+      return view.getInt32(0, true);
+    case ValueType.F32:
+      return view.getFloat32(0, true);
+    case ValueType.U64:
+      return Number(view.getBigUint64(0, true));
+    case ValueType.I64:
+      return Number(view.getBigInt64(0, true));
+    default:
+      return view.getFloat64(0, true);
+  }
+}
+
+async function skipValue(reader: RangeReader, type: number): Promise<void> {
+  const size = FIXED_VALUE_SIZES[type];
+  if (size !== undefined) {
+    await reader.skip(size);
+    return;
+  }
+  if (type === ValueType.STRING) {
+    const length = await reader.readU64();
+    await reader.skip(length);
+    return;
+  }
+  if (type === ValueType.ARRAY) {
+    const elemType = await reader.readU32();
+    const count = await reader.readU64();
+    const elemSize = FIXED_VALUE_SIZES[elemType];
+    if (elemSize !== undefined) {
+      // Token scores and types are skipped without being downloaded.
+      await reader.skip(elemSize * count);
+      return;
+    }
+    for (let i = 0; i < count; i++) {
+      await skipValue(reader, elemType);
+    }
+    return;
+  }
+  throw new Error(`Unknown GGUF type: ${type}`);
+}
+
+// Reads a numeric scalar, or the mean of a numeric array (some models vary
+// head counts per layer).
+async function readNumber(
+  reader: RangeReader,
+  type: number,
+): Promise<number | undefined> {
+  if (type !== ValueType.ARRAY) {
+    const value = await readScalar(reader, type);
+    if (value === undefined) {
+      await skipValue(reader, type);
+    }
+    return value;
+  }
+  const elemType = await reader.readU32();
+  const count = await reader.readU64();
+  if (FIXED_VALUE_SIZES[elemType] === undefined || count === 0) {
+    for (let i = 0; i < count; i++) {
+      await skipValue(reader, elemType);
+    }
+    return undefined;
+  }
+  let sum = 0;
+  for (let i = 0; i < count; i++) {
+    sum += (await readScalar(reader, elemType)) ?? 0;
+  }
+  return sum / count;
+}
+
+/** Bytes used by a tensor of `elements` values stored as ggml `type`. */
+export function ggmlTensorBytes(
+  type: number,
+  elements: number,
+): number | undefined {
+  const info = TENSOR_TYPES[type];
+  if (!info) {
+    return undefined;
+  }
+  const [, blockSize, typeSize] = info;
+  return Math.ceil(elements / blockSize) * typeSize;
+}
+
+const NUMERIC_KEYS = {
+  'attention.head_count': 'attentionHeads',
+  'attention.head_count_kv': 'kvHeads',
+  block_count: 'hiddenLayers',
+  embedding_length: 'hiddenSize',
+  'attention.key_length': 'keyLength',
+  'attention.value_length': 'valueLength',
+} as const;
+
+type NumericKey = (typeof NUMERIC_KEYS)[keyof typeof NUMERIC_KEYS];
+
+function matchNumericKey(
+  key: string,
+  architecture: string | undefined,
+): NumericKey | undefined {
+  const dot = key.indexOf('.');
+  if (dot < 0) {
+    return undefined;
+  }
+  if (architecture && key.slice(0, dot) !== architecture) {
+    return undefined;
+  }
+  const name = key.slice(dot + 1);
+  return Object.hasOwn(NUMERIC_KEYS, name)
+    ? NUMERIC_KEYS[name as keyof typeof NUMERIC_KEYS]
+    : undefined;
+}
+
+/**
+ * Parses the GGUF header: the model hyperparameters from the key/value
+ * metadata and the tensor layout that follows it. Returns null when the file
+ * is not a GGUF model or misses the hyperparameters needed for estimates.
+ */
+export async function parseGGUFMetadata(
+  reader: RangeReader,
+): Promise<GGUFMetadata | null> {
+  try {
+    if ((await reader.readU32()) !== GGUF_MAGIC) {
+      return null;
+    }
+    const version = await reader.readU32();
+    // Version 1 used 32-bit counts and is no longer produced.
+    if (version < 2 || version > 3) {
+      return null;
+    }
+    const tensorCount = await reader.readU64();
+    const kvCount = await reader.readU64();
+
+    let architecture: string | undefined;
+    const values: Partial<Record<NumericKey, number>> = {};
+    for (let i = 0; i < kvCount; i++) {
+      const key = await reader.readString();
+      const type = await reader.readU32();
+      if (key === 'general.architecture' && type === ValueType.STRING) {
+        architecture = await reader.readString();
+        continue;
+      }
+      const target = matchNumericKey(key, architecture);
+      if (target) {
+        const value = await readNumber(reader, type);
+        if (value !== undefined) {
+          values[target] = value;
+        }
+      } else {
+        await skipValue(reader, type);
+      }
+    }
+
+    const { attentionHeads, hiddenLayers, hiddenSize } = values;
+    if (!attentionHeads || !hiddenLayers || !hiddenSize) {
+      return null;
+    }
+    const headDim = hiddenSize / attentionHeads;
+    const metadata: GGUFMetadata = {
+      architecture,
+      attentionHeads,
+      kvHeads: values.kvHeads ?? attentionHeads,
+      hiddenLayers,
+      hiddenSize,
+      keyLength: values.keyLength ?? headDim,
+      valueLength: values.valueLength ?? headDim,
+      tensorCount,
+    };
+
+    try {
+      Object.assign(metadata, await readTensorLayout(reader, tensorCount));
+    } catch {
+      // The hyperparameters alone still give a usable estimate.
+    }
+    return metadata;
+  } catch {
+    return null;
+  }
+}
+
+async function readTensorLayout(
+  reader: RangeReader,
+  tensorCount: number,
+): Promise<Partial<GGUFMetadata>> {
+  let tensorBytes: number | undefined = 0;
+  let parameterCount = 0;
+  const tensorTypeBytes: Record<string, number> = {};
+  for (let i = 0; i < tensorCount; i++) {
+    await reader.skip(await reader.readU64()); // name
+    const dims = await reader.readU32();
+    let elements = 1;
+    for (let d = 0; d < dims; d++) {
+      elements *= await reader.readU64();
+    }
+    const type = await reader.readU32();
+    await reader.skip(8); // data offset
+
+    parameterCount += elements;
+    const bytes = ggmlTensorBytes(type, elements);
+    if (bytes === undefined || tensorBytes === undefined) {
+      tensorBytes = undefined;
+      continue;
+    }
+    tensorBytes += bytes;
+    const name = TENSOR_TYPES[type][0];
+    tensorTypeBytes[name] = (tensorTypeBytes[name] ?? 0) + bytes;
+  }
+  return tensorBytes === undefined
+    ? { parameterCount }
+    : { parameterCount, tensorBytes, tensorTypeBytes };
+}
+
+/**
+ * Bytes of KV cache for `contextSize` tokens. llama.cpp stores the cache as
+ * F16 unless configured otherwise.
+ */
+export function estimateKvCacheBytes(
+  metadata: GGUFMetadata,
+  contextSize: number,
+  bytesPerElement = 2,
+): number {
+  return (
+    contextSize *
+    metadata.hiddenLayers *
+    metadata.kvHeads *
+    (metadata.keyLength + metadata.valueLength) *
+    bytesPerElement
+  );
+}
+
+/**
+ * Parsed GGUF headers persisted across sessions, keyed by repository,
+ * revision, file name and ETag so a changed upload is parsed again.
+ */
+export class GGUFMetadataCache {
+  private entries: Map<string, GGUFMetadata> | undefined;
+  private loading: Promise<Map<string, GGUFMetadata>> | undefined;
+  private writeQueue: Promise<void> = Promise.resolve();
+  private dirty = false;
+
+  constructor(
+    readonly filePath: string,
+    private readonly maxEntries = DEFAULT_CACHE_ENTRIES,
+  ) {}
+
+  static key(
+    repo: string,
+    revision: string,
+    filename: string,
+    etag: string,
+  ): string {
+    return `${repo}@${revision}/${filename}#${etag}`;
+  }
+
+  async get(key: string): Promise<GGUFMetadata | undefined> {
+    const entries = await this.load();
+    const metadata = entries.get(key);
+    if (metadata) {
+      // Keep recently used entries when trimming.
+      entries.delete(key);
+      entries.set(key, metadata);
+    }
+    return metadata;
+  }
+
+  async set(key: string, metadata: GGUFMetadata): Promise<void> {
+    const entries = await this.load();
+    entries.delete(key);
+    entries.set(key, metadata);
+    while (entries.size > this.maxEntries) {
+      entries.delete(entries.keys().next().value as string);
+    }
+    this.dirty = true;
+    this.writeQueue = this.writeQueue.then(() => this.flush());
+    return this.writeQueue;
+  }
+
+  private load(): Promise<Map<string, GGUFMetadata>> {
+    if (this.entries) {
+      return Promise.resolve(this.entries);
+    }
+    this.loading ??= (async () => {
+      let entries = new Map<string, GGUFMetadata>();
+      try {
+        const data = JSON.parse(await fs.readFile(this.filePath, 'utf-8'));
+        if (data?.version === CACHE_VERSION && Array.isArray(data.entries)) {
+          entries = new Map(data.entries);
+        }
+      } catch {
+        // Missing or corrupt cache; start empty.
+      }
+      this.entries = entries;
+      return entries;
+    })();
+    return this.loading;
+  }
+
+  private async flush(): Promise<void> {
+    // Concurrent sets coalesce into the first pending write.
+    if (!this.dirty || !this.entries) {
+      return;
+    }
+    this.dirty = false;
+    const content = JSON.stringify({
+      version: CACHE_VERSION,
+      entries: [...this.entries],
+    });
+    try {
+      await fs.mkdir(dirname(this.filePath), { recursive: true });
+      const tmpPath = `${this.filePath}.${process.pid}.tmp`;
+      await fs.writeFile(tmpPath, content, 'utf-8');
+      await fs.rename(tmpPath, this.filePath);
+    } catch (error) {
+      console.debug('Failed to write GGUF metadata cache:', error);
+    }
+  }
+}
+
+let defaultCache: GGUFMetadataCache | undefined;
+
+export function getDefaultGGUFMetadataCache(): GGUFMetadataCache {
+  defaultCache ??= new GGUFMetadataCache(
+    join(Storage.getGlobalCacheDir(), 'gguf-metadata.json'),
+  );
+  return defaultCache;
+}
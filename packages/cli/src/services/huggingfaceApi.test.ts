@@ -0,0 +1,205 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+import * as fs from 'node:fs/promises';
+import http from 'node:http';
+import type { AddressInfo } from 'node:net';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { estimateMemory } from './huggingfaceApi.js';
+import { GGUFMetadataCache } from './ggufMetadata.js';
+
+// Minimal GGUF v3 writer for the metadata the estimator reads
+class GGUFBuilder {
+  private parts: Buffer[] = [];
+
+  u32(value: number) {
+    const buf = Buffer.alloc(4);
+    buf.writeUInt32LE(value);
+    this.parts.push(buf);
+    return this;
+  }
+
+  u64(value: number) {
+    const buf = Buffer.alloc(8);
+    buf.writeBigUInt64LE(BigInt(value));
+    this.parts.push(buf);
+    return this;
+  }
+
+  str(value: string) {
+    this.u64(Buffer.byteLength(value));
+    this.parts.push(Buffer.from(value));
+    return this;
+  }
+
+  kvU32(key: string, value: number) {
+    return this.str(key).u32(4).u32(value);
+  }
+
+  build() {
+    return Buffer.concat(this.parts);
+  }
+}
+
+function buildModelFile(): Buffer {
+  const tokens = Array.from({ length: 1000 }, (_, i) => `token-${i}`);
+  const builder = new GGUFBuilder()
+    .u32(0x46554747)
+    .u32(3)
+    .u64(2) // tensors
+    .u64(7) // metadata entries
+    .str('general.architecture')
+    .u32(8)
+    .str('llama')
+    .str('tokenizer.ggml.tokens')
+    .u32(9)
+    .u32(8)
+    .u64(tokens.length);
+  tokens.forEach((token) => builder.str(token));
+  builder.str('tokenizer.ggml.scores').u32(9).u32(6).u64(tokens.length);
+  tokens.forEach(() => builder.u32(0));
+  builder
+    .kvU32('llama.block_count', 32)
+    .kvU32('llama.embedding_length', 4096)
+    .kvU32('llama.attention.head_count', 32)
+    .kvU32('llama.attention.head_count_kv', 8)
+    // Tensor infos: a Q4_K matrix and an F32 vector
+    .str('blk.0.attn_q.weight')
+    .u32(2)
+    .u64(4096)
+    .u64(4096)
+    .u32(12)
+    .u64(0)
+    .str('output_norm.weight')
+    .u32(1)
+    .u64(4096)
+    .u32(0)
+    .u64(9437184);
+  return builder.build();
+}
+
+describe('estimateMemory', () => {
+  let server: http.Server;
+  let tmpDir: string;
+  let cache: GGUFMetadataCache;
+  const files = new Map<string, Buffer>();
+  const requests: Array<{ method?: string; range?: string }> = [];
+  let concurrentHeads = 0;
+  let maxConcurrentHeads = 0;
+
+  beforeEach(async () => {
+    tmpDir = await fs.mkdtemp(path.join(os.tmpdir(), 'hf-estimate-'));
+    cache = new GGUFMetadataCache(path.join(tmpDir, 'gguf-metadata.json'));
+    files.clear();
+    requests.length = 0;
+    maxConcurrentHeads = 0;
+
+    // Stand-in for the Hub's resolve endpoint with HEAD and range support
+    server = http.createServer((req, res) => {
+      const file = files.get(decodeURIComponent(req.url ?? ''));
+      requests.push({ method: req.method, range: req.headers.range });
+      if (!file) {
+        res.statusCode = 404;
+        res.end();
+        return;
+      }
+      res.setHeader('ETag', `"${file.length}"`);
+      if (req.method === 'HEAD') {
+        concurrentHeads++;
+        maxConcurrentHeads = Math.max(maxConcurrentHeads, concurrentHeads);
+        setTimeout(() => {
+          concurrentHeads--;
+          res.setHeader('Content-Length', file.length);
+          res.end();
+        }, 20);
+        return;
+      }
+      const match = /bytes=(\d+)-(\d+)/.exec(req.headers.range ?? '');
+      if (!match) {
+        res.end(file);
+        return;
+      }
+      const start = Number(match[1]);
+      const end = Math.min(Number(match[2]), file.length - 1);
+      res.statusCode = 206;
+      res.setHeader('Content-Range', `bytes ${start}-${end}/${file.length}`);
+      res.end(file.subarray(start, end + 1));
+    });
+    await new Promise<void>((resolve) =>
+      server.listen(0, '127.0.0.1', resolve),
+    );
+    vi.stubEnv(
+      'HF_ENDPOINT',
+      `http://127.0.0.1:${(server.address() as AddressInfo).port}`,
+    );
+  });
+
+  afterEach(async () => {
+    vi.unstubAllEnvs();
+    server.closeAllConnections();
+    await new Promise((resolve) => server.close(resolve));
+    await fs.rm(tmpDir, { recursive: true, force: true });
+  });
+
+  it('should account for quantized weights and grouped-query KV heads', async () => {
+    files.set('/org/model/resolve/main/model.gguf', buildModelFile());
+
+    const estimate = await estimateMemory(
+      'org/model',
+      'model.gguf',
+      undefined,
+      16384,
+      undefined,
+      { cache },
+    );
+
+    // Weights: 4096x4096 Q4_K + 4096 F32. KV: 16k x 32 layers x 8 heads x
+    // (128 + 128) x 2 bytes.
+    expect(estimate).toBe('2.2 GB (Model: 9 MB + KV: 2.1 GB)');
+    // The whole header is read in one speculative range request.
+    expect(requests.filter((r) => r.method === 'GET')).toHaveLength(1);
+  });
+
+  it('should reuse parsed headers while the ETag is unchanged', async () => {
+    files.set('/org/model/resolve/main/model.gguf', buildModelFile());
+    const estimate = (metadataCache: GGUFMetadataCache) =>
+      estimateMemory('org/model', 'model.gguf', undefined, 16384, undefined, {
+        cache: metadataCache,
+      });
+    const first = await estimate(cache);
+    requests.length = 0;
+
+    // A fresh instance reads the entry persisted by the first estimate.
+    const second = await estimate(new GGUFMetadataCache(cache.filePath));
+
+    expect(second).toBe(first);
+    expect(requests).toEqual([{ method: 'HEAD', range: undefined }]);
+  });
+
+  it('should size split files in parallel', async () => {
+    const header = buildModelFile();
+    const parts = [1, 2, 3].map((i) => `model-0000${i}-of-00003.gguf`);
+    files.set(`/org/model/resolve/main/${parts[0]}`, header);
+    files.set(`/org/model/resolve/main/${parts[1]}`, Buffer.alloc(2_000_000));
+    files.set(`/org/model/resolve/main/${parts[2]}`, Buffer.alloc(3_000_000));
+
+    const estimate = await estimateMemory(
+      'org/model',
+      parts[0],
+      undefined,
+      16384,
+      parts,
+      { cache: null },
+    );
+
+    expect(maxConcurrentHeads).toBe(3);
+    // Split files report the summed file sizes as weights.
+    const weightsMb = Math.round((header.length + 5_000_000) / 1_000_000);
+    expect(estimate).toBe(`2.2 GB (Model: ${weightsMb} MB + KV: 2.1 GB)`);
+  });
+});
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+import { httpPool } from '@kolosal-ai/kolosal-ai-core';
 import { getKolosalServerBaseUrl } from '../utils/modelIdentifiers.js';
 
 export interface RegisterModelOptions {
@@ -44,7 +45,7 @@ export async function registerModelWithServer(
 
   let responseText: string | undefined;
   try {
-    const response = await fetch(endpoint, {
+    const response = await httpPool.fetch(endpoint, {
       method: 'POST',
       headers: {
         'Content-Type': 'application/json',
@@ -97,6 +97,8 @@ import { DetailedMessagesDisplay } from './components/DetailedMessagesDisplay.js
 import { HistoryItemDisplay } from './components/HistoryItemDisplay.js';
 import { ContextSummaryDisplay } from './components/ContextSummaryDisplay.js';
 import { useHistory } from './hooks/useHistoryManager.js';
+import { HistoryJournal, findVisibleTailStart } from './utils/historyBudget.js';
+import { formatMemoryUsage } from './utils/formatters.js';
 import process from 'node:process';
 import type { EditorType, Config, IdeContext } from '@kolosal-ai/kolosal-ai-core';
 import {
@@ -180,6 +182,9 @@ import {
 } from './utils/dialogStack.js';
 import { deriveServerModelId, getKolosalServerBaseUrl } from '../utils/modelIdentifiers.js';
 
+// Screens of history written back to the terminal after it is cleared
+const REFRESH_SCROLLBACK_SCREENS = 2;
+
 // Maximum number of queued messages to display in UI to prevent performance issues
 const MAX_DISPLAYED_QUEUED_MESSAGES = 3;
 
@@ -239,7 +244,16 @@ const App = ({ config, settings, startupWarnings = [], version }: AppProps) => {
   const [updateInfo, setUpdateInfo] = useState<UpdateObject | null>(null);
   const { stdout } = useStdout();
   const nightly = version.includes('nightly');
-  const { history, addItem, clearItems, loadHistory } = useHistory();
+  const historyJournal = useMemo(() => {
+    const tempDir = config.storage?.getProjectTempDir();
+    return tempDir
+      ? new HistoryJournal(
+          path.join(tempDir, 'ui-history', `${config.getSessionId()}.jsonl`),
+        )
+      : undefined;
+  }, [config]);
+  const { history, addItem, clearItems, loadHistory, getMemoryStats } =
+    useHistory({ journal: historyJournal });
 
   const [idePromptAnswered, setIdePromptAnswered] = useState(false);
   const currentIDE = config.getIdeClient().getCurrentIde();
@@ -275,11 +289,35 @@ const App = ({ config, settings, startupWarnings = [], version }: AppProps) => {
   const { stats: sessionStats } = useSessionStats();
   const [staticNeedsRefresh, setStaticNeedsRefresh] = useState(false);
   const [staticKey, setStaticKey] = useState(0);
+  // After a refresh only the tail of the history is written again, starting
+  // at this index. It is fixed per refresh so <Static> keeps appending.
+  const staticStartRef = useRef({ key: 0, start: 0 });
+  const refreshStartedAtRef = useRef<number | null>(null);
   const refreshStatic = useCallback(() => {
+    refreshStartedAtRef.current = performance.now();
     stdout.write(ansiEscapes.clearTerminal);
     setStaticKey((prev) => prev + 1);
   }, [setStaticKey, stdout]);
 
+  useEffect(() => {
+    const startedAt = refreshStartedAtRef.current;
+    if (startedAt === null) {
+      return;
+    }
+    refreshStartedAtRef.current = null;
+    if (config.getDebugMode()) {
+      const elapsedMs = performance.now() - startedAt;
+      const stats = getMemoryStats();
+      const rendered = stats.items - staticStartRef.current.start;
+      console.debug(
+        `History refresh rendered ${rendered}/${stats.items} items in ${elapsedMs.toFixed(1)}ms; ` +
+          `${formatMemoryUsage(stats.totalBytes)} held, ` +
+          `${formatMemoryUsage(stats.averageItemBytes)} per item, ` +
+          `${stats.collapsedItems} collapsed`,
+      );
+    }
+  }, [staticKey, config, getMemoryStats]);
+
   const [geminiMdFileCount, setGeminiMdFileCount] = useState<number>(0);
   const [debugMessage, setDebugMessage] = useState<string>('');
   const [themeError, setThemeError] = useState<string | null>(null);
@@ -2972,6 +3010,23 @@ const App = ({ config, settings, startupWarnings = [], version }: AppProps) => {
   // Arbitrary threshold to ensure that items in the static area are large
   // enough but not too large to make the terminal hard to use.
   const staticAreaMaxItemHeight = Math.max(terminalHeight * 4, 100);
+  if (staticStartRef.current.key !== staticKey) {
+    staticStartRef.current = {
+      key: staticKey,
+      start: findVisibleTailStart(
+        history,
+        terminalHeight * REFRESH_SCROLLBACK_SCREENS,
+        mainAreaWidth,
+      ),
+    };
+  } else if (history.length < staticStartRef.current.start) {
+    // The history was cleared or replaced since the refresh.
+    staticStartRef.current = { key: staticKey, start: 0 };
+  }
+  const staticStart = staticStartRef.current.start;
+  const firstAssistantMessageIndex = history.findIndex(
+    (item) => item.type === 'gemini' || item.type === 'gemini_content',
+  );
   const placeholder = vimModeEnabled
     ? "  Press 'i' for INSERT mode and 'Esc' for NORMAL mode."
     : '  Type your message or @path/to/file';
@@ -2997,14 +3052,18 @@ const App = ({ config, settings, startupWarnings = [], version }: AppProps) => {
                 settings.merged.ui?.hideBanner || config.getScreenReader()
               ) && <Header version={version} nightly={nightly} />}
             </Box>,
-            ...history.map((h, index) => {
-              // Find the first assistant message in the history
-              const firstAssistantMessageIndex = history.findIndex(
-                (item) => item.type === 'gemini' || item.type === 'gemini_content'
-              );
-              const isFirstAssistantMessage = 
-                (h.type === 'gemini' || h.type === 'gemini_content') && 
-                index === firstAssistantMessageIndex;
+            ...(staticStart > 0
+              ? [
+                  <Box key="history-tail" marginBottom={1}>
+                    <Text color={Colors.Gray}>
+                      … {staticStart} earlier history items not shown
+                    </Text>
+                  </Box>,
+                ]
+              : []),
+            ...history.slice(staticStart).map((h, offset) => {
+              const isFirstAssistantMessage =
+                staticStart + offset === firstAssistantMessageIndex;
 
               return (
                 <HistoryItemDisplay
@@ -34,10 +34,11 @@ describe('chatCommand', () => {
   let mockSaveCheckpoint: ReturnType<typeof vi.fn>;
   let mockLoadCheckpoint: ReturnType<typeof vi.fn>;
   let mockDeleteCheckpoint: ReturnType<typeof vi.fn>;
+  let mockCollectCheckpointGarbage: ReturnType<typeof vi.fn>;
   let mockGetHistory: ReturnType<typeof vi.fn>;
 
   const getSubCommand = (
-    name: 'list' | 'save' | 'resume' | 'delete',
+    name: 'list' | 'save' | 'resume' | 'delete' | 'gc',
   ): SlashCommand => {
     const subCommand = chatCommand.subCommands?.find(
       (cmd) => cmd.name === name,
@@ -56,6 +57,9 @@ describe('chatCommand', () => {
     mockSaveCheckpoint = vi.fn().mockResolvedValue(undefined);
     mockLoadCheckpoint = vi.fn().mockResolvedValue([]);
     mockDeleteCheckpoint = vi.fn().mockResolvedValue(true);
+    mockCollectCheckpointGarbage = vi
+      .fn()
+      .mockResolvedValue({ removedBlobs: 0, freedBytes: 0 });
 
     mockContext = createMockCommandContext({
       services: {
@@ -73,6 +77,7 @@ describe('chatCommand', () => {
           saveCheckpoint: mockSaveCheckpoint,
           loadCheckpoint: mockLoadCheckpoint,
           deleteCheckpoint: mockDeleteCheckpoint,
+          collectCheckpointGarbage: mockCollectCheckpointGarbage,
           initialize: vi.fn().mockResolvedValue(undefined),
         },
       },
@@ -86,7 +91,7 @@ describe('chatCommand', () => {
   it('should have the correct main command definition', () => {
     expect(chatCommand.name).toBe('chat');
     expect(chatCommand.description).toBe('Manage conversation history.');
-    expect(chatCommand.subCommands).toHaveLength(4);
+    expect(chatCommand.subCommands).toHaveLength(5);
   });
 
   describe('list subcommand', () => {
@@ -407,4 +412,32 @@ describe('chatCommand', () => {
       });
     });
   });
+
+  describe('gc subcommand', () => {
+    it('should report the unused checkpoint messages it removed', async () => {
+      mockCollectCheckpointGarbage.mockResolvedValue({
+        removedBlobs: 3,
+        freedBytes: 2048,
+      });
+
+      const result = await getSubCommand('gc').action?.(mockContext, '');
+
+      expect(mockCollectCheckpointGarbage).toHaveBeenCalled();
+      expect(result).toEqual({
+        type: 'message',
+        messageType: 'info',
+        content: 'Removed 3 unused checkpoint message(s), freeing 2.0 KB.',
+      });
+    });
+
+    it('should say so when nothing was removed', async () => {
+      const result = await getSubCommand('gc').action?.(mockContext, '');
+
+      expect(result).toEqual({
+        type: 'message',
+        messageType: 'info',
+        content: 'No unused checkpoint messages found.',
+      });
+    });
+  });
 });
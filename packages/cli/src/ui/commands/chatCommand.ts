@@ -19,6 +19,7 @@ import { decodeTagName } from '@kolosal-ai/kolosal-ai-core';
 import path from 'node:path';
 import type { HistoryItemWithoutId } from '../types.js';
 import { MessageType } from '../types.js';
+import { formatMemoryUsage } from '../utils/formatters.js';
 
 interface ChatDetail {
   name: string;
@@ -274,9 +275,37 @@ const deleteCommand: SlashCommand = {
   },
 };
 
+const gcCommand: SlashCommand = {
+  name: 'gc',
+  description:
+    'Delete stored checkpoint messages that no saved conversation or restorable tool call uses anymore.',
+  kind: CommandKind.BUILT_IN,
+  action: async (context): Promise<MessageActionReturn> => {
+    const { logger } = context.services;
+    await logger.initialize();
+    const { removedBlobs, freedBytes } =
+      await logger.collectCheckpointGarbage();
+
+    return {
+      type: 'message',
+      messageType: 'info',
+      content:
+        removedBlobs > 0
+          ? `Removed ${removedBlobs} unused checkpoint message(s), freeing ${formatMemoryUsage(freedBytes)}.`
+          : 'No unused checkpoint messages found.',
+    };
+  },
+};
+
 export const chatCommand: SlashCommand = {
   name: 'chat',
   description: 'Manage conversation history.',
   kind: CommandKind.BUILT_IN,
-  subCommands: [listCommand, saveCommand, resumeCommand, deleteCommand],
+  subCommands: [
+    listCommand,
+    saveCommand,
+    resumeCommand,
+    deleteCommand,
+    gcCommand,
+  ],
 };
@@ -12,6 +12,7 @@ import { restoreCommand } from './restoreCommand.js';
 import { type CommandContext } from './types.js';
 import { createMockCommandContext } from '../../test-utils/mockCommandContext.js';
 import type { Config, GitService } from '@kolosal-ai/kolosal-ai-core';
+import { CheckpointStore } from '@kolosal-ai/kolosal-ai-core';
 
 describe('restoreCommand', () => {
   let mockContext: CommandContext;
@@ -41,6 +42,9 @@ describe('restoreCommand', () => {
       getCheckpointingEnabled: vi.fn().mockReturnValue(true),
       storage: {
         getProjectTempCheckpointsDir: vi.fn().mockReturnValue(checkpointsDir),
+        getProjectTempCheckpointObjectsDir: vi
+          .fn()
+          .mockReturnValue(path.join(checkpointsDir, 'objects')),
         getProjectTempDir: vi.fn().mockReturnValue(geminiTempDir),
       },
       getGeminiClient: vi.fn().mockReturnValue({
@@ -183,6 +187,29 @@ describe('restoreCommand', () => {
       );
     });
 
+    it('should restore a content-addressed checkpoint', async () => {
+      const toolCallData = {
+        history: [{ type: 'user', text: 'do a thing' }],
+        clientHistory: [{ role: 'user', parts: [{ text: 'do a thing' }] }],
+        toolCall: { name: 'edit', args: { file_path: '/a.ts' } },
+      };
+      await new CheckpointStore(path.join(checkpointsDir, 'objects')).write(
+        path.join(checkpointsDir, 'stored-checkpoint.json'),
+        toolCallData,
+      );
+      const command = restoreCommand(mockConfig);
+
+      expect(await command?.action?.(mockContext, 'stored-checkpoint')).toEqual({
+        type: 'tool',
+        toolName: 'edit',
+        toolArgs: { file_path: '/a.ts' },
+      });
+      expect(mockContext.ui.loadHistory).toHaveBeenCalledWith(
+        toolCallData.history,
+      );
+      expect(mockSetHistory).toHaveBeenCalledWith(toolCallData.clientHistory);
+    });
+
     it('should restore even if only toolCall is present', async () => {
       const toolCallData = {
         toolCall: { name: 'run_shell_command', args: 'ls' },
@@ -6,13 +6,23 @@
 
 import * as fs from 'node:fs/promises';
 import path from 'node:path';
+import type { Content } from '@google/genai';
 import {
   type CommandContext,
   type SlashCommand,
   type SlashCommandActionReturn,
   CommandKind,
 } from './types.js';
+import type { HistoryItem } from '../types.js';
 import type { Config } from '@kolosal-ai/kolosal-ai-core';
+import { CheckpointStore } from '@kolosal-ai/kolosal-ai-core';
+
+interface ToolCallCheckpoint {
+  history?: HistoryItem[];
+  clientHistory?: Content[];
+  toolCall: { name: string; args: Record<string, unknown> };
+  commitHash?: string;
+}
 
 async function restoreAction(
   context: CommandContext,
@@ -73,8 +83,10 @@ async function restoreAction(
     }
 
     const filePath = path.join(checkpointDir, selectedFile);
-    const data = await fs.readFile(filePath, 'utf-8');
-    const toolCallData = JSON.parse(data);
+    // Only the selected checkpoint's messages are loaded.
+    const toolCallData = (await new CheckpointStore(
+      config!.storage.getProjectTempCheckpointObjectsDir(),
+    ).read(filePath)) as ToolCallCheckpoint;
 
     if (toolCallData.history) {
       if (!loadHistory) {
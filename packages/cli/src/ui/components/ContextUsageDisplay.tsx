@@ -11,11 +11,14 @@ import { tokenLimit } from '@kolosal-ai/kolosal-ai-core';
 export const ContextUsageDisplay = ({
   promptTokenCount,
   model,
+  baseUrl,
 }: {
   promptTokenCount: number;
   model: string;
+  /** Content generator base URL, so limits discovered on it are used. */
+  baseUrl?: string;
 }) => {
-  const percentage = promptTokenCount / tokenLimit(model);
+  const percentage = promptTokenCount / tokenLimit(model, 'input', baseUrl);
 
   return (
     <Text color={Colors.Gray}>
@@ -1496,6 +1496,27 @@ describe('InputPrompt', () => {
 
       unmount();
     });
+
+    it('searches previous prompts, newest first, outside shell mode', async () => {
+      props.shellModeActive = false;
+      props.userMessages = ['explain the build', 'fix the build', 'run tests'];
+      const { stdin, stdout, unmount } = renderWithProviders(
+        <InputPrompt {...props} />,
+      );
+      await wait();
+
+      stdin.write('\x12');
+      await wait();
+
+      const frame = stdout.lastFrame() ?? '';
+      expect(frame).toContain('(r:)');
+      expect(frame).not.toContain('echo hello');
+      expect(frame.indexOf('fix the build')).toBeLessThan(
+        frame.indexOf('explain the build'),
+      );
+
+      unmount();
+    });
   });
 
   describe('Ctrl+E keyboard shortcut', () => {
@@ -5,7 +5,7 @@
  */
 
 import type React from 'react';
-import { useCallback, useEffect, useState, useRef } from 'react';
+import { useCallback, useEffect, useMemo, useState, useRef } from 'react';
 import { Box, Text } from 'ink';
 import { theme } from '../semantic-colors.js';
 import { SuggestionsDisplay } from './SuggestionsDisplay.js';
@@ -89,6 +89,11 @@ export const InputPrompt: React.FC<InputPromptProps> = ({
   ]);
   const shellHistory = useShellHistory(config.getProjectRoot(), config.storage);
   const historyData = shellHistory.history;
+  // Reverse search lists the newest prompts first.
+  const promptHistory = useMemo(
+    () => [...userMessages].reverse(),
+    [userMessages],
+  );
 
   const completion = useCommandCompletion(
     buffer,
@@ -102,7 +107,7 @@ export const InputPrompt: React.FC<InputPromptProps> = ({
 
   const reverseSearchCompletion = useReverseSearchCompletion(
     buffer,
-    historyData,
+    shellModeActive ? historyData : promptHistory,
     reverseSearchActive,
   );
   const resetCompletionState = completion.resetCompletionState;
@@ -319,7 +324,7 @@ export const InputPrompt: React.FC<InputPromptProps> = ({
         return;
       }
 
-      if (shellModeActive && keyMatchers[Command.REVERSE_SEARCH](key)) {
+      if (keyMatchers[Command.REVERSE_SEARCH](key)) {
         setReverseSearchActive(true);
         setTextBeforeReverseSearch(buffer.text);
         setCursorPosition(buffer.cursor);
@@ -703,17 +708,15 @@ export const InputPrompt: React.FC<InputPromptProps> = ({
         <Text
           color={shellModeActive ? theme.status.warning : theme.text.accent}
         >
-          {shellModeActive ? (
-            reverseSearchActive ? (
-              <Text
-                color={theme.text.link}
-                aria-label={SCREEN_READER_USER_PREFIX}
-              >
-                (r:){' '}
-              </Text>
-            ) : (
-              '! '
-            )
+          {reverseSearchActive ? (
+            <Text
+              color={theme.text.link}
+              aria-label={SCREEN_READER_USER_PREFIX}
+            >
+              (r:){' '}
+            </Text>
+          ) : shellModeActive ? (
+            '! '
           ) : (
             '> '
           )}
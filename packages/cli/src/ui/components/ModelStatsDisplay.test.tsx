@@ -249,4 +249,48 @@ describe('<ModelStatsDisplay />', () => {
     expect(output).not.toContain('gemini-2.5-flash');
     expect(output).toMatchSnapshot();
   });
+
+  it('should display streaming timings when a model has them', () => {
+    const { lastFrame } = renderWithMockedStats({
+      models: {
+        'local-model': {
+          api: { totalRequests: 2, totalErrors: 0, totalLatencyMs: 3000 },
+          tokens: {
+            prompt: 200,
+            candidates: 100,
+            total: 300,
+            cached: 0,
+            thoughts: 0,
+            tool: 0,
+          },
+          streaming: {
+            requests: 2,
+            engine: 'llama-vulkan',
+            totalQueueMs: 20,
+            totalTtftMs: 400,
+            interTokenBuckets: [0, 0, 90, 8, 0, 0, 0, 2, 0, 0, 0, 0],
+            promptTokens: 200,
+            promptEvalMs: 400,
+            generationTokens: 100,
+            generationMs: 2000,
+          },
+        },
+      },
+      tools: {
+        totalCalls: 0,
+        totalSuccess: 0,
+        totalFail: 0,
+        totalDurationMs: 0,
+        totalDecisions: { accept: 0, reject: 0, modify: 0 },
+        byName: {},
+      },
+    });
+
+    const output = lastFrame();
+    expect(output).toContain('llama-vulkan');
+    expect(output).toContain('Avg Time to First Token');
+    expect(output).toContain('20 / 20 / 150 ms');
+    expect(output).toContain('500.0 tok/s');
+    expect(output).toContain('50.0 tok/s');
+  });
 });
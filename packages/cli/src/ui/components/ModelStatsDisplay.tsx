@@ -6,10 +6,13 @@
 
 import type React from 'react';
 import { Box, Text } from 'ink';
+import { bucketPercentile, tokensPerSecond } from '@kolosal-ai/kolosal-ai-core';
 import { Colors } from '../colors.js';
 import { formatDuration } from '../utils/formatters.js';
 import {
   calculateAverageLatency,
+  calculateAverageQueueTime,
+  calculateAverageTtft,
   calculateCacheHitRate,
   calculateErrorRate,
 } from '../utils/computeStats.js';
@@ -87,6 +90,15 @@ export const ModelStatsDisplay: React.FC = () => {
   const hasCached = activeModels.some(
     ([, metrics]) => metrics.tokens.cached > 0,
   );
+  const hasStreaming = activeModels.some(
+    ([, metrics]) => (metrics.streaming?.requests ?? 0) > 0,
+  );
+  const streamingValue = (
+    getter: (streaming: NonNullable<ModelMetrics['streaming']>) => string,
+  ) =>
+    getModelValues((m) =>
+      m.streaming && m.streaming.requests > 0 ? getter(m.streaming) : '-',
+    );
 
   return (
     <LeftBorderPanel
@@ -158,6 +170,50 @@ export const ModelStatsDisplay: React.FC = () => {
 
       <Box height={1} />
 
+      {/* Streaming Section */}
+      {hasStreaming && (
+        <>
+          <StatRow title="Streaming" values={[]} isSection />
+          <StatRow title="Engine" values={streamingValue((s) => s.engine)} />
+          <StatRow
+            title="Avg Queue Time"
+            values={getModelValues((m) =>
+              m.streaming ? formatDuration(calculateAverageQueueTime(m)) : '-',
+            )}
+          />
+          <StatRow
+            title="Avg Time to First Token"
+            values={getModelValues((m) =>
+              m.streaming ? formatDuration(calculateAverageTtft(m)) : '-',
+            )}
+          />
+          <StatRow
+            title="Inter-token p50 / p90 / p99"
+            values={streamingValue((s) =>
+              [0.5, 0.9, 0.99]
+                .map((p) => `${bucketPercentile(s.interTokenBuckets, p)}`)
+                .join(' / ')
+                .concat(' ms'),
+            )}
+          />
+          <StatRow
+            title="Prompt Eval"
+            values={streamingValue(
+              (s) =>
+                `${tokensPerSecond(s.promptTokens, s.promptEvalMs).toFixed(1)} tok/s`,
+            )}
+          />
+          <StatRow
+            title="Generation"
+            values={streamingValue(
+              (s) =>
+                `${tokensPerSecond(s.generationTokens, s.generationMs).toFixed(1)} tok/s`,
+            )}
+          />
+          <Box height={1} />
+        </>
+      )}
+
       {/* Tokens Section */}
       <StatRow title="Tokens" values={[]} isSection />
       <StatRow
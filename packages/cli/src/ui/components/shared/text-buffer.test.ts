@@ -149,6 +149,27 @@ describe('textBufferReducer', () => {
       expect(stateAfterRedo.undoStack.length).toBe(1);
       expect(stateAfterRedo.redoStack.length).toBe(0);
     });
+
+    it('should keep snapshots intact without copying the lines', () => {
+      const state: TextBufferState = {
+        ...initialState,
+        lines: ['one', 'two'],
+        cursorRow: 1,
+        cursorCol: 3,
+      };
+      const stateAfterInsert = textBufferReducer(state, {
+        type: 'insert',
+        payload: '!',
+      });
+      expect(stateAfterInsert.undoStack[0].lines).toBe(state.lines);
+      expect(state.lines).toEqual(['one', 'two']);
+
+      const stateAfterUndo = textBufferReducer(stateAfterInsert, {
+        type: 'undo',
+      });
+      expect(stateAfterUndo.lines).toEqual(['one', 'two']);
+      expect(stateAfterUndo.redoStack[0].lines).toEqual(['one', 'two!']);
+    });
   });
 
   describe('create_undo_snapshot action', () => {
@@ -641,6 +662,59 @@ describe('useTextBuffer', () => {
       expect(state.allVisualLines[3]).toBe('text.');
     });
 
+    it('should rewrap only the edited line of a large buffer', () => {
+      const longLine = 'word '.repeat(10).trim();
+      const initialText = Array.from({ length: 2000 }, () => longLine).join(
+        '\n',
+      );
+      const { result } = renderHook(() =>
+        useTextBuffer({
+          initialText,
+          viewport: { width: 10, height: 5 },
+          isValidPath: () => false,
+        }),
+      );
+      expect(getBufferState(result).allVisualLines.length).toBe(2000 * 5);
+
+      act(() => result.current.insert('x'));
+
+      const state = getBufferState(result);
+      expect(state.allVisualLines.length).toBe(2000 * 5);
+      expect(state.allVisualLines[0]).toBe('xword word');
+      expect(state.allVisualLines[5]).toBe('word word');
+      expect(state.visualCursor).toEqual([0, 1]);
+    });
+
+    it('should keep the layouts of buffers with different widths apart', () => {
+      const initialText = 'This is a very long line of text.';
+      const { result } = renderHook(() => ({
+        narrow: useTextBuffer({
+          initialText,
+          viewport: { width: 10, height: 5 },
+          isValidPath: () => false,
+        }),
+        wide: useTextBuffer({
+          initialText,
+          viewport: { width: 20, height: 5 },
+          isValidPath: () => false,
+        }),
+      }));
+
+      act(() => result.current.narrow.insert('x'));
+      act(() => result.current.wide.insert('y'));
+
+      expect(result.current.narrow.allVisualLines).toEqual([
+        'xThis is a',
+        'very long',
+        'line of',
+        'text.',
+      ]);
+      expect(result.current.wide.allVisualLines).toEqual([
+        'yThis is a very long',
+        'line of text.',
+      ]);
+    });
+
     it('should update visualScrollRow when visualCursor moves out of viewport', () => {
       const { result } = renderHook(() =>
         useTextBuffer({
@@ -629,219 +629,303 @@ export function logicalPosToOffset(
   return offset;
 }
 
-// Helper to calculate visual lines and map cursor positions
-function calculateVisualLayout(
-  logicalLines: string[],
-  logicalCursor: [number, number],
-  viewportWidth: number,
-): {
+interface WrappedLine {
+  chunks: string[]; // The visual lines this logical line wraps into
+  starts: number[]; // Start col (code points) of each chunk in the logical line
+  lengths: number[]; // Length (code points) of each chunk
+  length: number; // Length (code points) of the logical line
+}
+
+interface VisualLayout {
   visualLines: string[];
-  visualCursor: [number, number];
   logicalToVisualMap: Array<Array<[number, number]>>; // For each logical line, an array of [visualLineIndex, startColInLogical]
   visualToLogicalMap: Array<[number, number]>; // For each visual line, its [logicalLineIndex, startColInLogical]
-} {
-  const visualLines: string[] = [];
-  const logicalToVisualMap: Array<Array<[number, number]>> = [];
-  const visualToLogicalMap: Array<[number, number]> = [];
-  let currentVisualCursor: [number, number] = [0, 0];
+}
 
-  logicalLines.forEach((logLine, logIndex) => {
-    logicalToVisualMap[logIndex] = [];
-    if (logLine.length === 0) {
-      // Handle empty logical line
-      logicalToVisualMap[logIndex].push([visualLines.length, 0]);
-      visualToLogicalMap.push([logIndex, 0]);
-      visualLines.push('');
-      if (logIndex === logicalCursor[0] && logicalCursor[1] === 0) {
-        currentVisualCursor = [visualLines.length - 1, 0];
-      }
-    } else {
-      // Non-empty logical line
-      let currentPosInLogLine = 0; // Tracks position within the current logical line (code point index)
-      const codePointsInLogLine = toCodePoints(logLine);
-
-      while (currentPosInLogLine < codePointsInLogLine.length) {
-        let currentChunk = '';
-        let currentChunkVisualWidth = 0;
-        let numCodePointsInChunk = 0;
-        let lastWordBreakPoint = -1; // Index in codePointsInLogLine for word break
-        let numCodePointsAtLastWordBreak = 0;
-
-        // Iterate through code points to build the current visual line (chunk)
-        for (let i = currentPosInLogLine; i < codePointsInLogLine.length; i++) {
-          const char = codePointsInLogLine[i];
-          const charVisualWidth = stringWidth(char);
-
-          if (currentChunkVisualWidth + charVisualWidth > viewportWidth) {
-            // Character would exceed viewport width
-            if (
-              lastWordBreakPoint !== -1 &&
-              numCodePointsAtLastWordBreak > 0 &&
-              currentPosInLogLine + numCodePointsAtLastWordBreak < i
-            ) {
-              // We have a valid word break point to use, and it's not the start of the current segment
-              currentChunk = codePointsInLogLine
-                .slice(
-                  currentPosInLogLine,
-                  currentPosInLogLine + numCodePointsAtLastWordBreak,
-                )
-                .join('');
-              numCodePointsInChunk = numCodePointsAtLastWordBreak;
-            } else {
-              // No word break, or word break is at the start of this potential chunk, or word break leads to empty chunk.
-              // Hard break: take characters up to viewportWidth, or just the current char if it alone is too wide.
-              if (
-                numCodePointsInChunk === 0 &&
-                charVisualWidth > viewportWidth
-              ) {
-                // Single character is wider than viewport, take it anyway
-                currentChunk = char;
-                numCodePointsInChunk = 1;
-              } else if (
-                numCodePointsInChunk === 0 &&
-                charVisualWidth <= viewportWidth
-              ) {
-                // This case should ideally be caught by the next iteration if the char fits.
-                // If it doesn't fit (because currentChunkVisualWidth was already > 0 from a previous char that filled the line),
-                // then numCodePointsInChunk would not be 0.
-                // This branch means the current char *itself* doesn't fit an empty line, which is handled by the above.
-                // If we are here, it means the loop should break and the current chunk (which is empty) is finalized.
-              }
-            }
-            break; // Break from inner loop to finalize this chunk
-          }
+const WRAP_CACHE_LIMIT = 50_000;
 
-          currentChunk += char;
-          currentChunkVisualWidth += charVisualWidth;
-          numCodePointsInChunk++;
+/**
+ * Layout state of one text buffer, shared by its reducer and hook.
+ */
+class LayoutCache {
+  // Wrapped lines keyed by content for the current viewport width. Wrapping
+  // depends only on the line and the width, so after an edit only the edited
+  // lines are wrapped again.
+  private readonly wrapped = new Map<string, WrappedLine>();
+  private wrapWidth = -1;
+  // The most recently computed layout. Cursor moves don't change the lines,
+  // so the reducer and the hook share a single layout per edit.
+  private last:
+    | { lines: string[]; viewportWidth: number; layout: VisualLayout }
+    | undefined;
+
+  getWrappedLine(logLine: string, viewportWidth: number): WrappedLine {
+    if (
+      this.wrapWidth !== viewportWidth ||
+      this.wrapped.size >= WRAP_CACHE_LIMIT
+    ) {
+      this.wrapped.clear();
+      this.wrapWidth = viewportWidth;
+    }
+    let wrapped = this.wrapped.get(logLine);
+    if (!wrapped) {
+      wrapped = wrapLogicalLine(logLine, viewportWidth);
+      this.wrapped.set(logLine, wrapped);
+    }
+    return wrapped;
+  }
 
-          // Check for word break opportunity (space)
-          if (char === ' ') {
-            lastWordBreakPoint = i; // Store code point index of the space
-            // Store the state *before* adding the space, if we decide to break here.
-            numCodePointsAtLastWordBreak = numCodePointsInChunk - 1; // Chars *before* the space
-          }
-        }
+  getLastLayout(
+    lines: string[],
+    viewportWidth: number,
+  ): VisualLayout | undefined {
+    return this.last?.lines === lines &&
+      this.last.viewportWidth === viewportWidth
+      ? this.last.layout
+      : undefined;
+  }
 
-        // If the inner loop completed without breaking (i.e., remaining text fits)
-        // or if the loop broke but numCodePointsInChunk is still 0 (e.g. first char too wide for empty line)
-        if (
-          numCodePointsInChunk === 0 &&
-          currentPosInLogLine < codePointsInLogLine.length
-        ) {
-          // This can happen if the very first character considered for a new visual line is wider than the viewport.
-          // In this case, we take that single character.
-          const firstChar = codePointsInLogLine[currentPosInLogLine];
-          currentChunk = firstChar;
-          numCodePointsInChunk = 1; // Ensure we advance
-        }
+  setLastLayout(
+    lines: string[],
+    viewportWidth: number,
+    layout: VisualLayout,
+  ): void {
+    this.last = { lines, viewportWidth, layout };
+  }
+}
 
-        // If after everything, numCodePointsInChunk is still 0 but we haven't processed the whole logical line,
-        // it implies an issue, like viewportWidth being 0 or less. Avoid infinite loop.
+// Splits a non-empty logical line into visual lines, breaking at spaces when possible
+function wrapLogicalLine(logLine: string, viewportWidth: number): WrappedLine {
+  const codePointsInLogLine = toCodePoints(logLine);
+  const chunks: string[] = [];
+  const starts: number[] = [];
+  const lengths: number[] = [];
+
+  let currentPosInLogLine = 0; // Tracks position within the current logical line (code point index)
+
+  while (currentPosInLogLine < codePointsInLogLine.length) {
+    let currentChunk = '';
+    let currentChunkVisualWidth = 0;
+    let numCodePointsInChunk = 0;
+    let lastWordBreakPoint = -1; // Index in codePointsInLogLine for word break
+    let numCodePointsAtLastWordBreak = 0;
+
+    // Iterate through code points to build the current visual line (chunk)
+    for (let i = currentPosInLogLine; i < codePointsInLogLine.length; i++) {
+      const char = codePointsInLogLine[i];
+      const charVisualWidth = stringWidth(char);
+
+      if (currentChunkVisualWidth + charVisualWidth > viewportWidth) {
+        // Character would exceed viewport width
         if (
-          numCodePointsInChunk === 0 &&
-          currentPosInLogLine < codePointsInLogLine.length
+          lastWordBreakPoint !== -1 &&
+          numCodePointsAtLastWordBreak > 0 &&
+          currentPosInLogLine + numCodePointsAtLastWordBreak < i
         ) {
-          // Force advance by one character to prevent infinite loop if something went wrong
-          currentChunk = codePointsInLogLine[currentPosInLogLine];
-          numCodePointsInChunk = 1;
-        }
-
-        logicalToVisualMap[logIndex].push([
-          visualLines.length,
-          currentPosInLogLine,
-        ]);
-        visualToLogicalMap.push([logIndex, currentPosInLogLine]);
-        visualLines.push(currentChunk);
-
-        // Cursor mapping logic
-        // Note: currentPosInLogLine here is the start of the currentChunk within the logical line.
-        if (logIndex === logicalCursor[0]) {
-          const cursorLogCol = logicalCursor[1]; // This is a code point index
-          if (
-            cursorLogCol >= currentPosInLogLine &&
-            cursorLogCol < currentPosInLogLine + numCodePointsInChunk // Cursor is within this chunk
-          ) {
-            currentVisualCursor = [
-              visualLines.length - 1,
-              cursorLogCol - currentPosInLogLine, // Visual col is also code point index within visual line
-            ];
+          // We have a valid word break point to use, and it's not the start of the current segment
+          currentChunk = codePointsInLogLine
+            .slice(
+              currentPosInLogLine,
+              currentPosInLogLine + numCodePointsAtLastWordBreak,
+            )
+            .join('');
+          numCodePointsInChunk = numCodePointsAtLastWordBreak;
+        } else {
+          // No word break, or word break is at the start of this potential chunk, or word break leads to empty chunk.
+          // Hard break: take characters up to viewportWidth, or just the current char if it alone is too wide.
+          if (numCodePointsInChunk === 0 && charVisualWidth > viewportWidth) {
+            // Single character is wider than viewport, take it anyway
+            currentChunk = char;
+            numCodePointsInChunk = 1;
           } else if (
-            cursorLogCol === currentPosInLogLine + numCodePointsInChunk &&
-            numCodePointsInChunk > 0
+            numCodePointsInChunk === 0 &&
+            charVisualWidth <= viewportWidth
           ) {
-            // Cursor is exactly at the end of this non-empty chunk
-            currentVisualCursor = [
-              visualLines.length - 1,
-              numCodePointsInChunk,
-            ];
+            // This case should ideally be caught by the next iteration if the char fits.
+            // If it doesn't fit (because currentChunkVisualWidth was already > 0 from a previous char that filled the line),
+            // then numCodePointsInChunk would not be 0.
+            // This branch means the current char *itself* doesn't fit an empty line, which is handled by the above.
+            // If we are here, it means the loop should break and the current chunk (which is empty) is finalized.
           }
         }
+        break; // Break from inner loop to finalize this chunk
+      }
 
-        const logicalStartOfThisChunk = currentPosInLogLine;
-        currentPosInLogLine += numCodePointsInChunk;
+      currentChunk += char;
+      currentChunkVisualWidth += charVisualWidth;
+      numCodePointsInChunk++;
 
-        // If the chunk processed did not consume the entire logical line,
-        // and the character immediately following the chunk is a space,
-        // advance past this space as it acted as a delimiter for word wrapping.
-        if (
-          logicalStartOfThisChunk + numCodePointsInChunk <
-            codePointsInLogLine.length &&
-          currentPosInLogLine < codePointsInLogLine.length && // Redundant if previous is true, but safe
-          codePointsInLogLine[currentPosInLogLine] === ' '
-        ) {
-          currentPosInLogLine++;
-        }
-      }
-      // After all chunks of a non-empty logical line are processed,
-      // if the cursor is at the very end of this logical line, update visual cursor.
-      if (
-        logIndex === logicalCursor[0] &&
-        logicalCursor[1] === codePointsInLogLine.length // Cursor at end of logical line
-      ) {
-        const lastVisualLineIdx = visualLines.length - 1;
-        if (
-          lastVisualLineIdx >= 0 &&
-          visualLines[lastVisualLineIdx] !== undefined
-        ) {
-          currentVisualCursor = [
-            lastVisualLineIdx,
-            cpLen(visualLines[lastVisualLineIdx]), // Cursor at end of last visual line for this logical line
-          ];
-        }
+      // Check for word break opportunity (space)
+      if (char === ' ') {
+        lastWordBreakPoint = i; // Store code point index of the space
+        // Store the state *before* adding the space, if we decide to break here.
+        numCodePointsAtLastWordBreak = numCodePointsInChunk - 1; // Chars *before* the space
       }
     }
+
+    // If the inner loop completed without breaking (i.e., remaining text fits)
+    // or if the loop broke but numCodePointsInChunk is still 0 (e.g. first char too wide for empty line)
+    if (
+      numCodePointsInChunk === 0 &&
+      currentPosInLogLine < codePointsInLogLine.length
+    ) {
+      // This can happen if the very first character considered for a new visual line is wider than the viewport.
+      // In this case, we take that single character.
+      const firstChar = codePointsInLogLine[currentPosInLogLine];
+      currentChunk = firstChar;
+      numCodePointsInChunk = 1; // Ensure we advance
+    }
+
+    // If after everything, numCodePointsInChunk is still 0 but we haven't processed the whole logical line,
+    // it implies an issue, like viewportWidth being 0 or less. Avoid infinite loop.
+    if (
+      numCodePointsInChunk === 0 &&
+      currentPosInLogLine < codePointsInLogLine.length
+    ) {
+      // Force advance by one character to prevent infinite loop if something went wrong
+      currentChunk = codePointsInLogLine[currentPosInLogLine];
+      numCodePointsInChunk = 1;
+    }
+
+    chunks.push(currentChunk);
+    starts.push(currentPosInLogLine);
+    lengths.push(numCodePointsInChunk);
+
+    const logicalStartOfThisChunk = currentPosInLogLine;
+    currentPosInLogLine += numCodePointsInChunk;
+
+    // If the chunk processed did not consume the entire logical line,
+    // and the character immediately following the chunk is a space,
+    // advance past this space as it acted as a delimiter for word wrapping.
+    if (
+      logicalStartOfThisChunk + numCodePointsInChunk <
+        codePointsInLogLine.length &&
+      currentPosInLogLine < codePointsInLogLine.length && // Redundant if previous is true, but safe
+      codePointsInLogLine[currentPosInLogLine] === ' '
+    ) {
+      currentPosInLogLine++;
+    }
+  }
+
+  return { chunks, starts, lengths, length: codePointsInLogLine.length };
+}
+
+// Builds the cursor-independent part of the layout
+function getVisualLayout(
+  logicalLines: string[],
+  viewportWidth: number,
+  cache: LayoutCache,
+): VisualLayout {
+  const cached = cache.getLastLayout(logicalLines, viewportWidth);
+  if (cached) {
+    return cached;
+  }
+
+  const visualLines: string[] = [];
+  const logicalToVisualMap: Array<Array<[number, number]>> = [];
+  const visualToLogicalMap: Array<[number, number]> = [];
+
+  logicalLines.forEach((logLine, logIndex) => {
+    logicalToVisualMap[logIndex] = [];
+    if (logLine.length === 0) {
+      // Handle empty logical line
+      logicalToVisualMap[logIndex].push([visualLines.length, 0]);
+      visualToLogicalMap.push([logIndex, 0]);
+      visualLines.push('');
+      return;
+    }
+    const { chunks, starts } = cache.getWrappedLine(logLine, viewportWidth);
+    for (let i = 0; i < chunks.length; i++) {
+      logicalToVisualMap[logIndex].push([visualLines.length, starts[i]]);
+      visualToLogicalMap.push([logIndex, starts[i]]);
+      visualLines.push(chunks[i]);
+    }
   });
 
   // If the entire logical text was empty, ensure there's one empty visual line.
+  if (visualLines.length === 0) {
+    visualLines.push('');
+    logicalToVisualMap[0] = [[0, 0]];
+    visualToLogicalMap.push([0, 0]);
+  }
+
+  const layout = { visualLines, logicalToVisualMap, visualToLogicalMap };
+  cache.setLastLayout(logicalLines, viewportWidth, layout);
+  return layout;
+}
+
+// Maps a logical cursor position onto the visual layout
+function getVisualCursor(
+  logicalLines: string[],
+  layout: VisualLayout,
+  logicalCursor: [number, number],
+  viewportWidth: number,
+  cache: LayoutCache,
+): [number, number] {
+  // If the entire logical text was empty, the cursor is at the origin.
   if (
     logicalLines.length === 0 ||
     (logicalLines.length === 1 && logicalLines[0] === '')
   ) {
-    if (visualLines.length === 0) {
-      visualLines.push('');
-      if (!logicalToVisualMap[0]) logicalToVisualMap[0] = [];
-      logicalToVisualMap[0].push([0, 0]);
-      visualToLogicalMap.push([0, 0]);
+    return [0, 0];
+  }
+
+  const [cursorRow, cursorCol] = logicalCursor;
+  const logLine = logicalLines[cursorRow];
+  if (logLine === undefined) {
+    return [0, 0];
+  }
+
+  const firstVisualRow = layout.logicalToVisualMap[cursorRow][0][0];
+  if (logLine.length === 0) {
+    return cursorCol === 0 ? [firstVisualRow, 0] : [0, 0];
+  }
+
+  const { starts, lengths, length } = cache.getWrappedLine(
+    logLine,
+    viewportWidth,
+  );
+  let visualCursor: [number, number] = [0, 0];
+  // Later chunks take precedence, so a cursor on a chunk boundary lands at
+  // the start of the following chunk.
+  for (let i = 0; i < starts.length; i++) {
+    if (cursorCol >= starts[i] && cursorCol < starts[i] + lengths[i]) {
+      visualCursor = [firstVisualRow + i, cursorCol - starts[i]];
+    } else if (cursorCol === starts[i] + lengths[i] && lengths[i] > 0) {
+      visualCursor = [firstVisualRow + i, lengths[i]];
     }
-    currentVisualCursor = [0, 0];
   }
-  // Handle cursor at the very end of the text (after all processing)
-  // This case might be covered by the loop end condition now, but kept for safety.
-  else if (
-    logicalCursor[0] === logicalLines.length - 1 &&
-    logicalCursor[1] === cpLen(logicalLines[logicalLines.length - 1]) &&
-    visualLines.length > 0
-  ) {
-    const lastVisLineIdx = visualLines.length - 1;
-    currentVisualCursor = [lastVisLineIdx, cpLen(visualLines[lastVisLineIdx])];
+
+  // If the cursor is at the very end of the logical line, place it at the
+  // end of its last visual line.
+  if (cursorCol === length) {
+    const lastVisualLineIdx = firstVisualRow + starts.length - 1;
+    visualCursor = [
+      lastVisualLineIdx,
+      cpLen(layout.visualLines[lastVisualLineIdx]),
+    ];
   }
 
+  return visualCursor;
+}
+
+// Helper to calculate visual lines and map cursor positions
+function calculateVisualLayout(
+  logicalLines: string[],
+  logicalCursor: [number, number],
+  viewportWidth: number,
+  cache: LayoutCache,
+): VisualLayout & { visualCursor: [number, number] } {
+  const layout = getVisualLayout(logicalLines, viewportWidth, cache);
   return {
-    visualLines,
-    visualCursor: currentVisualCursor,
-    logicalToVisualMap,
-    visualToLogicalMap,
+    ...layout,
+    visualCursor: getVisualCursor(
+      logicalLines,
+      layout,
+      logicalCursor,
+      viewportWidth,
+      cache,
+    ),
   };
 }
 
@@ -861,9 +945,11 @@ export interface TextBufferState {
 
 const historyLimit = 100;
 
+// The reducer never mutates a lines array in place; every edit produces a new
+// array. Undo entries can therefore share the array instead of copying it.
 export const pushUndo = (currentState: TextBufferState): TextBufferState => {
   const snapshot = {
-    lines: [...currentState.lines],
+    lines: currentState.lines,
     cursorRow: currentState.cursorRow,
     cursorCol: currentState.cursorCol,
   };
@@ -944,6 +1030,7 @@ export type TextBufferAction =
 export function textBufferReducer(
   state: TextBufferState,
   action: TextBufferAction,
+  layoutCache: LayoutCache = new LayoutCache(),
 ): TextBufferState {
   const pushUndoLocal = pushUndo;
 
@@ -1061,6 +1148,7 @@ export function textBufferReducer(
         lines,
         [cursorRow, cursorCol],
         viewportWidth,
+        layoutCache,
       );
       const { visualLines, visualCursor, visualToLogicalMap } = visualLayout;
 
@@ -1341,7 +1429,7 @@ export function textBufferReducer(
       if (!stateToRestore) return state;
 
       const currentSnapshot = {
-        lines: [...state.lines],
+        lines: state.lines,
         cursorRow: state.cursorRow,
         cursorCol: state.cursorCol,
       };
@@ -1358,7 +1446,7 @@ export function textBufferReducer(
       if (!stateToRestore) return state;
 
       const currentSnapshot = {
-        lines: [...state.lines],
+        lines: state.lines,
         cursorRow: state.cursorRow,
         cursorCol: state.cursorCol,
       };
@@ -1475,15 +1563,26 @@ export function useTextBuffer({
     };
   }, [initialText, initialCursorOffset, viewport.width]);
 
-  const [state, dispatch] = useReducer(textBufferReducer, initialState);
+  const [layoutCache] = useState(() => new LayoutCache());
+  const reducer = useCallback(
+    (current: TextBufferState, action: TextBufferAction) =>
+      textBufferReducer(current, action, layoutCache),
+    [layoutCache],
+  );
+  const [state, dispatch] = useReducer(reducer, initialState);
   const { lines, cursorRow, cursorCol, preferredCol, selectionAnchor } = state;
 
   const text = useMemo(() => lines.join('\n'), [lines]);
 
   const visualLayout = useMemo(
     () =>
-      calculateVisualLayout(lines, [cursorRow, cursorCol], state.viewportWidth),
-    [lines, cursorRow, cursorCol, state.viewportWidth],
+      calculateVisualLayout(
+        lines,
+        [cursorRow, cursorCol],
+        state.viewportWidth,
+        layoutCache,
+      ),
+    [lines, cursorRow, cursorCol, state.viewportWidth, layoutCache],
   );
 
   const { visualLines, visualCursor } = visualLayout;
@@ -189,6 +189,8 @@ export const AgentExecutionDisplay: React.FC<AgentExecutionDisplayProps> = ({
               Execution Summary: {data.executionSummary.totalToolCalls} tool
               uses · {data.executionSummary.totalTokens.toLocaleString()} tokens
               · {fmtDuration(data.executionSummary.totalDurationMs)}
+              {data.executionSummary.queueTimeMs > 0 &&
+                ` · queued ${fmtDuration(data.executionSummary.queueTimeMs)}`}
             </Text>
           </Box>
         )}
@@ -454,6 +456,11 @@ const ExecutionSummaryDetails: React.FC<{
       <Text>
         • <Text>Duration: {fmtDuration(stats.totalDurationMs)}</Text>
       </Text>
+      {stats.queueTimeMs > 0 && (
+        <Text>
+          • <Text>Queued: {fmtDuration(stats.queueTimeMs)}</Text>
+        </Text>
+      )}
       <Text>
         • <Text>Rounds: {stats.rounds}</Text>
       </Text>
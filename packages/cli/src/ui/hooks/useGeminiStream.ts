@@ -31,6 +31,7 @@ import {
   ConversationFinishedEvent,
   ApprovalMode,
   parseAndFormatApiError,
+  CheckpointStore,
 } from '@kolosal-ai/kolosal-ai-core';
 import { type Part, type PartListUnion, FinishReason } from '@google/genai';
 import type {
@@ -543,18 +544,25 @@ export const useGeminiStream = (
   );
 
   const handleChatCompressionEvent = useCallback(
-    (eventValue: ServerGeminiChatCompressedEvent['value']) =>
-      addItem(
-        {
-          type: 'info',
-          text:
+    (eventValue: ServerGeminiChatCompressedEvent['value']) => {
+      const tokens =
+        `${eventValue?.originalTokenCount ?? 'unknown'} to ` +
+        `${eventValue?.newTokenCount ?? 'unknown'} tokens`;
+      let text: string;
+      switch (eventValue?.tier) {
+        case 'prune':
+          text = `Stale tool outputs were removed from the context to stay under the input token limit for ${config.getModel()} (reduced from ${tokens}).`;
+          break;
+        case 'summary':
+          text = `Older messages were replaced with a summary prepared in the background to stay under the input token limit for ${config.getModel()} (reduced from ${tokens}).`;
+          break;
+        default:
+          text =
             `IMPORTANT: This conversation approached the input token limit for ${config.getModel()}. ` +
-            `A compressed context will be sent for future messages (compressed from: ` +
-            `${eventValue?.originalTokenCount ?? 'unknown'} to ` +
-            `${eventValue?.newTokenCount ?? 'unknown'} tokens).`,
-        },
-        Date.now(),
-      ),
+            `A compressed context will be sent for future messages (compressed from: ${tokens}).`;
+      }
+      addItem({ type: 'info', text }, Date.now());
+    },
     [addItem, config],
   );
 
@@ -1045,23 +1053,19 @@ export const useGeminiStream = (
               toolCallWithSnapshotFileName,
             );
 
-            await fs.writeFile(
-              toolCallWithSnapshotFilePath,
-              JSON.stringify(
-                {
-                  history,
-                  clientHistory,
-                  toolCall: {
-                    name: toolCall.request.name,
-                    args: toolCall.request.args,
-                  },
-                  commitHash,
-                  filePath,
-                },
-                null,
-                2,
-              ),
-            );
+            // Messages shared with earlier checkpoints are stored only once.
+            await new CheckpointStore(
+              storage.getProjectTempCheckpointObjectsDir(),
+            ).write(toolCallWithSnapshotFilePath, {
+              history,
+              clientHistory,
+              toolCall: {
+                name: toolCall.request.name,
+                args: toolCall.request.args,
+              },
+              commitHash,
+              filePath,
+            });
           } catch (error) {
             onDebugMessage(
               `Failed to create checkpoint for ${filePath}: ${getErrorMessage(
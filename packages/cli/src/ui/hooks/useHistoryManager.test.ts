@@ -4,10 +4,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-import { describe, it, expect } from 'vitest';
+import { describe, it, expect, vi } from 'vitest';
 import { renderHook, act } from '@testing-library/react';
 import { useHistory } from './useHistoryManager.js';
 import type { HistoryItem } from '../types.js';
+import type { HistoryJournal } from '../utils/historyBudget.js';
 
 describe('useHistoryManager', () => {
   it('should initialize with an empty history', () => {
@@ -199,4 +200,61 @@ describe('useHistoryManager', () => {
     expect(result.current.history[1].text).toBe('Gemini response');
     expect(result.current.history[2].text).toBe('Message 1');
   });
+
+  it('should collapse the oldest items once the memory budget is exceeded', () => {
+    const append = vi.fn().mockResolvedValue(undefined);
+    const journal = { append } as unknown as HistoryJournal;
+    const { result } = renderHook(() =>
+      useHistory({ memoryBudgetBytes: 10_000, journal }),
+    );
+    const timestamp = Date.now();
+    const longText = Array.from({ length: 100 }, (_, i) => `line ${i}`).join(
+      '\n',
+    );
+
+    act(() => {
+      for (let i = 0; i < 30; i++) {
+        result.current.addItem({ type: 'gemini', text: longText }, timestamp);
+      }
+    });
+
+    const { history } = result.current;
+    expect(history).toHaveLength(30);
+    expect(history[0].collapsed).toBe(true);
+    expect(history[0].text).toContain('92 more lines collapsed');
+    // Recent items keep their full content.
+    expect(history[29].collapsed).toBeUndefined();
+    expect(history[29].text).toBe(longText);
+    expect(append).toHaveBeenCalledWith(
+      expect.arrayContaining([expect.objectContaining({ text: longText })]),
+    );
+    expect(result.current.getMemoryStats().collapsedItems).toBeGreaterThan(0);
+  });
+
+  it('should keep old prompts whole for recall when over the memory budget', () => {
+    const { result } = renderHook(() =>
+      useHistory({ memoryBudgetBytes: 10_000 }),
+    );
+    const timestamp = Date.now();
+    const longText = Array.from({ length: 100 }, (_, i) => `line ${i}`).join(
+      '\n',
+    );
+    const prompt = `${longText}\nplease summarise`;
+
+    act(() => {
+      result.current.addItem({ type: 'user', text: prompt }, timestamp);
+      for (let i = 0; i < 30; i++) {
+        result.current.addItem({ type: 'gemini', text: longText }, timestamp);
+      }
+    });
+
+    const { history } = result.current;
+    // The up arrow and Ctrl+R recall prompts from the user items.
+    const recalled = history
+      .filter((item) => item.type === 'user')
+      .map((item) => item.text);
+    expect(recalled).toEqual([prompt]);
+    expect(history[0].collapsed).toBeUndefined();
+    expect(history[1].collapsed).toBe(true);
+  });
 });
@@ -4,8 +4,22 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-import { useState, useRef, useCallback } from 'react';
+import { useState, useRef, useCallback, useEffect } from 'react';
 import type { HistoryItem } from '../types.js';
+import type {
+  HistoryJournal,
+  HistoryMemoryStats,
+} from '../utils/historyBudget.js';
+import {
+  collapseHistoryItem,
+  computeHistoryMemoryStats,
+  estimateHistoryItemBytes,
+} from '../utils/historyBudget.js';
+
+// Estimated bytes retained by history items before old ones are collapsed
+export const DEFAULT_HISTORY_MEMORY_BUDGET = 32 * 1024 * 1024;
+// The most recent items are never collapsed
+const UNCOLLAPSIBLE_RECENT_ITEMS = 20;
 
 // Type for the updater function passed to updateHistoryItem
 type HistoryItemUpdater = (
@@ -21,17 +35,66 @@ export interface UseHistoryManagerReturn {
   ) => void;
   clearItems: () => void;
   loadHistory: (newHistory: HistoryItem[]) => void;
+  getMemoryStats: () => HistoryMemoryStats;
+}
+
+export interface UseHistoryOptions {
+  /** Estimated bytes of history content kept in memory. */
+  memoryBudgetBytes?: number;
+  /** Receives the full content of items when they are collapsed. */
+  journal?: HistoryJournal;
 }
 
 /**
  * Custom hook to manage the chat history state.
  *
  * Encapsulates the history array, message ID generation, adding items,
- * updating items, and clearing the history.
+ * updating items, and clearing the history. Once the history exceeds its
+ * memory budget, the oldest items are collapsed into compact summaries and
+ * their full content is written to the journal.
  */
-export function useHistory(): UseHistoryManagerReturn {
+export function useHistory({
+  memoryBudgetBytes = DEFAULT_HISTORY_MEMORY_BUDGET,
+  journal,
+}: UseHistoryOptions = {}): UseHistoryManagerReturn {
   const [history, setHistory] = useState<HistoryItem[]>([]);
   const messageIdCounterRef = useRef(0);
+  const historyRef = useRef(history);
+  historyRef.current = history;
+
+  useEffect(() => {
+    let totalBytes = 0;
+    for (const item of history) {
+      totalBytes += estimateHistoryItemBytes(item);
+    }
+    if (totalBytes <= memoryBudgetBytes) {
+      return;
+    }
+
+    const replacements = new Map<HistoryItem, HistoryItem>();
+    const collapsibleCount = history.length - UNCOLLAPSIBLE_RECENT_ITEMS;
+    for (
+      let i = 0;
+      i < collapsibleCount && totalBytes > memoryBudgetBytes;
+      i++
+    ) {
+      const item = history[i];
+      const collapsed = collapseHistoryItem(item);
+      if (collapsed !== item) {
+        totalBytes +=
+          estimateHistoryItemBytes(collapsed) - estimateHistoryItemBytes(item);
+        replacements.set(item, collapsed);
+      }
+    }
+    if (replacements.size === 0) {
+      return;
+    }
+
+    void journal?.append([...replacements.keys()]);
+    setHistory((prevHistory) =>
+      prevHistory.map((item) => replacements.get(item) ?? item),
+    );
+  }, [history, memoryBudgetBytes, journal]);
 
   // Generates a unique message ID based on a timestamp and a counter.
   const getNextMessageId = useCallback((baseTimestamp: number): number => {
@@ -101,11 +164,17 @@ export function useHistory(): UseHistoryManagerReturn {
     messageIdCounterRef.current = 0;
   }, []);
 
+  const getMemoryStats = useCallback(
+    () => computeHistoryMemoryStats(historyRef.current),
+    [],
+  );
+
   return {
     history,
     addItem,
     updateItem,
     clearItems,
     loadHistory,
+    getMemoryStats,
   };
 }
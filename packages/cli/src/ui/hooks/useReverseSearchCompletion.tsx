@@ -4,7 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-import { useEffect, useCallback } from 'react';
+import { useEffect, useCallback, useMemo } from 'react';
+import { PromptHistoryIndex } from '@kolosal-ai/kolosal-ai-core';
 import { useCompletion } from './useCompletion.js';
 import type { TextBuffer } from '../components/shared/text-buffer.js';
 import type { Suggestion } from '../components/SuggestionsDisplay.js';
@@ -47,26 +48,31 @@ export function useReverseSearchCompletion(
     }
   }, [reverseSearchActive, resetCompletionState]);
 
+  // Built once per search session, then queried on every keystroke.
+  const historyIndex = useMemo(
+    () =>
+      reverseSearchActive ? new PromptHistoryIndex(shellHistory) : undefined,
+    [shellHistory, reverseSearchActive],
+  );
+
   useEffect(() => {
-    if (!reverseSearchActive) {
+    if (!historyIndex) {
       return;
     }
 
-    const q = buffer.text.toLowerCase();
-    const matches = shellHistory.reduce<Suggestion[]>((acc, cmd) => {
-      const idx = cmd.toLowerCase().indexOf(q);
-      if (idx !== -1) {
-        acc.push({ label: cmd, value: cmd, matchedIndex: idx });
-      }
-      return acc;
-    }, []);
+    const matches: Suggestion[] = historyIndex
+      .search(buffer.text)
+      .map(({ text, matchedIndex }) => ({
+        label: text,
+        value: text,
+        matchedIndex,
+      }));
     setSuggestions(matches);
     setShowSuggestions(matches.length > 0);
     setActiveSuggestionIndex(matches.length > 0 ? 0 : -1);
   }, [
     buffer.text,
-    shellHistory,
-    reverseSearchActive,
+    historyIndex,
     setActiveSuggestionIndex,
     setShowSuggestions,
     setSuggestions,
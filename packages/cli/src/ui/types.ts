@@ -69,6 +69,7 @@ export interface SummaryProps {
 
 export interface HistoryItemBase {
   text?: string; // Text content for user/gemini/info/error messages
+  collapsed?: boolean; // Content was truncated to stay within the history memory budget
 }
 
 export type HistoryItemUser = HistoryItemBase & {
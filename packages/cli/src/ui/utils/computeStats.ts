@@ -31,6 +31,23 @@ export function calculateCacheHitRate(metrics: ModelMetrics): number {
   return (metrics.tokens.cached / metrics.tokens.prompt) * 100;
 }
 
+/** Average time to first token of streamed requests, in milliseconds. */
+export function calculateAverageTtft(metrics: ModelMetrics): number {
+  const streaming = metrics.streaming;
+  if (!streaming || streaming.requests === 0) {
+    return 0;
+  }
+  return streaming.totalTtftMs / streaming.requests;
+}
+
+export function calculateAverageQueueTime(metrics: ModelMetrics): number {
+  const streaming = metrics.streaming;
+  if (!streaming || streaming.requests === 0) {
+    return 0;
+  }
+  return streaming.totalQueueMs / streaming.requests;
+}
+
 export const computeSessionStats = (
   metrics: SessionMetrics,
 ): ComputedSessionStats => {
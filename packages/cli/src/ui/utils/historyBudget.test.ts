@@ -0,0 +1,138 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import type { HistoryItem } from '../types.js';
+import { ToolCallStatus } from '../types.js';
+import {
+  HistoryJournal,
+  collapseHistoryItem,
+  estimateHistoryItemBytes,
+  findVisibleTailStart,
+} from './historyBudget.js';
+
+const manyLines = (count: number) =>
+  Array.from({ length: count }, (_, i) => `line ${i}`).join('\n');
+
+describe('historyBudget', () => {
+  describe('collapseHistoryItem', () => {
+    it('should leave short items unchanged', () => {
+      const item: HistoryItem = { id: 1, type: 'gemini', text: 'short' };
+      expect(collapseHistoryItem(item)).toBe(item);
+    });
+
+    it('should truncate long text to a summary', () => {
+      const item: HistoryItem = { id: 1, type: 'info', text: manyLines(50) };
+      const collapsed = collapseHistoryItem(item);
+
+      expect(collapsed.collapsed).toBe(true);
+      expect(collapsed.text).toContain('line 7');
+      expect(collapsed.text).not.toContain('line 8\n');
+      expect(collapsed.text).toContain('42 more lines collapsed');
+      expect(estimateHistoryItemBytes(collapsed)).toBeLessThan(
+        estimateHistoryItemBytes(item),
+      );
+    });
+
+    it('should never collapse prompts the user typed', () => {
+      const prompt: HistoryItem = { id: 1, type: 'user', text: manyLines(50) };
+      const command: HistoryItem = {
+        id: 2,
+        type: 'user_shell',
+        text: manyLines(50),
+      };
+
+      expect(collapseHistoryItem(prompt)).toBe(prompt);
+      expect(collapseHistoryItem(command)).toBe(command);
+    });
+
+    it('should drop file contents from collapsed diffs', () => {
+      const item: HistoryItem = {
+        id: 1,
+        type: 'tool_group',
+        tools: [
+          {
+            callId: 'call-1',
+            name: 'Edit',
+            description: 'edit a file',
+            status: ToolCallStatus.Success,
+            confirmationDetails: undefined,
+            resultDisplay: {
+              fileName: 'a.ts',
+              fileDiff: '@@ -1 +1 @@\n-a\n+b',
+              originalContent: 'a'.repeat(10_000),
+              newContent: 'b'.repeat(10_000),
+            },
+          },
+        ],
+      };
+      const collapsed = collapseHistoryItem(item);
+
+      expect(collapsed.collapsed).toBe(true);
+      expect(collapsed.type === 'tool_group' && collapsed.tools[0]).toEqual(
+        expect.objectContaining({
+          resultDisplay: expect.objectContaining({
+            fileDiff: '@@ -1 +1 @@\n-a\n+b',
+            originalContent: null,
+            newContent: '',
+          }),
+        }),
+      );
+    });
+  });
+
+  describe('findVisibleTailStart', () => {
+    it('should keep only the items that fit in the given rows', () => {
+      const history: HistoryItem[] = Array.from({ length: 10 }, (_, i) => ({
+        id: i,
+        type: 'gemini',
+        text: 'x'.repeat(80),
+      }));
+      // Each item takes about four rows at a width of 80, including margins.
+      expect(findVisibleTailStart(history, 9, 80)).toBe(8);
+      expect(findVisibleTailStart(history, 1000, 80)).toBe(0);
+    });
+
+    it('should always keep the latest item', () => {
+      const history: HistoryItem[] = [
+        { id: 1, type: 'gemini', text: 'x'.repeat(10_000) },
+      ];
+      expect(findVisibleTailStart(history, 5, 80)).toBe(0);
+    });
+  });
+
+  describe('HistoryJournal', () => {
+    let tmpDir: string;
+
+    beforeEach(async () => {
+      tmpDir = await fs.mkdtemp(path.join(os.tmpdir(), 'history-journal-'));
+    });
+
+    afterEach(async () => {
+      await fs.rm(tmpDir, { recursive: true, force: true });
+    });
+
+    it('should append items as JSON lines', async () => {
+      const journal = new HistoryJournal(
+        path.join(tmpDir, 'nested', 'session.jsonl'),
+      );
+      await journal.append([{ id: 1, type: 'user', text: 'hi' }]);
+      await journal.append([{ id: 2, type: 'gemini', text: 'hello' }]);
+
+      const lines = (await fs.readFile(journal.filePath, 'utf-8'))
+        .trim()
+        .split('\n')
+        .map((line) => JSON.parse(line));
+      expect(lines).toEqual([
+        { id: 1, type: 'user', text: 'hi' },
+        { id: 2, type: 'gemini', text: 'hello' },
+      ]);
+    });
+  });
+});
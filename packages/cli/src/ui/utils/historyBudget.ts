@@ -0,0 +1,200 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import fs from 'node:fs/promises';
+import path from 'node:path';
+import type { HistoryItem, IndividualToolCallDisplay } from '../types.js';
+import { ToolCallStatus } from '../types.js';
+
+// Lines of text kept when an item is collapsed into a summary
+const COLLAPSED_MAX_LINES = 8;
+// Characters kept when an item is collapsed into a summary
+const COLLAPSED_MAX_CHARS = 2000;
+
+export interface HistoryMemoryStats {
+  items: number;
+  collapsedItems: number;
+  totalBytes: number;
+  averageItemBytes: number;
+  largestItemBytes: number;
+}
+
+// Sizes are cached per item object; items are immutable, so an updated item
+// is a new object and gets measured again.
+const sizeCache = new WeakMap<HistoryItem, number>();
+
+/**
+ * Estimates the memory held by a history item from the strings it retains.
+ * JavaScript strings use two bytes per UTF-16 code unit.
+ */
+export function estimateHistoryItemBytes(item: HistoryItem): number {
+  const cached = sizeCache.get(item);
+  if (cached !== undefined) {
+    return cached;
+  }
+  let chars = 0;
+  const visit = (value: unknown, depth: number) => {
+    if (typeof value === 'string') {
+      chars += value.length;
+    } else if (value && typeof value === 'object' && depth < 8) {
+      for (const child of Object.values(value)) {
+        visit(child, depth + 1);
+      }
+    }
+  };
+  visit(item, 0);
+  const bytes = chars * 2;
+  sizeCache.set(item, bytes);
+  return bytes;
+}
+
+export function computeHistoryMemoryStats(
+  history: HistoryItem[],
+): HistoryMemoryStats {
+  let totalBytes = 0;
+  let largestItemBytes = 0;
+  let collapsedItems = 0;
+  for (const item of history) {
+    const bytes = estimateHistoryItemBytes(item);
+    totalBytes += bytes;
+    largestItemBytes = Math.max(largestItemBytes, bytes);
+    if (item.collapsed) {
+      collapsedItems++;
+    }
+  }
+  return {
+    items: history.length,
+    collapsedItems,
+    totalBytes,
+    averageItemBytes: history.length
+      ? Math.round(totalBytes / history.length)
+      : 0,
+    largestItemBytes,
+  };
+}
+
+function collapseText(text: string): string {
+  const lines = text.split('\n');
+  if (
+    lines.length <= COLLAPSED_MAX_LINES &&
+    text.length <= COLLAPSED_MAX_CHARS
+  ) {
+    return text;
+  }
+  const kept = lines
+    .slice(0, COLLAPSED_MAX_LINES)
+    .join('\n')
+    .slice(0, COLLAPSED_MAX_CHARS);
+  const hiddenLines = lines.length - kept.split('\n').length;
+  const detail =
+    hiddenLines > 0 ? `${hiddenLines} more lines` : 'remaining output';
+  return `${kept}\n… (${detail} collapsed; full content is in the session journal)`;
+}
+
+function collapseTool(
+  tool: IndividualToolCallDisplay,
+): IndividualToolCallDisplay {
+  const { resultDisplay } = tool;
+  let collapsedDisplay = resultDisplay;
+  if (typeof resultDisplay === 'string') {
+    collapsedDisplay = collapseText(resultDisplay);
+  } else if (resultDisplay && 'fileDiff' in resultDisplay) {
+    // Only the diff is rendered; the full file contents are not needed.
+    collapsedDisplay = {
+      ...resultDisplay,
+      fileDiff: collapseText(resultDisplay.fileDiff),
+      originalContent: null,
+      newContent: '',
+    };
+  }
+  const confirmationDetails =
+    tool.status === ToolCallStatus.Confirming
+      ? tool.confirmationDetails
+      : undefined;
+  if (
+    collapsedDisplay === resultDisplay &&
+    confirmationDetails === tool.confirmationDetails
+  ) {
+    return tool;
+  }
+  return { ...tool, resultDisplay: collapsedDisplay, confirmationDetails };
+}
+
+/**
+ * Collapses a history item into a compact summary by truncating long text and
+ * tool output. Returns the item unchanged when there is nothing to collapse.
+ * Prompts the user typed are never collapsed: they are recalled from the
+ * history with the up arrow and Ctrl+R, and may be submitted again.
+ */
+export function collapseHistoryItem(item: HistoryItem): HistoryItem {
+  if (item.collapsed || item.type === 'user' || item.type === 'user_shell') {
+    return item;
+  }
+  if (item.type === 'tool_group') {
+    const tools = item.tools.map(collapseTool);
+    if (tools.every((tool, i) => tool === item.tools[i])) {
+      return item;
+    }
+    return { ...item, tools, collapsed: true };
+  }
+  if (typeof item.text === 'string') {
+    const text = collapseText(item.text);
+    if (text === item.text) {
+      return item;
+    }
+    return { ...item, text, collapsed: true } as HistoryItem;
+  }
+  return item;
+}
+
+/**
+ * Append-only JSONL file holding the full content of history items that were
+ * collapsed to stay within the memory budget.
+ */
+export class HistoryJournal {
+  private queue: Promise<void> = Promise.resolve();
+
+  constructor(readonly filePath: string) {}
+
+  append(items: HistoryItem[]): Promise<void> {
+    if (items.length === 0) {
+      return this.queue;
+    }
+    const lines = items.map((item) => JSON.stringify(item)).join('\n') + '\n';
+    this.queue = this.queue.then(async () => {
+      try {
+        await fs.mkdir(path.dirname(this.filePath), { recursive: true });
+        await fs.appendFile(this.filePath, lines, 'utf-8');
+      } catch (error) {
+        console.debug('Failed to write history journal:', error);
+      }
+    });
+    return this.queue;
+  }
+}
+
+/**
+ * Returns the index of the first history item to render after the terminal is
+ * cleared, keeping roughly `maxRows` rows of the most recent items.
+ */
+export function findVisibleTailStart(
+  history: HistoryItem[],
+  maxRows: number,
+  terminalWidth: number,
+): number {
+  const width = Math.max(terminalWidth, 20);
+  let rows = 0;
+  for (let i = history.length - 1; i >= 0; i--) {
+    // Rough estimate from the retained text: wrapped lines plus margins.
+    const chars = estimateHistoryItemBytes(history[i]) / 2;
+    rows += Math.ceil(chars / width) + 2;
+    if (rows > maxRows) {
+      // Always keep at least the latest item.
+      return Math.min(i + 1, history.length - 1);
+    }
+  }
+  return 0;
+}
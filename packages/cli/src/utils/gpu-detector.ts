@@ -8,7 +8,10 @@
 
 import { exec } from 'node:child_process';
 import { promisify } from 'node:util';
-import { existsSync } from 'node:fs';
+import { existsSync, promises as fs } from 'node:fs';
+import os from 'node:os';
+import { join, dirname } from 'node:path';
+import { Storage } from '@kolosal-ai/kolosal-ai-core';
 
 const execAsync = promisify(exec);
 
@@ -62,6 +65,61 @@ export async function detectGPUs(): Promise<GPUDetectionResult> {
   }
 }
 
+interface CachedGPUDetection {
+  bootId: string;
+  result: GPUDetectionResult;
+}
+
+/**
+ * Identifies the current boot, so cached hardware facts are discarded after a
+ * reboot (when drivers or devices may have changed).
+ */
+async function getBootId(): Promise<string> {
+  if (process.platform === 'linux') {
+    try {
+      return (
+        await fs.readFile('/proc/sys/kernel/random/boot_id', 'utf-8')
+      ).trim();
+    } catch {
+      // Fall back to the boot time below.
+    }
+  }
+  // Boot time rounded to the minute absorbs clock jitter between calls.
+  const bootTime = Date.now() / 1000 - os.uptime();
+  return `boot-${Math.round(bootTime / 60)}`;
+}
+
+/**
+ * Same as {@link detectGPUs}, but reuses the result from an earlier run during
+ * the same boot. Detection shells out to lspci/vulkaninfo and can take
+ * seconds; the hardware does not change until the next reboot.
+ */
+export async function detectGPUsCached(
+  cachePath = join(Storage.getGlobalCacheDir(), 'gpu-detection.json'),
+): Promise<GPUDetectionResult> {
+  const bootId = await getBootId();
+  try {
+    const cached = JSON.parse(
+      await fs.readFile(cachePath, 'utf-8'),
+    ) as CachedGPUDetection;
+    if (cached.bootId === bootId && cached.result) {
+      return cached.result;
+    }
+  } catch {
+    // No usable cache; detect below.
+  }
+
+  const result = await detectGPUs();
+  try {
+    await fs.mkdir(dirname(cachePath), { recursive: true });
+    const entry: CachedGPUDetection = { bootId, result };
+    await fs.writeFile(cachePath, JSON.stringify(entry), 'utf-8');
+  } catch {
+    // The cache is only an optimization.
+  }
+  return result;
+}
+
 /**
  * Detect GPUs on Linux systems
  */
@@ -19,6 +19,12 @@ import { promisify } from 'node:util';
 import type { Config, SandboxConfig } from '@kolosal-ai/kolosal-ai-core';
 import { FatalSandboxError } from '@kolosal-ai/kolosal-ai-core';
 import { ConsolePatcher } from '../ui/utils/ConsolePatcher.js';
+import {
+  isSandboxReuseEnabled,
+  rebuildOnceCommand,
+  runInReusableContainer,
+  StartupTimer,
+} from './sandboxReuse.js';
 
 const execAsync = promisify(exec);
 
@@ -117,7 +123,11 @@ function ports(): string[] {
     .map((p) => p.trim());
 }
 
-function entrypoint(workdir: string, cliArgs: string[]): string[] {
+function entrypoint(
+  workdir: string,
+  cliArgs: string[],
+  reuseContainer = false,
+): string[] {
   const isWindows = os.platform() === 'win32';
   const containerWorkdir = getContainerPath(workdir);
   const shellCmds = [];
@@ -174,7 +184,9 @@ function entrypoint(workdir: string, cliArgs: string[]): string[] {
     process.env['NODE_ENV'] === 'development'
       ? process.env['DEBUG']
         ? 'npm run debug --'
-        : 'npm rebuild && npm run start --'
+        : reuseContainer
+          ? rebuildOnceCommand('npm run start --')
+          : 'npm rebuild && npm run start --'
       : process.env['DEBUG']
         ? `node --inspect-brk=0.0.0.0:${process.env['DEBUG_PORT'] || '9229'} $(which kolosal)`
         : 'kolosal';
@@ -347,6 +359,7 @@ export async function start_sandbox(
     }
 
     console.error(`hopping into sandbox (command: ${config.command}) ...`);
+    const timer = new StartupTimer();
 
     // determine full path for gemini-cli to distinguish linked vs installed setting
     const gcPath = fs.realpathSync(process.argv[1]);
@@ -397,7 +410,12 @@ export async function start_sandbox(
     }
 
     // stop if image is missing
-    if (!(await ensureSandboxImageIsPresent(config.command, image))) {
+    const imagePresent = await ensureSandboxImageIsPresent(
+      config.command,
+      image,
+    );
+    timer.mark('image');
+    if (!imagePresent) {
       const remedy =
         image === LOCAL_DEV_SANDBOX_IMAGE_NAME
           ? 'Try running `npm run build:all` or `npm run build:sandbox` under the gemini-cli repo to build it locally, or check the image name and your network connection.'
@@ -549,19 +567,31 @@ export async function start_sandbox(
       }
     }
 
+    // with SANDBOX_REUSE, exec into a long-lived container named after its
+    // configuration instead; the proxy setup below needs a fresh container
+    const reuseContainer = isSandboxReuseEnabled() && !proxyCommand;
+    if (isSandboxReuseEnabled() && proxyCommand) {
+      console.error(
+        'SANDBOX_REUSE is ignored with GEMINI_SANDBOX_PROXY_COMMAND; starting a fresh container',
+      );
+    }
+
     // name container after image, plus numeric suffix to avoid conflicts
     const imageName = parseImageName(image);
-    let index = 0;
-    const containerNameCheck = execSync(
-      `${config.command} ps -a --format "{{.Names}}"`,
-    )
-      .toString()
-      .trim();
-    while (containerNameCheck.includes(`${imageName}-${index}`)) {
-      index++;
-    }
-    const containerName = `${imageName}-${index}`;
-    args.push('--name', containerName, '--hostname', containerName);
+    let containerName = '';
+    if (!reuseContainer) {
+      let index = 0;
+      const containerNameCheck = execSync(
+        `${config.command} ps -a --format "{{.Names}}"`,
+      )
+        .toString()
+        .trim();
+      while (containerNameCheck.includes(`${imageName}-${index}`)) {
+        index++;
+      }
+      containerName = `${imageName}-${index}`;
+      args.push('--name', containerName, '--hostname', containerName);
+    }
 
     // copy API keys
     if (process.env['OPENAI_API_KEY']) {
@@ -678,8 +708,10 @@ export async function start_sandbox(
       args.push('--env', `NODE_OPTIONS="${allNodeOptions}"`);
     }
 
-    // set SANDBOX as container name
-    args.push('--env', `SANDBOX=${containerName}`);
+    // set SANDBOX as container name (a reused container sets it per session)
+    if (!reuseContainer) {
+      args.push('--env', `SANDBOX=${containerName}`);
+    }
 
     // for podman only, use empty --authfile to skip unnecessary auth refresh overhead
     if (config.command === 'podman') {
@@ -691,7 +723,7 @@ export async function start_sandbox(
     // Determine if the current user's UID/GID should be passed to the sandbox.
     // See shouldUseCurrentUserInSandbox for more details.
     let userFlag = '';
-    const finalEntrypoint = entrypoint(workdir, cliArgs);
+    const finalEntrypoint = entrypoint(workdir, cliArgs, reuseContainer);
 
     if (process.env['GEMINI_CLI_INTEGRATION_TEST'] === 'true') {
       args.push('--user', 'root');
@@ -734,6 +766,22 @@ export async function start_sandbox(
       args.push('--env', `HOME=${os.homedir()}`);
     }
 
+    if (reuseContainer) {
+      timer.mark('container setup');
+      const code = await runInReusableContainer({
+        command: config.command,
+        runArgs: args,
+        image,
+        imageName,
+        entrypoint: finalEntrypoint,
+        timer,
+      });
+      if (code !== 0) {
+        console.log(`Sandbox process exited with code: ${code}`);
+      }
+      return;
+    }
+
     // push container image name
     args.push(image);
 
@@ -788,6 +836,8 @@ export async function start_sandbox(
     }
 
     // spawn child and let it inherit stdio
+    timer.mark('container setup');
+    console.debug(`sandbox startup: ${timer.summary()}`);
     sandboxProcess = spawn(config.command, args, {
       stdio: 'inherit',
     });
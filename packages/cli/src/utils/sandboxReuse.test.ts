@@ -0,0 +1,109 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, describe, expect, it } from 'vitest';
+import {
+  isSandboxReuseEnabled,
+  reusableContainerName,
+  sandboxIdleTimeoutSeconds,
+  splitRunArgs,
+} from './sandboxReuse.js';
+
+describe('splitRunArgs', () => {
+  it('should keep container flags and move session flags to exec', () => {
+    const split = splitRunArgs([
+      'run',
+      '-i',
+      '--rm',
+      '--init',
+      '--workdir',
+      '/work',
+      '-t',
+      '--volume',
+      '/work:/work',
+      '--publish=8080:8080',
+      '--privileged',
+      '--name',
+      'sandbox-0',
+      '--hostname',
+      'sandbox-0',
+      '--env',
+      'TERM=xterm',
+      '--env=NODE_OPTIONS="--max-old-space-size=4096"',
+      '--user',
+      'root',
+    ]);
+
+    expect(split).toEqual({
+      containerArgs: [
+        '--workdir',
+        '/work',
+        '--volume',
+        '/work:/work',
+        '--publish=8080:8080',
+        '--privileged',
+        '--user',
+        'root',
+      ],
+      execArgs: [
+        '--workdir',
+        '/work',
+        '--env',
+        'TERM=xterm',
+        '--env=NODE_OPTIONS="--max-old-space-size=4096"',
+        '--user',
+        'root',
+      ],
+      tty: true,
+    });
+  });
+});
+
+describe('reusableContainerName', () => {
+  it('should depend on the image and the container flags only', () => {
+    const args = ['--volume', '/work:/work'];
+    const name = reusableContainerName('sandbox', 'sha256:abc', args);
+
+    expect(name).toMatch(/^sandbox-reuse-[0-9a-f]{12}$/);
+    expect(reusableContainerName('sandbox', 'sha256:abc', [...args])).toBe(
+      name,
+    );
+    expect(reusableContainerName('sandbox', 'sha256:def', args)).not.toBe(
+      name,
+    );
+    expect(
+      reusableContainerName('sandbox', 'sha256:abc', [
+        ...args,
+        '--volume',
+        '/data:/data',
+      ]),
+    ).not.toBe(name);
+  });
+});
+
+describe('sandbox reuse settings', () => {
+  const saved = { ...process.env };
+
+  afterEach(() => {
+    process.env = { ...saved };
+  });
+
+  it('should enable reuse only when SANDBOX_REUSE is set', () => {
+    delete process.env['SANDBOX_REUSE'];
+    expect(isSandboxReuseEnabled()).toBe(false);
+    process.env['SANDBOX_REUSE'] = 'True';
+    expect(isSandboxReuseEnabled()).toBe(true);
+    process.env['SANDBOX_REUSE'] = '0';
+    expect(isSandboxReuseEnabled()).toBe(false);
+  });
+
+  it('should read the idle timeout, falling back to 15 minutes', () => {
+    process.env['SANDBOX_IDLE_TIMEOUT'] = '120';
+    expect(sandboxIdleTimeoutSeconds()).toBe(120);
+    process.env['SANDBOX_IDLE_TIMEOUT'] = 'soon';
+    expect(sandboxIdleTimeoutSeconds()).toBe(900);
+  });
+});
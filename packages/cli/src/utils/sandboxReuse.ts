@@ -0,0 +1,278 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { execFile, spawn } from 'node:child_process';
+import crypto from 'node:crypto';
+import { promisify } from 'node:util';
+
+const execFileAsync = promisify(execFile);
+
+/**
+ * Touched by every session running in a reused container; the container
+ * stops once it has not been touched for the idle timeout. Kept out of /tmp,
+ * which is mounted from the host.
+ */
+export const SANDBOX_HEARTBEAT_FILE = '/var/tmp/.kolosal-sandbox-heartbeat';
+/** Created once `npm rebuild` has run in a reused dev container. */
+export const SANDBOX_REBUILT_MARKER = '/var/tmp/.kolosal-sandbox-rebuilt';
+/** Lets reused containers be listed with `docker ps --filter label=...`. */
+const SANDBOX_LABEL = 'ai.kolosal.sandbox=reuse';
+const DEFAULT_IDLE_TIMEOUT_SECONDS = 15 * 60;
+const HEARTBEAT_INTERVAL_SECONDS = 15;
+const HEALTH_CHECK_TIMEOUT_MS = 5000;
+
+/** `run` flags with a value that apply to each session only. */
+const SESSION_FLAGS_WITH_VALUE = new Set(['--env', '-e']);
+/** `run` flags that are dropped; the reused container sets its own. */
+const DROPPED_FLAGS_WITH_VALUE = new Set(['--name', '--hostname']);
+const DROPPED_FLAGS = new Set(['--rm', '--init', '-i', '-t', '-it']);
+/** `run` flags that apply to both the container and each session. */
+const SHARED_FLAGS_WITH_VALUE = new Set(['--workdir', '-w', '--user', '-u']);
+
+/**
+ * Whether `--sandbox` runs should exec into a long-lived container instead of
+ * starting a fresh one, controlled by the `SANDBOX_REUSE` environment
+ * variable ("1" or "true").
+ */
+export function isSandboxReuseEnabled(): boolean {
+  const value = process.env['SANDBOX_REUSE']?.toLowerCase().trim();
+  return value === '1' || value === 'true';
+}
+
+/**
+ * Seconds a reused container may stay idle before it stops, from
+ * `SANDBOX_IDLE_TIMEOUT`; 15 minutes by default.
+ */
+export function sandboxIdleTimeoutSeconds(): number {
+  const value = Number(process.env['SANDBOX_IDLE_TIMEOUT']);
+  return Number.isFinite(value) && value > 0
+    ? Math.ceil(value)
+    : DEFAULT_IDLE_TIMEOUT_SECONDS;
+}
+
+export interface SplitRunArgs {
+  /** Flags that define the container: mounts, ports, network, user, ... */
+  containerArgs: string[];
+  /** Flags passed to each `exec`: environment, workdir and user. */
+  execArgs: string[];
+  tty: boolean;
+}
+
+/**
+ * Splits the flags built for `docker run` into those that define the
+ * long-lived container and those that belong to each session. Values given
+ * as `--flag=value` are recognised as well.
+ */
+export function splitRunArgs(runArgs: string[]): SplitRunArgs {
+  const result: SplitRunArgs = {
+    containerArgs: [],
+    execArgs: [],
+    tty: false,
+  };
+  for (let i = runArgs[0] === 'run' ? 1 : 0; i < runArgs.length; i++) {
+    const arg = runArgs[i];
+    const [flag] = arg.split('=', 1);
+    const withValue = () => (flag !== arg ? [arg] : [arg, runArgs[++i]]);
+    if (DROPPED_FLAGS.has(arg)) {
+      result.tty ||= arg === '-t' || arg === '-it';
+    } else if (SESSION_FLAGS_WITH_VALUE.has(flag)) {
+      result.execArgs.push(...withValue());
+    } else if (SHARED_FLAGS_WITH_VALUE.has(flag)) {
+      const value = withValue();
+      result.containerArgs.push(...value);
+      result.execArgs.push(...value);
+    } else if (DROPPED_FLAGS_WITH_VALUE.has(flag)) {
+      if (flag === arg) i++;
+    } else {
+      // Everything else, including SANDBOX_FLAGS, defines the container.
+      result.containerArgs.push(arg);
+    }
+  }
+  return result;
+}
+
+/**
+ * Names the reusable container after the image and a hash of everything that
+ * defines it, so each (image, workspace, mounts) combination gets its own.
+ */
+export function reusableContainerName(
+  imageName: string,
+  imageId: string,
+  containerArgs: string[],
+): string {
+  const key = crypto
+    .createHash('sha256')
+    .update(JSON.stringify([imageId, ...containerArgs]))
+    .digest('hex')
+    .slice(0, 12);
+  return `${imageName}-reuse-${key}`;
+}
+
+/** Main process of a reused container: exits once it has been idle. */
+export function watchdogCommand(idleSeconds: number): string {
+  const hb = SANDBOX_HEARTBEAT_FILE;
+  return [
+    `touch ${hb} && chmod 666 ${hb} 2>/dev/null;`,
+    `while sleep ${HEARTBEAT_INTERVAL_SECONDS}; do`,
+    `[ $(( $(date +%s) - $(stat -c %Y ${hb}) )) -ge ${idleSeconds} ] && exit 0;`,
+    'done',
+  ].join(' ');
+}
+
+/** Wraps a session's command so it keeps the container alive while running. */
+export function sessionCommand(command: string): string {
+  const hb = SANDBOX_HEARTBEAT_FILE;
+  return [
+    `touch ${hb} 2>/dev/null;`,
+    `( while sleep ${HEARTBEAT_INTERVAL_SECONDS}; do touch ${hb} 2>/dev/null; done ) &`,
+    `trap 'kill $! 2>/dev/null; touch ${hb} 2>/dev/null' EXIT;`,
+    command,
+  ].join(' ');
+}
+
+/**
+ * Dev-mode command that rebuilds native modules only the first time it runs
+ * in a reused container, instead of on every invocation.
+ */
+export function rebuildOnceCommand(command: string): string {
+  const marker = SANDBOX_REBUILT_MARKER;
+  return `{ [ -e ${marker} ] || { npm rebuild && touch ${marker}; }; } && ${command}`;
+}
+
+/** Records how long each phase of starting a sandbox took. */
+export class StartupTimer {
+  private readonly phases: Array<[string, number]> = [];
+  private last = performance.now();
+
+  mark(phase: string): void {
+    const now = performance.now();
+    this.phases.push([phase, now - this.last]);
+    this.last = now;
+  }
+
+  summary(): string {
+    return this.phases
+      .map(([phase, ms]) => `${phase} ${Math.round(ms)}ms`)
+      .join(', ');
+  }
+}
+
+async function run(command: string, args: string[], timeout?: number) {
+  const { stdout } = await execFileAsync(command, args, { timeout });
+  return stdout.toString().trim();
+}
+
+async function isHealthy(command: string, name: string): Promise<boolean> {
+  try {
+    const running = await run(command, [
+      'inspect',
+      '--format',
+      '{{.State.Running}}',
+      name,
+    ]);
+    if (running !== 'true') return false;
+    await run(
+      command,
+      ['exec', name, 'bash', '-c', `touch ${SANDBOX_HEARTBEAT_FILE}`],
+      HEALTH_CHECK_TIMEOUT_MS,
+    );
+    return true;
+  } catch {
+    return false;
+  }
+}
+
+export interface ReusableContainerOptions {
+  command: string;
+  /** Flags built for `docker run`, without the image and entrypoint. */
+  runArgs: string[];
+  image: string;
+  imageName: string;
+  /** `['bash', '-c', <command>]`, as built for a fresh container. */
+  entrypoint: string[];
+  timer: StartupTimer;
+}
+
+/**
+ * Runs the sandboxed CLI through `exec` in the long-lived container for these
+ * options, starting or replacing the container first if it is missing or
+ * fails its health check. Resolves with the exit code of the session.
+ */
+export async function runInReusableContainer(
+  options: ReusableContainerOptions,
+): Promise<number | null> {
+  const { command, image, timer } = options;
+  const { containerArgs, execArgs, tty } = splitRunArgs(options.runArgs);
+  const imageId = await run(command, [
+    'image',
+    'inspect',
+    '--format',
+    '{{.Id}}',
+    image,
+  ]);
+  const name = reusableContainerName(
+    options.imageName,
+    imageId,
+    containerArgs,
+  );
+  timer.mark('image id');
+
+  const healthy = await isHealthy(command, name);
+  timer.mark('health check');
+  if (!healthy) {
+    await execFileAsync(command, ['rm', '-f', name]).catch(() => {});
+    const idleSeconds = sandboxIdleTimeoutSeconds();
+    try {
+      await run(command, [
+        'run',
+        '--detach',
+        '--rm',
+        '--init',
+        '--name',
+        name,
+        '--hostname',
+        name,
+        '--label',
+        SANDBOX_LABEL,
+        ...containerArgs,
+        image,
+        'bash',
+        '-c',
+        watchdogCommand(idleSeconds),
+      ]);
+    } catch (error) {
+      // Another invocation may have started the same container meanwhile.
+      if (!(await isHealthy(command, name))) throw error;
+    }
+    console.error(
+      `started reusable sandbox ${name} (stops after ${idleSeconds}s idle)`,
+    );
+    timer.mark('container start');
+  }
+
+  const [shell, flag, entrypointCommand] = options.entrypoint;
+  const args = [
+    'exec',
+    '-i',
+    ...(tty ? ['-t'] : []),
+    ...execArgs,
+    '--env',
+    `SANDBOX=${name}`,
+    name,
+    shell,
+    flag,
+    sessionCommand(entrypointCommand),
+  ];
+  console.debug(`sandbox startup: ${timer.summary()}`);
+
+  const session = spawn(command, args, { stdio: 'inherit' });
+  session.on('error', (err) => {
+    console.error('Sandbox process error:', err);
+  });
+  return new Promise((resolve) => {
+    session.on('close', (code) => resolve(code));
+  });
+}
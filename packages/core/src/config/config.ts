@@ -82,6 +82,13 @@ export interface BugCommandSettings {
 
 export interface ChatCompressionSettings {
   contextPercentageThreshold?: number;
+  /** Replace stale tool outputs with stubs before compressing. Default: true. */
+  pruneToolOutputs?: boolean;
+  /**
+   * Keep a summary of older history up to date in the background and use it
+   * before compressing on the spot. Default: true.
+   */
+  rollingSummary?: boolean;
 }
 
 export interface SummarizeToolOutputSettings {
@@ -181,6 +188,8 @@ export interface ConfigParameters {
   toolDiscoveryCommand?: string;
   toolCallCommand?: string;
   mcpServerCommand?: string;
+  /** Where discovered MCP schemas are persisted; under ~/.kolosal by default. */
+  mcpSchemaCachePath?: string;
   mcpServers?: Record<string, MCPServerConfig>;
   userMemory?: string;
   geminiMdFileCount?: number;
@@ -207,6 +216,7 @@ export interface ConfigParameters {
   extensionContextFilePaths?: string[];
   maxSessionTurns?: number;
   sessionTokenLimit?: number;
+  subagentTokenBudget?: number;
   experimentalZedIntegration?: boolean;
   listExtensions?: boolean;
   extensions?: GeminiCLIExtension[];
@@ -267,6 +277,7 @@ export class Config {
   private readonly toolDiscoveryCommand: string | undefined;
   private readonly toolCallCommand: string | undefined;
   private readonly mcpServerCommand: string | undefined;
+  private readonly mcpSchemaCachePath: string;
   private readonly mcpServers: Record<string, MCPServerConfig> | undefined;
   private userMemory: string;
   private geminiMdFileCount: number;
@@ -304,6 +315,7 @@ export class Config {
   }>;
   private readonly maxSessionTurns: number;
   private readonly sessionTokenLimit: number;
+  private readonly subagentTokenBudget: number | undefined;
   private readonly listExtensions: boolean;
   private readonly _extensions: GeminiCLIExtension[];
   private readonly _blockedMcpServers: Array<{
@@ -362,6 +374,8 @@ export class Config {
     this.toolDiscoveryCommand = params.toolDiscoveryCommand;
     this.toolCallCommand = params.toolCallCommand;
     this.mcpServerCommand = params.mcpServerCommand;
+    this.mcpSchemaCachePath =
+      params.mcpSchemaCachePath ?? Storage.getMcpSchemaCachePath();
     this.mcpServers = params.mcpServers;
     this.userMemory = params.userMemory ?? '';
     this.geminiMdFileCount = params.geminiMdFileCount ?? 0;
@@ -399,6 +413,7 @@ export class Config {
     this.extensionContextFilePaths = params.extensionContextFilePaths ?? [];
     this.maxSessionTurns = params.maxSessionTurns ?? -1;
     this.sessionTokenLimit = params.sessionTokenLimit ?? -1;
+    this.subagentTokenBudget = params.subagentTokenBudget;
     this.experimentalZedIntegration =
       params.experimentalZedIntegration ?? false;
     this.listExtensions = params.listExtensions ?? false;
@@ -618,6 +633,14 @@ export class Config {
     return this.sessionTokenLimit;
   }
 
+  /**
+   * Tokens that concurrently running subagents may consume together before
+   * new ones are queued; undefined when not configured.
+   */
+  getSubagentTokenBudget(): number | undefined {
+    return this.subagentTokenBudget;
+  }
+
   setQuotaErrorOccurred(value: boolean): void {
     this.quotaErrorOccurred = value;
   }
@@ -705,6 +728,10 @@ export class Config {
     return this.mcpServerCommand;
   }
 
+  getMcpSchemaCachePath(): string {
+    return this.mcpSchemaCachePath;
+  }
+
   getMcpServers(): Record<string, MCPServerConfig> | undefined {
     return this.mcpServers;
   }
@@ -715,6 +742,7 @@ export class Config {
 
   setUserMemory(newUserMemory: string): void {
     this.userMemory = newUserMemory;
+    this.geminiClient?.invalidateSystemPromptCache();
   }
 
   getGeminiMdFileCount(): number {
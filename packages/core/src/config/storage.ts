@@ -13,6 +13,7 @@ export const GEMINI_DIR = '.kolosal';
 export const GOOGLE_ACCOUNTS_FILENAME = 'google_accounts.json';
 const TMP_DIR_NAME = 'tmp';
 const MODELS_DIR_NAME = 'models';
+const CACHE_DIR_NAME = 'cache';
 
 export class Storage {
   private readonly targetDir: string;
@@ -33,6 +34,10 @@ export class Storage {
     return path.join(Storage.getGlobalGeminiDir(), 'mcp-oauth-tokens.json');
   }
 
+  static getMcpSchemaCachePath(): string {
+    return path.join(Storage.getGlobalGeminiDir(), 'mcp-schema-cache.json');
+  }
+
   static getGlobalSettingsPath(): string {
     return path.join(Storage.getGlobalGeminiDir(), 'settings.json');
   }
@@ -61,6 +66,10 @@ export class Storage {
     return path.join(Storage.getGlobalGeminiDir(), MODELS_DIR_NAME);
   }
 
+  static getGlobalCacheDir(): string {
+    return path.join(Storage.getGlobalGeminiDir(), CACHE_DIR_NAME);
+  }
+
   getGeminiDir(): string {
     return path.join(this.targetDir, GEMINI_DIR);
   }
@@ -115,6 +124,10 @@ export class Storage {
     return path.join(this.getProjectTempDir(), 'checkpoints');
   }
 
+  getProjectTempCheckpointObjectsDir(): string {
+    return path.join(this.getProjectTempCheckpointsDir(), 'objects');
+  }
+
   getExtensionsDir(): string {
     return path.join(this.getGeminiDir(), 'extensions');
   }
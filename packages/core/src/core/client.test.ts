@@ -23,6 +23,7 @@ import type {
 } from '@google/genai';
 import { GoogleGenAI } from '@google/genai';
 import { findIndexAfterFraction, GeminiClient } from './client.js';
+import { RollingSummary } from './contextManager.js';
 import { getPlanModeSystemReminder } from './prompts.js';
 import {
   AuthType,
@@ -616,7 +617,7 @@ describe('Gemini Client (client.ts)', () => {
 
       client['chat'] = mockChat as GeminiChat;
       client['contentGenerator'] = mockGenerator as ContentGenerator;
-      client['startChat'] = vi.fn().mockResolvedValue({ ...mockChat });
+      client['createChat'] = vi.fn().mockResolvedValue({ ...mockChat });
 
       return { client, mockChat, mockGenerator };
     }
@@ -635,6 +636,7 @@ describe('Gemini Client (client.ts)', () => {
           compressionStatus: CompressionStatus.COMPRESSED,
           newTokenCount: 1000,
           originalTokenCount: 1000,
+          tier: 'full',
         });
       });
 
@@ -825,6 +827,7 @@ describe('Gemini Client (client.ts)', () => {
         compressionStatus: CompressionStatus.COMPRESSED,
         originalTokenCount,
         newTokenCount,
+        tier: 'full',
       });
 
       // Assert that the chat was reset
@@ -878,6 +881,7 @@ describe('Gemini Client (client.ts)', () => {
         compressionStatus: CompressionStatus.COMPRESSED,
         originalTokenCount,
         newTokenCount,
+        tier: 'full',
       });
       // Assert that the chat was reset
       expect(newChat).not.toBe(initialChat);
@@ -918,12 +922,155 @@ describe('Gemini Client (client.ts)', () => {
         compressionStatus: CompressionStatus.COMPRESSED,
         originalTokenCount,
         newTokenCount,
+        tier: 'full',
       });
 
       // Assert that the chat was reset
       expect(newChat).not.toBe(initialChat);
     });
 
+    describe('before a full compression', () => {
+      const history: Content[] = [
+        { role: 'user', parts: [{ text: 'Fix the bug in a.ts' }] },
+        {
+          role: 'model',
+          parts: [
+            {
+              functionCall: {
+                id: 'read-1',
+                name: 'read_file',
+                args: { absolute_path: '/a.ts' },
+              },
+            },
+          ],
+        },
+        {
+          role: 'user',
+          parts: [
+            {
+              functionResponse: {
+                id: 'read-1',
+                name: 'read_file',
+                response: { output: 'const a = 1;\n'.repeat(200) },
+              },
+            },
+          ],
+        },
+        {
+          role: 'model',
+          parts: [
+            {
+              functionCall: {
+                id: 'edit-1',
+                name: 'edit',
+                args: { file_path: '/a.ts' },
+              },
+            },
+          ],
+        },
+        {
+          role: 'user',
+          parts: [
+            {
+              functionResponse: {
+                id: 'edit-1',
+                name: 'edit',
+                response: { output: 'Successfully modified file: /a.ts' },
+              },
+            },
+          ],
+        },
+        { role: 'model', parts: [{ text: 'Fixed.' }] },
+        { role: 'user', parts: [{ text: 'Now add a test' }] },
+        { role: 'model', parts: [{ text: 'Added.' }] },
+        { role: 'user', parts: [{ text: 'Thanks' }] },
+      ];
+
+      beforeEach(() => {
+        vi.mocked(tokenLimit).mockReturnValue(1000);
+        mockGetHistory.mockReturnValue(history);
+      });
+
+      it('prunes stale tool outputs without summarizing when that is enough', async () => {
+        mockCountTokens
+          .mockResolvedValueOnce({ totalTokens: 800 })
+          .mockResolvedValueOnce({ totalTokens: 300 });
+
+        const result = await client.tryCompressChat('prompt-id-6');
+
+        expect(result).toEqual({
+          compressionStatus: CompressionStatus.COMPRESSED,
+          originalTokenCount: 800,
+          newTokenCount: 300,
+          tier: 'prune',
+        });
+        expect(mockSendMessage).not.toHaveBeenCalled();
+        const [prunedHistory] = vi.mocked(client['chat']!.setHistory).mock
+          .calls[0];
+        expect(JSON.stringify(prunedHistory)).toContain(
+          '[Pruned: this output of /a.ts is stale',
+        );
+      });
+
+      it('applies the rolling summary instead of summarizing on the spot', async () => {
+        const rollingSummary = new RollingSummary(
+          async () => 'Rolling summary',
+          0.3,
+        );
+        client['rollingSummary'] = rollingSummary;
+        rollingSummary.update(history);
+        await rollingSummary.settle();
+        vi.spyOn(client['config'], 'getChatCompression').mockReturnValue({
+          pruneToolOutputs: false,
+        });
+        mockCountTokens
+          .mockResolvedValueOnce({ totalTokens: 800 })
+          .mockResolvedValueOnce({ totalTokens: 200 });
+
+        const initialChat = client.getChat();
+        const result = await client.tryCompressChat('prompt-id-7');
+
+        expect(result).toEqual({
+          compressionStatus: CompressionStatus.COMPRESSED,
+          originalTokenCount: 800,
+          newTokenCount: 200,
+          tier: 'summary',
+        });
+        expect(mockSendMessage).not.toHaveBeenCalled();
+        expect(client.getChat()).not.toBe(initialChat);
+        expect(JSON.stringify(client.getChat().getHistory())).toContain(
+          'Rolling summary',
+        );
+      });
+
+      it('keeps the rolling summary when its result is discarded', async () => {
+        const rollingSummary = new RollingSummary(
+          async () => 'Rolling summary',
+          0.3,
+        );
+        client['rollingSummary'] = rollingSummary;
+        rollingSummary.update(history);
+        await rollingSummary.settle();
+        vi.spyOn(client['config'], 'getChatCompression').mockReturnValue({
+          pruneToolOutputs: false,
+        });
+        mockSendMessage.mockResolvedValue({ text: 'Summary' });
+        mockCountTokens
+          .mockResolvedValueOnce({ totalTokens: 800 })
+          .mockResolvedValueOnce({ totalTokens: 900 })
+          .mockResolvedValueOnce({ totalTokens: 900 });
+
+        const initialChat = client.getChat();
+        const result = await client.tryCompressChat('prompt-id-8');
+
+        expect(result.compressionStatus).toBe(
+          CompressionStatus.COMPRESSION_FAILED_INFLATED_TOKEN_COUNT,
+        );
+        expect(client.getChat()).toBe(initialChat);
+        expect(rollingSummary.apply(history)).toBeDefined();
+      });
+    });
+
     it('should use current model from config for token counting after sendMessage', async () => {
       const initialModel = client['config'].getModel();
 
@@ -958,7 +1105,7 @@ describe('Gemini Client (client.ts)', () => {
 
       client['chat'] = mockChat as GeminiChat;
       client['contentGenerator'] = mockGenerator as ContentGenerator;
-      client['startChat'] = vi.fn().mockResolvedValue(mockChat);
+      client['createChat'] = vi.fn().mockResolvedValue(mockChat);
 
       const result = await client.tryCompressChat('prompt-id-4', true);
 
@@ -976,6 +1123,7 @@ describe('Gemini Client (client.ts)', () => {
         compressionStatus: CompressionStatus.COMPRESSED,
         originalTokenCount: 100000,
         newTokenCount: 5000,
+        tier: 'full',
       });
     });
   });
@@ -30,6 +30,10 @@ import {
   makeChatCompressionEvent,
   NextSpeakerCheckEvent,
 } from '../telemetry/types.js';
+import {
+  internalPromptId,
+  uiTelemetryService,
+} from '../telemetry/uiTelemetry.js';
 import { TaskTool } from '../tools/task.js';
 import {
   getDirectoryContextString,
@@ -38,23 +42,31 @@ import {
 import { reportError } from '../utils/errorReporting.js';
 import { getErrorMessage } from '../utils/errors.js';
 import { getFunctionCalls } from '../utils/generateContentResponseUtilities.js';
-import { isFunctionResponse } from '../utils/messageInspectors.js';
 import { checkNextSpeaker } from '../utils/nextSpeakerChecker.js';
+import { httpPool } from '../utils/httpPool.js';
 import { retryWithBackoff } from '../utils/retry.js';
-import { flatMapTextParts } from '../utils/partUtils.js';
+import { flatMapTextParts, getResponseText } from '../utils/partUtils.js';
 import type {
   ContentGenerator,
   ContentGeneratorConfig,
 } from './contentGenerator.js';
 import { AuthType, createContentGenerator } from './contentGenerator.js';
+import type { ContextReductionTier } from './contextManager.js';
+import {
+  findCompressionSplitIndex,
+  pruneStaleToolOutputs,
+  RollingSummary,
+  summaryHistory,
+} from './contextManager.js';
+import { discoverContextWindow } from './contextWindowProbe.js';
 import { GeminiChat } from './geminiChat.js';
 import {
   getCompressionPrompt,
-  getCoreSystemPrompt,
   getCustomSystemPrompt,
   getPlanModeSystemReminder,
   getSubagentSystemReminder,
 } from './prompts.js';
+import { SystemPromptCache } from './systemPromptCache.js';
 import { tokenLimit } from './tokenLimits.js';
 import type { ChatCompressionInfo, ServerGeminiStreamEvent } from './turn.js';
 import { CompressionStatus, GeminiEventType, Turn } from './turn.js';
@@ -64,38 +76,8 @@ function isThinkingSupported(model: string) {
   return false;
 }
 
-/**
- * Returns the index of the content after the fraction of the total characters in the history.
- *
- * Exported for testing purposes.
- */
-export function findIndexAfterFraction(
-  history: Content[],
-  fraction: number,
-): number {
-  if (fraction <= 0 || fraction >= 1) {
-    throw new Error('Fraction must be between 0 and 1');
-  }
-
-  const contentLengths = history.map(
-    (content) => JSON.stringify(content).length,
-  );
-
-  const totalCharacters = contentLengths.reduce(
-    (sum, length) => sum + length,
-    0,
-  );
-  const targetCharacters = totalCharacters * fraction;
-
-  let charactersSoFar = 0;
-  for (let i = 0; i < contentLengths.length; i++) {
-    charactersSoFar += contentLengths[i];
-    if (charactersSoFar >= targetCharacters) {
-      return i;
-    }
-  }
-  return contentLengths.length;
-}
+// Exported for testing purposes.
+export { findIndexAfterFraction } from './contextManager.js';
 
 const MAX_TURNS = 100;
 
@@ -111,6 +93,15 @@ const COMPRESSION_TOKEN_THRESHOLD = 0.7;
  */
 const COMPRESSION_PRESERVE_THRESHOLD = 0.3;
 
+/**
+ * Fraction of the compression threshold from which a rolling summary of the
+ * older history is kept up to date in the background after each turn.
+ */
+const ROLLING_SUMMARY_THRESHOLD = 0.7;
+
+const COMPRESSION_INSTRUCTION =
+  'First, reason in your scratchpad. Then, generate the <state_snapshot>.';
+
 export class GeminiClient {
   private chat?: GeminiChat;
   private contentGenerator?: ContentGenerator;
@@ -122,6 +113,7 @@ export class GeminiClient {
   private sessionTurnCount = 0;
 
   private readonly loopDetector: LoopDetectionService;
+  private readonly systemPromptCache = new SystemPromptCache();
   private lastPromptId: string;
   private lastSentIdeContext: IdeContext | undefined;
   private forceFullIdeContext = true;
@@ -132,9 +124,17 @@ export class GeminiClient {
    */
   private hasFailedCompressionAttempt = false;
 
+  private rollingSummary = new RollingSummary(
+    (contents, signal) => this.summarizeHistory(contents, signal),
+    COMPRESSION_PRESERVE_THRESHOLD,
+  );
+  /** Duration of the last full compression, to estimate stalls avoided. */
+  private lastFullCompressionMs: number | undefined;
+
   constructor(private readonly config: Config) {
     if (config.getProxy()) {
       setGlobalDispatcher(new ProxyAgent(config.getProxy() as string));
+      httpPool.configure({ proxy: config.getProxy() });
     }
 
     this.embeddingModel = config.getEmbeddingModel();
@@ -160,6 +160,14 @@ export class GeminiClient {
       extraHistory || [],
       contentGeneratorConfig.model,
     );
+    if (contentGeneratorConfig.baseUrl) {
+      // Runs in the background; the static token limits apply until it ends.
+      void discoverContextWindow(
+        contentGeneratorConfig.baseUrl,
+        contentGeneratorConfig.model,
+        { apiKey: contentGeneratorConfig.apiKey },
+      );
+    }
   }
 
   getContentGenerator(): ContentGenerator {
@@ -218,6 +226,7 @@ export class GeminiClient {
         })
       : history;
     this.getChat().setHistory(historyToSet);
+    this.rollingSummary.reset();
     this.forceFullIdeContext = true;
   }
 
@@ -269,8 +278,25 @@ export class GeminiClient {
     extraHistory?: Content[],
     model?: string,
   ): Promise<GeminiChat> {
+    this.resetChatState();
+    return this.createChat(extraHistory, model);
+  }
+
+  /** Resets the state tied to the history of the current chat. */
+  private resetChatState(): void {
     this.forceFullIdeContext = true;
     this.hasFailedCompressionAttempt = false;
+    this.rollingSummary.reset();
+  }
+
+  /**
+   * Builds a chat over `extraHistory` without touching the current one, so
+   * compression can discard it if it does not save tokens.
+   */
+  private async createChat(
+    extraHistory?: Content[],
+    model?: string,
+  ): Promise<GeminiChat> {
     const envParts = await getEnvironmentContext(this.config);
     const toolRegistry = this.config.getToolRegistry();
     const toolDeclarations = toolRegistry.getFunctionDeclarations();
@@ -287,12 +313,9 @@ export class GeminiClient {
       ...(extraHistory ?? []),
     ];
     try {
-      const userMemory = this.config.getUserMemory();
-      const systemInstruction = getCoreSystemPrompt(
-        userMemory,
-        {},
+      const systemInstruction = this.getSystemPrompt(
         model || this.config.getModel(),
-      );
+      ).text;
       const generateContentConfigWithThinking = isThinkingSupported(
         model || this.config.getModel(),
       )
@@ -325,6 +348,22 @@ export class GeminiClient {
     }
   }
 
+  /**
+   * Returns the memoized core system prompt for the current user memory and
+   * the given model.
+   */
+  private getSystemPrompt(model: string) {
+    return this.systemPromptCache.get(this.config.getUserMemory(), model);
+  }
+
+  /**
+   * Drops cached system prompts so the next request rebuilds them. Called
+   * when user memory or prompt-related settings are reloaded.
+   */
+  invalidateSystemPromptCache(): void {
+    this.systemPromptCache.invalidate();
+  }
+
   private getIdeContextParts(forceFullContext: boolean): {
     contextParts: string[];
     newIdeContext: IdeContext | undefined;
@@ -533,29 +572,31 @@ export class GeminiClient {
     if (sessionTokenLimit > 0) {
       // Get all the content that would be sent in an API call
       const currentHistory = this.getChat().getHistory(true);
-      const userMemory = this.config.getUserMemory();
-      const systemPrompt = getCoreSystemPrompt(
-        userMemory,
-        {},
+      const systemPromptTokens = await this.getSystemPrompt(
         this.config.getModel(),
-      );
+      ).getTokenCount();
       const environment = await getEnvironmentContext(this.config);
 
-      // Create a mock request content to count total tokens
+      // Create a mock request content to count total tokens. The system
+      // prompt is counted once per cache entry and added separately.
       const mockRequestContent = [
         {
-          role: 'system' as const,
-          parts: [{ text: systemPrompt }, ...environment],
+          role: 'user' as const,
+          parts: environment,
         },
         ...currentHistory,
       ];
 
       // Use the improved countTokens method for accurate counting
-      const { totalTokens: totalRequestTokens } =
+      const { totalTokens: contentTokens } =
         await this.getContentGenerator().countTokens({
           model: this.config.getModel(),
           contents: mockRequestContent,
         });
+      const totalRequestTokens =
+        contentTokens === undefined
+          ? undefined
+          : contentTokens + systemPromptTokens;
 
       if (
         totalRequestTokens !== undefined &&
@@ -649,6 +690,8 @@ export class GeminiClient {
       }
     }
     if (!turn.pendingToolCalls.length && signal && !signal.aborted) {
+      this.updateRollingSummary();
+
       // Check if model was switched during the call (likely due to quota error)
       const currentModel = this.config.getModel();
       if (currentModel !== initialModel) {
@@ -665,6 +708,7 @@ export class GeminiClient {
         this.getChat(),
         this,
         signal,
+        turn.finishReason,
       );
       logNextSpeakerCheck(
         this.config,
@@ -705,10 +749,12 @@ export class GeminiClient {
      */
     const modelToUse = this.config.getModel() || DEFAULT_GEMINI_FLASH_MODEL;
     try {
-      const userMemory = this.config.getUserMemory();
       const finalSystemInstruction = config.systemInstruction
-        ? getCustomSystemPrompt(config.systemInstruction, userMemory)
-        : getCoreSystemPrompt(userMemory, {}, modelToUse);
+        ? getCustomSystemPrompt(
+            config.systemInstruction,
+            this.config.getUserMemory(),
+          )
+        : this.getSystemPrompt(modelToUse).text;
 
       const requestConfig = {
         abortSignal,
@@ -788,6 +834,7 @@ export class GeminiClient {
     generationConfig: GenerateContentConfig,
     abortSignal: AbortSignal,
     model?: string,
+    promptId: string = this.lastPromptId,
   ): Promise<GenerateContentResponse> {
     const modelToUse = model ?? this.config.getModel();
     const configToUse: GenerateContentConfig = {
@@ -796,10 +843,12 @@ export class GeminiClient {
     };
 
     try {
-      const userMemory = this.config.getUserMemory();
       const finalSystemInstruction = generationConfig.systemInstruction
-        ? getCustomSystemPrompt(generationConfig.systemInstruction, userMemory)
-        : getCoreSystemPrompt(userMemory, {}, this.config.getModel());
+        ? getCustomSystemPrompt(
+            generationConfig.systemInstruction,
+            this.config.getUserMemory(),
+          )
+        : this.getSystemPrompt(this.config.getModel()).text;
 
       const requestConfig: GenerateContentConfig = {
         abortSignal,
@@ -814,7 +863,7 @@ export class GeminiClient {
             config: requestConfig,
             contents,
           },
-          this.lastPromptId,
+          promptId,
         );
 
       const result = await retryWithBackoff(apiCall, {
@@ -882,7 +931,7 @@ export class GeminiClient {
     prompt_id: string,
     force: boolean = false,
   ): Promise<ChatCompressionInfo> {
-    const curatedHistory = this.getChat().getHistory(true);
+    let curatedHistory = this.getChat().getHistory(true);
 
     // Regardless of `force`, don't do anything if the history is empty.
     if (
@@ -914,64 +963,131 @@ export class GeminiClient {
       };
     }
 
-    const contextPercentageThreshold =
-      this.config.getChatCompression()?.contextPercentageThreshold;
+    const chatCompression = this.config.getChatCompression();
+    let tokenCount = originalTokenCount;
 
     // Don't compress if not forced and we are under the limit.
     if (!force) {
       const threshold =
-        contextPercentageThreshold ?? COMPRESSION_TOKEN_THRESHOLD;
-      if (originalTokenCount < threshold * tokenLimit(model)) {
+        chatCompression?.contextPercentageThreshold ??
+        COMPRESSION_TOKEN_THRESHOLD;
+      const systemPromptTokens =
+        await this.getSystemPrompt(model).getTokenCount();
+      const baseUrl = this.config.getContentGeneratorConfig()?.baseUrl;
+      const historyBudget =
+        threshold * tokenLimit(model, 'input', baseUrl) - systemPromptTokens;
+      if (originalTokenCount < historyBudget) {
         return {
           originalTokenCount,
           newTokenCount: originalTokenCount,
           compressionStatus: CompressionStatus.NOOP,
         };
       }
+
+      // Cheaper tiers first; a full compression stalls the turn for a long
+      // summarization call and is only used when they do not free enough.
+      if (chatCompression?.pruneToolOutputs !== false) {
+        const pruned = pruneStaleToolOutputs(curatedHistory);
+        const prunedTokenCount =
+          pruned.prunedOutputs > 0
+            ? (
+                await this.getContentGenerator().countTokens({
+                  model,
+                  contents: pruned.history,
+                })
+              ).totalTokens
+            : undefined;
+        if (prunedTokenCount !== undefined && prunedTokenCount < tokenCount) {
+          this.getChat().setHistory(pruned.history);
+          curatedHistory = pruned.history;
+          const sufficient = prunedTokenCount < historyBudget;
+          this.logContextReduction(
+            'prune',
+            tokenCount,
+            prunedTokenCount,
+            sufficient ? (this.lastFullCompressionMs ?? 0) : undefined,
+          );
+          tokenCount = prunedTokenCount;
+          if (sufficient) {
+            return {
+              originalTokenCount,
+              newTokenCount: tokenCount,
+              compressionStatus: CompressionStatus.COMPRESSED,
+              tier: 'prune',
+            };
+          }
+        }
+      }
+
+      if (chatCompression?.rollingSummary !== false) {
+        const waitStartedAt = Date.now();
+        await this.rollingSummary.settle();
+        const waitedMs = Date.now() - waitStartedAt;
+        const summarized = this.rollingSummary.apply(curatedHistory);
+        if (summarized) {
+          const chat = await this.createChat(summarized.history);
+          const { totalTokens: summarizedTokenCount } =
+            await this.getContentGenerator().countTokens({
+              model,
+              contents: chat.getHistory(),
+            });
+          if (
+            summarizedTokenCount !== undefined &&
+            summarizedTokenCount < tokenCount
+          ) {
+            this.resetChatState();
+            this.chat = chat;
+            curatedHistory = chat.getHistory(true);
+            const sufficient = summarizedTokenCount < historyBudget;
+            this.logContextReduction(
+              'summary',
+              tokenCount,
+              summarizedTokenCount,
+              sufficient
+                ? Math.max(0, summarized.summarizeMs - waitedMs)
+                : undefined,
+            );
+            tokenCount = summarizedTokenCount;
+            if (sufficient) {
+              return {
+                originalTokenCount,
+                newTokenCount: tokenCount,
+                compressionStatus: CompressionStatus.COMPRESSED,
+                tier: 'summary',
+              };
+            }
+          }
+        }
+      }
     }
 
-    let compressBeforeIndex = findIndexAfterFraction(
+    const compressBeforeIndex = findCompressionSplitIndex(
       curatedHistory,
-      1 - COMPRESSION_PRESERVE_THRESHOLD,
+      COMPRESSION_PRESERVE_THRESHOLD,
     );
-    // Find the first user message after the index. This is the start of the next turn.
-    while (
-      compressBeforeIndex < curatedHistory.length &&
-      (curatedHistory[compressBeforeIndex]?.role === 'model' ||
-        isFunctionResponse(curatedHistory[compressBeforeIndex]))
-    ) {
-      compressBeforeIndex++;
-    }
-
     const historyToCompress = curatedHistory.slice(0, compressBeforeIndex);
     const historyToKeep = curatedHistory.slice(compressBeforeIndex);
 
     this.getChat().setHistory(historyToCompress);
 
+    const compressionStartedAt = Date.now();
     const { text: summary } = await this.getChat().sendMessage(
       {
         message: {
-          text: 'First, reason in your scratchpad. Then, generate the <state_snapshot>.',
+          text: COMPRESSION_INSTRUCTION,
         },
         config: {
           systemInstruction: { text: getCompressionPrompt() },
-          maxOutputTokens: originalTokenCount,
+          maxOutputTokens: tokenCount,
         },
       },
       prompt_id,
     );
-    const chat = await this.startChat([
-      {
-        role: 'user',
-        parts: [{ text: summary }],
-      },
-      {
-        role: 'model',
-        parts: [{ text: 'Got it. Thanks for the additional context!' }],
-      },
+    this.lastFullCompressionMs = Date.now() - compressionStartedAt;
+    const chat = await this.createChat([
+      ...summaryHistory(summary),
       ...historyToKeep,
     ]);
-    this.forceFullIdeContext = true;
 
     const { totalTokens: newTokenCount } =
       await this.getContentGenerator().countTokens({
@@ -981,24 +1097,19 @@ export class GeminiClient {
       });
     if (newTokenCount === undefined) {
       console.warn('Could not determine compressed history token count.');
+      // The history was left with the summary request, which the rolling
+      // summary does not cover.
+      this.rollingSummary.reset();
       this.hasFailedCompressionAttempt = !force && true;
       return {
         originalTokenCount,
-        newTokenCount: originalTokenCount,
+        newTokenCount: tokenCount,
         compressionStatus:
           CompressionStatus.COMPRESSION_FAILED_TOKEN_COUNT_ERROR,
       };
     }
 
-    logChatCompression(
-      this.config,
-      makeChatCompressionEvent({
-        tokens_before: originalTokenCount,
-        tokens_after: newTokenCount,
-      }),
-    );
-
-    if (newTokenCount > originalTokenCount) {
+    if (newTokenCount > tokenCount) {
       this.getChat().setHistory(curatedHistory);
       this.hasFailedCompressionAttempt = !force && true;
       return {
@@ -1008,24 +1119,84 @@ export class GeminiClient {
           CompressionStatus.COMPRESSION_FAILED_INFLATED_TOKEN_COUNT,
       };
     } else {
-      this.chat = chat; // Chat compression successful, set new state.
+      // Chat compression successful, set new state.
+      this.resetChatState();
+      this.chat = chat;
     }
 
-    logChatCompression(
-      this.config,
-      makeChatCompressionEvent({
-        tokens_before: originalTokenCount,
-        tokens_after: newTokenCount,
-      }),
-    );
+    this.logContextReduction('full', tokenCount, newTokenCount);
 
     return {
       originalTokenCount,
       newTokenCount,
       compressionStatus: CompressionStatus.COMPRESSED,
+      tier: 'full',
     };
   }
 
+  private logContextReduction(
+    tier: ContextReductionTier,
+    tokensBefore: number,
+    tokensAfter: number,
+    stallAvoidedMs?: number,
+  ): void {
+    logChatCompression(
+      this.config,
+      makeChatCompressionEvent({
+        tokens_before: tokensBefore,
+        tokens_after: tokensAfter,
+        tier,
+        stall_avoided_ms: stallAvoidedMs,
+      }),
+    );
+  }
+
+  /**
+   * Once the last prompt is past ROLLING_SUMMARY_THRESHOLD of the compression
+   * threshold, brings the rolling summary up to date in the background so a
+   * later compression can use it instead of summarizing on the spot.
+   */
+  private updateRollingSummary(): void {
+    const chatCompression = this.config.getChatCompression();
+    if (chatCompression?.rollingSummary === false) {
+      return;
+    }
+    const threshold =
+      chatCompression?.contextPercentageThreshold ??
+      COMPRESSION_TOKEN_THRESHOLD;
+    const limit = tokenLimit(
+      this.config.getModel(),
+      'input',
+      this.config.getContentGeneratorConfig()?.baseUrl,
+    );
+    if (
+      !limit ||
+      uiTelemetryService.getLastPromptTokenCount() <
+        ROLLING_SUMMARY_THRESHOLD * threshold * limit
+    ) {
+      return;
+    }
+    this.rollingSummary.update(this.getChat().getHistory(true));
+  }
+
+  private async summarizeHistory(
+    contents: Content[],
+    signal: AbortSignal,
+  ): Promise<string> {
+    const response = await this.generateContent(
+      [
+        ...contents,
+        { role: 'user', parts: [{ text: COMPRESSION_INSTRUCTION }] },
+      ],
+      { systemInstruction: { text: getCompressionPrompt() } },
+      signal,
+      undefined,
+      // Kept out of the prompt size that triggers compression.
+      internalPromptId(this.lastPromptId),
+    );
+    return getResponseText(response) ?? '';
+  }
+
   /**
    * Handles falling back to Flash model when persistent 429 errors occur for OAuth users.
    * Uses a fallback handler if provided by the config; otherwise, returns null.
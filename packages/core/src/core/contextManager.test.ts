@@ -0,0 +1,316 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import type { Content } from '@google/genai';
+import {
+  findCompressionSplitIndex,
+  pruneStaleToolOutputs,
+  RollingSummary,
+} from './contextManager.js';
+
+function prompt(text: string): Content {
+  return { role: 'user', parts: [{ text }] };
+}
+
+function reply(text: string): Content {
+  return { role: 'model', parts: [{ text }] };
+}
+
+function toolCall(
+  id: string,
+  name: string,
+  args: Record<string, unknown>,
+  response: Record<string, unknown>,
+): Content[] {
+  return [
+    { role: 'model', parts: [{ functionCall: { id, name, args } }] },
+    {
+      role: 'user',
+      parts: [{ functionResponse: { id, name, response } }],
+    },
+  ];
+}
+
+function outputOf(history: Content[], id: string): unknown {
+  for (const content of history) {
+    for (const part of content.parts ?? []) {
+      if (part.functionResponse?.id === id) {
+        return part.functionResponse.response?.['output'];
+      }
+    }
+  }
+  return undefined;
+}
+
+const fileContent = 'export const value = 1;\n'.repeat(100);
+const shellOutput = [
+  'Command: npm test',
+  'Directory: (root)',
+  `Output: ${'PASS test\n'.repeat(200)}`,
+  'Error: (none)',
+  'Exit Code: 0',
+].join('\n');
+
+describe('pruneStaleToolOutputs', () => {
+  it('should stub reads of files that were edited later', () => {
+    const history = [
+      prompt('Fix a.ts'),
+      ...toolCall(
+        'r1',
+        'read_file',
+        { absolute_path: '/a.ts' },
+        { output: fileContent },
+      ),
+      ...toolCall(
+        'e1',
+        'edit',
+        { file_path: '/a.ts' },
+        { output: 'Successfully modified file: /a.ts' },
+      ),
+      reply('Done.'),
+      prompt('Next'),
+      reply('Ok.'),
+      prompt('And then'),
+    ];
+
+    const result = pruneStaleToolOutputs(history);
+
+    expect(result.prunedOutputs).toBe(1);
+    expect(outputOf(result.history, 'r1')).toMatch(
+      /^\[Pruned: this output of \/a\.ts is stale because the file was modified later/,
+    );
+    expect(outputOf(result.history, 'e1')).toBe(
+      'Successfully modified file: /a.ts',
+    );
+    expect(result.tokensReclaimed).toBeGreaterThanOrEqual(500);
+    // The input is not modified.
+    expect(outputOf(history, 'r1')).toBe(fileContent);
+  });
+
+  it('should keep reads when the later edit failed', () => {
+    const history = [
+      prompt('Fix a.ts'),
+      ...toolCall(
+        'r1',
+        'read_file',
+        { absolute_path: '/a.ts' },
+        { output: fileContent },
+      ),
+      ...toolCall('e1', 'edit', { file_path: '/a.ts' }, { error: 'No match' }),
+      prompt('Next'),
+      reply('Ok.'),
+      prompt('And then'),
+    ];
+
+    const result = pruneStaleToolOutputs(history);
+
+    expect(result.prunedOutputs).toBe(0);
+    expect(result.history).toBe(history);
+  });
+
+  it('should stub long shell output from earlier turns, keeping its status', () => {
+    const history = [
+      prompt('Run the tests'),
+      ...toolCall(
+        's1',
+        'run_shell_command',
+        { command: 'npm test' },
+        { output: shellOutput },
+      ),
+      reply('They pass.'),
+      prompt('Next'),
+      reply('Ok.'),
+      prompt('And then'),
+    ];
+
+    const result = pruneStaleToolOutputs(history);
+
+    expect(outputOf(result.history, 's1')).toBe(
+      [
+        '[Pruned: the 205 lines of output of this earlier command were removed to save context. Run it again if the output is needed.]',
+        'Command: npm test',
+        'Directory: (root)',
+        'Error: (none)',
+        'Exit Code: 0',
+      ].join('\n'),
+    );
+  });
+
+  it('should leave the most recent turns untouched', () => {
+    const history = [
+      prompt('Earlier'),
+      reply('Ok.'),
+      prompt('Run the tests'),
+      ...toolCall(
+        's1',
+        'run_shell_command',
+        { command: 'npm test' },
+        { output: shellOutput },
+      ),
+      ...toolCall(
+        'r1',
+        'read_file',
+        { absolute_path: '/a.ts' },
+        { output: fileContent },
+      ),
+      ...toolCall(
+        'r2',
+        'read_file',
+        { absolute_path: '/a.ts' },
+        { output: fileContent },
+      ),
+      reply('Done.'),
+      prompt('Thanks'),
+    ];
+
+    expect(pruneStaleToolOutputs(history).prunedOutputs).toBe(0);
+  });
+
+  it('should not prune an output twice', () => {
+    const history = [
+      prompt('Run the tests'),
+      ...toolCall(
+        's1',
+        'run_shell_command',
+        { command: 'npm test' },
+        { output: shellOutput },
+      ),
+      prompt('Next'),
+      reply('Ok.'),
+      prompt('And then'),
+    ];
+
+    const once = pruneStaleToolOutputs(history);
+    const twice = pruneStaleToolOutputs(once.history);
+
+    expect(once.prunedOutputs).toBe(1);
+    expect(twice.prunedOutputs).toBe(0);
+  });
+});
+
+describe('findCompressionSplitIndex', () => {
+  it('should split at a user prompt, never between a call and its response', () => {
+    const history = [
+      prompt('a'.repeat(100)),
+      ...toolCall('s1', 'run_shell_command', {}, { output: 'b'.repeat(100) }),
+      reply('c'),
+      prompt('d'),
+      reply('e'),
+    ];
+
+    expect(findCompressionSplitIndex(history, 0.3)).toBe(4);
+  });
+});
+
+describe('RollingSummary', () => {
+  const history = [
+    prompt('first'),
+    reply('one'),
+    prompt('second '.repeat(50)),
+    reply('two '.repeat(50)),
+    prompt('third'),
+    reply('three'),
+  ];
+
+  it('should summarize the older history in the background and apply it', async () => {
+    const calls: Content[][] = [];
+    let now = 0;
+    const summary = new RollingSummary(
+      async (contents) => {
+        calls.push(contents);
+        now += 1500;
+        return 'Summary 1';
+      },
+      0.3,
+      () => now,
+    );
+
+    expect(summary.apply(history)).toBeUndefined();
+    summary.update(history);
+    await summary.settle();
+    const applied = summary.apply([...history, prompt('fourth')]);
+
+    expect(calls).toEqual([history.slice(0, 4)]);
+    expect(applied).toEqual({
+      history: [
+        prompt('Summary 1'),
+        reply('Got it. Thanks for the additional context!'),
+        prompt('third'),
+        reply('three'),
+        prompt('fourth'),
+      ],
+      summarizedCount: 4,
+      summarizeMs: 1500,
+    });
+  });
+
+  it('should only summarize new entries on top of the previous summary', async () => {
+    const calls: Content[][] = [];
+    const summary = new RollingSummary(async (contents) => {
+      calls.push(contents);
+      return `Summary ${calls.length}`;
+    }, 0.3);
+
+    summary.update(history);
+    await summary.settle();
+    const longer = [
+      ...history,
+      prompt('fourth'),
+      reply('four '.repeat(100)),
+      prompt('fifth'),
+      reply('five'),
+    ];
+    summary.update(longer);
+    await summary.settle();
+
+    expect(calls[1]).toEqual([
+      prompt('Summary 1'),
+      reply('Got it. Thanks for the additional context!'),
+      ...longer.slice(4, 8),
+    ]);
+    expect(summary.apply(longer)?.summarizedCount).toBe(8);
+  });
+
+  it('should discard a running update when reset', async () => {
+    let finish: (summary: string) => void = () => {};
+    let aborted = false;
+    const summary = new RollingSummary(
+      (_contents, signal) =>
+        new Promise<string>((resolve) => {
+          signal.addEventListener('abort', () => {
+            aborted = true;
+          });
+          finish = resolve;
+        }),
+      0.3,
+    );
+
+    summary.update(history);
+    summary.reset();
+    finish('Too late');
+    await summary.settle();
+
+    expect(aborted).toBe(true);
+    expect(summary.apply(history)).toBeUndefined();
+  });
+
+  it('should keep the previous summary when an update fails', async () => {
+    let fail = false;
+    const summary = new RollingSummary(async () => {
+      if (fail) throw new Error('server busy');
+      return 'Summary 1';
+    }, 0.3);
+
+    summary.update(history);
+    await summary.settle();
+    fail = true;
+    summary.update([...history, prompt('x '.repeat(500)), reply('y')]);
+    await summary.settle();
+
+    expect(summary.apply(history)?.history[0]).toEqual(prompt('Summary 1'));
+  });
+});
@@ -0,0 +1,363 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import type { Content, Part } from '@google/genai';
+import { ToolNames } from '../tools/tool-names.js';
+import { isFunctionResponse } from '../utils/messageInspectors.js';
+
+/**
+ * How a chat history was brought back under the compression threshold:
+ * - `prune`: stale tool outputs were replaced with stubs, without an LLM call.
+ * - `summary`: a summary kept up to date in the background replaced the
+ *   older part of the history.
+ * - `full`: the older part of the history was summarized on the spot.
+ */
+export type ContextReductionTier = 'prune' | 'summary' | 'full';
+
+const CHARS_PER_TOKEN = 4;
+/** User prompts, counted from the end, whose tool outputs are never pruned. */
+const PRESERVE_RECENT_TURNS = 2;
+/** Shell outputs shorter than this are cheaper to keep than to re-run. */
+const MIN_PRUNED_SHELL_OUTPUT_CHARS = 1000;
+const PRUNED_PREFIX = '[Pruned:';
+const SHELL_SUMMARY_LINE =
+  /^(?:Command|Directory|Error|Exit Code|Signal|Background PIDs):/;
+
+/**
+ * Returns the index of the content after the fraction of the total characters in the history.
+ */
+export function findIndexAfterFraction(
+  history: Content[],
+  fraction: number,
+): number {
+  if (fraction <= 0 || fraction >= 1) {
+    throw new Error('Fraction must be between 0 and 1');
+  }
+
+  const contentLengths = history.map(
+    (content) => JSON.stringify(content).length,
+  );
+
+  const totalCharacters = contentLengths.reduce(
+    (sum, length) => sum + length,
+    0,
+  );
+  const targetCharacters = totalCharacters * fraction;
+
+  let charactersSoFar = 0;
+  for (let i = 0; i < contentLengths.length; i++) {
+    charactersSoFar += contentLengths[i];
+    if (charactersSoFar >= targetCharacters) {
+      return i;
+    }
+  }
+  return contentLengths.length;
+}
+
+/**
+ * Returns the index of the first user prompt after the oldest
+ * `1 - preserveFraction` of the history. Everything before it can be replaced
+ * by a summary without separating a function call from its response.
+ */
+export function findCompressionSplitIndex(
+  history: Content[],
+  preserveFraction: number,
+): number {
+  let index = findIndexAfterFraction(history, 1 - preserveFraction);
+  while (
+    index < history.length &&
+    (history[index]?.role === 'model' || isFunctionResponse(history[index]))
+  ) {
+    index++;
+  }
+  return index;
+}
+
+/** The two entries that stand in for a summarized part of the history. */
+export function summaryHistory(summary: string): Content[] {
+  return [
+    {
+      role: 'user',
+      parts: [{ text: summary }],
+    },
+    {
+      role: 'model',
+      parts: [{ text: 'Got it. Thanks for the additional context!' }],
+    },
+  ];
+}
+
+export interface ToolOutputPruneResult {
+  history: Content[];
+  prunedOutputs: number;
+  /** Estimated number of tokens removed. */
+  tokensReclaimed: number;
+}
+
+interface ToolResponseRef {
+  contentIndex: number;
+  partIndex: number;
+  name: string;
+  args: Record<string, unknown>;
+  output: string | undefined;
+  failed: boolean;
+}
+
+function isUserPrompt(content: Content): boolean {
+  return content.role === 'user' && !isFunctionResponse(content);
+}
+
+// Index from which tool outputs belong to the turns that are kept verbatim.
+function findPreservedStart(history: Content[], turns: number): number {
+  let seen = 0;
+  for (let i = history.length - 1; i >= 0; i--) {
+    if (isUserPrompt(history[i]) && ++seen === turns) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+function collectToolResponses(history: Content[]): ToolResponseRef[] {
+  const calls = new Map<string, Record<string, unknown>>();
+  const responses: ToolResponseRef[] = [];
+  history.forEach((content, contentIndex) => {
+    content.parts?.forEach((part, partIndex) => {
+      if (part.functionCall?.id) {
+        calls.set(part.functionCall.id, part.functionCall.args ?? {});
+      }
+      const response = part.functionResponse;
+      if (response?.name && response.id && calls.has(response.id)) {
+        const output = response.response?.['output'];
+        responses.push({
+          contentIndex,
+          partIndex,
+          name: response.name,
+          args: calls.get(response.id)!,
+          output: typeof output === 'string' ? output : undefined,
+          failed: response.response?.['error'] !== undefined,
+        });
+      }
+    });
+  });
+  return responses;
+}
+
+function isSameRead(a: ToolResponseRef, b: ToolResponseRef): boolean {
+  return (
+    a.args['absolute_path'] === b.args['absolute_path'] &&
+    a.args['offset'] === b.args['offset'] &&
+    a.args['limit'] === b.args['limit']
+  );
+}
+
+// Why a read_file output no longer reflects the file, if it does not.
+function supersededBy(
+  read: ToolResponseRef,
+  later: ToolResponseRef[],
+): string | undefined {
+  const path = read.args['absolute_path'];
+  for (const response of later) {
+    if (response.failed) continue;
+    if (
+      (response.name === ToolNames.EDIT ||
+        response.name === ToolNames.WRITE_FILE) &&
+      response.args['file_path'] === path
+    ) {
+      return 'the file was modified later';
+    }
+    if (response.name === ToolNames.READ_FILE && isSameRead(read, response)) {
+      return 'the file was read again later';
+    }
+  }
+  return undefined;
+}
+
+function shellStub(output: string): string {
+  const lines = output.split('\n');
+  const kept = lines.filter((line) => SHELL_SUMMARY_LINE.test(line));
+  return [
+    `${PRUNED_PREFIX} the ${lines.length} lines of output of this earlier command were removed to save context. Run it again if the output is needed.]`,
+    ...kept,
+  ].join('\n');
+}
+
+/**
+ * Tier 1 of context management: replaces tool outputs that no longer carry
+ * information with short stubs, at no LLM cost. A read_file output is stale
+ * once the file was edited, rewritten or read again the same way, and long
+ * shell output from earlier turns is reduced to its command and exit status.
+ * Tool outputs of the most recent turns are left untouched.
+ */
+export function pruneStaleToolOutputs(
+  history: Content[],
+  preserveRecentTurns: number = PRESERVE_RECENT_TURNS,
+): ToolOutputPruneResult {
+  const preservedStart = findPreservedStart(history, preserveRecentTurns);
+  const responses = collectToolResponses(history);
+  const stubs = new Map<ToolResponseRef, string>();
+
+  responses.forEach((response, index) => {
+    const { output } = response;
+    if (
+      response.contentIndex >= preservedStart ||
+      output === undefined ||
+      output.startsWith(PRUNED_PREFIX) ||
+      response.failed
+    ) {
+      return;
+    }
+    if (response.name === ToolNames.READ_FILE) {
+      const reason = supersededBy(response, responses.slice(index + 1));
+      if (reason) {
+        stubs.set(
+          response,
+          `${PRUNED_PREFIX} this output of ${response.args['absolute_path']} is stale because ${reason}. Read the file again if its current content is needed.]`,
+        );
+      }
+    } else if (
+      response.name === ToolNames.SHELL &&
+      output.length >= MIN_PRUNED_SHELL_OUTPUT_CHARS
+    ) {
+      stubs.set(response, shellStub(output));
+    }
+  });
+
+  let prunedOutputs = 0;
+  let reclaimedChars = 0;
+  const pruned = [...history];
+  for (const [response, stub] of stubs) {
+    if (stub.length >= response.output!.length) continue;
+    prunedOutputs++;
+    reclaimedChars += response.output!.length - stub.length;
+    const content = pruned[response.contentIndex];
+    const parts = [...(content.parts ?? [])];
+    const part = parts[response.partIndex];
+    parts[response.partIndex] = {
+      ...part,
+      functionResponse: {
+        ...part.functionResponse,
+        response: { ...part.functionResponse!.response, output: stub },
+      },
+    } as Part;
+    pruned[response.contentIndex] = { ...content, parts };
+  }
+
+  return {
+    history: prunedOutputs > 0 ? pruned : history,
+    prunedOutputs,
+    tokensReclaimed: Math.round(reclaimedChars / CHARS_PER_TOKEN),
+  };
+}
+
+export type HistorySummarizer = (
+  contents: Content[],
+  signal: AbortSignal,
+) => Promise<string>;
+
+export interface RollingSummaryResult {
+  history: Content[];
+  /** Number of history entries the summary replaced. */
+  summarizedCount: number;
+  /** Time the summary took to produce in the background. */
+  summarizeMs: number;
+}
+
+/**
+ * Tier 2 of context management: keeps a summary of the older part of the
+ * history up to date in the background. Each update only summarizes the
+ * entries added since the previous one, on top of the previous summary, so
+ * that compression can later swap in the result without blocking the turn.
+ */
+export class RollingSummary {
+  private summary: string | undefined;
+  private coveredCount = 0;
+  private summarizeMs = 0;
+  private pending: Promise<void> | undefined;
+  private controller: AbortController | undefined;
+
+  constructor(
+    private readonly summarize: HistorySummarizer,
+    private readonly preserveFraction: number,
+    private readonly now: () => number = Date.now,
+  ) {}
+
+  /**
+   * Starts summarizing the part of `history` that is not covered yet, unless
+   * an update is already running. `history` must extend the history passed
+   * to earlier calls; call reset() whenever it is replaced.
+   */
+  update(history: Content[]): void {
+    if (this.pending) return;
+    const splitIndex = findCompressionSplitIndex(
+      history,
+      this.preserveFraction,
+    );
+    if (splitIndex <= this.coveredCount || splitIndex >= history.length) {
+      return;
+    }
+
+    const contents = [
+      ...(this.summary ? summaryHistory(this.summary) : []),
+      ...history.slice(this.coveredCount, splitIndex),
+    ];
+    const controller = new AbortController();
+    const startedAt = this.now();
+    const pending = this.summarize(contents, controller.signal)
+      .then(
+        (summary) => {
+          if (this.controller !== controller || !summary.trim()) return;
+          this.summary = summary;
+          this.coveredCount = splitIndex;
+          this.summarizeMs += this.now() - startedAt;
+        },
+        () => {
+          // A failed update is retried after the next turn.
+        },
+      )
+      .finally(() => {
+        if (this.controller === controller) {
+          this.pending = undefined;
+          this.controller = undefined;
+        }
+      });
+    this.controller = controller;
+    this.pending = pending;
+  }
+
+  /** Waits for a running update, if any. */
+  async settle(): Promise<void> {
+    await this.pending;
+  }
+
+  /**
+   * Returns `history` with its summarized part replaced by the summary, or
+   * undefined if nothing has been summarized yet.
+   */
+  apply(history: Content[]): RollingSummaryResult | undefined {
+    if (!this.summary || this.coveredCount > history.length) {
+      return undefined;
+    }
+    return {
+      history: [
+        ...summaryHistory(this.summary),
+        ...history.slice(this.coveredCount),
+      ],
+      summarizedCount: this.coveredCount,
+      summarizeMs: this.summarizeMs,
+    };
+  }
+
+  /** Drops the summary and cancels any running update. */
+  reset(): void {
+    this.controller?.abort();
+    this.controller = undefined;
+    this.pending = undefined;
+    this.summary = undefined;
+    this.coveredCount = 0;
+    this.summarizeMs = 0;
+  }
+}
@@ -0,0 +1,192 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, describe, expect, it } from 'vitest';
+import type { ProbeFetch } from './contextWindowProbe.js';
+import {
+  clearContextWindowCache,
+  discoverContextWindow,
+  probeContextWindow,
+} from './contextWindowProbe.js';
+import { tokenLimit } from './tokenLimits.js';
+
+const BASE_URL = 'http://localhost:8087/v1';
+const MODEL = 'qwen3-4b';
+
+function fakeFetch(responses: Record<string, unknown>) {
+  const requested: string[] = [];
+  const fetch: ProbeFetch = async (url) => {
+    requested.push(url);
+    const body = responses[url];
+    return {
+      ok: body !== undefined,
+      json: async () => body,
+    };
+  };
+  return { fetch, requested };
+}
+
+describe('probeContextWindow', () => {
+  afterEach(() => {
+    clearContextWindowCache();
+  });
+
+  it('should read the allocated context from llama.cpp /props', async () => {
+    const { fetch, requested } = fakeFetch({
+      'http://localhost:8087/props': {
+        default_generation_settings: { n_ctx: 8192, n_predict: -1 },
+        n_ctx_train: 40960,
+      },
+    });
+
+    const window = await probeContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(window).toEqual({
+      input: 8192,
+      output: undefined,
+      source: 'http://localhost:8087/props',
+    });
+    expect(requested).toEqual([
+      `${BASE_URL}/models/${MODEL}`,
+      `${BASE_URL}/models`,
+      'http://localhost:8087/props',
+    ]);
+  });
+
+  it('should pick the matching entry of a model list', async () => {
+    const { fetch } = fakeFetch({
+      [`${BASE_URL}/models`]: {
+        data: [
+          { id: 'other', max_model_len: 4096 },
+          { id: MODEL, max_model_len: 32768, max_output_tokens: 65536 },
+        ],
+      },
+    });
+
+    const window = await probeContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(window).toEqual({
+      input: 32768,
+      output: 32768,
+      source: `${BASE_URL}/models`,
+    });
+  });
+
+  it('should cache found limits per server and model', async () => {
+    const { fetch, requested } = fakeFetch({
+      [`${BASE_URL}/models/${MODEL}`]: { context_length: 16384 },
+    });
+
+    await probeContextWindow(BASE_URL, MODEL, { fetch });
+    const probed = requested.length;
+    await probeContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(probed).toBe(3);
+    expect(requested).toHaveLength(probed);
+  });
+
+  it('should prefer n_ctx from /props over n_ctx_train', async () => {
+    const { fetch } = fakeFetch({
+      [`${BASE_URL}/models`]: {
+        data: [{ id: MODEL, meta: { n_ctx_train: 40960 } }],
+      },
+      'http://localhost:8087/props': {
+        default_generation_settings: { n_ctx: 4096 },
+      },
+    });
+
+    const window = await probeContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(window).toEqual({
+      input: 4096,
+      output: undefined,
+      source: 'http://localhost:8087/props',
+    });
+  });
+
+  it('should stop probing once the allocated context is found', async () => {
+    const { fetch, requested } = fakeFetch({
+      [`${BASE_URL}/models/${MODEL}`]: { n_ctx: 8192 },
+    });
+
+    const window = await probeContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(window?.input).toBe(8192);
+    expect(requested).toHaveLength(1);
+  });
+
+  it('should probe again after a failed probe', async () => {
+    const { fetch, requested } = fakeFetch({});
+
+    expect(await probeContextWindow(BASE_URL, MODEL, { fetch })).toBe(
+      undefined,
+    );
+    await probeContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(requested).toHaveLength(6);
+  });
+});
+
+describe('discoverContextWindow', () => {
+  afterEach(() => {
+    clearContextWindowCache();
+  });
+
+  it('should make tokenLimit use the discovered limits', async () => {
+    const { fetch } = fakeFetch({
+      [`${BASE_URL}/models/${MODEL}`]: {
+        id: MODEL,
+        context_length: 16384,
+        max_completion_tokens: 4096,
+      },
+    });
+
+    await discoverContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(tokenLimit(MODEL, 'input', BASE_URL)).toBe(16384);
+    expect(tokenLimit(MODEL, 'output', BASE_URL)).toBe(4096);
+  });
+
+  it('should apply discovered limits only to the server that reported them', async () => {
+    const staticLimit = tokenLimit(MODEL);
+    const { fetch } = fakeFetch({
+      [`${BASE_URL}/models/${MODEL}`]: { context_length: 16384 },
+    });
+
+    await discoverContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(tokenLimit(MODEL)).toBe(staticLimit);
+    expect(tokenLimit(MODEL, 'input', 'http://localhost:9000/v1')).toBe(
+      staticLimit,
+    );
+  });
+
+  it('should probe a restarted server again', async () => {
+    const responses: Record<string, unknown> = {
+      [`${BASE_URL}/models/${MODEL}`]: { context_length: 16384 },
+    };
+    const { fetch } = fakeFetch(responses);
+    await discoverContextWindow(BASE_URL, MODEL, { fetch });
+
+    responses[`${BASE_URL}/models/${MODEL}`] = { context_length: 4096 };
+    // The server manager addresses the same server by its loopback IP.
+    clearContextWindowCache('http://127.0.0.1:8087');
+    await probeContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(tokenLimit(MODEL, 'input', BASE_URL)).toBe(4096);
+  });
+
+  it('should keep the static limits when the server reports none', async () => {
+    const staticLimit = tokenLimit(MODEL);
+    const { fetch } = fakeFetch({
+      [`${BASE_URL}/models`]: { data: [{ id: MODEL }] },
+    });
+
+    await discoverContextWindow(BASE_URL, MODEL, { fetch });
+
+    expect(tokenLimit(MODEL, 'input', BASE_URL)).toBe(staticLimit);
+  });
+});
@@ -0,0 +1,241 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { httpPool } from '../utils/httpPool.js';
+import { setDiscoveredTokenLimits } from './tokenLimits.js';
+
+const PROBE_TIMEOUT_MS = 3000;
+/** Objects are searched this many levels deep for limit fields. */
+const MAX_SEARCH_DEPTH = 4;
+
+/**
+ * Fields that carry the context length, most authoritative first: the size
+ * the server actually allocated, then what the model was registered or
+ * trained with.
+ */
+const CONTEXT_FIELDS = [
+  'n_ctx',
+  'ctx_size',
+  'context_size',
+  'max_model_len',
+  'context_length',
+  'context_window',
+  'max_context_length',
+  'n_ctx_train',
+];
+const OUTPUT_FIELDS = ['max_output_tokens', 'max_completion_tokens', 'n_predict'];
+
+export interface ContextWindow {
+  /** Context length in tokens. */
+  input?: number;
+  /** Maximum tokens per response. */
+  output?: number;
+  /** The URL the limits were read from. */
+  source: string;
+}
+
+export type ProbeFetch = (
+  url: string,
+  init: RequestInit,
+) => Promise<Pick<Response, 'ok' | 'json'>>;
+
+export interface ProbeOptions {
+  apiKey?: string;
+  fetch?: ProbeFetch;
+  timeoutMs?: number;
+}
+
+const probes = new Map<string, Promise<ContextWindow | undefined>>();
+/** Discoveries applied to tokenLimit(), so they can be redone on a restart. */
+const discoveries = new Map<
+  string,
+  { baseUrl: string; model: string; options: ProbeOptions }
+>();
+
+function asTokenCount(value: unknown): number | undefined {
+  const count = typeof value === 'string' ? Number(value) : value;
+  return typeof count === 'number' && Number.isInteger(count) && count > 0
+    ? count
+    : undefined;
+}
+
+interface FieldMatch {
+  count: number;
+  /** Index of the matched field; lower is more authoritative. */
+  rank: number;
+}
+
+// Fields are tried in priority order; each is searched breadth-first, so a
+// top-level occurrence wins over one nested deeper.
+function findField(root: unknown, fields: string[]): FieldMatch | undefined {
+  for (const [rank, field] of fields.entries()) {
+    let level: unknown[] = [root];
+    for (let depth = 0; depth < MAX_SEARCH_DEPTH && level.length > 0; depth++) {
+      const objects = level.filter(
+        (value): value is Record<string, unknown> =>
+          typeof value === 'object' && value !== null && !Array.isArray(value),
+      );
+      for (const object of objects) {
+        const count = asTokenCount(object[field]);
+        if (count !== undefined) return { count, rank };
+      }
+      level = objects.flatMap((object) => Object.values(object));
+    }
+  }
+  return undefined;
+}
+
+// Picks the entry for `model` out of an OpenAI-style model list.
+function findModelEntry(body: unknown, model: string): unknown {
+  const list = (body as { data?: unknown } | null)?.data ?? body;
+  if (!Array.isArray(list)) return body;
+  return list.find((entry) => {
+    const { id, model_id, name } = (entry ?? {}) as Record<string, unknown>;
+    return id === model || model_id === model || name === model;
+  });
+}
+
+function candidateUrls(baseUrl: string, model: string): string[] {
+  const base = baseUrl.replace(/\/+$/, '');
+  const urls = [`${base}/models/${encodeURIComponent(model)}`, `${base}/models`];
+  try {
+    // llama.cpp based servers report the allocated context on /props.
+    urls.push(new URL('/props', base).toString());
+  } catch {
+    // Not an absolute URL; only the model endpoints are tried.
+  }
+  return urls;
+}
+
+async function runProbe(
+  baseUrl: string,
+  model: string,
+  options: ProbeOptions,
+): Promise<ContextWindow | undefined> {
+  const fetchFn = options.fetch ?? (httpPool.fetch as ProbeFetch);
+  const headers: Record<string, string> = { Accept: 'application/json' };
+  if (options.apiKey) {
+    headers['Authorization'] = `Bearer ${options.apiKey}`;
+  }
+
+  // Endpoints report different fields (llama.cpp lists n_ctx_train on
+  // /models but the allocated n_ctx only on /props), so the field priority
+  // applies across all of them; the first endpoint wins a tie.
+  let input: (FieldMatch & { source: string }) | undefined;
+  let output: FieldMatch | undefined;
+  for (const url of candidateUrls(baseUrl, model)) {
+    let body: unknown;
+    try {
+      const response = await fetchFn(url, {
+        headers,
+        signal: AbortSignal.timeout(options.timeoutMs ?? PROBE_TIMEOUT_MS),
+      });
+      if (!response.ok) continue;
+      body = await response.json();
+    } catch {
+      continue;
+    }
+    const entry = url.endsWith('/models') ? findModelEntry(body, model) : body;
+    const foundOutput = findField(entry, OUTPUT_FIELDS);
+    if (foundOutput && (!output || foundOutput.rank < output.rank)) {
+      output = foundOutput;
+    }
+    const foundInput = findField(entry, CONTEXT_FIELDS);
+    if (foundInput && (!input || foundInput.rank < input.rank)) {
+      input = { ...foundInput, source: url };
+    }
+    if (input?.rank === 0) break;
+  }
+  if (!input) return undefined;
+  return {
+    input: input.count,
+    // A response cannot be longer than the context it is generated in.
+    output: output && Math.min(output.count, input.count),
+    source: input.source,
+  };
+}
+
+/**
+ * Asks the server behind `baseUrl` how large the context window of `model`
+ * is, trying the OpenAI-style model endpoints and llama.cpp's /props. Found
+ * limits are cached per (baseUrl, model); a failed probe is retried on the
+ * next call, since a local server may still have been loading the model.
+ */
+export function probeContextWindow(
+  baseUrl: string,
+  model: string,
+  options: ProbeOptions = {},
+): Promise<ContextWindow | undefined> {
+  const key = `${baseUrl}\n${model}`;
+  let probe = probes.get(key);
+  if (!probe) {
+    probe = runProbe(baseUrl, model, options).then((window) => {
+      if (!window) probes.delete(key);
+      return window;
+    });
+    probes.set(key, probe);
+  }
+  return probe;
+}
+
+/**
+ * Probes the context window of `model` and makes tokenLimit() use it for
+ * requests to `baseUrl`. The static tables stay in effect when the server
+ * does not report one.
+ */
+export async function discoverContextWindow(
+  baseUrl: string,
+  model: string,
+  options: ProbeOptions = {},
+): Promise<ContextWindow | undefined> {
+  discoveries.set(`${baseUrl}\n${model}`, { baseUrl, model, options });
+  const window = await probeContextWindow(baseUrl, model, options);
+  setDiscoveredTokenLimits(
+    baseUrl,
+    model,
+    window && { input: window.input, output: window.output },
+  );
+  return window;
+}
+
+function originOf(url: string): string | undefined {
+  try {
+    const parsed = new URL(url);
+    // Loopback aliases refer to the same local server.
+    const host =
+      parsed.hostname === 'localhost' ? '127.0.0.1' : parsed.hostname;
+    return `${parsed.protocol}//${host}:${parsed.port}`;
+  } catch {
+    return undefined;
+  }
+}
+
+/**
+ * Forgets cached probe results for the server at `serverUrl`, e.g. after it
+ * was restarted with another context size, and probes the models discovered
+ * there again; their previous limits apply until that finishes. Without a
+ * `serverUrl`, every result and discovered limit is forgotten.
+ */
+export function clearContextWindowCache(serverUrl?: string): void {
+  if (serverUrl === undefined) {
+    probes.clear();
+    for (const discovery of discoveries.values()) {
+      setDiscoveredTokenLimits(discovery.baseUrl, discovery.model, undefined);
+    }
+    discoveries.clear();
+    return;
+  }
+  const origin = originOf(serverUrl);
+  for (const [key, discovery] of discoveries) {
+    if (originOf(discovery.baseUrl) !== origin) continue;
+    probes.delete(key);
+    void discoverContextWindow(
+      discovery.baseUrl,
+      discovery.model,
+      discovery.options,
+    );
+  }
+}
@@ -30,7 +30,8 @@ import os from 'node:os';
 
 const GEMINI_DIR_NAME = '.kolosal';
 const TMP_DIR_NAME = 'tmp';
-const LOG_FILE_NAME = 'logs.json';
+const LOG_FILE_NAME = 'logs.jsonl';
+const LEGACY_LOG_FILE_NAME = 'logs.json';
 const CHECKPOINT_FILE_NAME = 'checkpoint.json';
 
 const projectDir = process.cwd();
@@ -43,11 +44,22 @@ const TEST_GEMINI_DIR = path.join(
 );
 
 const TEST_LOG_FILE_PATH = path.join(TEST_GEMINI_DIR, LOG_FILE_NAME);
+const TEST_LEGACY_LOG_FILE_PATH = path.join(
+  TEST_GEMINI_DIR,
+  LEGACY_LOG_FILE_NAME,
+);
 const TEST_CHECKPOINT_FILE_PATH = path.join(
   TEST_GEMINI_DIR,
   CHECKPOINT_FILE_NAME,
 );
 
+async function writeLogFile(entries: LogEntry[]): Promise<void> {
+  await fs.writeFile(
+    TEST_LOG_FILE_PATH,
+    entries.map((entry) => JSON.stringify(entry) + '\n').join(''),
+  );
+}
+
 async function cleanupLogAndCheckpointFiles() {
   try {
     await fs.rm(TEST_GEMINI_DIR, { recursive: true, force: true });
@@ -59,7 +71,10 @@ async function cleanupLogAndCheckpointFiles() {
 async function readLogFile(): Promise<LogEntry[]> {
   try {
     const content = await fs.readFile(TEST_LOG_FILE_PATH, 'utf-8');
-    return JSON.parse(content) as LogEntry[];
+    return content
+      .split('\n')
+      .filter((line) => line !== '')
+      .map((line) => JSON.parse(line) as LogEntry);
   } catch (error) {
     if ((error as NodeJS.ErrnoException).code === 'ENOENT') {
       return [];
@@ -147,10 +162,7 @@ describe('Logger', () => {
           message: 'Msg2',
         },
       ];
-      await fs.writeFile(
-        TEST_LOG_FILE_PATH,
-        JSON.stringify(existingLogs, null, 2),
-      );
+      await writeLogFile(existingLogs);
       const newLogger = new Logger(
         currentSessionId,
         new Storage(process.cwd()),
@@ -171,10 +183,7 @@ describe('Logger', () => {
           message: 'OldMsg',
         },
       ];
-      await fs.writeFile(
-        TEST_LOG_FILE_PATH,
-        JSON.stringify(existingLogs, null, 2),
-      );
+      await writeLogFile(existingLogs);
       const newLogger = new Logger('a-new-session', new Storage(process.cwd()));
       await newLogger.initialize();
       expect(newLogger['messageId']).toBe(0);
@@ -194,8 +203,9 @@ describe('Logger', () => {
       expect(logsFromFile.length).toBe(1);
     });
 
-    it('should handle invalid JSON in log file by backing it up and starting fresh', async () => {
-      await fs.writeFile(TEST_LOG_FILE_PATH, 'invalid json');
+    it('should handle invalid JSON in a legacy log file by backing it up and starting fresh', async () => {
+      await fs.rm(TEST_LOG_FILE_PATH);
+      await fs.writeFile(TEST_LEGACY_LOG_FILE_PATH, 'invalid json');
       const consoleDebugSpy = vi
         .spyOn(console, 'debug')
         .mockImplementation(() => {});
@@ -213,15 +223,17 @@ describe('Logger', () => {
       expect(
         dirContents.some(
           (f) =>
-            f.startsWith(LOG_FILE_NAME + '.invalid_json') && f.endsWith('.bak'),
+            f.startsWith(LEGACY_LOG_FILE_NAME + '.invalid_json') &&
+            f.endsWith('.bak'),
         ),
       ).toBe(true);
       newLogger.close();
     });
 
-    it('should handle non-array JSON in log file by backing it up and starting fresh', async () => {
+    it('should handle non-array JSON in a legacy log file by backing it up and starting fresh', async () => {
+      await fs.rm(TEST_LOG_FILE_PATH);
       await fs.writeFile(
-        TEST_LOG_FILE_PATH,
+        TEST_LEGACY_LOG_FILE_PATH,
         JSON.stringify({ not: 'an array' }),
       );
       const consoleDebugSpy = vi
@@ -232,7 +244,7 @@ describe('Logger', () => {
       await newLogger.initialize();
 
       expect(consoleDebugSpy).toHaveBeenCalledWith(
-        `Log file at ${TEST_LOG_FILE_PATH} is not a valid JSON array. Starting with empty logs.`,
+        `Log file at ${TEST_LEGACY_LOG_FILE_PATH} is not a valid JSON array. Starting with empty logs.`,
       );
       const logContent = await readLogFile();
       expect(logContent).toEqual([]);
@@ -240,7 +252,7 @@ describe('Logger', () => {
       expect(
         dirContents.some(
           (f) =>
-            f.startsWith(LOG_FILE_NAME + '.malformed_array') &&
+            f.startsWith(LEGACY_LOG_FILE_NAME + '.malformed_array') &&
             f.endsWith('.bak'),
         ),
       ).toBe(true);
@@ -248,6 +260,72 @@ describe('Logger', () => {
     });
   });
 
+  describe('log file format', () => {
+    const entry = (message: string, messageId = 0): LogEntry => ({
+      sessionId: 'old-session',
+      messageId,
+      timestamp: new Date('2025-01-01T10:00:00.000Z').toISOString(),
+      type: MessageSenderType.USER,
+      message,
+    });
+
+    it('should carry over the entries of a legacy JSON log', async () => {
+      await fs.rm(TEST_LOG_FILE_PATH);
+      const legacyLogs = [entry('Legacy 1', 0), entry('Legacy 2', 1)];
+      await fs.writeFile(
+        TEST_LEGACY_LOG_FILE_PATH,
+        JSON.stringify(legacyLogs, null, 2),
+      );
+
+      const newLogger = new Logger('old-session', new Storage(process.cwd()));
+      await newLogger.initialize();
+
+      expect(await readLogFile()).toEqual(legacyLogs);
+      expect(newLogger['messageId']).toBe(2);
+      expect(existsSync(TEST_LEGACY_LOG_FILE_PATH)).toBe(true);
+      newLogger.close();
+    });
+
+    it('should append one line per message without rewriting the file', async () => {
+      await logger.logMessage(MessageSenderType.USER, 'First');
+      const before = await fs.readFile(TEST_LOG_FILE_PATH, 'utf-8');
+      await logger.logMessage(MessageSenderType.USER, 'Second');
+      const after = await fs.readFile(TEST_LOG_FILE_PATH, 'utf-8');
+
+      expect(after.startsWith(before)).toBe(true);
+      expect(after.split('\n')).toHaveLength(3);
+    });
+
+    it('should skip lines that cannot be parsed', async () => {
+      await fs.writeFile(
+        TEST_LOG_FILE_PATH,
+        JSON.stringify(entry('Kept')) + '\n{"sessionId": "torn',
+      );
+
+      const newLogger = new Logger(testSessionId, new Storage(process.cwd()));
+      await newLogger.initialize();
+
+      expect(await newLogger.getPreviousUserMessages()).toEqual(['Kept']);
+      newLogger.close();
+    });
+
+    it('should only load the most recent user messages', async () => {
+      const entries = Array.from({ length: 1005 }, (_, i) =>
+        entry(`Message ${i}`, i),
+      );
+      await writeLogFile(entries);
+
+      const newLogger = new Logger(testSessionId, new Storage(process.cwd()));
+      await newLogger.initialize();
+      const messages = await newLogger.getPreviousUserMessages();
+
+      expect(messages).toHaveLength(1000);
+      expect(messages).toContain('Message 1004');
+      expect(messages).not.toContain('Message 4');
+      newLogger.close();
+    });
+  });
+
   describe('logMessage', () => {
     it('should append a message to the log file and update in-memory logs', async () => {
       await logger.logMessage(MessageSenderType.USER, 'Hello, world!');
@@ -338,7 +416,7 @@ describe('Logger', () => {
     });
 
     it('should not throw, not increment messageId, and log error if writing to file fails', async () => {
-      vi.spyOn(fs, 'writeFile').mockRejectedValueOnce(new Error('Disk full'));
+      vi.spyOn(fs, 'appendFile').mockRejectedValueOnce(new Error('Disk full'));
       const consoleDebugSpy = vi
         .spyOn(console, 'debug')
         .mockImplementation(() => {});
@@ -443,7 +521,30 @@ describe('Logger', () => {
         `checkpoint-${encodedTag}.json`,
       );
       const fileContent = await fs.readFile(taggedFilePath, 'utf-8');
-      expect(JSON.parse(fileContent)).toEqual(conversation);
+      expect(JSON.parse(fileContent)).toEqual({
+        version: 2,
+        conversation: { blobs: [expect.any(String), expect.any(String)] },
+      });
+      expect(await logger.loadCheckpoint(tag)).toEqual(conversation);
+    });
+
+    it('should store messages shared between checkpoints once', async () => {
+      const longer: Content[] = [
+        ...conversation,
+        { role: 'user', parts: [{ text: 'And then?' }] },
+      ];
+      await logger.saveCheckpoint(conversation, 'first');
+      await logger.saveCheckpoint(longer, 'second');
+
+      const objectsDir = path.join(TEST_GEMINI_DIR, 'checkpoint-objects');
+      const shards = await fs.readdir(objectsDir);
+      const blobs = (
+        await Promise.all(
+          shards.map((shard) => fs.readdir(path.join(objectsDir, shard))),
+        )
+      ).flat();
+      expect(blobs).toHaveLength(3);
+      expect(await logger.loadCheckpoint('second')).toEqual(longer);
     });
 
     it('should not throw if logger is not initialized', async () => {
@@ -772,8 +873,7 @@ describe('Logger', () => {
       await logger.logModelSwitch(modelSwitchEvent);
 
       // Read the log file to verify the entry was written
-      const logContent = await fs.readFile(TEST_LOG_FILE_PATH, 'utf-8');
-      const logs: LogEntry[] = JSON.parse(logContent);
+      const logs = await readLogFile();
 
       const modelSwitchLog = logs.find(
         (log) =>
@@ -815,8 +915,7 @@ describe('Logger', () => {
       });
 
       // Read the log file to verify both entries were written
-      const logContent = await fs.readFile(TEST_LOG_FILE_PATH, 'utf-8');
-      const logs: LogEntry[] = JSON.parse(logContent);
+      const logs = await readLogFile();
 
       const modelSwitchLogs = logs.filter(
         (log) =>
@@ -8,8 +8,18 @@ import path from 'node:path';
 import { promises as fs } from 'node:fs';
 import type { Content } from '@google/genai';
 import type { Storage } from '../config/storage.js';
-
-const LOG_FILE_NAME = 'logs.json';
+import type { CheckpointGcResult } from '../services/checkpointStore.js';
+import { CheckpointStore } from '../services/checkpointStore.js';
+
+const LOG_FILE_NAME = 'logs.jsonl';
+/** Where the messages of saved conversations are stored, once each. */
+const CHECKPOINT_OBJECTS_DIR_NAME = 'checkpoint-objects';
+/** The pretty-printed JSON array the log was kept in before. */
+const LEGACY_LOG_FILE_NAME = 'logs.json';
+/** How many recent user messages are loaded for the input history. */
+const MAX_LOADED_USER_MESSAGES = 1000;
+const READ_CHUNK_BYTES = 64 * 1024;
+const NEWLINE = 0x0a;
 
 export enum MessageSenderType {
   USER = 'user',
@@ -67,13 +77,80 @@ export function decodeTagName(str: string): string {
   }
 }
 
+function isLogEntry(entry: unknown): entry is LogEntry {
+  const e = entry as Partial<LogEntry> | null;
+  return (
+    typeof e?.sessionId === 'string' &&
+    typeof e.messageId === 'number' &&
+    typeof e.timestamp === 'string' &&
+    typeof e.type === 'string' &&
+    typeof e.message === 'string'
+  );
+}
+
+function parseLogLine(line: string): LogEntry | undefined {
+  try {
+    const entry = JSON.parse(line);
+    return isLogEntry(entry) ? entry : undefined;
+  } catch (_e) {
+    // A line torn by a crash mid-append is skipped.
+    return undefined;
+  }
+}
+
+/**
+ * Yields the lines of the first `end` bytes of a file, last line first,
+ * reading the file backwards in chunks so that callers which stop early never
+ * read the older part of it.
+ */
+async function* readLinesBackwards(
+  filePath: string,
+  end: number,
+): AsyncGenerator<string> {
+  const handle = await fs.open(filePath, 'r');
+  try {
+    let position = end;
+    let rest = Buffer.alloc(0);
+    while (position > 0) {
+      const size = Math.min(READ_CHUNK_BYTES, position);
+      position -= size;
+      const chunk = Buffer.alloc(size);
+      await handle.read(chunk, 0, size, position);
+      const buffer = rest.length > 0 ? Buffer.concat([chunk, rest]) : chunk;
+      let lineEnd = buffer.length;
+      let newline = buffer.lastIndexOf(NEWLINE, lineEnd - 1);
+      while (newline !== -1) {
+        if (newline + 1 < lineEnd) {
+          yield buffer.toString('utf-8', newline + 1, lineEnd);
+        }
+        lineEnd = newline;
+        newline = lineEnd > 0 ? buffer.lastIndexOf(NEWLINE, lineEnd - 1) : -1;
+      }
+      rest = buffer.subarray(0, lineEnd);
+    }
+    if (rest.length > 0) {
+      yield rest.toString('utf-8');
+    }
+  } finally {
+    await handle.close();
+  }
+}
+
+/**
+ * Keeps the prompt log of a project as JSON Lines. Messages are appended
+ * without reading the file back; only what other instances appended since the
+ * last write is read, to keep message ids in order. On start only the most
+ * recent entries are loaded, reading the file from its end.
+ */
 export class Logger {
   private qwenDir: string | undefined;
   private logFilePath: string | undefined;
   private sessionId: string | undefined;
   private messageId = 0; // Instance-specific counter for the next messageId
   private initialized = false;
-  private logs: LogEntry[] = []; // In-memory cache, ideally reflects the last known state of the file
+  private logs: LogEntry[] = []; // Entries loaded on start plus those appended since, oldest first
+  private logFileSize = 0; // Bytes of the log file reflected in `logs`
+  private previousUserMessages: string[] | undefined;
 
   constructor(
     sessionId: string,
@@ -82,28 +159,18 @@ export class Logger {
     this.sessionId = sessionId;
   }
 
-  private async _readLogFile(): Promise<LogEntry[]> {
-    if (!this.logFilePath) {
-      throw new Error('Log file path not set during read attempt.');
-    }
+  private async _readLegacyLogFile(legacyPath: string): Promise<LogEntry[]> {
     try {
-      const fileContent = await fs.readFile(this.logFilePath, 'utf-8');
+      const fileContent = await fs.readFile(legacyPath, 'utf-8');
       const parsedLogs = JSON.parse(fileContent);
       if (!Array.isArray(parsedLogs)) {
         console.debug(
-          `Log file at ${this.logFilePath} is not a valid JSON array. Starting with empty logs.`,
+          `Log file at ${legacyPath} is not a valid JSON array. Starting with empty logs.`,
         );
-        await this._backupCorruptedLogFile('malformed_array');
+        await this._backupCorruptedLogFile(legacyPath, 'malformed_array');
         return [];
       }
-      return parsedLogs.filter(
-        (entry) =>
-          typeof entry.sessionId === 'string' &&
-          typeof entry.messageId === 'number' &&
-          typeof entry.timestamp === 'string' &&
-          typeof entry.type === 'string' &&
-          typeof entry.message === 'string',
-      ) as LogEntry[];
+      return parsedLogs.filter(isLogEntry);
     } catch (error) {
       const nodeError = error as NodeJS.ErrnoException;
       if (nodeError.code === 'ENOENT') {
@@ -111,31 +178,50 @@ export class Logger {
       }
       if (error instanceof SyntaxError) {
         console.debug(
-          `Invalid JSON in log file ${this.logFilePath}. Backing up and starting fresh.`,
+          `Invalid JSON in log file ${legacyPath}. Backing up and starting fresh.`,
           error,
         );
-        await this._backupCorruptedLogFile('invalid_json');
+        await this._backupCorruptedLogFile(legacyPath, 'invalid_json');
         return [];
       }
-      console.debug(
-        `Failed to read or parse log file ${this.logFilePath}:`,
-        error,
-      );
+      console.debug(`Failed to read or parse log file ${legacyPath}:`, error);
       throw error;
     }
   }
 
-  private async _backupCorruptedLogFile(reason: string): Promise<void> {
-    if (!this.logFilePath) return;
-    const backupPath = `${this.logFilePath}.${reason}.${Date.now()}.bak`;
+  private async _backupCorruptedLogFile(
+    filePath: string,
+    reason: string,
+  ): Promise<void> {
+    const backupPath = `${filePath}.${reason}.${Date.now()}.bak`;
     try {
-      await fs.rename(this.logFilePath, backupPath);
+      await fs.rename(filePath, backupPath);
       console.debug(`Backed up corrupted log file to ${backupPath}`);
     } catch (_backupError) {
       // If rename fails (e.g. file doesn't exist), no need to log an error here as the primary error (e.g. invalid JSON) is already handled.
     }
   }
 
+  /**
+   * Creates the log file, carrying over the entries of the legacy JSON log
+   * if there is one. The legacy file is left in place for older versions.
+   */
+  private async _createLogFile(logFilePath: string): Promise<void> {
+    const legacyLogs = await this._readLegacyLogFile(
+      path.join(this.qwenDir!, LEGACY_LOG_FILE_NAME),
+    );
+    try {
+      // Exclusive, so that a log another instance just created is kept.
+      await fs.writeFile(
+        logFilePath,
+        legacyLogs.map((entry) => JSON.stringify(entry) + '\n').join(''),
+        { encoding: 'utf-8', flag: 'wx' },
+      );
+    } catch (error) {
+      if ((error as NodeJS.ErrnoException).code !== 'EEXIST') throw error;
+    }
+  }
+
   async initialize(): Promise<void> {
     if (this.initialized) {
       return;
@@ -146,16 +232,32 @@ export class Logger {
 
     try {
       await fs.mkdir(this.qwenDir, { recursive: true });
-      let fileExisted = true;
+      let size: number;
       try {
-        await fs.access(this.logFilePath);
-      } catch (_e) {
-        fileExisted = false;
+        size = (await fs.stat(this.logFilePath)).size;
+      } catch (error) {
+        if ((error as NodeJS.ErrnoException).code !== 'ENOENT') throw error;
+        await this._createLogFile(this.logFilePath);
+        size = (await fs.stat(this.logFilePath)).size;
       }
-      this.logs = await this._readLogFile();
-      if (!fileExisted && this.logs.length === 0) {
-        await fs.writeFile(this.logFilePath, '[]', 'utf-8');
+
+      const recentLogs: LogEntry[] = [];
+      let userMessages = 0;
+      for await (const line of readLinesBackwards(this.logFilePath, size)) {
+        const entry = parseLogLine(line);
+        if (!entry) continue;
+        recentLogs.push(entry);
+        if (
+          entry.type === MessageSenderType.USER &&
+          ++userMessages >= MAX_LOADED_USER_MESSAGES
+        ) {
+          break;
+        }
       }
+      this.logs = recentLogs.reverse();
+      this.logFileSize = size;
+      this.previousUserMessages = undefined;
+
       const sessionLogs = this.logs.filter(
         (entry) => entry.sessionId === this.sessionId,
       );
@@ -170,7 +272,35 @@ export class Logger {
     }
   }
 
-  private async _updateLogFile(
+  /**
+   * Reads the entries other instances appended since this one last read or
+   * wrote the log file, and returns them.
+   */
+  private async _readAppendedEntries(): Promise<LogEntry[]> {
+    const handle = await fs.open(this.logFilePath!, 'r');
+    try {
+      const { size } = await handle.stat();
+      if (size <= this.logFileSize) {
+        // Nothing new, or the file was replaced; keep appending after it.
+        this.logFileSize = size;
+        return [];
+      }
+      const buffer = Buffer.alloc(size - this.logFileSize);
+      await handle.read(buffer, 0, buffer.length, this.logFileSize);
+      // A line still being written by another instance is read next time.
+      const complete = buffer.lastIndexOf(NEWLINE) + 1;
+      this.logFileSize += complete;
+      return buffer
+        .toString('utf-8', 0, complete)
+        .split('\n')
+        .map(parseLogLine)
+        .filter((entry): entry is LogEntry => entry !== undefined);
+    } finally {
+      await handle.close();
+    }
+  }
+
+  private async _appendToLogFile(
     entryToAppend: LogEntry,
   ): Promise<LogEntry | null> {
     if (!this.logFilePath) {
@@ -178,9 +308,9 @@ export class Logger {
       throw new Error('Log file path not set during update attempt.');
     }
 
-    let currentLogsOnDisk: LogEntry[];
+    let appendedByOthers: LogEntry[];
     try {
-      currentLogsOnDisk = await this._readLogFile();
+      appendedByOthers = await this._readAppendedEntries();
     } catch (readError) {
       console.debug(
         'Critical error reading log file before append:',
@@ -188,23 +318,25 @@ export class Logger {
       );
       throw readError;
     }
+    if (appendedByOthers.length > 0) {
+      this.logs.push(...appendedByOthers);
+      this.previousUserMessages = undefined;
+    }
 
-    // Determine the correct messageId for the new entry based on current disk state for its session
-    const sessionLogsOnDisk = currentLogsOnDisk.filter(
-      (e) => e.sessionId === entryToAppend.sessionId,
+    // Other instances of the same session may have taken message ids since
+    // this one last wrote.
+    const sessionIds = appendedByOthers
+      .filter((e) => e.sessionId === entryToAppend.sessionId)
+      .map((e) => e.messageId);
+    entryToAppend.messageId = Math.max(
+      entryToAppend.messageId,
+      ...sessionIds.map((id) => id + 1),
     );
-    const nextMessageIdForSession =
-      sessionLogsOnDisk.length > 0
-        ? Math.max(...sessionLogsOnDisk.map((e) => e.messageId)) + 1
-        : 0;
-
-    // Update the messageId of the entry we are about to append
-    entryToAppend.messageId = nextMessageIdForSession;
 
     // Check if this entry (same session, same *recalculated* messageId, same content) might already exist
     // This is a stricter check for true duplicates if multiple instances try to log the exact same thing
     // at the exact same calculated messageId slot.
-    const entryExists = currentLogsOnDisk.some(
+    const entryExists = appendedByOthers.some(
       (e) =>
         e.sessionId === entryToAppend.sessionId &&
         e.messageId === entryToAppend.messageId &&
@@ -216,19 +348,15 @@ export class Logger {
       console.debug(
         `Duplicate log entry detected and skipped: session ${entryToAppend.sessionId}, messageId ${entryToAppend.messageId}`,
       );
-      this.logs = currentLogsOnDisk; // Ensure in-memory is synced with disk
       return null; // Indicate that no new entry was actually added
     }
 
-    currentLogsOnDisk.push(entryToAppend);
-
+    const line = JSON.stringify(entryToAppend) + '\n';
     try {
-      await fs.writeFile(
-        this.logFilePath,
-        JSON.stringify(currentLogsOnDisk, null, 2),
-        'utf-8',
-      );
-      this.logs = currentLogsOnDisk;
+      await fs.appendFile(this.logFilePath, line, 'utf-8');
+      this.logFileSize += Buffer.byteLength(line, 'utf-8');
+      this.logs.push(entryToAppend);
+      this.previousUserMessages = undefined;
       return entryToAppend; // Return the successfully appended entry
     } catch (error) {
       console.debug('Error writing to log file:', error);
@@ -236,9 +364,13 @@ export class Logger {
     }
   }
 
+  /**
+   * Returns the recently logged user messages, newest first. Older messages
+   * than the ones loaded on start are not included.
+   */
   async getPreviousUserMessages(): Promise<string[]> {
     if (!this.initialized) return [];
-    return this.logs
+    this.previousUserMessages ??= this.logs
       .filter((entry) => entry.type === MessageSenderType.USER)
       .sort((a, b) => {
         const dateA = new Date(a.timestamp).getTime();
@@ -246,6 +378,7 @@ export class Logger {
         return dateB - dateA;
       })
       .map((entry) => entry.message);
+    return [...this.previousUserMessages];
   }
 
   async logMessage(type: MessageSenderType, message: string): Promise<void> {
@@ -257,24 +390,24 @@ export class Logger {
     }
 
     // The messageId used here is the instance's idea of the next ID.
-    // _updateLogFile will verify and potentially recalculate based on the file's actual state.
+    // _appendToLogFile will raise it past ids other instances have taken.
     const newEntryObject: LogEntry = {
       sessionId: this.sessionId,
-      messageId: this.messageId, // This will be recalculated in _updateLogFile
+      messageId: this.messageId,
       type,
       message,
       timestamp: new Date().toISOString(),
     };
 
     try {
-      const writtenEntry = await this._updateLogFile(newEntryObject);
+      const writtenEntry = await this._appendToLogFile(newEntryObject);
       if (writtenEntry) {
         // If an entry was actually written (not a duplicate skip),
         // then this instance can increment its idea of the next messageId for this session.
         this.messageId = writtenEntry.messageId + 1;
       }
     } catch (_error) {
-      // Error already logged by _updateLogFile or _readLogFile
+      // Error already logged by _appendToLogFile
     }
   }
 
@@ -289,6 +422,12 @@ export class Logger {
     await this.logMessage(MessageSenderType.MODEL_SWITCH, message);
   }
 
+  private _checkpointStore(): CheckpointStore {
+    return new CheckpointStore(
+      path.join(this.qwenDir!, CHECKPOINT_OBJECTS_DIR_NAME),
+    );
+  }
+
   private _checkpointPath(tag: string): string {
     if (!tag.length) {
       throw new Error('No checkpoint tag specified.');
@@ -341,7 +480,7 @@ export class Logger {
     // Always save with the new encoded path.
     const path = this._checkpointPath(tag);
     try {
-      await fs.writeFile(path, JSON.stringify(conversation, null, 2), 'utf-8');
+      await this._checkpointStore().write(path, { conversation });
     } catch (error) {
       console.error('Error writing to checkpoint file:', error);
     }
@@ -357,8 +496,11 @@ export class Logger {
 
     const path = await this._getCheckpointPath(tag);
     try {
-      const fileContent = await fs.readFile(path, 'utf-8');
-      const parsedContent = JSON.parse(fileContent);
+      const checkpoint = await this._checkpointStore().read(path);
+      // Checkpoints saved before the content-addressed store are plain arrays.
+      const parsedContent = Array.isArray(checkpoint)
+        ? checkpoint
+        : (checkpoint as { conversation?: unknown } | null)?.conversation;
       if (!Array.isArray(parsedContent)) {
         console.warn(
           `Checkpoint file at ${path} is not a valid JSON array. Returning empty checkpoint.`,
@@ -449,10 +591,49 @@ export class Logger {
     }
   }
 
+  /**
+   * Deletes the stored messages that neither a saved conversation nor a
+   * restorable tool call refers to anymore, e.g. after checkpoints were
+   * deleted or overwritten.
+   */
+  async collectCheckpointGarbage(): Promise<CheckpointGcResult> {
+    if (!this.initialized || !this.qwenDir) {
+      throw new Error(
+        'Logger not initialized. Cannot collect checkpoint garbage.',
+      );
+    }
+    const listJsonFiles = async (dir: string, prefix = '') => {
+      try {
+        return (await fs.readdir(dir))
+          .filter((file) => file.startsWith(prefix) && file.endsWith('.json'))
+          .map((file) => path.join(dir, file));
+      } catch (error) {
+        if ((error as NodeJS.ErrnoException).code === 'ENOENT') return [];
+        throw error;
+      }
+    };
+    const [chats, toolCalls] = await Promise.all([
+      this._checkpointStore().collectGarbage(
+        await listJsonFiles(this.qwenDir, 'checkpoint-'),
+      ),
+      new CheckpointStore(
+        this.storage.getProjectTempCheckpointObjectsDir(),
+      ).collectGarbage(
+        await listJsonFiles(this.storage.getProjectTempCheckpointsDir()),
+      ),
+    ]);
+    return {
+      removedBlobs: chats.removedBlobs + toolCalls.removedBlobs,
+      freedBytes: chats.freedBytes + toolCalls.freedBytes,
+    };
+  }
+
   close(): void {
     this.initialized = false;
     this.logFilePath = undefined;
     this.logs = [];
+    this.logFileSize = 0;
+    this.previousUserMessages = undefined;
     this.sessionId = undefined;
     this.messageId = 0;
   }
@@ -1106,6 +1106,56 @@ describe('ContentGenerationPipeline', () => {
       );
     });
 
+    it('should attach stream timings to the context of a completed stream', async () => {
+      const request: GenerateContentParameters = {
+        model: 'test-model',
+        contents: [{ parts: [{ text: 'Hello' }], role: 'user' }],
+      };
+      const mockStream = {
+        async *[Symbol.asyncIterator]() {
+          yield { id: 'chunk-1', choices: [{ delta: { content: 'Hel' } }] };
+          yield { id: 'chunk-2', choices: [{ delta: { content: 'lo' } }] };
+          yield {
+            id: 'chunk-3',
+            choices: [{ delta: {}, finish_reason: 'stop' }],
+            timings: {
+              prompt_n: 8,
+              prompt_ms: 4,
+              predicted_n: 2,
+              predicted_ms: 40,
+            },
+          };
+        },
+      };
+      const mockGeminiResponse = new GenerateContentResponse();
+      mockGeminiResponse.candidates = [
+        { content: { parts: [{ text: 'Hello' }], role: 'model' } },
+      ];
+      (mockConverter.convertGeminiRequestToOpenAI as Mock).mockReturnValue([]);
+      (mockConverter.convertOpenAIChunkToGemini as Mock).mockReturnValue(
+        mockGeminiResponse,
+      );
+      (mockClient.chat.completions.create as Mock).mockResolvedValue(
+        mockStream,
+      );
+
+      const resultGenerator = await pipeline.executeStream(request, 'id');
+      for await (const _result of resultGenerator) {
+        // Consume the stream
+      }
+
+      const context = (mockTelemetryService.logStreamingSuccess as Mock).mock
+        .calls[0][0];
+      expect(context.streamTiming).toMatchObject({
+        interTokenGapsMs: [expect.any(Number)],
+        promptTokens: 8,
+        promptEvalMs: 4,
+        generationTokens: 2,
+        generationMs: 40,
+      });
+      expect(context.engine).toBe('unknown');
+    });
+
     it('should collect all OpenAI chunks for logging even when Gemini responses are filtered', async () => {
       // Create chunks that would produce empty Gemini responses (partial tool calls)
       const partialToolCallChunk1: OpenAI.Chat.ChatCompletionChunk = {
@@ -16,6 +16,11 @@ import { OpenAIContentConverter } from './converter.js';
 import type { TelemetryService, RequestContext } from './telemetryService.js';
 import type { ErrorHandler } from './errorHandler.js';
 import { normalizeOpenAIMessages } from './messageNormalizer.js';
+import {
+  StreamTimer,
+  getInferenceEngine,
+  getProviderLabel,
+} from '../../telemetry/streamTiming.js';
 
 export interface PipelineConfig {
   cliConfig: Config;
@@ -80,6 +85,8 @@ export class ContentGenerationPipeline {
         const stream = (await this.client.chat.completions.create(
           openaiRequest,
         )) as AsyncIterable<OpenAI.Chat.ChatCompletionChunk>;
+        const timer = new StreamTimer(context.startTime);
+        timer.markResponse();
 
         // Stage 2: Process stream with conversion and logging
         return this.processStreamWithLogging(
@@ -87,6 +94,7 @@ export class ContentGenerationPipeline {
           context,
           openaiRequest,
           request,
+          timer,
         );
       },
     );
@@ -106,6 +114,7 @@ export class ContentGenerationPipeline {
     context: RequestContext,
     openaiRequest: OpenAI.Chat.ChatCompletionCreateParams,
     request: GenerateContentParameters,
+    timer?: StreamTimer,
   ): AsyncGenerator<GenerateContentResponse> {
     const collectedGeminiResponses: GenerateContentResponse[] = [];
     const collectedOpenAIChunks: OpenAI.Chat.ChatCompletionChunk[] = [];
@@ -121,6 +130,21 @@ export class ContentGenerationPipeline {
       for await (const chunk of stream) {
         // Always collect OpenAI chunks for logging, regardless of Gemini conversion result
         collectedOpenAIChunks.push(chunk);
+        if (timer) {
+          timer.observeChunk(chunk);
+          const delta = chunk.choices?.[0]?.delta as
+            | (OpenAI.Chat.ChatCompletionChunk.Choice.Delta & {
+                reasoning_content?: string;
+              })
+            | undefined;
+          if (
+            delta?.content ||
+            delta?.reasoning_content ||
+            delta?.tool_calls?.length
+          ) {
+            timer.markToken();
+          }
+        }
 
         const response = this.converter.convertOpenAIChunkToGemini(chunk);
 
@@ -160,6 +184,16 @@ export class ContentGenerationPipeline {
 
       // Stage 2e: Stream completed successfully - perform logging with original OpenAI chunks
       context.duration = Date.now() - context.startTime;
+      if (timer) {
+        const usage = collectedGeminiResponses
+          .slice()
+          .reverse()
+          .find((r) => r.usageMetadata)?.usageMetadata;
+        context.streamTiming = timer.finish(
+          usage?.promptTokenCount,
+          usage?.candidatesTokenCount,
+        );
+      }
 
       await this.config.telemetryService.logStreamingSuccess(
         context,
@@ -474,6 +508,8 @@ export class ContentGenerationPipeline {
       startTime: Date.now(),
       duration: 0,
       isStreaming,
+      engine: getInferenceEngine(this.contentGeneratorConfig.baseUrl),
+      provider: getProviderLabel(this.contentGeneratorConfig.baseUrl),
     };
   }
 }
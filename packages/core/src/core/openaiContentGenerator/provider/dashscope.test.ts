@@ -175,6 +175,7 @@ describe('DashScopeOpenAICompatibleProvider', () => {
           'X-DashScope-UserAgent': `QwenCode/1.0.0 (${process.platform}; ${process.arch})`,
           'X-DashScope-AuthType': AuthType.USE_OPENAI,
         },
+        fetch: expect.any(Function),
       });
 
       expect(client).toBeDefined();
@@ -192,6 +193,7 @@ describe('DashScopeOpenAICompatibleProvider', () => {
         timeout: DEFAULT_TIMEOUT,
         maxRetries: DEFAULT_MAX_RETRIES,
         defaultHeaders: expect.any(Object),
+        fetch: expect.any(Function),
       });
     });
   });
@@ -2,6 +2,7 @@ import OpenAI from 'openai';
 import type { Config } from '../../../config/config.js';
 import type { ContentGeneratorConfig } from '../../contentGenerator.js';
 import { DEFAULT_TIMEOUT, DEFAULT_MAX_RETRIES } from '../constants.js';
+import { httpPool } from '../../../utils/httpPool.js';
 import { tokenLimit } from '../../tokenLimits.js';
 import type {
   OpenAICompatibleProvider,
@@ -61,6 +62,7 @@ export class DashScopeOpenAICompatibleProvider
       timeout,
       maxRetries,
       defaultHeaders,
+      fetch: httpPool.fetch,
     });
   }
 
@@ -307,7 +309,11 @@ export class DashScopeOpenAICompatibleProvider
       return request; // No max_tokens parameter, return unchanged
     }
 
-    const modelLimit = tokenLimit(model, 'output');
+    const modelLimit = tokenLimit(
+      model,
+      'output',
+      this.contentGeneratorConfig.baseUrl,
+    );
 
     // If max_tokens exceeds the model limit, cap it to the model's limit
     if (currentMaxTokens > modelLimit) {
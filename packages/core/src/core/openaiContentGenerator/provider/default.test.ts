@@ -100,6 +100,7 @@ describe('DefaultOpenAICompatibleProvider', () => {
         defaultHeaders: {
           'User-Agent': `QwenCode/1.0.0 (${process.platform}; ${process.arch})`,
         },
+        fetch: expect.any(Function),
       });
 
       expect(client).toBeDefined();
@@ -119,6 +120,7 @@ describe('DefaultOpenAICompatibleProvider', () => {
         defaultHeaders: {
           'User-Agent': `QwenCode/1.0.0 (${process.platform}; ${process.arch})`,
         },
+        fetch: expect.any(Function),
       });
     });
 
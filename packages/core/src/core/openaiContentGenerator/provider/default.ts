@@ -2,6 +2,7 @@ import OpenAI from 'openai';
 import type { Config } from '../../../config/config.js';
 import type { ContentGeneratorConfig } from '../../contentGenerator.js';
 import { DEFAULT_TIMEOUT, DEFAULT_MAX_RETRIES } from '../constants.js';
+import { httpPool } from '../../../utils/httpPool.js';
 import type { OpenAICompatibleProvider } from './types.js';
 
 /**
@@ -43,6 +44,7 @@ export class DefaultOpenAICompatibleProvider
       timeout,
       maxRetries,
       defaultHeaders,
+      fetch: httpPool.fetch,
     });
   }
 
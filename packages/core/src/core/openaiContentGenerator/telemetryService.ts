@@ -6,6 +6,8 @@
 
 import type { Config } from '../../config/config.js';
 import { logApiError, logApiResponse } from '../../telemetry/loggers.js';
+import { recordStreamTimingMetrics } from '../../telemetry/metrics.js';
+import type { StreamTimingStats } from '../../telemetry/streamTiming.js';
 import { ApiErrorEvent, ApiResponseEvent } from '../../telemetry/types.js';
 import { openaiLogger } from '../../utils/openaiLogger.js';
 import type { GenerateContentResponse } from '@google/genai';
@@ -18,6 +20,11 @@ export interface RequestContext {
   startTime: number;
   duration: number;
   isStreaming: boolean;
+  /** Inference engine serving the request, when known. */
+  engine?: string;
+  provider?: string;
+  /** Set by the pipeline once a stream has completed. */
+  streamTiming?: StreamTimingStats;
 }
 
 export interface TelemetryService {
@@ -127,6 +134,31 @@ export class DefaultTelemetryService implements TelemetryService {
       finalUsageMetadata,
     );
 
+    const timing = context.streamTiming;
+    if (timing) {
+      const engine = context.engine ?? 'unknown';
+      const provider = context.provider ?? 'unknown';
+      Object.assign(responseEvent, {
+        engine,
+        provider,
+        queue_ms: timing.queueMs,
+        ttft_ms: timing.ttftMs,
+        inter_token_p50_ms: timing.interTokenP50Ms,
+        inter_token_p90_ms: timing.interTokenP90Ms,
+        inter_token_p99_ms: timing.interTokenP99Ms,
+        inter_token_buckets: timing.interTokenBuckets,
+        prompt_eval_tokens: timing.promptTokens,
+        prompt_eval_ms: timing.promptEvalMs,
+        generation_tokens: timing.generationTokens,
+        generation_ms: timing.generationMs,
+      });
+      recordStreamTimingMetrics(
+        this.config,
+        { model: context.model, engine, provider },
+        timing,
+      );
+    }
+
     logApiResponse(this.config, responseEvent);
 
     // Log interaction if enabled - combine chunks only when needed
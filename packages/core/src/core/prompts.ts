@@ -80,34 +80,47 @@ export function getCustomSystemPrompt(
   return `${instructionText}${memorySuffix}`;
 }
 
+/**
+ * Resolves the system prompt override file configured through GEMINI_SYSTEM_MD.
+ *
+ * @returns The absolute path of the override file, or undefined when the
+ *   override is disabled.
+ */
+export function getSystemMdPath(): string | undefined {
+  // if GEMINI_SYSTEM_MD is set (and not 0|false), override system prompt from file
+  // default path is .gemini/system.md but can be modified via custom path in GEMINI_SYSTEM_MD
+  const systemMdVar = process.env['GEMINI_SYSTEM_MD'];
+  if (!systemMdVar) {
+    return undefined;
+  }
+  const systemMdVarLower = systemMdVar.toLowerCase();
+  if (['0', 'false'].includes(systemMdVarLower)) {
+    return undefined;
+  }
+  if (['1', 'true'].includes(systemMdVarLower)) {
+    return path.resolve(path.join(GEMINI_CONFIG_DIR, 'system.md'));
+  }
+  let customPath = systemMdVar;
+  if (customPath.startsWith('~/')) {
+    customPath = path.join(os.homedir(), customPath.slice(2));
+  } else if (customPath === '~') {
+    customPath = os.homedir();
+  }
+  return path.resolve(customPath); // use custom path from GEMINI_SYSTEM_MD
+}
+
 export function getCoreSystemPrompt(
   userMemory?: string,
   config?: SystemPromptConfig,
   model?: string,
 ): string {
-  // if GEMINI_SYSTEM_MD is set (and not 0|false), override system prompt from file
-  // default path is .gemini/system.md but can be modified via custom path in GEMINI_SYSTEM_MD
-  let systemMdEnabled = false;
-  let systemMdPath = path.resolve(path.join(GEMINI_CONFIG_DIR, 'system.md'));
-  const systemMdVar = process.env['GEMINI_SYSTEM_MD'];
-  if (systemMdVar) {
-    const systemMdVarLower = systemMdVar.toLowerCase();
-    if (!['0', 'false'].includes(systemMdVarLower)) {
-      systemMdEnabled = true; // enable system prompt override
-      if (!['1', 'true'].includes(systemMdVarLower)) {
-        let customPath = systemMdVar;
-        if (customPath.startsWith('~/')) {
-          customPath = path.join(os.homedir(), customPath.slice(2));
-        } else if (customPath === '~') {
-          customPath = os.homedir();
-        }
-        systemMdPath = path.resolve(customPath); // use custom path from GEMINI_SYSTEM_MD
-      }
-      // require file to exist when override is enabled
-      if (!fs.existsSync(systemMdPath)) {
-        throw new Error(`missing system prompt file '${systemMdPath}'`);
-      }
-    }
+  const overridePath = getSystemMdPath();
+  const systemMdEnabled = overridePath !== undefined;
+  const systemMdPath =
+    overridePath ?? path.resolve(path.join(GEMINI_CONFIG_DIR, 'system.md'));
+  // require file to exist when override is enabled
+  if (systemMdEnabled && !fs.existsSync(systemMdPath)) {
+    throw new Error(`missing system prompt file '${systemMdPath}'`);
   }
 
   // Check for system prompt mappings from global config
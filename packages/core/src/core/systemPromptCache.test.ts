@@ -0,0 +1,67 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, it, expect, vi, beforeEach } from 'vitest';
+import { SystemPromptCache } from './systemPromptCache.js';
+import { getCoreSystemPrompt, getSystemMdPath } from './prompts.js';
+
+vi.mock('./prompts.js', () => ({
+  getCoreSystemPrompt: vi.fn(),
+  getSystemMdPath: vi.fn(),
+}));
+
+describe('SystemPromptCache', () => {
+  beforeEach(() => {
+    vi.resetAllMocks();
+    vi.stubEnv('SANDBOX', undefined);
+    vi.mocked(getSystemMdPath).mockReturnValue(undefined);
+    vi.mocked(getCoreSystemPrompt).mockImplementation(
+      (userMemory?: string, _config?: unknown, model?: string) =>
+        `prompt:${model}:${userMemory ?? ''}`,
+    );
+  });
+
+  it('should build the prompt once for identical inputs', () => {
+    const cache = new SystemPromptCache();
+    const first = cache.get('memory', 'model-a');
+    const second = cache.get('memory', 'model-a');
+
+    expect(second).toBe(first);
+    expect(first.text).toBe('prompt:model-a:memory');
+    expect(getCoreSystemPrompt).toHaveBeenCalledTimes(1);
+    expect(cache.getStats()).toEqual({ hits: 1, misses: 1 });
+  });
+
+  it('should rebuild when the user memory, model or sandbox changes', () => {
+    const cache = new SystemPromptCache();
+    cache.get('memory', 'model-a');
+    cache.get('other memory', 'model-a');
+    cache.get('memory', 'model-b');
+    vi.stubEnv('SANDBOX', 'docker');
+    cache.get('memory', 'model-a');
+
+    expect(getCoreSystemPrompt).toHaveBeenCalledTimes(4);
+  });
+
+  it('should rebuild after invalidate()', () => {
+    const cache = new SystemPromptCache();
+    cache.get('memory', 'model-a');
+    cache.invalidate();
+    cache.get('memory', 'model-a');
+
+    expect(getCoreSystemPrompt).toHaveBeenCalledTimes(2);
+  });
+
+  it('should compute the token count once per entry', async () => {
+    const cache = new SystemPromptCache();
+    const entry = cache.get('memory', 'model-a');
+    const first = await entry.getTokenCount();
+    const second = await cache.get('memory', 'model-a').getTokenCount();
+
+    expect(first).toBeGreaterThan(0);
+    expect(second).toBe(first);
+  });
+});
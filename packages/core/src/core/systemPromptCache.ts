@@ -0,0 +1,126 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { createHash } from 'node:crypto';
+import fs from 'node:fs';
+import process from 'node:process';
+import { LruCache } from '../utils/LruCache.js';
+import { TextTokenizer } from '../utils/request-tokenizer/index.js';
+import { getCoreSystemPrompt, getSystemMdPath } from './prompts.js';
+
+/**
+ * Environment variables that influence the text produced by
+ * `getCoreSystemPrompt()`. Any change to these produces a new cache key.
+ */
+const PROMPT_ENV_VARS = [
+  'SANDBOX',
+  'GEMINI_SYSTEM_MD',
+  'GEMINI_WRITE_SYSTEM_MD',
+  'QWEN_CODE_TOOL_CALL_STYLE',
+  'OPENAI_MODEL',
+  'OPENAI_BASE_URL',
+] as const;
+
+const MAX_CACHED_PROMPTS = 8;
+
+export interface CachedSystemPrompt {
+  text: string;
+  /** Lazily computed token count, shared by every caller of this entry. */
+  getTokenCount(): Promise<number>;
+}
+
+/**
+ * Memoizes the core system prompt so that the per-request callers in
+ * `GeminiClient` do not re-read the environment, stat the system.md override
+ * and rebuild the template on every call.
+ *
+ * Entries are keyed by (userMemory hash, model, prompt-related env vars,
+ * working directory, system.md mtime). Inputs that are not part of the key,
+ * such as whether the working directory is a git repository, are picked up
+ * after an explicit `invalidate()`.
+ */
+export class SystemPromptCache {
+  private readonly entries = new LruCache<string, CachedSystemPrompt>(
+    MAX_CACHED_PROMPTS,
+  );
+  private tokenizer?: TextTokenizer;
+  private hits = 0;
+  private misses = 0;
+
+  get(userMemory: string | undefined, model: string): CachedSystemPrompt {
+    const key = this.computeKey(userMemory, model);
+    const cached = this.entries.get(key);
+    if (cached) {
+      this.hits++;
+      return cached;
+    }
+    this.misses++;
+
+    const text = getCoreSystemPrompt(userMemory, {}, model);
+    let tokenCount: Promise<number> | undefined;
+    const entry: CachedSystemPrompt = {
+      text,
+      getTokenCount: () => {
+        if (!tokenCount) {
+          tokenCount = this.getTokenizer()
+            .calculateTokens(text)
+            .catch(() => Math.ceil((text?.length ?? 0) / 4));
+        }
+        return tokenCount;
+      },
+    };
+    this.entries.set(key, entry);
+    return entry;
+  }
+
+  /**
+   * Drops every cached prompt. Call this when user memory or settings that
+   * feed into the prompt are reloaded.
+   */
+  invalidate(): void {
+    this.entries.clear();
+  }
+
+  getStats(): { hits: number; misses: number } {
+    return { hits: this.hits, misses: this.misses };
+  }
+
+  private getTokenizer(): TextTokenizer {
+    if (!this.tokenizer) {
+      this.tokenizer = new TextTokenizer();
+    }
+    return this.tokenizer;
+  }
+
+  private computeKey(userMemory: string | undefined, model: string): string {
+    const hash = createHash('sha256');
+    hash.update(userMemory ?? '');
+    hash.update('\0');
+    hash.update(model ?? '');
+    for (const name of PROMPT_ENV_VARS) {
+      hash.update('\0');
+      hash.update(process.env[name] ?? '');
+    }
+    hash.update('\0');
+    hash.update(process.cwd());
+    hash.update('\0');
+    hash.update(String(getSystemMdMtime()));
+    return hash.digest('hex');
+  }
+}
+
+function getSystemMdMtime(): number {
+  const systemMdPath = getSystemMdPath();
+  if (!systemMdPath) {
+    return 0;
+  }
+  try {
+    return fs.statSync(systemMdPath).mtimeMs;
+  } catch {
+    // Let getCoreSystemPrompt() surface the missing-file error.
+    return -1;
+  }
+}
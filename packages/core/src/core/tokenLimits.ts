@@ -192,21 +192,56 @@ const OUTPUT_PATTERNS: Array<[RegExp, TokenCount]> = [
   [/^qwen3-vl-plus$/, LIMITS['32k']],
 ];
 
+/** Limits reported by serving backends, keyed by `${baseUrl}|${model}`. */
+const discoveredLimits = new Map<
+  string,
+  Partial<Record<TokenLimitType, TokenCount>>
+>();
+
+/**
+ * Records the limits the backend at `baseUrl` reports for `model`, which take
+ * precedence over the tables above for requests to that backend. Passing
+ * undefined forgets them.
+ */
+export function setDiscoveredTokenLimits(
+  baseUrl: string,
+  model: Model,
+  limits: Partial<Record<TokenLimitType, TokenCount>> | undefined,
+): void {
+  const key = `${baseUrl}|${model}`;
+  if (limits && (limits.input || limits.output)) {
+    discoveredLimits.set(key, limits);
+  } else {
+    discoveredLimits.delete(key);
+  }
+}
+
 /**
  * Return the token limit for a model string based on the specified type.
  *
  * This function determines the maximum number of tokens for either input context
  * or output generation based on the model and token type. It uses the same
  * normalization logic for consistency across both input and output limits.
+ * Limits discovered from the serving backend are preferred when known.
  *
  * @param model - The model name to get the token limit for
  * @param type - The type of token limit ('input' for context window, 'output' for generation)
+ * @param baseUrl - The backend serving the model, whose discovered limits apply
  * @returns The maximum number of tokens allowed for this model and type
  */
 export function tokenLimit(
   model: Model,
   type: TokenLimitType = 'input',
+  baseUrl?: string,
 ): TokenCount {
+  const discovered =
+    baseUrl !== undefined
+      ? discoveredLimits.get(`${baseUrl}|${model}`)?.[type]
+      : undefined;
+  if (discovered) {
+    return discovered;
+  }
+
   const norm = normalize(model);
 
   // Choose the appropriate patterns based on token type
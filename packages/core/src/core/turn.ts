@@ -25,6 +25,7 @@ import {
   UnauthorizedError,
   toFriendlyError,
 } from '../utils/errors.js';
+import type { ContextReductionTier } from './contextManager.js';
 import type { GeminiChat } from './geminiChat.js';
 
 // Define a structure for tools passed to the server
@@ -156,6 +157,8 @@ export interface ChatCompressionInfo {
   originalTokenCount: number;
   newTokenCount: number;
   compressionStatus: CompressionStatus;
+  /** Which tier freed the context, when it was compressed. */
+  tier?: ContextReductionTier;
 }
 
 export type ServerGeminiChatCompressedEvent = {
@@ -14,8 +14,11 @@ export * from './core/loggingContentGenerator.js';
 export * from './core/geminiChat.js';
 export * from './core/logger.js';
 export * from './core/prompts.js';
+export * from './core/systemPromptCache.js';
 export * from './core/tokenLimits.js';
+export * from './core/contextWindowProbe.js';
 export * from './core/turn.js';
+export type { ContextReductionTier } from './core/contextManager.js';
 export * from './core/geminiRequest.js';
 export * from './core/coreToolScheduler.js';
 export * from './core/nonInteractiveToolExecutor.js';
@@ -27,6 +30,7 @@ export * from './code_assist/types.js';
 
 // Export utilities
 export * from './utils/paths.js';
+export * from './utils/promptHistoryIndex.js';
 export * from './utils/schemaValidator.js';
 export * from './utils/errors.js';
 export * from './utils/getFolderStructure.js';
@@ -36,6 +40,9 @@ export * from './utils/gitUtils.js';
 export * from './utils/editor.js';
 export * from './utils/quotaErrorDetection.js';
 export * from './utils/fileUtils.js';
+export * from './utils/fileContentCache.js';
+export * from './utils/httpPool.js';
+export * from './utils/toolOutputReducer.js';
 export * from './utils/retry.js';
 export * from './utils/shell-utils.js';
 export * from './utils/systemEncoding.js';
@@ -49,10 +56,14 @@ export * from './utils/ignorePatterns.js';
 export * from './utils/partUtils.js';
 export * from './utils/subagentGenerator.js';
 export * from './utils/projectSummary.js';
+export * from './utils/fileMetadataCache.js';
+export * from './utils/nextSpeakerChecker.js';
 
 // Export services
 export * from './services/fileDiscoveryService.js';
+export * from './services/workspaceIgnoreService.js';
 export * from './services/gitService.js';
+export * from './services/checkpointStore.js';
 export * from './services/chatRecordingService.js';
 export * from './services/fileSystemService.js';
 
@@ -92,6 +103,7 @@ export * from './tools/shell.js';
 export * from './tools/web-search.js';
 export * from './tools/read-many-files.js';
 export * from './tools/mcp-client.js';
+export * from './tools/mcp-schema-cache.js';
 export * from './tools/mcp-tool.js';
 
 // MCP OAuth
@@ -0,0 +1,115 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { CheckpointStore } from './checkpointStore.js';
+
+async function listBlobs(objectsDir: string): Promise<string[]> {
+  const shards = await fs.readdir(objectsDir);
+  const blobs = await Promise.all(
+    shards.map((shard) => fs.readdir(path.join(objectsDir, shard))),
+  );
+  return blobs.flat();
+}
+
+describe('CheckpointStore', () => {
+  let tempDir: string;
+  let objectsDir: string;
+  let store: CheckpointStore;
+
+  beforeEach(async () => {
+    tempDir = await fs.mkdtemp(path.join(os.tmpdir(), 'checkpoint-store-'));
+    objectsDir = path.join(tempDir, 'objects');
+    store = new CheckpointStore(objectsDir);
+  });
+
+  afterEach(async () => {
+    await fs.rm(tempDir, { recursive: true, force: true });
+  });
+
+  const message = (text: string) => ({ role: 'user', parts: [{ text }] });
+
+  it('should round-trip a checkpoint, keeping non-array fields inline', async () => {
+    const filePath = path.join(tempDir, 'a.json');
+    const data = {
+      history: [message('one'), message('two')],
+      toolCall: { name: 'edit', args: { file_path: '/a.ts' } },
+      commitHash: 'abc123',
+    };
+
+    await store.write(filePath, data);
+    const manifest = JSON.parse(await fs.readFile(filePath, 'utf-8'));
+
+    expect(manifest.history.blobs).toHaveLength(2);
+    expect(manifest.toolCall).toEqual(data.toolCall);
+    expect(await store.read(filePath)).toEqual(data);
+  });
+
+  it('should store each message once across checkpoints', async () => {
+    const history = [message('one'), message('two')];
+    await store.write(path.join(tempDir, 'a.json'), { history });
+    await store.write(path.join(tempDir, 'b.json'), {
+      history: [...history, message('three')],
+      clientHistory: history,
+    });
+
+    expect(await listBlobs(objectsDir)).toHaveLength(3);
+  });
+
+  it('should compress large messages', async () => {
+    const filePath = path.join(tempDir, 'a.json');
+    const large = message('x'.repeat(100_000));
+
+    await store.write(filePath, { history: [large] });
+    const [blob] = await listBlobs(objectsDir);
+    const { size } = await fs.stat(
+      path.join(objectsDir, blob.slice(0, 2), blob),
+    );
+
+    expect(size).toBeLessThan(10_000);
+    expect(await store.read(filePath)).toEqual({ history: [large] });
+  });
+
+  it('should return checkpoints in the earlier format as they are', async () => {
+    const filePath = path.join(tempDir, 'legacy.json');
+    const legacy = { history: [message('one')], commitHash: 'abc123' };
+    await fs.writeFile(filePath, JSON.stringify(legacy, null, 2));
+
+    expect(await store.read(filePath)).toEqual(legacy);
+  });
+
+  it('should remove only blobs that no checkpoint refers to', async () => {
+    const kept = path.join(tempDir, 'kept.json');
+    const deleted = path.join(tempDir, 'deleted.json');
+    await store.write(kept, { history: [message('shared')] });
+    await store.write(deleted, {
+      history: [message('shared'), message('only in deleted')],
+    });
+    await fs.rm(deleted);
+
+    const result = await store.collectGarbage([kept, deleted], 0);
+
+    expect(result.removedBlobs).toBe(1);
+    expect(result.freedBytes).toBeGreaterThan(0);
+    expect(await listBlobs(objectsDir)).toHaveLength(1);
+    expect(await store.read(kept)).toEqual({
+      history: [message('shared')],
+    });
+  });
+
+  it('should keep recently written blobs during the grace period', async () => {
+    await store.write(path.join(tempDir, 'a.json'), {
+      history: [message('one')],
+    });
+
+    const result = await store.collectGarbage([]);
+
+    expect(result.removedBlobs).toBe(0);
+  });
+});
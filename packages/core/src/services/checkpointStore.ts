@@ -0,0 +1,205 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import * as crypto from 'node:crypto';
+import * as fs from 'node:fs/promises';
+import * as path from 'node:path';
+import { promisify } from 'node:util';
+import * as zlib from 'node:zlib';
+import { isNodeError } from '../utils/errors.js';
+
+const gzip = promisify(zlib.gzip);
+const gunzip = promisify(zlib.gunzip);
+
+const CHECKPOINT_FORMAT_VERSION = 2;
+/** Blobs at least this large are stored gzip-compressed. */
+const COMPRESSION_THRESHOLD_BYTES = 4 * 1024;
+const GZIP_MAGIC = [0x1f, 0x8b];
+/** Blob reads and writes in flight at once. */
+const IO_CONCURRENCY = 32;
+/** Blobs younger than this survive garbage collection, since a checkpoint
+ * that references them may still be being written. */
+const GC_GRACE_PERIOD_MS = 10 * 60 * 1000;
+
+interface BlobList {
+  blobs: string[];
+}
+
+function isBlobList(value: unknown): value is BlobList {
+  const blobs = (value as Partial<BlobList> | null)?.blobs;
+  return (
+    typeof value === 'object' &&
+    value !== null &&
+    Array.isArray(blobs) &&
+    blobs.every((hash) => typeof hash === 'string')
+  );
+}
+
+async function mapInBatches<T, R>(
+  items: T[],
+  fn: (item: T) => Promise<R>,
+): Promise<R[]> {
+  const results: R[] = [];
+  for (let i = 0; i < items.length; i += IO_CONCURRENCY) {
+    results.push(
+      ...(await Promise.all(items.slice(i, i + IO_CONCURRENCY).map(fn))),
+    );
+  }
+  return results;
+}
+
+// Writes through a temporary file, so readers never see a partial file.
+async function writeFileAtomic(
+  filePath: string,
+  data: string | Buffer,
+): Promise<void> {
+  const tempPath = `${filePath}.${process.pid}.${crypto.randomUUID()}.tmp`;
+  try {
+    await fs.writeFile(tempPath, data);
+    await fs.rename(tempPath, filePath);
+  } catch (error) {
+    await fs.rm(tempPath, { force: true });
+    throw error;
+  }
+}
+
+export interface CheckpointGcResult {
+  removedBlobs: number;
+  freedBytes: number;
+}
+
+/**
+ * Stores conversation checkpoints content-addressed. Each array in a
+ * checkpoint, such as the chat history, is split into its elements; every
+ * element is stored once as a blob named by the SHA-256 of its JSON, and the
+ * checkpoint file only lists the hashes. Saving the same growing conversation
+ * again therefore only writes the messages added since, and listing or
+ * choosing a checkpoint never reads the blobs.
+ */
+export class CheckpointStore {
+  constructor(private readonly objectsDir: string) {}
+
+  private blobPath(hash: string): string {
+    return path.join(this.objectsDir, hash.slice(0, 2), hash);
+  }
+
+  private async putBlob(value: unknown): Promise<string> {
+    const json = JSON.stringify(value) ?? 'null';
+    const hash = crypto.createHash('sha256').update(json).digest('hex');
+    const blobPath = this.blobPath(hash);
+    try {
+      // Touching a stored blob also keeps it clear of a concurrent GC.
+      const now = new Date();
+      await fs.utimes(blobPath, now, now);
+    } catch (error) {
+      if (!isNodeError(error) || error.code !== 'ENOENT') throw error;
+      const data =
+        json.length >= COMPRESSION_THRESHOLD_BYTES ? await gzip(json) : json;
+      await fs.mkdir(path.dirname(blobPath), { recursive: true });
+      await writeFileAtomic(blobPath, data);
+    }
+    return hash;
+  }
+
+  private async getBlob(hash: string): Promise<unknown> {
+    if (!/^[0-9a-f]{64}$/.test(hash)) {
+      throw new Error(`Invalid checkpoint blob hash: ${hash}`);
+    }
+    const data = await fs.readFile(this.blobPath(hash));
+    const json =
+      data[0] === GZIP_MAGIC[0] && data[1] === GZIP_MAGIC[1]
+        ? await gunzip(data)
+        : data;
+    return JSON.parse(json.toString('utf-8'));
+  }
+
+  /**
+   * Writes `data` to `filePath`, storing the elements of its top-level
+   * arrays as blobs. An existing checkpoint at `filePath` is replaced.
+   */
+  async write(filePath: string, data: Record<string, unknown>): Promise<void> {
+    const manifest: Record<string, unknown> = {
+      version: CHECKPOINT_FORMAT_VERSION,
+    };
+    for (const [key, value] of Object.entries(data)) {
+      manifest[key] = Array.isArray(value)
+        ? { blobs: await mapInBatches(value, (item) => this.putBlob(item)) }
+        : value;
+    }
+    await writeFileAtomic(filePath, JSON.stringify(manifest));
+  }
+
+  /**
+   * Reads a checkpoint written by write(), loading its blobs. Files in the
+   * earlier format, which inlined everything, are returned as they are.
+   */
+  async read(filePath: string): Promise<unknown> {
+    const parsed = JSON.parse(await fs.readFile(filePath, 'utf-8'));
+    if (parsed?.version !== CHECKPOINT_FORMAT_VERSION) {
+      return parsed;
+    }
+    const { version: _version, ...manifest } = parsed as Record<
+      string,
+      unknown
+    >;
+    const data: Record<string, unknown> = {};
+    for (const [key, value] of Object.entries(manifest)) {
+      data[key] = isBlobList(value)
+        ? await mapInBatches(value.blobs, (hash) => this.getBlob(hash))
+        : value;
+    }
+    return data;
+  }
+
+  /**
+   * Deletes the blobs none of the checkpoints in `checkpointPaths` refer to.
+   * Checkpoints that cannot be read keep all blobs alive, so nothing they
+   * might refer to is lost.
+   */
+  async collectGarbage(
+    checkpointPaths: string[],
+    gracePeriodMs: number = GC_GRACE_PERIOD_MS,
+  ): Promise<CheckpointGcResult> {
+    const referenced = new Set<string>();
+    for (const checkpointPath of checkpointPaths) {
+      let parsed: unknown;
+      try {
+        parsed = JSON.parse(await fs.readFile(checkpointPath, 'utf-8'));
+      } catch (error) {
+        if (isNodeError(error) && error.code === 'ENOENT') continue;
+        return { removedBlobs: 0, freedBytes: 0 };
+      }
+      for (const value of Object.values(parsed ?? {})) {
+        if (isBlobList(value)) {
+          value.blobs.forEach((hash) => referenced.add(hash));
+        }
+      }
+    }
+
+    const result: CheckpointGcResult = { removedBlobs: 0, freedBytes: 0 };
+    let shards: string[];
+    try {
+      shards = await fs.readdir(this.objectsDir);
+    } catch (error) {
+      if (isNodeError(error) && error.code === 'ENOENT') return result;
+      throw error;
+    }
+    const cutoff = Date.now() - gracePeriodMs;
+    for (const shard of shards) {
+      const shardDir = path.join(this.objectsDir, shard);
+      for (const hash of await fs.readdir(shardDir)) {
+        if (referenced.has(hash)) continue;
+        const blobPath = path.join(shardDir, hash);
+        const stats = await fs.stat(blobPath);
+        if (stats.mtimeMs > cutoff) continue;
+        await fs.rm(blobPath, { force: true });
+        result.removedBlobs++;
+        result.freedBytes += stats.size;
+      }
+    }
+    return result;
+  }
+}
@@ -9,6 +9,7 @@ import * as fs from 'node:fs/promises';
 import * as os from 'node:os';
 import * as path from 'node:path';
 import { FileDiscoveryService } from './fileDiscoveryService.js';
+import { WorkspaceIgnoreService } from './workspaceIgnoreService.js';
 
 describe('FileDiscoveryService', () => {
   let testRootDir: string;
@@ -30,6 +31,7 @@ describe('FileDiscoveryService', () => {
   });
 
   afterEach(async () => {
+    WorkspaceIgnoreService.reset();
     await fs.rm(testRootDir, { recursive: true, force: true });
   });
 
@@ -4,41 +4,25 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-import type { GitIgnoreFilter } from '../utils/gitIgnoreParser.js';
-import { GitIgnoreParser } from '../utils/gitIgnoreParser.js';
-import { isGitRepository } from '../utils/gitUtils.js';
+import type { WorkspaceIgnoreStats } from './workspaceIgnoreService.js';
+import { WorkspaceIgnoreService } from './workspaceIgnoreService.js';
 import * as path from 'node:path';
 
-const GEMINI_IGNORE_FILE_NAME = '.qwenignore';
-
 export interface FilterFilesOptions {
   respectGitIgnore?: boolean;
   respectGeminiIgnore?: boolean;
 }
 
 export class FileDiscoveryService {
-  private gitIgnoreFilter: GitIgnoreFilter | null = null;
-  private geminiIgnoreFilter: GitIgnoreFilter | null = null;
+  private readonly ignoreService: WorkspaceIgnoreService;
   private projectRoot: string;
 
   constructor(projectRoot: string) {
     this.projectRoot = path.resolve(projectRoot);
-    if (isGitRepository(this.projectRoot)) {
-      const parser = new GitIgnoreParser(this.projectRoot);
-      try {
-        parser.loadGitRepoPatterns();
-      } catch (_error) {
-        // ignore file not found
-      }
-      this.gitIgnoreFilter = parser;
-    }
-    const gParser = new GitIgnoreParser(this.projectRoot);
-    try {
-      gParser.loadPatterns(GEMINI_IGNORE_FILE_NAME);
-    } catch (_error) {
-      // ignore file not found
-    }
-    this.geminiIgnoreFilter = gParser;
+    // The rules are shared with every other service for this root; pick up
+    // ignore files changed since they were last loaded.
+    this.ignoreService = WorkspaceIgnoreService.forRoot(this.projectRoot);
+    this.ignoreService.invalidate();
   }
 
   /**
@@ -69,20 +53,14 @@ export class FileDiscoveryService {
    * Checks if a single file should be git-ignored
    */
   shouldGitIgnoreFile(filePath: string): boolean {
-    if (this.gitIgnoreFilter) {
-      return this.gitIgnoreFilter.isIgnored(filePath);
-    }
-    return false;
+    return this.ignoreService.isIgnored(filePath, 'git');
   }
 
   /**
    * Checks if a single file should be gemini-ignored
    */
   shouldGeminiIgnoreFile(filePath: string): boolean {
-    if (this.geminiIgnoreFilter) {
-      return this.geminiIgnoreFilter.isIgnored(filePath);
-    }
-    return false;
+    return this.ignoreService.isIgnored(filePath, 'qwen');
   }
 
   /**
@@ -107,6 +85,13 @@ export class FileDiscoveryService {
    * Returns loaded patterns from .qwenignore
    */
   getGeminiIgnorePatterns(): string[] {
-    return this.geminiIgnoreFilter?.getPatterns() ?? [];
+    return this.ignoreService.getPatterns('qwen');
+  }
+
+  /**
+   * Returns the match-rate and cache counters of the shared ignore rules
+   */
+  getIgnoreStats(): WorkspaceIgnoreStats {
+    return this.ignoreService.getStats();
   }
 }
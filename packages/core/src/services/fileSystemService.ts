@@ -5,6 +5,8 @@
  */
 
 import fs from 'node:fs/promises';
+import { fileContentCache } from '../utils/fileContentCache.js';
+import { WorkspaceIgnoreService } from './workspaceIgnoreService.js';
 
 /**
  * Interface for file system operations that may be delegated to different implementations
@@ -28,14 +30,19 @@ export interface FileSystemService {
 }
 
 /**
- * Standard file system implementation
+ * Standard file system implementation. Reads go through the shared file
+ * content cache, so repeated reads of an unchanged file skip the disk.
  */
 export class StandardFileSystemService implements FileSystemService {
   async readTextFile(filePath: string): Promise<string> {
-    return fs.readFile(filePath, 'utf-8');
+    return fileContentCache.readText(filePath, () =>
+      fs.readFile(filePath, 'utf-8'),
+    );
   }
 
   async writeTextFile(filePath: string, content: string): Promise<void> {
+    fileContentCache.invalidate(filePath);
     await fs.writeFile(filePath, content, 'utf-8');
+    WorkspaceIgnoreService.notifyFileChanged(filePath);
   }
 }
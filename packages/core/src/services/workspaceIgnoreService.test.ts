@@ -0,0 +1,138 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { WorkspaceIgnoreService } from './workspaceIgnoreService.js';
+
+describe('WorkspaceIgnoreService', () => {
+  let projectRoot: string;
+
+  async function createTestFile(filePath: string, content = '') {
+    const fullPath = path.join(projectRoot, filePath);
+    await fs.mkdir(path.dirname(fullPath), { recursive: true });
+    await fs.writeFile(fullPath, content);
+    return fullPath;
+  }
+
+  beforeEach(async () => {
+    projectRoot = await fs.mkdtemp(path.join(os.tmpdir(), 'ignore-service-'));
+    await fs.mkdir(path.join(projectRoot, '.git'));
+  });
+
+  afterEach(async () => {
+    WorkspaceIgnoreService.reset();
+    await fs.rm(projectRoot, { recursive: true, force: true });
+  });
+
+  it('should be shared by everything working in the same root', () => {
+    expect(WorkspaceIgnoreService.forRoot(projectRoot)).toBe(
+      WorkspaceIgnoreService.forRoot(path.join(projectRoot, '.')),
+    );
+  });
+
+  it('should apply nested .gitignore files within their directory', async () => {
+    await createTestFile('.gitignore', '*.log\n');
+    await createTestFile('packages/app/.gitignore', 'dist/\n!keep.log\n');
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+
+    expect(service.isIgnored('debug.log', 'git')).toBe(true);
+    expect(service.isIgnored('packages/app/dist/index.js', 'git')).toBe(true);
+    expect(service.isIgnored('dist/index.js', 'git')).toBe(false);
+    expect(service.isIgnored('packages/app/keep.log', 'git')).toBe(false);
+    expect(service.isIgnored('packages/app/other.log', 'git')).toBe(true);
+    expect(service.isIgnored('.git/HEAD', 'git')).toBe(true);
+  });
+
+  it('should accept absolute paths and never ignore paths outside the root', async () => {
+    await createTestFile('.gitignore', 'secret.txt\n');
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+
+    expect(
+      service.isIgnored(path.join(projectRoot, 'secret.txt'), 'git'),
+    ).toBe(true);
+    expect(service.isIgnored('../secret.txt', 'git')).toBe(false);
+  });
+
+  it('should decide each directory once', async () => {
+    await createTestFile('.gitignore', 'node_modules/\n');
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+    service.resetStats();
+
+    for (let i = 0; i < 10; i++) {
+      expect(service.isIgnored(`node_modules/pkg/file${i}.js`, 'git')).toBe(
+        true,
+      );
+    }
+
+    expect(service.getStats()).toMatchObject({
+      checks: 10,
+      ignored: 10,
+      cacheMisses: 2,
+      cacheHits: 9,
+      ignoreFiles: 1,
+    });
+  });
+
+  it('should keep git and .qwenignore rules apart', async () => {
+    await fs.rm(path.join(projectRoot, '.git'), { recursive: true });
+    await createTestFile('.gitignore', 'build/\n');
+    await createTestFile('.qwenignore', 'secrets/\n');
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+
+    expect(service.isIgnored('build/out.js', 'git')).toBe(false);
+    expect(service.isIgnored('secrets/key.pem', 'qwen')).toBe(true);
+    expect(service.getPatterns('qwen')).toEqual(['secrets/']);
+  });
+
+  it('should reload rules when an ignore file is written', async () => {
+    const gitignore = await createTestFile('.gitignore', 'a.txt\n');
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+    expect(service.isIgnored('b.txt', 'git')).toBe(false);
+
+    await fs.writeFile(gitignore, 'b.txt\n');
+    WorkspaceIgnoreService.notifyFileChanged(gitignore);
+
+    expect(service.isIgnored('b.txt', 'git')).toBe(true);
+    expect(service.isIgnored('a.txt', 'git')).toBe(false);
+  });
+
+  it('should only reload for the exclude file of the repository', async () => {
+    const exclude = await createTestFile('.git/info/exclude', 'a.txt\n');
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+    expect(service.isIgnored('a.txt', 'git')).toBe(true);
+    service.resetStats();
+    service.isIgnored('dir/a.txt', 'git');
+
+    WorkspaceIgnoreService.notifyFileChanged(
+      await createTestFile('src/exclude', 'b.txt\n'),
+    );
+    service.isIgnored('dir/b.txt', 'git');
+    expect(service.getStats()).toMatchObject({ cacheHits: 1, cacheMisses: 1 });
+
+    await fs.writeFile(exclude, 'b.txt\n');
+    WorkspaceIgnoreService.notifyFileChanged(exclude);
+    expect(service.isIgnored('b.txt', 'git')).toBe(true);
+  });
+
+  it('should start afresh after a reset', () => {
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+    WorkspaceIgnoreService.reset();
+    expect(WorkspaceIgnoreService.forRoot(projectRoot)).not.toBe(service);
+  });
+
+  it('should notice ignore files changed or created outside', async () => {
+    const service = WorkspaceIgnoreService.forRoot(projectRoot);
+    expect(service.isIgnored('out/app.js', 'git')).toBe(false);
+
+    await createTestFile('.gitignore', 'out/\n');
+    service.revalidate();
+
+    expect(service.isIgnored('out/app.js', 'git')).toBe(true);
+  });
+});
@@ -0,0 +1,350 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import * as fs from 'node:fs';
+import * as path from 'node:path';
+import ignore, { type Ignore } from 'ignore';
+import { isGitRepository } from '../utils/gitUtils.js';
+
+export const GIT_IGNORE_FILE_NAME = '.gitignore';
+export const QWEN_IGNORE_FILE_NAME = '.qwenignore';
+
+/** Loaded ignore files are checked for changes at most this often. */
+const REVALIDATE_INTERVAL_MS = 1000;
+
+/**
+ * Which rules a path is checked against: `git` covers the `.gitignore` files
+ * of the repository, including nested ones, and `.git/info/exclude`; `qwen`
+ * covers the `.qwenignore` file at the workspace root.
+ */
+export type IgnoreSource = 'git' | 'qwen';
+
+export interface WorkspaceIgnoreStats {
+  /** Paths checked. */
+  checks: number;
+  /** Checked paths found ignored. */
+  ignored: number;
+  /** Directory decisions served from the cache. */
+  cacheHits: number;
+  /** Directory decisions computed from the rules. */
+  cacheMisses: number;
+  /** Ignore files currently loaded. */
+  ignoreFiles: number;
+}
+
+interface IgnoreScope {
+  /** Directory the rules apply to, relative to the root; '' for the root. */
+  dir: string;
+  matcher: Ignore;
+}
+
+interface SourceState {
+  /** Rules that apply inside each directory, outermost first. */
+  scopes: Map<string, IgnoreScope[]>;
+  /** Whether each directory, with everything in it, is ignored. */
+  ignoredDirs: Map<string, boolean>;
+}
+
+function parsePatterns(content: string): string[] {
+  return content
+    .split(/\r?\n/)
+    .map((p) => p.trim())
+    .filter((p) => p !== '' && !p.startsWith('#'));
+}
+
+function mtimeOf(filePath: string): number | undefined {
+  try {
+    return fs.statSync(filePath).mtimeMs;
+  } catch {
+    return undefined;
+  }
+}
+
+/**
+ * Ignore rules of one workspace root, shared by every file service and tool
+ * working in it. Each ignore file is parsed and compiled once. The rules that
+ * apply inside a directory, including those of nested `.gitignore` files, are
+ * assembled once per directory, and whether a directory is ignored is decided
+ * once per directory, so checking the many paths below it only matches their
+ * last segment. Everything is dropped when an ignore file changes: writes
+ * through the file system service invalidate immediately, and edits made
+ * outside are noticed within a second.
+ */
+export class WorkspaceIgnoreService {
+  private static readonly instances = new Map<
+    string,
+    WorkspaceIgnoreService
+  >();
+
+  /** Returns the service shared by everything working in `projectRoot`. */
+  static forRoot(projectRoot: string): WorkspaceIgnoreService {
+    const root = path.resolve(projectRoot);
+    let service = WorkspaceIgnoreService.instances.get(root);
+    if (!service) {
+      service = new WorkspaceIgnoreService(root);
+      WorkspaceIgnoreService.instances.set(root, service);
+    }
+    return service;
+  }
+
+  /**
+   * Invalidates the services whose rules `filePath` may contribute to. Call
+   * this after writing a file; other files are ignored cheaply.
+   */
+  static notifyFileChanged(filePath: string): void {
+    const name = path.basename(filePath);
+    const isExclude = name === 'exclude';
+    if (
+      name !== GIT_IGNORE_FILE_NAME &&
+      name !== QWEN_IGNORE_FILE_NAME &&
+      !isExclude
+    ) {
+      return;
+    }
+    const resolved = path.resolve(filePath);
+    for (const [root, service] of WorkspaceIgnoreService.instances) {
+      const affected = isExclude
+        ? resolved === path.join(root, '.git', 'info', 'exclude')
+        : resolved.startsWith(root + path.sep);
+      if (affected) {
+        service.invalidate();
+      }
+    }
+  }
+
+  /** Forgets every shared service, so the next lookups start afresh. */
+  static reset(): void {
+    WorkspaceIgnoreService.instances.clear();
+  }
+
+  private readonly root: string;
+  private isGitRepo = false;
+  private readonly sources = new Map<IgnoreSource, SourceState>();
+  /** Parsed patterns of each ignore file read, by absolute path. */
+  private readonly patternFiles = new Map<string, string[]>();
+  /** Modification times of the ignore files to watch; undefined if absent. */
+  private readonly watched = new Map<string, number | undefined>();
+  private lastValidated = 0;
+  private stats: Omit<WorkspaceIgnoreStats, 'ignoreFiles'> = {
+    checks: 0,
+    ignored: 0,
+    cacheHits: 0,
+    cacheMisses: 0,
+  };
+
+  private constructor(root: string) {
+    this.root = root;
+    this.invalidate();
+  }
+
+  /**
+   * Checks whether `filePath`, absolute or relative to the root, is ignored
+   * by the rules of `source`. Paths outside the root are never ignored. A
+   * trailing slash marks a directory, so directory-only patterns apply.
+   */
+  isIgnored(filePath: string, source: IgnoreSource): boolean {
+    const resolved = path.resolve(this.root, filePath);
+    const relativePath = path.relative(this.root, resolved);
+    if (relativePath === '' || relativePath.startsWith('..')) {
+      return false;
+    }
+    if (source === 'git' && !this.isGitRepo) {
+      return false;
+    }
+    this.revalidateIfStale();
+    this.stats.checks++;
+
+    // Even in windows, Ignore expects forward slashes.
+    const normalizedPath =
+      relativePath.replace(/\\/g, '/') +
+      (/[\\/]$/.test(filePath) ? '/' : '');
+    const lastSlash = normalizedPath.lastIndexOf(
+      '/',
+      normalizedPath.length - 2,
+    );
+    const parentDir =
+      lastSlash === -1 ? '' : normalizedPath.slice(0, lastSlash);
+    const ignored =
+      (parentDir !== '' && this.isDirIgnored(source, parentDir)) ||
+      this.matches(source, parentDir, normalizedPath);
+    if (ignored) this.stats.ignored++;
+    return ignored;
+  }
+
+  /**
+   * Returns the patterns of the ignore file at `relativePath` from the root,
+   * or an empty list when there is none. The file is parsed once and shared.
+   */
+  getFilePatterns(relativePath: string): string[] {
+    this.revalidateIfStale();
+    return this.readPatterns(path.join(this.root, relativePath), true);
+  }
+
+  /** Returns the patterns that apply across the whole root for `source`. */
+  getPatterns(source: IgnoreSource): string[] {
+    this.revalidateIfStale();
+    return this.rootPatterns(source);
+  }
+
+  /** Drops all parsed rules and cached decisions. */
+  invalidate(): void {
+    this.isGitRepo = isGitRepository(this.root);
+    this.sources.clear();
+    this.patternFiles.clear();
+    this.watched.clear();
+    this.lastValidated = Date.now();
+  }
+
+  /** Invalidates now if an ignore file read before has changed. */
+  revalidate(): void {
+    this.lastValidated = Date.now();
+    for (const [filePath, mtimeMs] of this.watched) {
+      if (mtimeOf(filePath) !== mtimeMs) {
+        this.invalidate();
+        return;
+      }
+    }
+  }
+
+  getStats(): WorkspaceIgnoreStats {
+    let ignoreFiles = 0;
+    for (const mtimeMs of this.watched.values()) {
+      if (mtimeMs !== undefined) ignoreFiles++;
+    }
+    return { ...this.stats, ignoreFiles };
+  }
+
+  resetStats(): void {
+    this.stats = { checks: 0, ignored: 0, cacheHits: 0, cacheMisses: 0 };
+  }
+
+  private revalidateIfStale(): void {
+    if (Date.now() - this.lastValidated >= REVALIDATE_INTERVAL_MS) {
+      this.revalidate();
+    }
+  }
+
+  private rootPatterns(source: IgnoreSource): string[] {
+    const read = (file: string) =>
+      this.readPatterns(path.join(this.root, file), true);
+    if (source === 'qwen') {
+      return read(QWEN_IGNORE_FILE_NAME);
+    }
+    if (!this.isGitRepo) {
+      return [];
+    }
+    // Always ignore .git directory regardless of .gitignore content
+    return [
+      '.git',
+      ...read(GIT_IGNORE_FILE_NAME),
+      ...read(path.join('.git', 'info', 'exclude')),
+    ];
+  }
+
+  private state(source: IgnoreSource): SourceState {
+    let state = this.sources.get(source);
+    if (!state) {
+      state = { scopes: new Map(), ignoredDirs: new Map() };
+      this.sources.set(source, state);
+    }
+    return state;
+  }
+
+  /**
+   * Reads an ignore file through the cache. Files at the root are watched
+   * even while absent, so creating one is noticed; a nested `.gitignore`
+   * created later is picked up on the next invalidation.
+   */
+  private readPatterns(filePath: string, watchIfAbsent: boolean): string[] {
+    const cached = this.patternFiles.get(filePath);
+    if (cached) return cached;
+    let patterns: string[] = [];
+    const mtimeMs = mtimeOf(filePath);
+    if (mtimeMs !== undefined) {
+      try {
+        patterns = parsePatterns(fs.readFileSync(filePath, 'utf-8'));
+      } catch {
+        // Unreadable ignore files, such as directories, add no rules.
+      }
+    }
+    if (mtimeMs !== undefined || watchIfAbsent) {
+      this.watched.set(filePath, mtimeMs);
+    }
+    this.patternFiles.set(filePath, patterns);
+    return patterns;
+  }
+
+  private scopesFor(source: IgnoreSource, dir: string): IgnoreScope[] {
+    const { scopes } = this.state(source);
+    let result = scopes.get(dir);
+    if (result) return result;
+
+    if (dir === '') {
+      const patterns = this.rootPatterns(source);
+      result =
+        patterns.length > 0 ? [{ dir, matcher: ignore().add(patterns) }] : [];
+    } else {
+      const slash = dir.lastIndexOf('/');
+      const parent = this.scopesFor(
+        source,
+        slash === -1 ? '' : dir.slice(0, slash),
+      );
+      const patterns =
+        source === 'git'
+          ? this.readPatterns(
+              path.join(this.root, dir, GIT_IGNORE_FILE_NAME),
+              false,
+            )
+          : [];
+      result =
+        patterns.length > 0
+          ? [...parent, { dir, matcher: ignore().add(patterns) }]
+          : parent;
+    }
+    scopes.set(dir, result);
+    return result;
+  }
+
+  private isDirIgnored(source: IgnoreSource, dir: string): boolean {
+    const { ignoredDirs } = this.state(source);
+    const cached = ignoredDirs.get(dir);
+    if (cached !== undefined) {
+      this.stats.cacheHits++;
+      return cached;
+    }
+    this.stats.cacheMisses++;
+    const slash = dir.lastIndexOf('/');
+    const parent = slash === -1 ? '' : dir.slice(0, slash);
+    const ignored =
+      (parent !== '' && this.isDirIgnored(source, parent)) ||
+      this.matches(source, parent, `${dir}/`);
+    ignoredDirs.set(dir, ignored);
+    return ignored;
+  }
+
+  /**
+   * Matches `relativePath` against the rules that apply in `dir`, its parent
+   * directory. Rules of deeper ignore files take precedence.
+   */
+  private matches(
+    source: IgnoreSource,
+    dir: string,
+    relativePath: string,
+  ): boolean {
+    const scopes = this.scopesFor(source, dir);
+    for (let i = scopes.length - 1; i >= 0; i--) {
+      const scope = scopes[i];
+      const scoped =
+        scope.dir === ''
+          ? relativePath
+          : relativePath.slice(scope.dir.length + 1);
+      const { ignored, unignored } = scope.matcher.test(scoped);
+      if (ignored) return true;
+      if (unignored) return false;
+    }
+    return false;
+  }
+}
@@ -40,6 +40,7 @@ export { SubagentValidator } from './validation.js';
 
 // Main management class
 export { SubagentManager } from './subagent-manager.js';
+export type { SubagentManagerOptions } from './subagent-manager.js';
 
 // Re-export existing runtime types for convenience
 export type {
@@ -52,6 +53,17 @@ export type {
 
 export { SubAgentScope } from './subagent.js';
 
+// Execution pool shared by concurrent subagent runs
+export type {
+  SubagentPoolOptions,
+  SubagentPoolStats,
+  SubagentSlot,
+} from './subagent-pool.js';
+export {
+  SubagentPool,
+  getDefaultSubagentTokenBudget,
+} from './subagent-pool.js';
+
 // Event system for UI integration
 export type {
   SubAgentEvent,
@@ -6,9 +6,11 @@
 
 import { vi, describe, it, expect, beforeEach, afterEach } from 'vitest';
 import * as fs from 'fs/promises';
+import { mkdtempSync, rmSync } from 'fs';
 import * as path from 'path';
 import * as os from 'os';
 import { SubagentManager } from './subagent-manager.js';
+import { getDefaultSubagentTokenBudget } from './subagent-pool.js';
 import { type SubagentConfig, SubagentError } from './types.js';
 import type { ToolRegistry } from '../tools/tool-registry.js';
 import type { Config } from '../config/config.js';
@@ -44,8 +46,12 @@ describe('SubagentManager', () => {
   let manager: SubagentManager;
   let mockToolRegistry: ToolRegistry;
   let mockConfig: Config;
+  let fileCacheDir: string;
 
-  beforeEach(() => {
+  beforeEach(async () => {
+    // The parsed-file cache is written for real; keep it out of the home dir.
+    const { tmpdir } = await vi.importActual<typeof os>('os');
+    fileCacheDir = mkdtempSync(path.join(tmpdir(), 'subagent-cache-'));
     mockToolRegistry = {
       getAllTools: vi.fn().mockReturnValue([
         { name: 'read_file', displayName: 'Read File' },
@@ -157,10 +163,14 @@ describe('SubagentManager', () => {
       return yaml.trim();
     });
 
-    manager = new SubagentManager(mockConfig);
+    manager = new SubagentManager(mockConfig, {
+      fileCachePath: path.join(fileCacheDir, 'subagents.json'),
+    });
   });
 
   afterEach(() => {
+    manager.dispose();
+    rmSync(fileCacheDir, { recursive: true, force: true });
     vi.restoreAllMocks();
   });
 
@@ -1136,4 +1146,39 @@ System prompt 3`);
       });
     });
   });
+
+  describe('getPool', () => {
+    it('should queue subagents once the configured token budget is used', async () => {
+      const pool = new SubagentManager(
+        makeFakeConfig({ subagentTokenBudget: 100 }),
+      ).getPool();
+      const first = await pool.acquire();
+      first.recordTokens(60);
+      const second = await pool.acquire();
+      second.recordTokens(60);
+
+      const third = pool.acquire();
+      expect(pool.getStats().queued).toBe(1);
+
+      first.release();
+      await third;
+      expect(pool.getStats()).toMatchObject({ running: 2, queued: 0 });
+    });
+
+    it('should default the token budget to context windows of the model', async () => {
+      const config = makeFakeConfig();
+      const pool = new SubagentManager(config).getPool();
+      const budget = getDefaultSubagentTokenBudget(config.getModel());
+      expect(budget).toBeGreaterThan(0);
+
+      const first = await pool.acquire();
+      first.recordTokens(budget - 1);
+      await pool.acquire();
+      expect(pool.getStats().queued).toBe(0);
+
+      first.recordTokens(1);
+      void pool.acquire();
+      expect(pool.getStats().queued).toBe(1);
+    });
+  });
 });
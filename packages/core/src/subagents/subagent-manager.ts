@@ -5,6 +5,7 @@
  */
 
 import * as fs from 'fs/promises';
+import { watch, type FSWatcher } from 'fs';
 import * as path from 'path';
 import * as os from 'os';
 // Note: yaml package would need to be added as a dependency
@@ -27,11 +28,24 @@ import type {
 import { SubagentError, SubagentErrorCode } from './types.js';
 import { SubagentValidator } from './validation.js';
 import { SubAgentScope } from './subagent.js';
+import {
+  SubagentPool,
+  getDefaultSubagentTokenBudget,
+} from './subagent-pool.js';
 import type { Config } from '../config/config.js';
 import { BuiltinAgentRegistry } from './builtin-agents.js';
+import { FileMetadataCache } from '../utils/fileMetadataCache.js';
+import type { FileStamp } from '../utils/fileMetadataCache.js';
 
 const QWEN_CONFIG_DIR = '.kolosal';
 const AGENT_CONFIG_DIR = 'agents';
+const FILE_CACHE_NAME = 'subagents';
+const WATCH_DEBOUNCE_MS = 100;
+
+export interface SubagentManagerOptions {
+  /** Overrides where parsed subagent files are cached between sessions. */
+  fileCachePath?: string;
+}
 
 /**
  * Manages subagent configurations stored as Markdown files with YAML frontmatter.
@@ -41,9 +55,52 @@ export class SubagentManager {
   private readonly validator: SubagentValidator;
   private subagentsCache: Map<SubagentLevel, SubagentConfig[]> | null = null;
   private readonly changeListeners: Set<() => void> = new Set();
-
-  constructor(private readonly config: Config) {
+  private readonly pool: SubagentPool;
+  private readonly fileCache: FileMetadataCache<SubagentConfig>;
+  private readonly watchers = new Map<string, FSWatcher>();
+  private readonly pendingLevelRefreshes = new Map<
+    SubagentLevel,
+    NodeJS.Timeout
+  >();
+
+  constructor(
+    private readonly config: Config,
+    options: SubagentManagerOptions = {},
+  ) {
     this.validator = new SubagentValidator();
+    this.fileCache = new FileMetadataCache(FILE_CACHE_NAME, {
+      filePath: options.fileCachePath,
+    });
+    this.pool = new SubagentPool({
+      tokenBudget: () =>
+        config.getSubagentTokenBudget() ??
+        getDefaultSubagentTokenBudget(
+          config.getModel(),
+          config.getContentGeneratorConfig()?.baseUrl,
+        ),
+    });
+  }
+
+  /**
+   * Stops watching the subagent directories.
+   */
+  dispose(): void {
+    for (const watcher of this.watchers.values()) {
+      watcher.close();
+    }
+    this.watchers.clear();
+    for (const timer of this.pendingLevelRefreshes.values()) {
+      clearTimeout(timer);
+    }
+    this.pendingLevelRefreshes.clear();
+  }
+
+  /**
+   * Returns the pool that schedules subagent runs and holds their shared,
+   * warm resources.
+   */
+  getPool(): SubagentPool {
+    return this.pool;
   }
 
   addChangeListener(listener: () => void): () => void {
@@ -341,23 +398,75 @@ export class SubagentManager {
   /**
    * Refreshes the subagents cache by loading all subagents from disk.
    * This method is called automatically when cache is null or when force=true.
+   * Files whose mtime and size are unchanged are not parsed again.
    *
    * @private
    */
   private async refreshCache(): Promise<void> {
-    const subagentsCache = new Map();
-
     const levels: SubagentLevel[] = ['project', 'user', 'builtin'];
 
-    for (const level of levels) {
-      const levelSubagents = await this.listSubagentsAtLevel(level);
-      subagentsCache.set(level, levelSubagents);
-    }
+    const results = await Promise.all(
+      levels.map((level) => this.listSubagentsAtLevel(level)),
+    );
 
-    this.subagentsCache = subagentsCache;
+    this.subagentsCache = new Map(
+      levels.map((level, index) => [level, results[index]]),
+    );
+    this.watchSubagentDirs();
     this.notifyChangeListeners();
   }
 
+  /**
+   * Reloads a single level after its directory changed on disk.
+   */
+  private async refreshLevel(level: SubagentLevel): Promise<void> {
+    const levelSubagents = await this.listSubagentsAtLevel(level);
+    if (!this.subagentsCache) {
+      return;
+    }
+    this.subagentsCache.set(level, levelSubagents);
+    this.notifyChangeListeners();
+  }
+
+  /**
+   * Watches the project and user subagent directories so that edits made
+   * outside the CLI are picked up without a full rescan. Directories that
+   * don't exist yet are not watched; creating a subagent through the manager
+   * refreshes the cache explicitly.
+   */
+  private watchSubagentDirs(): void {
+    for (const level of ['project', 'user'] as const) {
+      const dir = this.getLevelDir(level);
+      if (!dir || this.watchers.has(dir)) {
+        continue;
+      }
+      try {
+        const watcher = watch(dir, () => this.scheduleLevelRefresh(level));
+        watcher.on('error', () => {
+          watcher.close();
+          this.watchers.delete(dir);
+        });
+        watcher.unref();
+        this.watchers.set(dir, watcher);
+      } catch (_error) {
+        // Directory doesn't exist or can't be watched
+      }
+    }
+  }
+
+  private scheduleLevelRefresh(level: SubagentLevel): void {
+    // Editors typically emit several events per save; coalesce them.
+    clearTimeout(this.pendingLevelRefreshes.get(level));
+    const timer = setTimeout(() => {
+      this.pendingLevelRefreshes.delete(level);
+      this.refreshLevel(level).catch((error) => {
+        console.warn(`Failed to reload ${level} subagents:`, error);
+      });
+    }, WATCH_DEBOUNCE_MS);
+    timer.unref?.();
+    this.pendingLevelRefreshes.set(level, timer);
+  }
+
   /**
    * Finds a subagent by name and returns its metadata.
    *
@@ -549,6 +658,7 @@ export class SubagentManager {
         runtimeConfig.toolConfig,
         options?.eventEmitter,
         options?.hooks,
+        this.pool,
       );
     } catch (error) {
       if (error instanceof Error) {
@@ -714,44 +824,88 @@ export class SubagentManager {
       return BuiltinAgentRegistry.getBuiltinAgents();
     }
 
-    const projectRoot = this.config.getProjectRoot();
-    const homeDir = os.homedir();
-    const isHomeDirectory = path.resolve(projectRoot) === path.resolve(homeDir);
-
-    // If project level is requested but project root is same as home directory,
-    // return empty array to avoid conflicts between project and global agents
-    if (level === 'project' && isHomeDirectory) {
+    const baseDir = this.getLevelDir(level);
+    if (!baseDir) {
       return [];
     }
 
-    let baseDir = level === 'project' ? projectRoot : homeDir;
-    baseDir = path.join(baseDir, QWEN_CONFIG_DIR, AGENT_CONFIG_DIR);
-
     try {
       const files = await fs.readdir(baseDir);
-      const subagents: SubagentConfig[] = [];
-
-      for (const file of files) {
-        if (!file.endsWith('.md')) continue;
+      await this.fileCache.load();
 
-        const filePath = path.join(baseDir, file);
+      const filePaths = files
+        .filter((file) => file.endsWith('.md'))
+        .map((file) => path.join(baseDir, file));
+      const results = await Promise.all(
+        filePaths.map((filePath) => this.loadSubagentFile(filePath, level)),
+      );
 
-        try {
-          const config = await this.parseSubagentFile(filePath, level);
-          subagents.push(config);
-        } catch (_error) {
-          // Ignore invalid files
-          continue;
-        }
-      }
+      this.fileCache.pruneDirectory(baseDir, filePaths);
+      void this.fileCache.save();
 
-      return subagents;
+      return results.filter(
+        (config): config is SubagentConfig => config !== null,
+      );
     } catch (_error) {
       // Directory doesn't exist or can't be read
       return [];
     }
   }
 
+  /**
+   * Parses a subagent file, reusing the cached result if the file's mtime and
+   * size haven't changed. Returns null for invalid files.
+   */
+  private async loadSubagentFile(
+    filePath: string,
+    level: SubagentLevel,
+  ): Promise<SubagentConfig | null> {
+    let stamp: FileStamp | undefined;
+    try {
+      stamp = await fs.stat(filePath);
+    } catch (_error) {
+      stamp = undefined;
+    }
+
+    const cached = this.fileCache.get(filePath, stamp);
+    if (cached && cached.level === level) {
+      return cached;
+    }
+
+    try {
+      const config = await this.parseSubagentFile(filePath, level);
+      this.fileCache.set(filePath, stamp, config);
+      return config;
+    } catch (_error) {
+      // Ignore invalid files
+      this.fileCache.delete(filePath);
+      return null;
+    }
+  }
+
+  /**
+   * Returns the directory holding file-based subagents for a level, or null
+   * if the level has no directory. The project level is skipped when the
+   * project root is the home directory, to avoid conflicts between project
+   * and global agents.
+   */
+  private getLevelDir(level: SubagentLevel): string | null {
+    if (level === 'builtin') {
+      return null;
+    }
+
+    const projectRoot = this.config.getProjectRoot();
+    const homeDir = os.homedir();
+    const isHomeDirectory = path.resolve(projectRoot) === path.resolve(homeDir);
+
+    if (level === 'project' && isHomeDirectory) {
+      return null;
+    }
+
+    const baseDir = level === 'project' ? projectRoot : homeDir;
+    return path.join(baseDir, QWEN_CONFIG_DIR, AGENT_CONFIG_DIR);
+  }
+
   /**
    * Finds a subagent by name at a specific level by scanning all files.
    * This method ensures we find subagents even if the filename doesn't match the name.
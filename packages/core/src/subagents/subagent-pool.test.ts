@@ -0,0 +1,124 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, it, expect, vi, beforeEach } from 'vitest';
+import { SubagentPool } from './subagent-pool.js';
+import type { Config } from '../config/config.js';
+import { createContentGenerator } from '../core/contentGenerator.js';
+import type { ContentGenerator } from '../core/contentGenerator.js';
+import { getEnvironmentContext } from '../utils/environmentContext.js';
+
+vi.mock('../core/contentGenerator.js');
+vi.mock('../utils/environmentContext.js');
+
+describe('SubagentPool', () => {
+  beforeEach(() => {
+    vi.resetAllMocks();
+  });
+
+  describe('acquire', () => {
+    it('should run up to maxConcurrent subagents and queue the rest', async () => {
+      const pool = new SubagentPool({ maxConcurrent: 2 });
+      const first = await pool.acquire();
+      const second = await pool.acquire();
+
+      let thirdStarted = false;
+      const third = pool.acquire().then((slot) => {
+        thirdStarted = true;
+        return slot;
+      });
+      await Promise.resolve();
+      expect(thirdStarted).toBe(false);
+      expect(pool.getStats()).toMatchObject({ running: 2, queued: 1 });
+
+      first.release();
+      const thirdSlot = await third;
+      expect(thirdStarted).toBe(true);
+      expect(pool.getStats()).toMatchObject({
+        running: 2,
+        queued: 0,
+        completed: 1,
+      });
+
+      second.release();
+      thirdSlot.release();
+      expect(pool.getStats()).toMatchObject({ running: 0, completed: 3 });
+    });
+
+    it('should queue new subagents while the token budget is exhausted', async () => {
+      const pool = new SubagentPool({ maxConcurrent: 4, tokenBudget: 100 });
+      const first = await pool.acquire();
+      first.recordTokens(150);
+
+      let secondStarted = false;
+      const second = pool.acquire().then((slot) => {
+        secondStarted = true;
+        return slot;
+      });
+      await Promise.resolve();
+      expect(secondStarted).toBe(false);
+
+      first.release();
+      (await second).release();
+      expect(secondStarted).toBe(true);
+      expect(pool.getStats().tokensInFlight).toBe(0);
+    });
+
+    it('should reject queued subagents when cancelled', async () => {
+      const pool = new SubagentPool({ maxConcurrent: 1 });
+      const first = await pool.acquire();
+      const controller = new AbortController();
+      const queued = pool.acquire(controller.signal);
+
+      controller.abort();
+      await expect(queued).rejects.toThrow('cancelled while queued');
+      expect(pool.getStats().queued).toBe(0);
+      first.release();
+    });
+
+    it('should ignore repeated release calls', async () => {
+      const pool = new SubagentPool({ maxConcurrent: 1 });
+      const slot = await pool.acquire();
+      slot.release();
+      slot.release();
+      expect(pool.getStats()).toMatchObject({ running: 0, completed: 1 });
+    });
+  });
+
+  describe('warm resources', () => {
+    const generatorConfig = { model: 'test-model' };
+    const runtimeContext = {
+      getContentGeneratorConfig: vi.fn(() => generatorConfig),
+      getSessionId: vi.fn(() => 'session'),
+    } as unknown as Config;
+
+    it('should reuse the content generator while its config is unchanged', async () => {
+      vi.mocked(createContentGenerator).mockResolvedValue(
+        {} as ContentGenerator,
+      );
+      const pool = new SubagentPool();
+
+      const a = await pool.getContentGenerator(runtimeContext);
+      const b = await pool.getContentGenerator(runtimeContext);
+
+      expect(a).toBe(b);
+      expect(createContentGenerator).toHaveBeenCalledTimes(1);
+    });
+
+    it('should share the environment context within the TTL', async () => {
+      vi.mocked(getEnvironmentContext).mockResolvedValue([{ text: 'env' }]);
+      const pool = new SubagentPool({ sharedCacheTtlMs: 60_000 });
+
+      await pool.getEnvironmentContext(runtimeContext);
+      await pool.getEnvironmentContext(runtimeContext);
+      expect(getEnvironmentContext).toHaveBeenCalledTimes(1);
+
+      pool.clearCaches();
+      await pool.getEnvironmentContext(runtimeContext);
+      expect(getEnvironmentContext).toHaveBeenCalledTimes(2);
+    });
+  });
+});
@@ -0,0 +1,268 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import type { Part } from '@google/genai';
+import type { Config } from '../config/config.js';
+import type {
+  ContentGenerator,
+  ContentGeneratorConfig,
+} from '../core/contentGenerator.js';
+import { createContentGenerator } from '../core/contentGenerator.js';
+import { tokenLimit } from '../core/tokenLimits.js';
+import { getEnvironmentContext } from '../utils/environmentContext.js';
+
+export interface SubagentPoolOptions {
+  /** Maximum number of subagents running at the same time. */
+  maxConcurrent?: number;
+  /**
+   * Maximum number of tokens that running subagents may consume together
+   * before new subagents are queued. 0 disables the budget. A function is
+   * read on every admission, so the budget can follow model changes.
+   */
+  tokenBudget?: number | (() => number);
+  /**
+   * How long read-only data shared between subagents (environment context,
+   * tool declarations) stays valid, in milliseconds.
+   */
+  sharedCacheTtlMs?: number;
+}
+
+export interface SubagentPoolStats {
+  running: number;
+  queued: number;
+  completed: number;
+  tokensInFlight: number;
+  totalQueueTimeMs: number;
+  maxQueueTimeMs: number;
+}
+
+/**
+ * A running subagent's reservation in the pool. Must be released exactly once.
+ */
+export interface SubagentSlot {
+  /** Time spent waiting for the slot, in milliseconds. */
+  readonly queueTimeMs: number;
+  /** Adds tokens consumed by the subagent to the pool's in-flight total. */
+  recordTokens(tokens: number): void;
+  release(): void;
+}
+
+interface Waiter {
+  enqueuedAt: number;
+  resolve: (slot: SubagentSlot) => void;
+  reject: (error: Error) => void;
+  signal?: AbortSignal;
+  onAbort?: () => void;
+}
+
+interface SharedEntry<T> {
+  value: Promise<T>;
+  expiresAt: number;
+}
+
+const DEFAULT_MAX_CONCURRENT = 4;
+const DEFAULT_SHARED_CACHE_TTL_MS = 5_000;
+/** Context windows that running subagents may consume together by default. */
+const DEFAULT_TOKEN_BUDGET_CONTEXT_WINDOWS = 4;
+
+/**
+ * Returns the token budget used when none is configured: a few context
+ * windows of `model`, one for each subagent the pool runs at once by default.
+ */
+export function getDefaultSubagentTokenBudget(
+  model: string,
+  baseUrl?: string,
+): number {
+  return (
+    DEFAULT_TOKEN_BUDGET_CONTEXT_WINDOWS * tokenLimit(model, 'input', baseUrl)
+  );
+}
+
+/**
+ * Schedules subagent executions launched by the task tool.
+ *
+ * Multiple task calls in one model turn are executed concurrently by the tool
+ * scheduler; the pool bounds how many of them run at once and how many tokens
+ * they may consume together. It also keeps warm resources that would otherwise
+ * be rebuilt by every subagent: the content generator and short-lived,
+ * read-only data such as the environment context and tool declarations.
+ */
+export class SubagentPool {
+  private readonly maxConcurrent: number;
+  private readonly tokenBudget: () => number;
+  private readonly sharedCacheTtlMs: number;
+
+  private running = 0;
+  private tokensInFlight = 0;
+  private completed = 0;
+  private totalQueueTimeMs = 0;
+  private maxQueueTimeMs = 0;
+  private readonly waiters: Waiter[] = [];
+
+  private contentGenerator:
+    | { config: ContentGeneratorConfig; value: Promise<ContentGenerator> }
+    | undefined;
+  private readonly shared = new Map<string, SharedEntry<unknown>>();
+
+  constructor(options: SubagentPoolOptions = {}) {
+    this.maxConcurrent = Math.max(
+      1,
+      options.maxConcurrent ?? DEFAULT_MAX_CONCURRENT,
+    );
+    const tokenBudget = options.tokenBudget ?? 0;
+    this.tokenBudget =
+      typeof tokenBudget === 'function' ? tokenBudget : () => tokenBudget;
+    this.sharedCacheTtlMs =
+      options.sharedCacheTtlMs ?? DEFAULT_SHARED_CACHE_TTL_MS;
+  }
+
+  /**
+   * Waits until the subagent may start and returns its slot.
+   * @throws {Error} If the signal is aborted while waiting.
+   */
+  acquire(signal?: AbortSignal): Promise<SubagentSlot> {
+    const enqueuedAt = Date.now();
+    if (signal?.aborted) {
+      return Promise.reject(new Error('Subagent was cancelled while queued.'));
+    }
+    if (this.hasCapacity()) {
+      return Promise.resolve(this.createSlot(enqueuedAt));
+    }
+
+    return new Promise<SubagentSlot>((resolve, reject) => {
+      const waiter: Waiter = { enqueuedAt, resolve, reject, signal };
+      if (signal) {
+        waiter.onAbort = () => {
+          const index = this.waiters.indexOf(waiter);
+          if (index >= 0) {
+            this.waiters.splice(index, 1);
+          }
+          reject(new Error('Subagent was cancelled while queued.'));
+        };
+        signal.addEventListener('abort', waiter.onAbort, { once: true });
+      }
+      this.waiters.push(waiter);
+    });
+  }
+
+  /**
+   * Returns a content generator shared by all subagents for as long as the
+   * runtime's content generator configuration does not change.
+   */
+  getContentGenerator(runtimeContext: Config): Promise<ContentGenerator> {
+    const generatorConfig = runtimeContext.getContentGeneratorConfig();
+    const cached = this.contentGenerator;
+    if (cached && cached.config === generatorConfig) {
+      return cached.value;
+    }
+    const value = createContentGenerator(
+      generatorConfig,
+      runtimeContext,
+      runtimeContext.getSessionId(),
+    );
+    // Don't keep a failed generator around; the next subagent retries.
+    value.catch(() => {
+      if (this.contentGenerator?.value === value) {
+        this.contentGenerator = undefined;
+      }
+    });
+    this.contentGenerator = { config: generatorConfig, value };
+    return value;
+  }
+
+  /**
+   * Returns the environment context, shared between subagents started within
+   * the shared cache TTL.
+   */
+  getEnvironmentContext(runtimeContext: Config): Promise<Part[]> {
+    return this.getShared('environment', () =>
+      getEnvironmentContext(runtimeContext),
+    );
+  }
+
+  /**
+   * Returns a read-only value shared between subagents started within the
+   * shared cache TTL, computing it with `factory` on a miss.
+   */
+  getShared<T>(key: string, factory: () => Promise<T> | T): Promise<T> {
+    const now = Date.now();
+    const existing = this.shared.get(key) as SharedEntry<T> | undefined;
+    if (existing && existing.expiresAt > now) {
+      return existing.value;
+    }
+    const value = Promise.resolve().then(factory);
+    value.catch(() => this.shared.delete(key));
+    this.shared.set(key, { value, expiresAt: now + this.sharedCacheTtlMs });
+    return value;
+  }
+
+  /**
+   * Drops warm resources so the next subagent rebuilds them.
+   */
+  clearCaches(): void {
+    this.contentGenerator = undefined;
+    this.shared.clear();
+  }
+
+  getStats(): SubagentPoolStats {
+    return {
+      running: this.running,
+      queued: this.waiters.length,
+      completed: this.completed,
+      tokensInFlight: this.tokensInFlight,
+      totalQueueTimeMs: this.totalQueueTimeMs,
+      maxQueueTimeMs: this.maxQueueTimeMs,
+    };
+  }
+
+  private hasCapacity(): boolean {
+    if (this.running >= this.maxConcurrent) {
+      return false;
+    }
+    if (this.running === 0) {
+      // Always let at least one subagent run so a budget can't deadlock.
+      return true;
+    }
+    const tokenBudget = this.tokenBudget();
+    return !(tokenBudget > 0) || this.tokensInFlight < tokenBudget;
+  }
+
+  private createSlot(enqueuedAt: number): SubagentSlot {
+    const queueTimeMs = Date.now() - enqueuedAt;
+    this.running++;
+    this.totalQueueTimeMs += queueTimeMs;
+    this.maxQueueTimeMs = Math.max(this.maxQueueTimeMs, queueTimeMs);
+
+    let tokens = 0;
+    let released = false;
+    return {
+      queueTimeMs,
+      recordTokens: (count: number) => {
+        if (released || !(count > 0)) return;
+        tokens += count;
+        this.tokensInFlight += count;
+      },
+      release: () => {
+        if (released) return;
+        released = true;
+        this.running--;
+        this.completed++;
+        this.tokensInFlight -= tokens;
+        this.drain();
+      },
+    };
+  }
+
+  private drain(): void {
+    while (this.waiters.length > 0 && this.hasCapacity()) {
+      const waiter = this.waiters.shift()!;
+      if (waiter.signal && waiter.onAbort) {
+        waiter.signal.removeEventListener('abort', waiter.onAbort);
+      }
+      waiter.resolve(this.createSlot(waiter.enqueuedAt));
+    }
+  }
+}
@@ -17,6 +17,8 @@ export interface ToolUsageStats {
 export interface SubagentStatsSummary {
   rounds: number;
   totalDurationMs: number;
+  /** Time spent waiting in the subagent pool before the run started. */
+  queueTimeMs: number;
   totalToolCalls: number;
   successfulToolCalls: number;
   failedToolCalls: number;
@@ -30,6 +32,7 @@ export interface SubagentStatsSummary {
 
 export class SubagentStatistics {
   private startTimeMs = 0;
+  private queueTimeMs = 0;
   private rounds = 0;
   private totalToolCalls = 0;
   private successfulToolCalls = 0;
@@ -42,6 +45,10 @@ export class SubagentStatistics {
     this.startTimeMs = now;
   }
 
+  setQueueTime(queueTimeMs: number) {
+    this.queueTimeMs = Math.max(0, queueTimeMs || 0);
+  }
+
   setRounds(rounds: number) {
     this.rounds = rounds;
   }
@@ -91,6 +98,7 @@ export class SubagentStatistics {
     return {
       rounds: this.rounds,
       totalDurationMs,
+      queueTimeMs: this.queueTimeMs,
       totalToolCalls,
       successfulToolCalls: this.successfulToolCalls,
       failedToolCalls: this.failedToolCalls,
@@ -113,7 +121,7 @@ export class SubagentStatistics {
     const lines = [
       `📋 Task Completed: ${taskDesc}`,
       `🔧 Tool Usage: ${stats.totalToolCalls} calls${stats.totalToolCalls ? `, ${sr.toFixed(1)}% success` : ''}`,
-      `⏱️ Duration: ${this.fmtDuration(stats.totalDurationMs)} | 🔁 Rounds: ${stats.rounds}`,
+      `⏱️ Duration: ${this.fmtDuration(stats.totalDurationMs)} | 🔁 Rounds: ${stats.rounds}${stats.queueTimeMs ? ` | ⏳ Queued: ${this.fmtDuration(stats.queueTimeMs)}` : ''}`,
     ];
     if (typeof stats.totalTokens === 'number') {
       lines.push(
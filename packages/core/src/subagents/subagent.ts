@@ -52,6 +52,7 @@ import {
   type SubagentStatsSummary,
 } from './subagent-statistics.js';
 import type { SubagentHooks } from './subagent-hooks.js';
+import type { SubagentPool, SubagentSlot } from './subagent-pool.js';
 import { logSubagentExecution } from '../telemetry/loggers.js';
 import { SubagentExecutionEvent } from '../telemetry/types.js';
 import { TaskTool } from '../tools/task.js';
@@ -189,6 +190,15 @@ export class SubAgentScope {
   private readonly stats = new SubagentStatistics();
   private hooks?: SubagentHooks;
   private readonly subagentId: string;
+  private pool?: SubagentPool;
+  private slot?: SubagentSlot;
+  private toolScheduler?: CoreToolScheduler;
+  private toolBatch?: {
+    round: number;
+    responseParts: Part[];
+    responded: Set<string>;
+    resolve: () => void;
+  };
 
   /**
    * Constructs a new SubAgentScope instance.
@@ -198,6 +208,7 @@ export class SubAgentScope {
    * @param modelConfig - Configuration for the generative model parameters.
    * @param runConfig - Configuration for the subagent's execution environment.
    * @param toolConfig - Optional configuration for tools available to the subagent.
+   * @param pool - Optional pool that bounds concurrency and provides warm resources.
    */
   private constructor(
     readonly name: string,
@@ -208,11 +219,13 @@ export class SubAgentScope {
     private readonly toolConfig?: ToolConfig,
     eventEmitter?: SubAgentEventEmitter,
     hooks?: SubagentHooks,
+    pool?: SubagentPool,
   ) {
     const randomPart = Math.random().toString(36).slice(2, 8);
     this.subagentId = `${this.name}-${randomPart}`;
     this.eventEmitter = eventEmitter;
     this.hooks = hooks;
+    this.pool = pool;
   }
 
   /**
@@ -225,6 +238,7 @@ export class SubAgentScope {
    * @param {ModelConfig} modelConfig - Configuration for the generative model parameters.
    * @param {RunConfig} runConfig - Configuration for the subagent's execution environment.
    * @param {ToolConfig} [toolConfig] - Optional configuration for tools.
+   * @param {SubagentPool} [pool] - Optional pool used to queue the run and share warm resources.
    * @returns {Promise<SubAgentScope>} A promise that resolves to a valid SubAgentScope instance.
    * @throws {Error} If any tool requires user confirmation.
    */
@@ -237,6 +251,7 @@ export class SubAgentScope {
     toolConfig?: ToolConfig,
     eventEmitter?: SubAgentEventEmitter,
     hooks?: SubagentHooks,
+    pool?: SubagentPool,
   ): Promise<SubAgentScope> {
     return new SubAgentScope(
       name,
@@ -247,6 +262,7 @@ export class SubAgentScope {
       toolConfig,
       eventEmitter,
       hooks,
+      pool,
     );
   }
 
@@ -260,6 +276,28 @@ export class SubAgentScope {
   async runNonInteractive(
     context: ContextState,
     externalSignal?: AbortSignal,
+  ): Promise<void> {
+    if (this.pool) {
+      try {
+        this.slot = await this.pool.acquire(externalSignal);
+      } catch {
+        this.terminateMode = SubagentTerminateMode.CANCELLED;
+        return;
+      }
+      this.stats.setQueueTime(this.slot.queueTimeMs);
+    }
+    try {
+      await this.execute(context, externalSignal);
+    } finally {
+      this.slot?.release();
+      this.slot = undefined;
+      this.toolScheduler = undefined;
+    }
+  }
+
+  private async execute(
+    context: ContextState,
+    externalSignal?: AbortSignal,
   ): Promise<void> {
     const chat = await this.createChatObject(context);
 
@@ -278,40 +316,11 @@ export class SubAgentScope {
       }
       externalSignal.addEventListener('abort', onAbort, { once: true });
     }
-    const toolRegistry = this.runtimeContext.getToolRegistry();
-
-    // Prepare the list of tools available to the subagent.
-    // If no explicit toolConfig or it contains "*" or is empty, inherit all tools.
-    const toolsList: FunctionDeclaration[] = [];
-    if (this.toolConfig) {
-      const asStrings = this.toolConfig.tools.filter(
-        (t): t is string => typeof t === 'string',
-      );
-      const hasWildcard = asStrings.includes('*');
-      const onlyInlineDecls = this.toolConfig.tools.filter(
-        (t): t is FunctionDeclaration => typeof t !== 'string',
-      );
-
-      if (hasWildcard || asStrings.length === 0) {
-        toolsList.push(
-          ...toolRegistry
-            .getFunctionDeclarations()
-            .filter((t) => t.name !== TaskTool.Name),
-        );
-      } else {
-        toolsList.push(
-          ...toolRegistry.getFunctionDeclarationsFiltered(asStrings),
-        );
-      }
-      toolsList.push(...onlyInlineDecls);
-    } else {
-      // Inherit all available tools by default when not specified.
-      toolsList.push(
-        ...toolRegistry
-          .getFunctionDeclarations()
-          .filter((t) => t.name !== TaskTool.Name),
-      );
-    }
+    const toolsList = this.pool
+      ? await this.pool.getShared(this.getToolsCacheKey(), () =>
+          this.buildToolsList(),
+        )
+      : this.buildToolsList();
 
     const initialTaskText = String(
       (context.get('task_prompt') as string) ?? 'Get Started!',
@@ -433,6 +442,9 @@ export class SubAgentScope {
               isFinite(inTok) ? inTok : 0,
               isFinite(outTok) ? outTok : 0,
             );
+            this.slot?.recordTokens(
+              (isFinite(inTok) ? inTok : 0) + (isFinite(outTok) ? outTok : 0),
+            );
             // mirror legacy fields for compatibility
             this.executionStats.inputTokens =
               (this.executionStats.inputTokens || 0) +
@@ -535,6 +547,52 @@ export class SubAgentScope {
     }
   }
 
+  /**
+   * Prepares the list of tools available to the subagent.
+   * If no explicit toolConfig or it contains "*" or is empty, inherit all tools.
+   */
+  private buildToolsList(): FunctionDeclaration[] {
+    const toolRegistry = this.runtimeContext.getToolRegistry();
+    const toolsList: FunctionDeclaration[] = [];
+    if (this.toolConfig) {
+      const asStrings = this.toolConfig.tools.filter(
+        (t): t is string => typeof t === 'string',
+      );
+      const hasWildcard = asStrings.includes('*');
+      const onlyInlineDecls = this.toolConfig.tools.filter(
+        (t): t is FunctionDeclaration => typeof t !== 'string',
+      );
+
+      if (hasWildcard || asStrings.length === 0) {
+        toolsList.push(
+          ...toolRegistry
+            .getFunctionDeclarations()
+            .filter((t) => t.name !== TaskTool.Name),
+        );
+      } else {
+        toolsList.push(
+          ...toolRegistry.getFunctionDeclarationsFiltered(asStrings),
+        );
+      }
+      toolsList.push(...onlyInlineDecls);
+    } else {
+      // Inherit all available tools by default when not specified.
+      toolsList.push(
+        ...toolRegistry
+          .getFunctionDeclarations()
+          .filter((t) => t.name !== TaskTool.Name),
+      );
+    }
+    return toolsList;
+  }
+
+  private getToolsCacheKey(): string {
+    const names = (this.toolConfig?.tools ?? ['*']).map((t) =>
+      typeof t === 'string' ? t : JSON.stringify(t),
+    );
+    return `tools:${names.join('\0')}`;
+  }
+
   /**
    * Processes a list of function calls, executing each one and collecting their responses.
    * This method iterates through the provided function calls, executes them using the
@@ -553,13 +611,85 @@ export class SubAgentScope {
     currentRound: number,
   ): Promise<Content[]> {
     const toolResponseParts: Part[] = [];
+    const scheduler = this.getToolScheduler();
+
+    // Prepare requests and emit TOOL_CALL events
+    const requests: ToolCallRequestInfo[] = functionCalls.map((fc) => {
+      const toolName = String(fc.name || 'unknown');
+      const callId = fc.id ?? `${fc.name}-${Date.now()}`;
+      const args = (fc.args ?? {}) as Record<string, unknown>;
+      const request: ToolCallRequestInfo = {
+        callId,
+        name: toolName,
+        args,
+        isClientInitiated: true,
+        prompt_id: promptId,
+      };
 
-    // Build scheduler
-    const responded = new Set<string>();
-    let resolveBatch: (() => void) | null = null;
-    const scheduler = new CoreToolScheduler({
+      const description = this.getToolDescription(toolName, args);
+      this.eventEmitter?.emit(SubAgentEventType.TOOL_CALL, {
+        subagentId: this.subagentId,
+        round: currentRound,
+        callId,
+        name: toolName,
+        args,
+        description,
+        timestamp: Date.now(),
+      } as SubAgentToolCallEvent);
+
+      // pre-tool hook
+      void this.hooks?.preToolUse?.({
+        subagentId: this.subagentId,
+        name: this.name,
+        toolName,
+        args,
+        timestamp: Date.now(),
+      });
+
+      return request;
+    });
+
+    if (requests.length > 0) {
+      // Create a per-batch completion promise, resolve when onAllToolCallsComplete fires
+      const batchDone = new Promise<void>((resolve) => {
+        this.toolBatch = {
+          round: currentRound,
+          responseParts: toolResponseParts,
+          responded: new Set<string>(),
+          resolve,
+        };
+      });
+      try {
+        await scheduler.schedule(requests, abortController.signal);
+        await batchDone; // Wait for approvals + execution to finish
+      } finally {
+        this.toolBatch = undefined;
+      }
+    }
+    // If all tool calls failed, inform the model so it can re-evaluate.
+    if (functionCalls.length > 0 && toolResponseParts.length === 0) {
+      toolResponseParts.push({
+        text: 'All tool calls failed. Please analyze the errors and try an alternative approach.',
+      });
+    }
+
+    return [{ role: 'user', parts: toolResponseParts }];
+  }
+
+  /**
+   * Returns the tool scheduler for the current run, creating it on first use.
+   * A single scheduler serves every round; per-round state lives in
+   * `toolBatch`.
+   */
+  private getToolScheduler(): CoreToolScheduler {
+    if (this.toolScheduler) {
+      return this.toolScheduler;
+    }
+    this.toolScheduler = new CoreToolScheduler({
       outputUpdateHandler: undefined,
       onAllToolCallsComplete: async (completedCalls) => {
+        const batch = this.toolBatch;
+        if (!batch) return;
         for (const call of completedCalls) {
           const toolName = call.request.name;
           const duration = call.durationMs ?? 0;
@@ -600,7 +730,7 @@ export class SubAgentScope {
           // Emit tool result event
           this.eventEmitter?.emit(SubAgentEventType.TOOL_RESULT, {
             subagentId: this.subagentId,
-            round: currentRound,
+            round: batch.round,
             callId: call.request.callId,
             name: toolName,
             success,
@@ -640,17 +770,19 @@ export class SubAgentScope {
             const parts = Array.isArray(respParts) ? respParts : [respParts];
             for (const part of parts) {
               if (typeof part === 'string') {
-                toolResponseParts.push({ text: part });
+                batch.responseParts.push({ text: part });
               } else if (part) {
-                toolResponseParts.push(part);
+                batch.responseParts.push(part);
               }
             }
           }
         }
         // Signal that this batch is complete (all tools terminal)
-        resolveBatch?.();
+        batch.resolve();
       },
       onToolCallsUpdate: (calls: ToolCall[]) => {
+        const batch = this.toolBatch;
+        if (!batch) return;
         for (const call of calls) {
           if (call.status !== 'awaiting_approval') continue;
           const waiting = call as WaitingToolCall;
@@ -661,7 +793,7 @@ export class SubAgentScope {
             const { onConfirm: _onConfirm, ...rest } = confirmationDetails;
             this.eventEmitter?.emit(SubAgentEventType.TOOL_WAITING_APPROVAL, {
               subagentId: this.subagentId,
-              round: currentRound,
+              round: batch.round,
               callId: waiting.request.callId,
               name: waiting.request.name,
               description: this.getToolDescription(
@@ -675,8 +807,8 @@ export class SubAgentScope {
                   ToolCallConfirmationDetails['onConfirm']
                 >[1],
               ) => {
-                if (responded.has(waiting.request.callId)) return;
-                responded.add(waiting.request.callId);
+                if (batch.responded.has(waiting.request.callId)) return;
+                batch.responded.add(waiting.request.callId);
                 await waiting.confirmationDetails.onConfirm(outcome, payload);
               },
               timestamp: Date.now(),
@@ -692,62 +824,7 @@ export class SubAgentScope {
       config: this.runtimeContext,
       onEditorClose: () => {},
     });
-
-    // Prepare requests and emit TOOL_CALL events
-    const requests: ToolCallRequestInfo[] = functionCalls.map((fc) => {
-      const toolName = String(fc.name || 'unknown');
-      const callId = fc.id ?? `${fc.name}-${Date.now()}`;
-      const args = (fc.args ?? {}) as Record<string, unknown>;
-      const request: ToolCallRequestInfo = {
-        callId,
-        name: toolName,
-        args,
-        isClientInitiated: true,
-        prompt_id: promptId,
-      };
-
-      const description = this.getToolDescription(toolName, args);
-      this.eventEmitter?.emit(SubAgentEventType.TOOL_CALL, {
-        subagentId: this.subagentId,
-        round: currentRound,
-        callId,
-        name: toolName,
-        args,
-        description,
-        timestamp: Date.now(),
-      } as SubAgentToolCallEvent);
-
-      // pre-tool hook
-      void this.hooks?.preToolUse?.({
-        subagentId: this.subagentId,
-        name: this.name,
-        toolName,
-        args,
-        timestamp: Date.now(),
-      });
-
-      return request;
-    });
-
-    if (requests.length > 0) {
-      // Create a per-batch completion promise, resolve when onAllToolCallsComplete fires
-      const batchDone = new Promise<void>((resolve) => {
-        resolveBatch = () => {
-          resolve();
-          resolveBatch = null;
-        };
-      });
-      await scheduler.schedule(requests, abortController.signal);
-      await batchDone; // Wait for approvals + execution to finish
-    }
-    // If all tool calls failed, inform the model so it can re-evaluate.
-    if (functionCalls.length > 0 && toolResponseParts.length === 0) {
-      toolResponseParts.push({
-        text: 'All tool calls failed. Please analyze the errors and try an alternative approach.',
-      });
-    }
-
-    return [{ role: 'user', parts: toolResponseParts }];
+    return this.toolScheduler;
   }
 
   getEventEmitter() {
@@ -792,7 +869,9 @@ export class SubAgentScope {
       );
     }
 
-    const envParts = await getEnvironmentContext(this.runtimeContext);
+    const envParts = this.pool
+      ? await this.pool.getEnvironmentContext(this.runtimeContext)
+      : await getEnvironmentContext(this.runtimeContext);
     const envHistory: Content[] = [
       { role: 'user', parts: envParts },
       { role: 'model', parts: [{ text: 'Got it. Thanks for the context!' }] },
@@ -819,11 +898,13 @@ export class SubAgentScope {
         generationConfig.systemInstruction = systemInstruction;
       }
 
-      const contentGenerator = await createContentGenerator(
-        this.runtimeContext.getContentGeneratorConfig(),
-        this.runtimeContext,
-        this.runtimeContext.getSessionId(),
-      );
+      const contentGenerator = this.pool
+        ? await this.pool.getContentGenerator(this.runtimeContext)
+        : await createContentGenerator(
+            this.runtimeContext.getContentGeneratorConfig(),
+            this.runtimeContext,
+            this.runtimeContext.getSessionId(),
+          );
 
       if (this.modelConfig.model) {
         await this.runtimeContext.setModel(this.modelConfig.model);
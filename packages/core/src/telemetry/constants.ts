@@ -39,3 +39,19 @@ export const METRIC_CONTENT_RETRY_FAILURE_COUNT =
   'kolosal-ai.chat.content_retry_failure.count';
 export const METRIC_SUBAGENT_EXECUTION_COUNT =
   'kolosal-ai.subagent.execution.count';
+export const METRIC_FILE_CONTENT_CACHE_COUNT =
+  'kolosal-ai.file.content_cache.count';
+export const METRIC_HTTP_POOL_REQUEST_COUNT =
+  'kolosal-ai.http_pool.request.count';
+export const METRIC_API_STREAM_QUEUE_TIME = 'kolosal-ai.api.stream.queue_time';
+export const METRIC_API_STREAM_TTFT = 'kolosal-ai.api.stream.ttft';
+export const METRIC_API_STREAM_INTER_TOKEN_LATENCY =
+  'kolosal-ai.api.stream.inter_token_latency';
+export const METRIC_API_STREAM_THROUGHPUT =
+  'kolosal-ai.api.stream.tokens_per_second';
+export const METRIC_TOOL_OUTPUT_REDUCTION_BYTES =
+  'kolosal-ai.tool.output_reduction.bytes';
+export const METRIC_CHAT_COMPRESSION_TOKENS_RECLAIMED =
+  'kolosal-ai.chat_compression.tokens_reclaimed';
+export const METRIC_CHAT_COMPRESSION_STALL_AVOIDED =
+  'kolosal-ai.chat_compression.stall_avoided';
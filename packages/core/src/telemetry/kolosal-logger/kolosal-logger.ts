@@ -624,6 +624,8 @@ export class QwenLogger {
       snapshots: JSON.stringify({
         tokens_before: event.tokens_before,
         tokens_after: event.tokens_after,
+        tier: event.tier,
+        stall_avoided_ms: event.stall_avoided_ms,
       }),
     });
 
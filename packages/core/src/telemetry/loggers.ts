@@ -474,6 +474,8 @@ export function logChatCompression(
   recordChatCompressionMetrics(config, {
     tokens_before: event.tokens_before,
     tokens_after: event.tokens_after,
+    tier: event.tier,
+    stall_avoided_ms: event.stall_avoided_ms,
   });
 }
 
@@ -119,6 +119,27 @@ describe('Telemetry Metrics', () => {
         tokens_before: 200,
       });
     });
+
+    it('records tokens reclaimed and stall avoided per tier', () => {
+      const config = makeFakeConfig({});
+      initializeMetricsModule(config);
+
+      recordChatCompressionMetricsModule(config, {
+        tokens_after: 100,
+        tokens_before: 250,
+        tier: 'prune',
+        stall_avoided_ms: 1200,
+      });
+
+      expect(mockCounterAddFn).toHaveBeenCalledWith(150, {
+        'session.id': 'test-session-id',
+        tier: 'prune',
+      });
+      expect(mockHistogramRecordFn).toHaveBeenCalledWith(1200, {
+        'session.id': 'test-session-id',
+        tier: 'prune',
+      });
+    });
   });
 
   describe('recordTokenUsageMetrics', () => {
@@ -20,9 +20,26 @@ import {
   METRIC_CONTENT_RETRY_COUNT,
   METRIC_CONTENT_RETRY_FAILURE_COUNT,
   METRIC_SUBAGENT_EXECUTION_COUNT,
+  METRIC_FILE_CONTENT_CACHE_COUNT,
+  METRIC_HTTP_POOL_REQUEST_COUNT,
+  METRIC_TOOL_OUTPUT_REDUCTION_BYTES,
+  METRIC_API_STREAM_QUEUE_TIME,
+  METRIC_API_STREAM_TTFT,
+  METRIC_API_STREAM_INTER_TOKEN_LATENCY,
+  METRIC_API_STREAM_THROUGHPUT,
+  METRIC_CHAT_COMPRESSION_TOKENS_RECLAIMED,
+  METRIC_CHAT_COMPRESSION_STALL_AVOIDED,
 } from './constants.js';
 import type { Config } from '../config/config.js';
 import type { DiffStat } from '../tools/tools.js';
+import { fileContentCache } from '../utils/fileContentCache.js';
+import { httpPool } from '../utils/httpPool.js';
+import type { HttpRequestInfo } from '../utils/httpPool.js';
+import type { StreamTimingStats } from './streamTiming.js';
+import {
+  INTER_TOKEN_LATENCY_BUCKETS_MS,
+  tokensPerSecond,
+} from './streamTiming.js';
 
 export enum FileOperation {
   CREATE = 'create',
@@ -42,6 +59,15 @@ let invalidChunkCounter: Counter | undefined;
 let contentRetryCounter: Counter | undefined;
 let contentRetryFailureCounter: Counter | undefined;
 let subagentExecutionCounter: Counter | undefined;
+let fileContentCacheCounter: Counter | undefined;
+let httpPoolRequestCounter: Counter | undefined;
+let toolOutputReductionCounter: Counter | undefined;
+let streamQueueTimeHistogram: Histogram | undefined;
+let streamTtftHistogram: Histogram | undefined;
+let streamInterTokenLatencyHistogram: Histogram | undefined;
+let streamThroughputHistogram: Histogram | undefined;
+let compressionTokensReclaimedCounter: Counter | undefined;
+let compressionStallAvoidedHistogram: Histogram | undefined;
 let isMetricsInitialized = false;
 
 function getCommonAttributes(config: Config): Attributes {
@@ -122,6 +148,85 @@ export function initializeMetrics(config: Config): void {
     },
   );
 
+  fileContentCacheCounter = meter.createCounter(
+    METRIC_FILE_CONTENT_CACHE_COUNT,
+    {
+      description:
+        'Counts file content cache lookups, tagged by whether they hit.',
+      valueType: ValueType.INT,
+    },
+  );
+  fileContentCache.setLookupListener((hit) =>
+    recordFileContentCacheLookup(config, hit),
+  );
+
+  httpPoolRequestCounter = meter.createCounter(METRIC_HTTP_POOL_REQUEST_COUNT, {
+    description:
+      'Counts requests sent through the shared HTTP connection pool, tagged by whether they reused a connection or queued.',
+    valueType: ValueType.INT,
+  });
+  httpPool.setRequestListener((info) => recordHttpPoolRequest(config, info));
+  streamQueueTimeHistogram = meter.createHistogram(
+    METRIC_API_STREAM_QUEUE_TIME,
+    {
+      description:
+        'Time until a streamed API request was accepted by the server, in milliseconds.',
+      unit: 'ms',
+      valueType: ValueType.INT,
+    },
+  );
+  streamTtftHistogram = meter.createHistogram(METRIC_API_STREAM_TTFT, {
+    description: 'Time to first token of streamed API requests in milliseconds.',
+    unit: 'ms',
+    valueType: ValueType.INT,
+  });
+  streamInterTokenLatencyHistogram = meter.createHistogram(
+    METRIC_API_STREAM_INTER_TOKEN_LATENCY,
+    {
+      description:
+        'Time between consecutive token chunks of streamed API responses in milliseconds.',
+      unit: 'ms',
+      valueType: ValueType.DOUBLE,
+      advice: { explicitBucketBoundaries: INTER_TOKEN_LATENCY_BUCKETS_MS },
+    },
+  );
+  streamThroughputHistogram = meter.createHistogram(
+    METRIC_API_STREAM_THROUGHPUT,
+    {
+      description:
+        'Prompt evaluation and generation speed of streamed API requests, tagged by phase.',
+      unit: '{token}/s',
+      valueType: ValueType.DOUBLE,
+    },
+  );
+  toolOutputReductionCounter = meter.createCounter(
+    METRIC_TOOL_OUTPUT_REDUCTION_BYTES,
+    {
+      description:
+        'Bytes of tool output saved before entering the history, tagged by tool and by whether the local reducer or the LLM summarizer produced the result.',
+      unit: 'By',
+      valueType: ValueType.INT,
+    },
+  );
+
+  compressionTokensReclaimedCounter = meter.createCounter(
+    METRIC_CHAT_COMPRESSION_TOKENS_RECLAIMED,
+    {
+      description:
+        'Tokens removed from the chat history, tagged by whether stale tool outputs were pruned, a rolling summary was applied or the history was fully summarized.',
+      valueType: ValueType.INT,
+    },
+  );
+  compressionStallAvoidedHistogram = meter.createHistogram(
+    METRIC_CHAT_COMPRESSION_STALL_AVOIDED,
+    {
+      description:
+        'Estimated time a full chat compression would have blocked the turn when pruning or a background summary was used instead.',
+      unit: 'ms',
+      valueType: ValueType.INT,
+    },
+  );
+
   const sessionCounter = meter.createCounter(METRIC_SESSION_COUNT, {
     description: 'Count of CLI sessions started.',
     valueType: ValueType.INT,
@@ -132,13 +237,30 @@ export function initializeMetrics(config: Config): void {
 
 export function recordChatCompressionMetrics(
   config: Config,
-  args: { tokens_before: number; tokens_after: number },
+  args: {
+    tokens_before: number;
+    tokens_after: number;
+    tier?: string;
+    stall_avoided_ms?: number;
+  },
 ) {
   if (!chatCompressionCounter || !isMetricsInitialized) return;
+  const { tokens_before, tokens_after, tier, stall_avoided_ms } = args;
   chatCompressionCounter.add(1, {
     ...getCommonAttributes(config),
-    ...args,
+    tokens_before,
+    tokens_after,
+    ...(tier !== undefined && { tier }),
   });
+  if (!tier) return;
+  const tierAttributes = { ...getCommonAttributes(config), tier };
+  compressionTokensReclaimedCounter?.add(
+    Math.max(0, tokens_before - tokens_after),
+    tierAttributes,
+  );
+  if (stall_avoided_ms !== undefined) {
+    compressionStallAvoidedHistogram?.record(stall_avoided_ms, tierAttributes);
+  }
 }
 
 export function recordToolCallMetrics(
@@ -309,3 +431,93 @@ export function recordSubagentExecutionMetrics(
 
   subagentExecutionCounter.add(1, attributes);
 }
+
+/**
+ * Records a metric for a lookup in the shared file content cache.
+ */
+export function recordFileContentCacheLookup(
+  config: Config,
+  hit: boolean,
+): void {
+  if (!fileContentCacheCounter || !isMetricsInitialized) return;
+  fileContentCacheCounter.add(1, {
+    ...getCommonAttributes(config),
+    result: hit ? 'hit' : 'miss',
+  });
+}
+
+/**
+ * Records a metric for a request sent through the shared HTTP connection pool.
+ */
+export function recordHttpPoolRequest(
+  config: Config,
+  info: HttpRequestInfo,
+): void {
+  if (!httpPoolRequestCounter || !isMetricsInitialized) return;
+  httpPoolRequestCounter.add(1, {
+    ...getCommonAttributes(config),
+    origin: info.origin,
+    connection: info.reused ? 'reused' : 'new',
+    queued: info.queued,
+  });
+}
+
+/**
+ * Records the bytes saved by reducing a tool's output before it is added to
+ * the history.
+ */
+export function recordToolOutputReduction(
+  config: Config,
+  args: {
+    tool_name: string;
+    stage: 'local' | 'llm';
+    bytes_saved: number;
+  },
+): void {
+  if (!toolOutputReductionCounter || !isMetricsInitialized) return;
+  toolOutputReductionCounter.add(Math.max(0, args.bytes_saved), {
+    ...getCommonAttributes(config),
+    tool_name: args.tool_name,
+    stage: args.stage,
+  });
+}
+
+/**
+ * Records queue time, time to first token, inter-token latency and
+ * throughput of a streamed API request.
+ */
+export function recordStreamTimingMetrics(
+  config: Config,
+  labels: { model: string; engine: string; provider: string },
+  stats: StreamTimingStats,
+): void {
+  if (
+    !streamQueueTimeHistogram ||
+    !streamTtftHistogram ||
+    !streamInterTokenLatencyHistogram ||
+    !streamThroughputHistogram ||
+    !isMetricsInitialized
+  )
+    return;
+  const attributes: Attributes = {
+    ...getCommonAttributes(config),
+    ...labels,
+  };
+  streamQueueTimeHistogram.record(stats.queueMs, attributes);
+  streamTtftHistogram.record(stats.ttftMs, attributes);
+  for (const gap of stats.interTokenGapsMs) {
+    streamInterTokenLatencyHistogram.record(gap, attributes);
+  }
+  if (stats.promptEvalMs > 0) {
+    streamThroughputHistogram.record(
+      tokensPerSecond(stats.promptTokens, stats.promptEvalMs),
+      { ...attributes, phase: 'prompt' },
+    );
+  }
+  if (stats.generationMs > 0) {
+    streamThroughputHistogram.record(
+      tokensPerSecond(stats.generationTokens, stats.generationMs),
+      { ...attributes, phase: 'generation' },
+    );
+  }
+}
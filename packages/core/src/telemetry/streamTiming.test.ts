@@ -0,0 +1,93 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import {
+  StreamTimer,
+  bucketPercentile,
+  getInferenceEngine,
+  registerInferenceEngine,
+  tokensPerSecond,
+} from './streamTiming.js';
+
+// Timer driven by a manual clock
+function timerAt(times: number[]) {
+  let index = 0;
+  return new StreamTimer(1000, () => times[index++]);
+}
+
+describe('StreamTimer', () => {
+  it('should measure queue time, TTFT and inter-token gaps', () => {
+    // Headers at +50ms, tokens at +300, +320, +330, +380
+    const timer = timerAt([1050, 1300, 1320, 1330, 1380]);
+    timer.markResponse();
+    for (let i = 0; i < 4; i++) timer.markToken();
+
+    const stats = timer.finish(120, 4)!;
+
+    expect(stats.queueMs).toBe(50);
+    expect(stats.ttftMs).toBe(300);
+    expect(stats.interTokenGapsMs).toEqual([20, 10, 50]);
+    expect(stats.interTokenP50Ms).toBe(20);
+    expect(stats.interTokenP99Ms).toBe(50);
+    expect(stats.interTokenBuckets.slice(0, 5)).toEqual([0, 1, 1, 0, 1]);
+    // Prompt evaluation is estimated from acceptance to first token.
+    expect(stats.promptEvalMs).toBe(250);
+    expect(stats.promptTokens).toBe(120);
+    expect(stats.generationMs).toBe(80);
+    expect(stats.generationTokens).toBe(4);
+  });
+
+  it('should prefer timings reported by the server', () => {
+    const timer = timerAt([1010, 1100, 1200]);
+    timer.markResponse();
+    timer.markToken();
+    timer.markToken();
+    timer.observeChunk({
+      choices: [],
+      timings: {
+        prompt_n: 512,
+        prompt_ms: 64,
+        predicted_n: 30,
+        predicted_ms: 600,
+      },
+    });
+
+    const stats = timer.finish(500, 2)!;
+
+    expect(stats.promptTokens).toBe(512);
+    expect(tokensPerSecond(stats.promptTokens, stats.promptEvalMs)).toBe(8000);
+    expect(tokensPerSecond(stats.generationTokens, stats.generationMs)).toBe(
+      50,
+    );
+  });
+
+  it('should return undefined when no token arrived', () => {
+    const timer = timerAt([1010]);
+    timer.markResponse();
+    expect(timer.finish()).toBeUndefined();
+  });
+});
+
+describe('bucketPercentile', () => {
+  it('should return the upper bound of the bucket holding the percentile', () => {
+    const buckets = [0, 0, 90, 8, 0, 0, 0, 2, 0, 0, 0, 0];
+    expect(bucketPercentile(buckets, 0.5)).toBe(20);
+    expect(bucketPercentile(buckets, 0.99)).toBe(150);
+    expect(bucketPercentile([], 0.5)).toBe(0);
+  });
+});
+
+describe('registerInferenceEngine', () => {
+  it('should resolve the engine by origin, treating localhost as loopback', () => {
+    registerInferenceEngine('http://127.0.0.1:8087', 'llama-vulkan');
+    expect(getInferenceEngine('http://localhost:8087/v1')).toBe(
+      'llama-vulkan',
+    );
+    expect(getInferenceEngine('http://127.0.0.1:9000/v1')).toBe('unknown');
+    expect(getInferenceEngine(undefined)).toBe('unknown');
+  });
+});
@@ -0,0 +1,201 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Upper bounds, in milliseconds, of the inter-token latency buckets shared by
+ * the OpenTelemetry histogram and the per-session /stats view.
+ */
+export const INTER_TOKEN_LATENCY_BUCKETS_MS = [
+  5, 10, 20, 35, 50, 75, 100, 150, 250, 500, 1000,
+];
+
+export interface StreamTimingStats {
+  /** Time until the server accepted the request and sent headers. */
+  queueMs: number;
+  /** Time from sending the request to the first generated token. */
+  ttftMs: number;
+  /** Per-request inter-token latency percentiles. */
+  interTokenP50Ms: number;
+  interTokenP90Ms: number;
+  interTokenP99Ms: number;
+  /**
+   * Gap counts per INTER_TOKEN_LATENCY_BUCKETS_MS bucket, with one extra
+   * bucket for gaps above the last bound.
+   */
+  interTokenBuckets: number[];
+  /** Every gap between token chunks, in arrival order. */
+  interTokenGapsMs: number[];
+  promptTokens: number;
+  promptEvalMs: number;
+  generationTokens: number;
+  generationMs: number;
+}
+
+/** Timings reported by llama.cpp-based servers on the final chunk. */
+interface ServerTimings {
+  prompt_n?: number;
+  prompt_ms?: number;
+  predicted_n?: number;
+  predicted_ms?: number;
+}
+
+const inferenceEngines = new Map<string, string>();
+
+function originOf(baseUrl: string): string | undefined {
+  try {
+    const url = new URL(baseUrl);
+    // Loopback aliases refer to the same local server.
+    const host = url.hostname === 'localhost' ? '127.0.0.1' : url.hostname;
+    return `${url.protocol}//${host}:${url.port}`;
+  } catch {
+    return undefined;
+  }
+}
+
+/**
+ * Records which inference engine serves requests sent to `baseUrl`, so that
+ * stream timings can be broken down by engine.
+ */
+export function registerInferenceEngine(baseUrl: string, engine: string): void {
+  const origin = originOf(baseUrl);
+  if (origin) {
+    inferenceEngines.set(origin, engine);
+  }
+}
+
+export function getInferenceEngine(baseUrl: string | undefined): string {
+  const origin = baseUrl ? originOf(baseUrl) : undefined;
+  return (origin && inferenceEngines.get(origin)) ?? 'unknown';
+}
+
+/** The host requests go to, used to tell providers apart in metrics. */
+export function getProviderLabel(baseUrl: string | undefined): string {
+  if (!baseUrl) return 'openai';
+  try {
+    return new URL(baseUrl).host;
+  } catch {
+    return 'unknown';
+  }
+}
+
+function percentile(sorted: number[], p: number): number {
+  if (sorted.length === 0) return 0;
+  const index = Math.min(sorted.length - 1, Math.ceil(p * sorted.length) - 1);
+  return sorted[Math.max(0, index)];
+}
+
+/**
+ * Measures one streamed completion: queue time, time to first token, the
+ * gaps between tokens and prompt-eval vs generation throughput. Server
+ * reported timings are preferred over client-side estimates when present.
+ */
+export class StreamTimer {
+  private responseAt: number | undefined;
+  private firstTokenAt: number | undefined;
+  private lastTokenAt: number | undefined;
+  private tokenChunks = 0;
+  private readonly gaps: number[] = [];
+  private serverTimings: ServerTimings | undefined;
+
+  constructor(
+    private readonly startTime: number,
+    private readonly now: () => number = Date.now,
+  ) {}
+
+  /** Call when the response headers have arrived. */
+  markResponse(): void {
+    this.responseAt ??= this.now();
+  }
+
+  /** Call for each chunk that carries generated text or tool call deltas. */
+  markToken(): void {
+    const at = this.now();
+    if (this.lastTokenAt !== undefined) {
+      this.gaps.push(at - this.lastTokenAt);
+    } else {
+      this.firstTokenAt = at;
+    }
+    this.lastTokenAt = at;
+    this.tokenChunks++;
+  }
+
+  /** Picks up server timings from a raw chunk if it has them. */
+  observeChunk(chunk: unknown): void {
+    const timings = (chunk as { timings?: ServerTimings } | null)?.timings;
+    if (timings && typeof timings === 'object') {
+      this.serverTimings = timings;
+    }
+  }
+
+  /**
+   * Returns the timings, or undefined if no token was received.
+   * `promptTokens` and `outputTokens` come from the usage metadata.
+   */
+  finish(
+    promptTokens = 0,
+    outputTokens = 0,
+  ): StreamTimingStats | undefined {
+    if (this.firstTokenAt === undefined || this.lastTokenAt === undefined) {
+      return undefined;
+    }
+    const queueMs = (this.responseAt ?? this.startTime) - this.startTime;
+    const ttftMs = this.firstTokenAt - this.startTime;
+
+    const sorted = [...this.gaps].sort((a, b) => a - b);
+    const interTokenBuckets = new Array<number>(
+      INTER_TOKEN_LATENCY_BUCKETS_MS.length + 1,
+    ).fill(0);
+    for (const gap of this.gaps) {
+      const bucket = INTER_TOKEN_LATENCY_BUCKETS_MS.findIndex(
+        (bound) => gap <= bound,
+      );
+      interTokenBuckets[
+        bucket === -1 ? INTER_TOKEN_LATENCY_BUCKETS_MS.length : bucket
+      ]++;
+    }
+
+    const server = this.serverTimings;
+    return {
+      queueMs,
+      ttftMs,
+      interTokenP50Ms: percentile(sorted, 0.5),
+      interTokenP90Ms: percentile(sorted, 0.9),
+      interTokenP99Ms: percentile(sorted, 0.99),
+      interTokenBuckets,
+      interTokenGapsMs: [...this.gaps],
+      promptTokens: server?.prompt_n ?? promptTokens,
+      // Without server timings, everything between acceptance and the first
+      // token is attributed to prompt evaluation.
+      promptEvalMs: server?.prompt_ms ?? Math.max(0, ttftMs - queueMs),
+      generationTokens:
+        server?.predicted_n ?? (outputTokens || this.tokenChunks),
+      generationMs:
+        server?.predicted_ms ?? this.lastTokenAt - this.firstTokenAt,
+    };
+  }
+}
+
+/** Tokens per second, or 0 when the duration is too short to measure. */
+export function tokensPerSecond(tokens: number, ms: number): number {
+  return ms > 0 ? (tokens * 1000) / ms : 0;
+}
+
+/** Approximate percentile from bucket counts, as the bucket's upper bound. */
+export function bucketPercentile(buckets: number[], p: number): number {
+  const total = buckets.reduce((sum, count) => sum + count, 0);
+  if (total === 0) return 0;
+  const target = Math.ceil(p * total);
+  let seen = 0;
+  let i = 0;
+  for (; i < buckets.length; i++) {
+    seen += buckets[i];
+    if (seen >= target) break;
+  }
+  // The overflow bucket is reported as the last bound.
+  return INTER_TOKEN_LATENCY_BUCKETS_MS[
+    Math.min(i, INTER_TOKEN_LATENCY_BUCKETS_MS.length - 1)
+  ];
+}
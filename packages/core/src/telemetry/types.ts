@@ -241,6 +241,19 @@ export class ApiResponseEvent implements BaseTelemetryEvent {
   response_text?: string;
   prompt_id: string;
   auth_type?: string;
+  // Streaming timings, set for streamed responses that produced tokens
+  engine?: string;
+  provider?: string;
+  queue_ms?: number;
+  ttft_ms?: number;
+  inter_token_p50_ms?: number;
+  inter_token_p90_ms?: number;
+  inter_token_p99_ms?: number;
+  inter_token_buckets?: number[];
+  prompt_eval_tokens?: number;
+  prompt_eval_ms?: number;
+  generation_tokens?: number;
+  generation_ms?: number;
 
   constructor(
     response_id: string,
@@ -351,17 +364,25 @@ export interface ChatCompressionEvent extends BaseTelemetryEvent {
   'event.timestamp': string;
   tokens_before: number;
   tokens_after: number;
+  /** 'prune', 'summary' or 'full'; see ContextReductionTier. */
+  tier?: string;
+  /** Estimated blocking time avoided by not running a full compression. */
+  stall_avoided_ms?: number;
 }
 
 export function makeChatCompressionEvent({
   tokens_before,
   tokens_after,
+  tier,
+  stall_avoided_ms,
 }: Omit<ChatCompressionEvent, CommonFields>): ChatCompressionEvent {
   return {
     'event.name': 'chat_compression',
     'event.timestamp': new Date().toISOString(),
     tokens_before,
     tokens_after,
+    ...(tier !== undefined && { tier }),
+    ...(stall_avoided_ms !== undefined && { stall_avoided_ms }),
   };
 }
 
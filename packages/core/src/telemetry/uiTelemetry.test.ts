@@ -5,7 +5,7 @@
  */
 
 import { describe, it, expect, vi, beforeEach } from 'vitest';
-import { UiTelemetryService } from './uiTelemetry.js';
+import { internalPromptId, UiTelemetryService } from './uiTelemetry.js';
 import { ToolCallDecision } from './tool-call-decision.js';
 import type { ApiErrorEvent, ApiResponseEvent } from './types.js';
 import { ToolCallEvent } from './types.js';
@@ -268,9 +268,72 @@ describe('UiTelemetryService', () => {
       expect(metrics.models['gemini-2.5-flash'].api.totalRequests).toBe(1);
       expect(service.getLastPromptTokenCount()).toBe(100);
     });
+
+    it('should count internal requests without taking their prompt size', () => {
+      const event = (promptId: string, inputTokens: number) =>
+        ({
+          'event.name': EVENT_API_RESPONSE,
+          model: 'gemini-2.5-pro',
+          duration_ms: 500,
+          prompt_id: promptId,
+          input_token_count: inputTokens,
+          output_token_count: 20,
+          total_token_count: inputTokens + 20,
+          cached_content_token_count: 0,
+          thoughts_token_count: 0,
+          tool_token_count: 0,
+        }) as ApiResponseEvent & { 'event.name': typeof EVENT_API_RESPONSE };
+
+      service.addEvent(event('prompt-1', 1000));
+      service.addEvent(event(internalPromptId('prompt-1'), 400));
+
+      expect(service.getLastPromptTokenCount()).toBe(1000);
+      expect(service.getMetrics().models['gemini-2.5-pro'].tokens.prompt).toBe(
+        1400,
+      );
+    });
   });
 
   describe('API Error Event Processing', () => {
+    it('should aggregate streaming timings of ApiResponseEvents', () => {
+      const streamed = (ttft: number, buckets: number[]) =>
+        ({
+          'event.name': EVENT_API_RESPONSE,
+          model: 'local-model',
+          duration_ms: 1000,
+          input_token_count: 100,
+          output_token_count: 50,
+          total_token_count: 150,
+          cached_content_token_count: 0,
+          thoughts_token_count: 0,
+          tool_token_count: 0,
+          engine: 'llama-vulkan',
+          queue_ms: 10,
+          ttft_ms: ttft,
+          inter_token_buckets: buckets,
+          prompt_eval_tokens: 100,
+          prompt_eval_ms: 200,
+          generation_tokens: 50,
+          generation_ms: 500,
+        }) as ApiResponseEvent & { 'event.name': typeof EVENT_API_RESPONSE };
+
+      service.addEvent(streamed(210, [0, 0, 4]));
+      service.addEvent(streamed(190, [0, 1, 2]));
+
+      const streaming = service.getMetrics().models['local-model'].streaming;
+      expect(streaming).toMatchObject({
+        requests: 2,
+        engine: 'llama-vulkan',
+        totalQueueMs: 20,
+        totalTtftMs: 400,
+        promptTokens: 200,
+        promptEvalMs: 400,
+        generationTokens: 100,
+        generationMs: 1000,
+      });
+      expect(streaming?.interTokenBuckets.slice(0, 3)).toEqual([0, 1, 6]);
+    });
+
     it('should process a single ApiErrorEvent', () => {
       const event = {
         'event.name': EVENT_API_ERROR,
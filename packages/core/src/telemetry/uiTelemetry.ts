@@ -12,12 +12,25 @@ import {
 } from './constants.js';
 
 import { ToolCallDecision } from './tool-call-decision.js';
+import { INTER_TOKEN_LATENCY_BUCKETS_MS } from './streamTiming.js';
 import type {
   ApiErrorEvent,
   ApiResponseEvent,
   ToolCallEvent,
 } from './types.js';
 
+/** Marks the prompt ids of background requests made on the user's behalf. */
+const INTERNAL_PROMPT_ID_SUFFIX = '#internal';
+
+/**
+ * Returns the prompt id for a background request made during `promptId`,
+ * such as a rolling summary. Its usage still counts towards the session
+ * metrics, but its prompt size is not taken for the conversation's.
+ */
+export function internalPromptId(promptId: string): string {
+  return `${promptId}${INTERNAL_PROMPT_ID_SUFFIX}`;
+}
+
 export type UiEvent =
   | (ApiResponseEvent & { 'event.name': typeof EVENT_API_RESPONSE })
   | (ApiErrorEvent & { 'event.name': typeof EVENT_API_ERROR })
@@ -36,6 +49,21 @@ export interface ToolCallStats {
   };
 }
 
+export interface StreamingMetrics {
+  /** Streamed requests that produced at least one token. */
+  requests: number;
+  /** Engine of the most recent streamed request. */
+  engine: string;
+  totalQueueMs: number;
+  totalTtftMs: number;
+  /** Inter-token gap counts per INTER_TOKEN_LATENCY_BUCKETS_MS bucket. */
+  interTokenBuckets: number[];
+  promptTokens: number;
+  promptEvalMs: number;
+  generationTokens: number;
+  generationMs: number;
+}
+
 export interface ModelMetrics {
   api: {
     totalRequests: number;
@@ -50,6 +78,8 @@ export interface ModelMetrics {
     thoughts: number;
     tool: number;
   };
+  /** Present once a streamed response has been timed. */
+  streaming?: StreamingMetrics;
 }
 
 export interface SessionMetrics {
@@ -89,6 +119,20 @@ const createInitialModelMetrics = (): ModelMetrics => ({
   },
 });
 
+const createInitialStreamingMetrics = (): StreamingMetrics => ({
+  requests: 0,
+  engine: 'unknown',
+  totalQueueMs: 0,
+  totalTtftMs: 0,
+  interTokenBuckets: new Array(INTER_TOKEN_LATENCY_BUCKETS_MS.length + 1).fill(
+    0,
+  ),
+  promptTokens: 0,
+  promptEvalMs: 0,
+  generationTokens: 0,
+  generationMs: 0,
+});
+
 const createInitialMetrics = (): SessionMetrics => ({
   models: {},
   tools: {
@@ -172,7 +216,27 @@ export class UiTelemetryService extends EventEmitter {
     modelMetrics.tokens.thoughts += event.thoughts_token_count;
     modelMetrics.tokens.tool += event.tool_token_count;
 
-    this.#lastPromptTokenCount = event.input_token_count;
+    if (event.ttft_ms !== undefined) {
+      const streaming = (modelMetrics.streaming ??=
+        createInitialStreamingMetrics());
+      streaming.requests++;
+      streaming.engine = event.engine ?? streaming.engine;
+      streaming.totalQueueMs += event.queue_ms ?? 0;
+      streaming.totalTtftMs += event.ttft_ms;
+      event.inter_token_buckets?.forEach((count, index) => {
+        if (index < streaming.interTokenBuckets.length) {
+          streaming.interTokenBuckets[index] += count;
+        }
+      });
+      streaming.promptTokens += event.prompt_eval_tokens ?? 0;
+      streaming.promptEvalMs += event.prompt_eval_ms ?? 0;
+      streaming.generationTokens += event.generation_tokens ?? 0;
+      streaming.generationMs += event.generation_ms ?? 0;
+    }
+
+    if (!event.prompt_id?.endsWith(INTERNAL_PROMPT_ID_SUFFIX)) {
+      this.#lastPromptTokenCount = event.input_token_count;
+    }
   }
 
   private processApiError(event: ApiErrorEvent) {
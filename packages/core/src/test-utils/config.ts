@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+import * as os from 'node:os';
+import * as path from 'node:path';
 import type { ConfigParameters } from '../config/config.js';
 import { Config } from '../config/config.js';
 
@@ -18,6 +20,7 @@ export const DEFAULT_CONFIG_PARAMETERS: ConfigParameters = {
   model: 'gemini-9001-super-duper',
   targetDir: '/',
   cwd: '/',
+  mcpSchemaCachePath: path.join(os.tmpdir(), 'kolosal-test-mcp-schema.json'),
 };
 
 /**
@@ -43,6 +43,7 @@ describe('GrepTool', () => {
     getFileExclusions: () => ({
       getGlobExcludes: () => [],
     }),
+    getSummarizeToolOutputConfig: () => undefined,
   } as unknown as Config;
 
   beforeEach(async () => {
@@ -265,6 +266,7 @@ describe('GrepTool', () => {
         getFileExclusions: () => ({
           getGlobExcludes: () => [],
         }),
+        getSummarizeToolOutputConfig: () => undefined,
       } as unknown as Config;
 
       const multiDirGrepTool = new GrepTool(multiDirConfig);
@@ -318,6 +320,7 @@ describe('GrepTool', () => {
         getFileExclusions: () => ({
           getGlobExcludes: () => [],
         }),
+        getSummarizeToolOutputConfig: () => undefined,
       } as unknown as Config;
 
       const multiDirGrepTool = new GrepTool(multiDirConfig);
@@ -380,6 +383,7 @@ describe('GrepTool', () => {
         getFileExclusions: () => ({
           getGlobExcludes: () => [],
         }),
+        getSummarizeToolOutputConfig: () => undefined,
       } as unknown as Config;
 
       const multiDirGrepTool = new GrepTool(multiDirConfig);
@@ -429,11 +433,11 @@ describe('GrepTool', () => {
 
       expect(result.llmContent).toContain('Found 20 matches');
       expect(result.llmContent).toContain(
-        'showing first 20 of 30+ total matches',
+        'showing first 20 of 21+ total matches',
       );
       expect(result.llmContent).toContain('WARNING: Results truncated');
       expect(result.returnDisplay).toContain(
-        'Found 20 matches (truncated from 30+)',
+        'Found 20 matches (truncated from 21+)',
       );
     });
 
@@ -444,11 +448,11 @@ describe('GrepTool', () => {
 
       expect(result.llmContent).toContain('Found 5 matches');
       expect(result.llmContent).toContain(
-        'showing first 5 of 30+ total matches',
+        'showing first 5 of 6+ total matches',
       );
       expect(result.llmContent).toContain('current: 5');
       expect(result.returnDisplay).toContain(
-        'Found 5 matches (truncated from 30+)',
+        'Found 5 matches (truncated from 6+)',
       );
     });
 
@@ -5,7 +5,6 @@
  */
 
 import fs from 'node:fs';
-import fsPromises from 'node:fs/promises';
 import path from 'node:path';
 import { EOL } from 'node:os';
 import { spawn } from 'node:child_process';
@@ -16,9 +15,11 @@ import { ToolNames } from './tool-names.js';
 import { makeRelative, shortenPath } from '../utils/paths.js';
 import { getErrorMessage, isNodeError } from '../utils/errors.js';
 import { isGitRepository } from '../utils/gitUtils.js';
+import { grepFilesInParallel } from '../utils/grepWorkerPool.js';
 import type { Config } from '../config/config.js';
 import type { FileExclusions } from '../utils/ignorePatterns.js';
 import { ToolErrorType } from './tool-error.js';
+import { compactToolOutput } from '../utils/toolOutputReducer.js';
 
 // --- Interfaces ---
 
@@ -138,6 +139,8 @@ class GrepToolInvocation extends BaseToolInvocation<
           pattern: this.params.pattern,
           path: searchDir,
           include: this.params.include,
+          // One extra match tells the caller the results were truncated.
+          maxMatches: maxResults - allMatches.length + 1,
           signal,
         });
 
@@ -235,7 +238,14 @@ class GrepToolInvocation extends BaseToolInvocation<
       }
 
       return {
-        llmContent: llmContent.trim(),
+        // Every match line is distinct, so only exact repeats are collapsed.
+        llmContent: await compactToolOutput(
+          this.config,
+          GrepTool.Name,
+          llmContent.trim(),
+          signal,
+          { collapseSimilar: false },
+        ),
         returnDisplay: displayText,
       };
     } catch (error) {
@@ -370,6 +380,8 @@ class GrepToolInvocation extends BaseToolInvocation<
     pattern: string;
     path: string; // Expects absolute path
     include?: string;
+    /** Matches past this are not needed; only the fallback stops early. */
+    maxMatches: number;
     signal: AbortSignal;
   }): Promise<GrepMatch[]> {
     const { pattern, path: absolutePath, include } = options;
@@ -549,38 +561,16 @@ class GrepToolInvocation extends BaseToolInvocation<
         signal: options.signal,
       });
 
-      const regex = new RegExp(pattern, 'i');
-      const allMatches: GrepMatch[] = [];
-
-      for await (const filePath of filesIterator) {
-        const fileAbsolutePath = filePath as string;
-        try {
-          const content = await fsPromises.readFile(fileAbsolutePath, 'utf8');
-          const lines = content.split(/\r?\n/);
-          lines.forEach((line, index) => {
-            if (regex.test(line)) {
-              allMatches.push({
-                filePath:
-                  path.relative(absolutePath, fileAbsolutePath) ||
-                  path.basename(fileAbsolutePath),
-                lineNumber: index + 1,
-                line,
-              });
-            }
-          });
-        } catch (readError: unknown) {
-          // Ignore errors like permission denied or file gone during read
-          if (!isNodeError(readError) || readError.code !== 'ENOENT') {
-            console.debug(
-              `GrepLogic: Could not read/process ${fileAbsolutePath}: ${getErrorMessage(
-                readError,
-              )}`,
-            );
-          }
-        }
-      }
-
-      return allMatches;
+      const matches = await grepFilesInParallel(
+        filesIterator as AsyncIterable<string>,
+        { pattern, maxMatches: options.maxMatches, signal: options.signal },
+      );
+      return matches.map((match) => ({
+        ...match,
+        filePath:
+          path.relative(absolutePath, match.filePath) ||
+          path.basename(match.filePath),
+      }));
     } catch (error: unknown) {
       console.error(
         `GrepLogic: Error in performGrepSearch (Strategy: ${strategyUsed}): ${getErrorMessage(
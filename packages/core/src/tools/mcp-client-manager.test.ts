@@ -10,6 +10,7 @@ import { McpClient } from './mcp-client.js';
 import type { ToolRegistry } from './tool-registry.js';
 import type { PromptRegistry } from '../prompts/prompt-registry.js';
 import type { WorkspaceContext } from '../utils/workspaceContext.js';
+import type { McpSchemaCache } from './mcp-schema-cache.js';
 
 vi.mock('./mcp-client.js', async () => {
   const originalModule = await vi.importActual('./mcp-client.js');
@@ -51,4 +52,149 @@ describe('McpClientManager', () => {
     expect(mockedMcpClient.connect).toHaveBeenCalledOnce();
     expect(mockedMcpClient.discover).toHaveBeenCalledOnce();
   });
+
+  it('should register cached schemas before the live discovery finishes', async () => {
+    const cachedSchema = {
+      serverName: 'test-server',
+      tools: [],
+      prompts: [],
+      updatedAt: 0,
+    };
+    let finishConnect: () => void = () => {};
+    const mockedMcpClient = {
+      connect: vi.fn(
+        () => new Promise<void>((resolve) => (finishConnect = resolve)),
+      ),
+      discover: vi.fn().mockResolvedValue({ ...cachedSchema, updatedAt: 1 }),
+      disconnect: vi.fn(),
+      getStatus: vi.fn(),
+      registerCachedSchema: vi.fn(),
+      unregister: vi.fn(),
+    };
+    vi.mocked(McpClient).mockReturnValue(
+      mockedMcpClient as unknown as McpClient,
+    );
+    const schemaCache = {
+      get: vi.fn().mockResolvedValue(cachedSchema),
+      set: vi.fn(),
+    };
+    const manager = new McpClientManager(
+      {
+        'test-server': {},
+      },
+      '',
+      {} as ToolRegistry,
+      {} as PromptRegistry,
+      false,
+      {} as WorkspaceContext,
+      schemaCache as unknown as McpSchemaCache,
+    );
+
+    await manager.discoverAllMcpTools();
+    expect(mockedMcpClient.registerCachedSchema).toHaveBeenCalledWith(
+      cachedSchema,
+    );
+    expect(mockedMcpClient.discover).not.toHaveBeenCalled();
+
+    finishConnect();
+    await manager.waitForBackgroundDiscovery();
+    expect(mockedMcpClient.discover).toHaveBeenCalledWith(cachedSchema);
+    // Only the timestamp changed, so the cache is not rewritten.
+    expect(schemaCache.set).not.toHaveBeenCalled();
+  });
+
+  it('should refresh the tools when the live tool list differs from the cache', async () => {
+    const cachedSchema = {
+      serverName: 'test-server',
+      tools: [],
+      prompts: [],
+      updatedAt: 0,
+    };
+    const liveSchema = {
+      ...cachedSchema,
+      tools: [{ name: 'new-tool', description: '', parameterSchema: {} }],
+      updatedAt: 1,
+    };
+    const mockedMcpClient = {
+      connect: vi.fn(),
+      discover: vi.fn().mockResolvedValue(liveSchema),
+      disconnect: vi.fn(),
+      getStatus: vi.fn(),
+      registerCachedSchema: vi.fn(),
+      unregister: vi.fn(),
+    };
+    vi.mocked(McpClient).mockReturnValue(
+      mockedMcpClient as unknown as McpClient,
+    );
+    const schemaCache = {
+      get: vi.fn().mockResolvedValue(cachedSchema),
+      set: vi.fn(),
+    };
+    const onToolsChanged = vi.fn().mockResolvedValue(undefined);
+    const manager = new McpClientManager(
+      {
+        'test-server': {},
+      },
+      '',
+      {} as ToolRegistry,
+      {} as PromptRegistry,
+      false,
+      {} as WorkspaceContext,
+      schemaCache as unknown as McpSchemaCache,
+      onToolsChanged,
+    );
+
+    await manager.discoverAllMcpTools();
+    await manager.waitForBackgroundDiscovery();
+    expect(schemaCache.set).toHaveBeenCalledOnce();
+    expect(onToolsChanged).toHaveBeenCalledOnce();
+  });
+
+  it('should not let an abandoned discovery unregister newer tools', async () => {
+    const cachedSchema = {
+      serverName: 'test-server',
+      tools: [],
+      prompts: [],
+      updatedAt: 0,
+    };
+    let failConnect: (error: Error) => void = () => {};
+    const staleClient = {
+      connect: vi.fn(
+        () => new Promise<void>((_, reject) => (failConnect = reject)),
+      ),
+      discover: vi.fn(),
+      disconnect: vi.fn(),
+      getStatus: vi.fn(),
+      registerCachedSchema: vi.fn(),
+      unregister: vi.fn(),
+    };
+    vi.mocked(McpClient).mockReturnValue(staleClient as unknown as McpClient);
+    const schemaCache = {
+      get: vi.fn().mockResolvedValue(cachedSchema),
+      set: vi.fn(),
+    };
+    const onToolsChanged = vi.fn().mockResolvedValue(undefined);
+    const manager = new McpClientManager(
+      {
+        'test-server': {},
+      },
+      '',
+      {} as ToolRegistry,
+      {} as PromptRegistry,
+      false,
+      {} as WorkspaceContext,
+      schemaCache as unknown as McpSchemaCache,
+      onToolsChanged,
+    );
+    vi.spyOn(console, 'error').mockImplementation(() => {});
+
+    await manager.discoverAllMcpTools();
+    const staleDiscovery = manager.waitForBackgroundDiscovery();
+    await manager.stop();
+    failConnect(new Error('server exited'));
+    await staleDiscovery;
+
+    expect(staleClient.unregister).not.toHaveBeenCalled();
+    expect(onToolsChanged).not.toHaveBeenCalled();
+  });
 });
@@ -7,6 +7,7 @@
 import type { MCPServerConfig } from '../config/config.js';
 import type { ToolRegistry } from './tool-registry.js';
 import type { PromptRegistry } from '../prompts/prompt-registry.js';
+import type { MCPServerTimings } from './mcp-client.js';
 import {
   McpClient,
   MCPDiscoveryState,
@@ -14,6 +15,15 @@ import {
 } from './mcp-client.js';
 import { getErrorMessage } from '../utils/errors.js';
 import type { WorkspaceContext } from '../utils/workspaceContext.js';
+import type {
+  CachedMcpServerSchema,
+  McpSchemaCache,
+} from './mcp-schema-cache.js';
+import {
+  getMcpServerConfigHash,
+  isSameMcpSchema,
+  isSameMcpToolList,
+} from './mcp-schema-cache.js';
 
 /**
  * Manages the lifecycle of multiple MCP clients, including local child processes.
@@ -29,6 +39,11 @@ export class McpClientManager {
   private readonly debugMode: boolean;
   private readonly workspaceContext: WorkspaceContext;
   private discoveryState: MCPDiscoveryState = MCPDiscoveryState.NOT_STARTED;
+  private readonly schemaCache: McpSchemaCache | undefined;
+  private readonly onToolsChanged: (() => Promise<void>) | undefined;
+  private backgroundDiscoveries: Array<Promise<void>> = [];
+  /** Bumped by `stop()` so discoveries it abandoned leave no traces. */
+  private generation = 0;
 
   constructor(
     mcpServers: Record<string, MCPServerConfig>,
@@ -37,6 +52,8 @@ export class McpClientManager {
     promptRegistry: PromptRegistry,
     debugMode: boolean,
     workspaceContext: WorkspaceContext,
+    schemaCache?: McpSchemaCache,
+    onToolsChanged?: () => Promise<void>,
   ) {
     this.mcpServers = mcpServers;
     this.mcpServerCommand = mcpServerCommand;
@@ -44,12 +61,20 @@ export class McpClientManager {
     this.promptRegistry = promptRegistry;
     this.debugMode = debugMode;
     this.workspaceContext = workspaceContext;
+    this.schemaCache = schemaCache;
+    this.onToolsChanged = onToolsChanged;
   }
 
   /**
    * Initiates the tool discovery process for all configured MCP servers.
    * It connects to each server, discovers its available tools, and registers
    * them with the `ToolRegistry`.
+   *
+   * Servers with a matching entry in the schema cache have their tools
+   * registered immediately; their live connection is then established in the
+   * background and reconciled with the cached schema, and `onToolsChanged` is
+   * called if that changes the registered tools. Only servers without a
+   * cached schema are awaited.
    */
   async discoverAllMcpTools(): Promise<void> {
     await this.stop();
@@ -70,16 +95,27 @@ export class McpClientManager {
           this.debugMode,
         );
         this.clients.set(name, client);
-        try {
-          await client.connect();
-          await client.discover();
-        } catch (error) {
-          // Log the error but don't let a single failed server stop the others
-          console.error(
-            `Error during discovery for server '${name}': ${getErrorMessage(
-              error,
-            )}`,
-          );
+
+        const configHash = this.schemaCache
+          ? getMcpServerConfigHash(name, config)
+          : undefined;
+        const cached = configHash
+          ? await this.schemaCache!.get(configHash)
+          : undefined;
+        if (cached) {
+          client.registerCachedSchema(cached);
+        }
+
+        const liveDiscovery = this.connectAndDiscover(
+          name,
+          client,
+          configHash,
+          cached,
+        );
+        if (cached) {
+          this.backgroundDiscoveries.push(liveDiscovery);
+        } else {
+          await liveDiscovery;
         }
       },
     );
@@ -88,11 +124,76 @@ export class McpClientManager {
     this.discoveryState = MCPDiscoveryState.COMPLETED;
   }
 
+  /**
+   * Waits for live discoveries of servers that were served from the schema
+   * cache. Primarily used for testing and orderly shutdown.
+   */
+  async waitForBackgroundDiscovery(): Promise<void> {
+    await Promise.all(this.backgroundDiscoveries);
+  }
+
+  private async connectAndDiscover(
+    name: string,
+    client: McpClient,
+    configHash: string | undefined,
+    cached: CachedMcpServerSchema | undefined,
+  ): Promise<void> {
+    const generation = this.generation;
+    try {
+      await client.connect();
+      if (generation !== this.generation) {
+        // Stopped while connecting; the registries belong to newer clients.
+        await client.disconnect();
+        return;
+      }
+      const schema = await client.discover(cached);
+      if (
+        configHash &&
+        schema &&
+        (!cached || !isSameMcpSchema(cached, schema))
+      ) {
+        await this.schemaCache!.set(configHash, schema);
+      }
+      if (cached && schema && !isSameMcpToolList(cached, schema)) {
+        await this.notifyToolsChanged();
+      }
+    } catch (error) {
+      if (generation !== this.generation) {
+        return;
+      }
+      if (cached) {
+        // Don't leave stale tools behind for a server that failed to start.
+        client.unregister();
+        await this.notifyToolsChanged();
+      }
+      // Log the error but don't let a single failed server stop the others
+      console.error(
+        `Error during discovery for server '${name}': ${getErrorMessage(
+          error,
+        )}`,
+      );
+    }
+  }
+
+  private async notifyToolsChanged(): Promise<void> {
+    try {
+      await this.onToolsChanged?.();
+    } catch (error) {
+      console.error(
+        `Error refreshing tools after MCP discovery: ${getErrorMessage(error)}`,
+      );
+    }
+  }
+
   /**
    * Stops all running local MCP servers and closes all client connections.
-   * This is the cleanup method to be called on application exit.
+   * This is the cleanup method to be called on application exit. Background
+   * discoveries still running are abandoned: they can no longer change the
+   * registries.
    */
   async stop(): Promise<void> {
+    this.generation++;
+    this.backgroundDiscoveries = [];
     const disconnectionPromises = Array.from(this.clients.entries()).map(
       async ([name, client]) => {
         try {
@@ -112,4 +213,15 @@ export class McpClientManager {
   getDiscoveryState(): MCPDiscoveryState {
     return this.discoveryState;
   }
+
+  /**
+   * Returns connect/discover latency per server from the last discovery.
+   */
+  getServerTimings(): Map<string, MCPServerTimings> {
+    const timings = new Map<string, MCPServerTimings>();
+    for (const [name, client] of this.clients) {
+      timings.set(name, client.getTimings());
+    }
+    return timings;
+  }
 }
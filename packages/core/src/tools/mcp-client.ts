@@ -26,8 +26,10 @@ import { AuthProviderType } from '../config/config.js';
 import { GoogleCredentialProvider } from '../mcp/google-auth-provider.js';
 import { DiscoveredMCPTool } from './mcp-tool.js';
 
-import type { FunctionDeclaration } from '@google/genai';
+import type { CallableTool, FunctionDeclaration } from '@google/genai';
 import { mcpToTool } from '@google/genai';
+import type { CachedMcpServerSchema } from './mcp-schema-cache.js';
+import { isSameMcpToolList } from './mcp-schema-cache.js';
 import type { ToolRegistry } from './tool-registry.js';
 import type { PromptRegistry } from '../prompts/prompt-registry.js';
 import { MCPOAuthProvider } from '../mcp/oauth-provider.js';
@@ -72,6 +74,17 @@ export enum MCPDiscoveryState {
   COMPLETED = 'completed',
 }
 
+/**
+ * Latency measurements for the most recent connect and discover phases of an
+ * MCP server, in milliseconds.
+ */
+export interface MCPServerTimings {
+  connectMs?: number;
+  discoverMs?: number;
+  /** True when tools were registered from the schema cache before connecting. */
+  servedFromCache?: boolean;
+}
+
 /**
  * A client for a single MCP server.
  *
@@ -83,6 +96,9 @@ export class McpClient {
   private transport: Transport | undefined;
   private status: MCPServerStatus = MCPServerStatus.DISCONNECTED;
   private isDisconnecting = false;
+  private connecting: Promise<void> | undefined;
+  private liveCallableTool: CallableTool | undefined;
+  private timings: MCPServerTimings = {};
 
   constructor(
     private readonly serverName: string,
@@ -102,8 +118,14 @@ export class McpClient {
    * Connects to the MCP server.
    */
   async connect(): Promise<void> {
+    this.connecting = this.doConnect();
+    return this.connecting;
+  }
+
+  private async doConnect(): Promise<void> {
     this.isDisconnecting = false;
     this.updateStatus(MCPServerStatus.CONNECTING);
+    const startTime = Date.now();
     try {
       this.transport = await this.createTransport();
 
@@ -136,6 +158,7 @@ export class McpClient {
         timeout: this.serverConfig.timeout,
       });
 
+      this.recordTimings({ connectMs: Date.now() - startTime });
       this.updateStatus(MCPServerStatus.CONNECTED);
     } catch (error) {
       this.updateStatus(MCPServerStatus.DISCONNECTED);
@@ -145,22 +168,113 @@ export class McpClient {
 
   /**
    * Discovers tools and prompts from the MCP server.
+   *
+   * @param cached The schema previously registered through
+   *   `registerCachedSchema()`, if any. Cached tools are kept when the live
+   *   tool list matches and replaced otherwise.
+   * @returns A snapshot of the discovered schema suitable for caching.
    */
-  async discover(): Promise<void> {
+  async discover(
+    cached?: CachedMcpServerSchema,
+  ): Promise<CachedMcpServerSchema> {
     if (this.status !== MCPServerStatus.CONNECTED) {
       throw new Error('Client is not connected.');
     }
 
+    const startTime = Date.now();
+    if (cached) {
+      // Live prompts carry an invoke bound to the connected client.
+      this.promptRegistry.removePromptsByServer(this.serverName);
+    }
     const prompts = await this.discoverPrompts();
     const tools = await this.discoverTools();
+    this.recordTimings({ discoverMs: Date.now() - startTime });
+    if (this.isDisconnecting) {
+      // Disconnected meanwhile; registering now would shadow a newer client.
+      throw new Error('Client was disconnected during discovery.');
+    }
 
     if (prompts.length === 0 && tools.length === 0) {
       throw new Error('No prompts or tools found on the server.');
     }
 
+    const schema: CachedMcpServerSchema = {
+      serverName: this.serverName,
+      tools: tools.map((tool) => ({
+        name: tool.serverToolName,
+        description: tool.description,
+        parameterSchema: tool.parameterSchema,
+      })),
+      prompts,
+      updatedAt: Date.now(),
+    };
+
+    if (cached) {
+      if (isSameMcpToolList(cached, schema)) {
+        // The cached registrations already route calls through this client.
+        return schema;
+      }
+      this.toolRegistry.removeMcpToolsByServer(this.serverName);
+    }
+
     for (const tool of tools) {
       this.toolRegistry.registerTool(tool);
     }
+    return schema;
+  }
+
+  /**
+   * Registers tools and prompts from a previously persisted schema so they are
+   * available before the server has finished starting. Invocations wait for
+   * the live connection, establishing it on demand.
+   */
+  registerCachedSchema(schema: CachedMcpServerSchema): void {
+    const callableTool = this.getDeferredCallableTool();
+    for (const tool of schema.tools) {
+      this.toolRegistry.registerTool(
+        new DiscoveredMCPTool(
+          callableTool,
+          this.serverName,
+          tool.name,
+          tool.description,
+          tool.parameterSchema,
+          this.serverConfig.timeout ?? MCP_DEFAULT_TIMEOUT_MSEC,
+          this.serverConfig.trust,
+        ),
+      );
+    }
+    for (const prompt of schema.prompts) {
+      this.promptRegistry.registerPrompt({
+        ...prompt,
+        serverName: this.serverName,
+        invoke: async (params: Record<string, unknown>) => {
+          await this.ensureConnected();
+          return invokeMcpPrompt(
+            this.serverName,
+            this.client,
+            prompt.name,
+            params,
+          );
+        },
+      });
+    }
+    this.recordTimings({ servedFromCache: true });
+  }
+
+  /**
+   * Removes everything this server registered with the tool and prompt
+   * registries.
+   */
+  unregister(): void {
+    this.toolRegistry.removeMcpToolsByServer(this.serverName);
+    this.promptRegistry.removePromptsByServer(this.serverName);
+  }
+
+  /**
+   * Returns the latency of the most recent connect and discover phases.
+   */
+  getTimings(): MCPServerTimings {
+    return { ...this.timings };
   }
 
   /**
@@ -187,6 +301,41 @@ export class McpClient {
     updateMCPServerStatus(this.serverName, status);
   }
 
+  private recordTimings(timings: MCPServerTimings): void {
+    this.timings = { ...this.timings, ...timings };
+    serverTimings.set(this.serverName, this.getTimings());
+  }
+
+  private async ensureConnected(): Promise<void> {
+    if (this.status === MCPServerStatus.CONNECTED) {
+      return;
+    }
+    if (this.status === MCPServerStatus.CONNECTING && this.connecting) {
+      await this.connecting;
+      return;
+    }
+    await this.connect();
+  }
+
+  /**
+   * Returns a CallableTool that waits for the live connection before
+   * delegating, used for tools registered from the schema cache.
+   */
+  private getDeferredCallableTool(): CallableTool {
+    const getLive = async () => {
+      await this.ensureConnected();
+      if (!this.liveCallableTool) {
+        this.liveCallableTool = mcpToTool(this.client);
+      }
+      return this.liveCallableTool;
+    };
+    return {
+      tool: async () => (await getLive()).tool(),
+      callTool: async (functionCalls) =>
+        (await getLive()).callTool(functionCalls),
+    };
+  }
+
   private async createTransport(): Promise<Transport> {
     return createTransport(this.serverName, this.serverConfig, this.debugMode);
   }
@@ -205,6 +354,11 @@ export class McpClient {
  */
 const serverStatuses: Map<string, MCPServerStatus> = new Map();
 
+/**
+ * Map to track connect/discover latency of each MCP server
+ */
+const serverTimings: Map<string, MCPServerTimings> = new Map();
+
 /**
  * Track the overall MCP discovery state
  */
@@ -273,6 +427,13 @@ export function getAllMCPServerStatuses(): Map<string, MCPServerStatus> {
   return new Map(serverStatuses);
 }
 
+/**
+ * Get connect/discover latency for all MCP servers
+ */
+export function getAllMCPServerTimings(): Map<string, MCPServerTimings> {
+  return new Map(serverTimings);
+}
+
 /**
  * Get the current MCP discovery state
  */
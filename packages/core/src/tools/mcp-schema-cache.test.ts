@@ -0,0 +1,89 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import {
+  McpSchemaCache,
+  getMcpServerConfigHash,
+  isSameMcpSchema,
+} from './mcp-schema-cache.js';
+import type { CachedMcpServerSchema } from './mcp-schema-cache.js';
+
+const schema: CachedMcpServerSchema = {
+  serverName: 'test-server',
+  tools: [
+    {
+      name: 'echo',
+      description: 'Echoes input',
+      parameterSchema: { type: 'object', properties: {} },
+    },
+  ],
+  prompts: [],
+  updatedAt: 1,
+};
+
+describe('McpSchemaCache', () => {
+  let tmpDir: string;
+  let cacheFile: string;
+
+  beforeEach(async () => {
+    tmpDir = await fs.mkdtemp(path.join(os.tmpdir(), 'mcp-schema-cache-'));
+    cacheFile = path.join(tmpDir, 'nested', 'cache.json');
+  });
+
+  afterEach(async () => {
+    await fs.rm(tmpDir, { recursive: true, force: true });
+  });
+
+  it('should persist schemas across instances', async () => {
+    await new McpSchemaCache(cacheFile).set('hash', schema);
+
+    const reloaded = new McpSchemaCache(cacheFile);
+    expect(await reloaded.get('hash')).toEqual(schema);
+    expect(await reloaded.get('other')).toBeUndefined();
+  });
+
+  it('should treat a corrupt cache file as empty', async () => {
+    await fs.mkdir(path.dirname(cacheFile), { recursive: true });
+    await fs.writeFile(cacheFile, '{not json');
+
+    expect(await new McpSchemaCache(cacheFile).get('hash')).toBeUndefined();
+  });
+
+  it('should delete entries', async () => {
+    const cache = new McpSchemaCache(cacheFile);
+    await cache.set('hash', schema);
+    await cache.delete('hash');
+
+    expect(await new McpSchemaCache(cacheFile).get('hash')).toBeUndefined();
+  });
+});
+
+describe('getMcpServerConfigHash', () => {
+  it('should ignore key order and change with the config', () => {
+    const a = getMcpServerConfigHash('s', { command: 'npx', args: ['x'] });
+    const b = getMcpServerConfigHash('s', { args: ['x'], command: 'npx' });
+    const c = getMcpServerConfigHash('s', { command: 'npx', args: ['y'] });
+
+    expect(a).toBe(b);
+    expect(a).not.toBe(c);
+  });
+});
+
+describe('isSameMcpSchema', () => {
+  it('should compare tools and prompts but not timestamps', () => {
+    expect(isSameMcpSchema(schema, { ...schema, updatedAt: 2 })).toBe(true);
+    expect(
+      isSameMcpSchema(schema, {
+        ...schema,
+        tools: [{ ...schema.tools[0], description: 'changed' }],
+      }),
+    ).toBe(false);
+  });
+});
@@ -0,0 +1,155 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import crypto from 'node:crypto';
+import path from 'node:path';
+import { promises as fsp } from 'node:fs';
+import type { Prompt } from '@modelcontextprotocol/sdk/types.js';
+import type { MCPServerConfig } from '../config/config.js';
+
+const CACHE_VERSION = 1;
+
+/**
+ * The subset of a discovered MCP tool needed to register it again without
+ * talking to the server.
+ */
+export interface CachedMcpToolSchema {
+  name: string;
+  description: string;
+  parameterSchema: unknown;
+}
+
+export interface CachedMcpServerSchema {
+  serverName: string;
+  tools: CachedMcpToolSchema[];
+  prompts: Prompt[];
+  updatedAt: number;
+}
+
+interface McpSchemaCacheFile {
+  version: number;
+  servers: Record<string, CachedMcpServerSchema>;
+}
+
+/**
+ * Computes a stable hash of a server's name and configuration. Secrets such as
+ * headers and env values only contribute to the hash and are never persisted.
+ */
+export function getMcpServerConfigHash(
+  serverName: string,
+  config: MCPServerConfig,
+): string {
+  const hash = crypto.createHash('sha256');
+  hash.update(serverName);
+  hash.update('\0');
+  hash.update(stableStringify(config));
+  return hash.digest('hex');
+}
+
+function stableStringify(value: unknown): string {
+  if (Array.isArray(value)) {
+    return `[${value.map(stableStringify).join(',')}]`;
+  }
+  if (value && typeof value === 'object') {
+    const entries = Object.entries(value as Record<string, unknown>)
+      .filter(([, v]) => v !== undefined)
+      .sort(([a], [b]) => a.localeCompare(b))
+      .map(([k, v]) => `${JSON.stringify(k)}:${stableStringify(v)}`);
+    return `{${entries.join(',')}}`;
+  }
+  return JSON.stringify(value) ?? 'null';
+}
+
+/**
+ * Returns true when two schema snapshots describe the same tools.
+ */
+export function isSameMcpToolList(
+  a: Pick<CachedMcpServerSchema, 'tools'>,
+  b: Pick<CachedMcpServerSchema, 'tools'>,
+): boolean {
+  return stableStringify(a.tools) === stableStringify(b.tools);
+}
+
+/**
+ * Returns true when two schema snapshots describe the same tools and prompts.
+ */
+export function isSameMcpSchema(
+  a: Pick<CachedMcpServerSchema, 'tools' | 'prompts'>,
+  b: Pick<CachedMcpServerSchema, 'tools' | 'prompts'>,
+): boolean {
+  return (
+    isSameMcpToolList(a, b) &&
+    stableStringify(a.prompts) === stableStringify(b.prompts)
+  );
+}
+
+/**
+ * Persists the last discovered tool and prompt schemas of each MCP server,
+ * keyed by a hash of the server configuration, so that tools can be
+ * registered at startup before the server itself has finished launching.
+ */
+export class McpSchemaCache {
+  private entries: Record<string, CachedMcpServerSchema> | undefined;
+  private loading: Promise<void> | undefined;
+  private saveQueue: Promise<void> = Promise.resolve();
+
+  constructor(private readonly filePath: string) {}
+
+  async get(configHash: string): Promise<CachedMcpServerSchema | undefined> {
+    await this.load();
+    return this.entries?.[configHash];
+  }
+
+  async set(configHash: string, schema: CachedMcpServerSchema): Promise<void> {
+    await this.load();
+    this.entries![configHash] = schema;
+    await this.save();
+  }
+
+  async delete(configHash: string): Promise<void> {
+    await this.load();
+    if (this.entries![configHash]) {
+      delete this.entries![configHash];
+      await this.save();
+    }
+  }
+
+  private load(): Promise<void> {
+    if (!this.loading) {
+      this.loading = (async () => {
+        try {
+          const content = await fsp.readFile(this.filePath, 'utf-8');
+          const parsed = JSON.parse(content) as McpSchemaCacheFile;
+          this.entries =
+            parsed?.version === CACHE_VERSION && parsed.servers
+              ? parsed.servers
+              : {};
+        } catch {
+          // A missing or corrupt cache simply means a cold start.
+          this.entries = {};
+        }
+      })();
+    }
+    return this.loading;
+  }
+
+  private save(): Promise<void> {
+    // Serialize writes so concurrent server discoveries do not interleave.
+    this.saveQueue = this.saveQueue.then(async () => {
+      const data: McpSchemaCacheFile = {
+        version: CACHE_VERSION,
+        servers: this.entries ?? {},
+      };
+      try {
+        await fsp.mkdir(path.dirname(this.filePath), { recursive: true });
+        await fsp.writeFile(this.filePath, JSON.stringify(data), 'utf-8');
+      } catch (error) {
+        console.debug('Failed to write MCP schema cache:', error);
+      }
+    });
+    return this.saveQueue;
+  }
+}
@@ -88,6 +88,7 @@ describe('ReadManyFilesTool', () => {
         buildExcludePatterns: () => DEFAULT_FILE_EXCLUDES,
         getReadManyFilesExcludes: () => DEFAULT_FILE_EXCLUDES,
       }),
+      getSummarizeToolOutputConfig: () => undefined,
     } as Partial<Config> as Config;
     tool = new ReadManyFilesTool(mockConfig);
 
@@ -500,6 +501,7 @@ describe('ReadManyFilesTool', () => {
           buildExcludePatterns: () => [],
           getReadManyFilesExcludes: () => [],
         }),
+        getSummarizeToolOutputConfig: () => undefined,
       } as Partial<Config> as Config;
       tool = new ReadManyFilesTool(mockConfig);
 
@@ -27,6 +27,10 @@ import { getProgrammingLanguage } from '../telemetry/telemetry-utils.js';
 import { logFileOperation } from '../telemetry/loggers.js';
 import { FileOperationEvent } from '../telemetry/types.js';
 import { ToolErrorType } from './tool-error.js';
+import {
+  compactToolOutput,
+  CONFIGURED_TOOL_OUTPUT_TOKEN_BUDGET,
+} from '../utils/toolOutputReducer.js';
 
 /**
  * Parameters for the ReadManyFilesTool.
@@ -400,6 +404,18 @@ ${finalExclusionPatternsForDescription
 
     const results = await Promise.allSettled(fileProcessingPromises);
 
+    // File contents are only reduced when configured, with the budget shared
+    // between the files read.
+    const reduceSettings =
+      this.config.getSummarizeToolOutputConfig()?.[ReadManyFilesTool.Name];
+    const perFileTokenBudget = Math.max(
+      256,
+      Math.floor(
+        (reduceSettings?.tokenBudget ?? CONFIGURED_TOOL_OUTPUT_TOKEN_BUDGET) /
+          Math.max(1, results.length),
+      ),
+    );
+
     for (const result of results) {
       if (result.status === 'fulfilled') {
         const fileResult = result.value;
@@ -424,7 +440,15 @@ ${finalExclusionPatternsForDescription
             if (fileReadResult.isTruncated) {
               fileContentForLlm += `[WARNING: This file was truncated. To view the full content, use the 'read_file' tool on this specific file.]\n\n`;
             }
-            fileContentForLlm += fileReadResult.llmContent;
+            fileContentForLlm += reduceSettings
+              ? await compactToolOutput(
+                  this.config,
+                  ReadManyFilesTool.Name,
+                  fileReadResult.llmContent,
+                  signal,
+                  { tokenBudget: perFileTokenBudget, collapseSimilar: false },
+                )
+              : fileReadResult.llmContent;
             contentParts.push(`${separator}\n\n${fileContentForLlm}\n\n`);
           } else {
             // This is a Part for image/pdf, which we don't add the separator to.
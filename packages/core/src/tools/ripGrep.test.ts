@@ -84,6 +84,7 @@ describe('RipGrepTool', () => {
     getTargetDir: () => tempRootDir,
     getWorkspaceContext: () => createMockWorkspaceContext(tempRootDir),
     getDebugMode: () => false,
+    getSummarizeToolOutputConfig: () => undefined,
   } as unknown as Config;
 
   beforeEach(async () => {
@@ -457,6 +458,7 @@ describe('RipGrepTool', () => {
         getWorkspaceContext: () =>
           createMockWorkspaceContext(tempRootDir, [secondDir]),
         getDebugMode: () => false,
+        getSummarizeToolOutputConfig: () => undefined,
       } as unknown as Config;
 
       // Setup specific mock for this test - multi-directory search for 'world'
@@ -562,6 +564,7 @@ describe('RipGrepTool', () => {
         getWorkspaceContext: () =>
           createMockWorkspaceContext(tempRootDir, [secondDir]),
         getDebugMode: () => false,
+        getSummarizeToolOutputConfig: () => undefined,
       } as unknown as Config;
 
       // Setup specific mock for this test - searching in 'sub' should only return matches from that directory
@@ -1192,6 +1195,7 @@ describe('RipGrepTool', () => {
         getWorkspaceContext: () =>
           createMockWorkspaceContext(tempRootDir, ['/another/dir']),
         getDebugMode: () => false,
+        getSummarizeToolOutputConfig: () => undefined,
       } as unknown as Config;
 
       const multiDirGrepTool = new RipGrepTool(multiDirConfig);
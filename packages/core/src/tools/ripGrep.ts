@@ -14,6 +14,7 @@ import { SchemaValidator } from '../utils/schemaValidator.js';
 import { makeRelative, shortenPath } from '../utils/paths.js';
 import { getErrorMessage, isNodeError } from '../utils/errors.js';
 import type { Config } from '../config/config.js';
+import { compactToolOutput } from '../utils/toolOutputReducer.js';
 
 const DEFAULT_TOTAL_MAX_MATCHES = 20000;
 
@@ -209,7 +210,14 @@ class GrepToolInvocation extends BaseToolInvocation<
       }
 
       return {
-        llmContent: llmContent.trim(),
+        // Every match line is distinct, so only exact repeats are collapsed.
+        llmContent: await compactToolOutput(
+          this.config,
+          RipGrepTool.Name,
+          llmContent.trim(),
+          signal,
+          { collapseSimilar: false },
+        ),
         returnDisplay: displayMessage,
       };
     } catch (error) {
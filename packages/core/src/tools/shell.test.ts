@@ -361,13 +361,22 @@ describe('ShellTool', () => {
       );
     });
 
-    it('should summarize output when configured', async () => {
+    it('should summarize output that does not fit the budget locally', async () => {
       (mockConfig.getSummarizeToolOutputConfig as Mock).mockReturnValue({
         [shellTool.name]: { tokenBudget: 1000 },
       });
       vi.mocked(summarizer.summarizeToolOutput).mockResolvedValue(
         'summarized output',
       );
+      // Distinct error lines that cannot be collapsed or elided.
+      const toLetters = (n: number) =>
+        n.toString(26).replace(/[0-9a-p]/g, (d) =>
+          String.fromCharCode(97 + parseInt(d, 26)),
+        );
+      const output = Array.from(
+        { length: 500 },
+        (_, i) => `error: unresolved symbol ${toLetters(i)}`,
+      ).join('\n');
 
       const invocation = shellTool.build({
         command: 'ls',
@@ -375,8 +384,8 @@ describe('ShellTool', () => {
       });
       const promise = invocation.execute(mockAbortSignal);
       resolveExecutionPromise({
-        output: 'long output',
-        rawOutput: Buffer.from('long output'),
+        output,
+        rawOutput: Buffer.from(output),
         exitCode: 0,
         signal: null,
         error: null,
@@ -394,7 +403,40 @@ describe('ShellTool', () => {
         1000,
       );
       expect(result.llmContent).toBe('summarized output');
-      expect(result.returnDisplay).toBe('long output');
+      expect(result.returnDisplay).toBe(output);
+    });
+
+    it('should reduce output locally instead of summarizing when it fits', async () => {
+      (mockConfig.getSummarizeToolOutputConfig as Mock).mockReturnValue({
+        [shellTool.name]: { tokenBudget: 500 },
+      });
+      const output = Array.from(
+        { length: 200 },
+        (_, i) => `Downloading ${i}%`,
+      ).join('\n');
+
+      const invocation = shellTool.build({
+        command: 'ls',
+        is_background: false,
+      });
+      const promise = invocation.execute(mockAbortSignal);
+      resolveExecutionPromise({
+        output,
+        rawOutput: Buffer.from(output),
+        exitCode: 0,
+        signal: null,
+        error: null,
+        aborted: false,
+        pid: 12345,
+        executionMethod: 'child_process',
+      });
+
+      const result = await promise;
+
+      expect(summarizer.summarizeToolOutput).not.toHaveBeenCalled();
+      expect(result.llmContent).toContain(
+        'Output: Downloading 0%\nDownloading 1%\n... (197 similar lines omitted)\nDownloading 199%',
+      );
     });
 
     it('should clean up the temp file on synchronous execution error', async () => {
@@ -17,6 +17,7 @@ import { spawn } from 'node:child_process';
 import { StringDecoder } from 'node:string_decoder';
 import { connectAndDiscover } from './mcp-client.js';
 import { McpClientManager } from './mcp-client-manager.js';
+import { McpSchemaCache } from './mcp-schema-cache.js';
 import { DiscoveredMCPTool } from './mcp-tool.js';
 import { parse } from 'shell-quote';
 import { ToolErrorType } from './tool-error.js';
@@ -180,6 +181,13 @@ export class ToolRegistry {
       this.config.getPromptRegistry(),
       this.config.getDebugMode(),
       this.config.getWorkspaceContext(),
+      new McpSchemaCache(this.config.getMcpSchemaCachePath()),
+      async () => {
+        const geminiClient = this.config.getGeminiClient();
+        if (geminiClient?.isInitialized()) {
+          await geminiClient.setTools();
+        }
+      },
     );
   }
 
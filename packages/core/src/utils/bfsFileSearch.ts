@@ -16,7 +16,8 @@ const logger = {
 };
 
 interface BfsFileSearchOptions {
-  fileName: string;
+  /** The file name to look for, or several names to find in a single pass. */
+  fileName: string | string[];
   ignoreDirs?: string[];
   maxDirs?: number;
   debug?: boolean;
@@ -50,6 +51,7 @@ export async function bfsFileSearch(
 
   // Convert ignoreDirs array to Set for O(1) lookup performance
   const ignoreDirsSet = new Set(ignoreDirs);
+  const fileNames = new Set(Array.isArray(fileName) ? fileName : [fileName]);
 
   // Process directories in parallel batches for maximum performance
   const PARALLEL_BATCH_SIZE = 15; // Parallel processing batch size for optimal performance
@@ -113,7 +115,7 @@ export async function bfsFileSearch(
           if (!ignoreDirsSet.has(entry.name)) {
             queue.push(fullPath);
           }
-        } else if (entry.isFile() && entry.name === fileName) {
+        } else if (entry.isFile() && fileNames.has(entry.name)) {
           foundFiles.push(fullPath);
         }
       }
@@ -0,0 +1,146 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { FileContentCache } from './fileContentCache.js';
+
+describe('FileContentCache', () => {
+  let tmpDir: string;
+
+  beforeEach(async () => {
+    tmpDir = await fs.mkdtemp(path.join(os.tmpdir(), 'file-content-cache-'));
+  });
+
+  afterEach(async () => {
+    await fs.rm(tmpDir, { recursive: true, force: true });
+  });
+
+  // Writes a file with an mtime outside the racy window so it can be cached.
+  async function writeSettledFile(name: string, content: string | Buffer) {
+    const filePath = path.join(tmpDir, name);
+    await fs.writeFile(filePath, content);
+    const past = new Date(Date.now() - 10_000);
+    await fs.utimes(filePath, past, past);
+    return filePath;
+  }
+
+  it('should serve repeated reads of an unchanged file from memory', async () => {
+    const cache = new FileContentCache();
+    const filePath = await writeSettledFile('a.txt', 'hello');
+    const read = vi.fn(() => fs.readFile(filePath, 'utf-8'));
+
+    expect(await cache.readText(filePath, read)).toBe('hello');
+    expect(await cache.readText(filePath, read)).toBe('hello');
+
+    expect(read).toHaveBeenCalledTimes(1);
+    expect(cache.getStats()).toMatchObject({ hits: 1, misses: 1, entries: 1 });
+  });
+
+  it('should reload a file once its stamp changes', async () => {
+    const cache = new FileContentCache();
+    const filePath = await writeSettledFile('a.txt', 'hello');
+    const read = () => fs.readFile(filePath, 'utf-8');
+    await cache.readText(filePath, read);
+
+    await writeSettledFile('a.txt', 'hello world');
+    expect(await cache.readText(filePath, read)).toBe('hello world');
+  });
+
+  it('should not cache files modified within the racy window', async () => {
+    const cache = new FileContentCache();
+    const filePath = path.join(tmpDir, 'fresh.txt');
+    await fs.writeFile(filePath, 'fresh');
+    const read = vi.fn(() => fs.readFile(filePath, 'utf-8'));
+
+    await cache.readText(filePath, read);
+    await cache.readText(filePath, read);
+
+    expect(read).toHaveBeenCalledTimes(2);
+    expect(cache.getStats().entries).toBe(0);
+  });
+
+  it('should propagate read errors without caching', async () => {
+    const cache = new FileContentCache();
+    const read = () => Promise.reject(new Error('ENOENT'));
+
+    await expect(
+      cache.readText(path.join(tmpDir, 'missing.txt'), read),
+    ).rejects.toThrow('ENOENT');
+    expect(cache.getStats().entries).toBe(0);
+  });
+
+  it('should serve the text read while sniffing without reopening', async () => {
+    const cache = new FileContentCache();
+    const filePath = await writeSettledFile('a.ts', 'const a = 1;');
+    const read = vi.fn(() => fs.readFile(filePath, 'utf-8'));
+
+    expect(await cache.sniff(filePath)).toEqual({ isBinary: false, size: 12 });
+    expect(await cache.readText(filePath, read)).toBe('const a = 1;');
+    expect(read).not.toHaveBeenCalled();
+  });
+
+  it('should remember binary files without holding their bytes', async () => {
+    const cache = new FileContentCache();
+    const filePath = await writeSettledFile(
+      'a.bin',
+      Buffer.from([0x00, 0x01, 0x02]),
+    );
+
+    expect((await cache.sniff(filePath)).isBinary).toBe(true);
+    expect((await cache.sniff(filePath)).isBinary).toBe(true);
+    expect(cache.getStats()).toMatchObject({ hits: 1, bytes: 0 });
+  });
+
+  it('should evict least recently used entries over the memory cap', async () => {
+    // Each 10-character file costs 20 bytes once decoded.
+    const cache = new FileContentCache({ maxTotalBytes: 50 });
+    const files = await Promise.all(
+      ['a', 'b', 'c'].map((name) =>
+        writeSettledFile(`${name}.txt`, name.repeat(10)),
+      ),
+    );
+    const read = (filePath: string) => () => fs.readFile(filePath, 'utf-8');
+
+    await cache.readText(files[0], read(files[0]));
+    await cache.readText(files[1], read(files[1]));
+    await cache.readText(files[0], read(files[0]));
+    await cache.readText(files[2], read(files[2]));
+
+    expect(cache.getStats()).toMatchObject({
+      entries: 2,
+      bytes: 40,
+      evictions: 1,
+    });
+    const reread = vi.fn(read(files[1]));
+    await cache.readText(files[1], reread);
+    expect(reread).toHaveBeenCalledTimes(1);
+  });
+
+  it('should drop invalidated entries', async () => {
+    const cache = new FileContentCache();
+    const filePath = await writeSettledFile('a.txt', 'hello');
+    await cache.readText(filePath, () => fs.readFile(filePath, 'utf-8'));
+
+    cache.invalidate(filePath);
+    expect(cache.getStats()).toMatchObject({ entries: 0, bytes: 0 });
+  });
+
+  it('should report lookups to the listener', async () => {
+    const cache = new FileContentCache();
+    const listener = vi.fn();
+    cache.setLookupListener(listener);
+    const filePath = await writeSettledFile('a.txt', 'hello');
+    const read = () => fs.readFile(filePath, 'utf-8');
+
+    await cache.readText(filePath, read);
+    await cache.readText(filePath, read);
+
+    expect(listener.mock.calls).toEqual([[false], [true]]);
+  });
+});
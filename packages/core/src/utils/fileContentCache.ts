@@ -0,0 +1,303 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import fs from 'node:fs/promises';
+import path from 'node:path';
+
+// Bytes inspected when deciding whether a file is binary.
+export const SNIFF_BYTES = 4096;
+
+// Files modified this recently are not cached. On filesystems with coarse
+// timestamps a second write within the same tick would otherwise keep the
+// same stamp and serve stale content.
+const RACY_WINDOW_MS = 1000;
+
+export interface FileContentCacheOptions {
+  /** Upper bound on the memory held by all entries. */
+  maxTotalBytes?: number;
+  /** Entries larger than this are never cached. */
+  maxEntryBytes?: number;
+}
+
+export interface FileContentCacheStats {
+  hits: number;
+  misses: number;
+  evictions: number;
+  entries: number;
+  bytes: number;
+}
+
+export interface SniffResult {
+  isBinary: boolean;
+  size: number;
+}
+
+interface FileIdentity {
+  mtimeNs: bigint;
+  size: bigint;
+  ino: bigint;
+}
+
+interface CacheEntry extends FileIdentity {
+  bytes?: Buffer;
+  text?: string;
+  isBinary?: boolean;
+  cost: number;
+}
+
+/**
+ * Process-wide cache of file contents shared by the file tools. Entries are
+ * keyed by absolute path and only served while the file's mtime (in
+ * nanoseconds), size and inode still match, so any write on disk invalidates
+ * them. Memory use is capped and the least recently used entries are evicted
+ * first.
+ */
+export class FileContentCache {
+  private readonly maxTotalBytes: number;
+  private readonly maxEntryBytes: number;
+  private readonly entries = new Map<string, CacheEntry>();
+  private totalBytes = 0;
+  private hits = 0;
+  private misses = 0;
+  private evictions = 0;
+  private lookupListener: ((hit: boolean) => void) | undefined;
+
+  constructor(options: FileContentCacheOptions = {}) {
+    this.maxTotalBytes = options.maxTotalBytes ?? 64 * 1024 * 1024;
+    this.maxEntryBytes = options.maxEntryBytes ?? 8 * 1024 * 1024;
+  }
+
+  /**
+   * Returns the text content of `filePath`, calling `read` only when no valid
+   * entry exists. Errors from `read` propagate unchanged.
+   */
+  async readText(
+    filePath: string,
+    read: () => Promise<string>,
+  ): Promise<string> {
+    const key = path.resolve(filePath);
+    const identity = await statIdentity(key);
+    const entry = this.lookup(key, identity);
+    if (entry && (entry.text !== undefined || entry.bytes)) {
+      this.recordLookup(true);
+      if (entry.text === undefined) {
+        entry.text = entry.bytes!.toString('utf-8');
+        entry.bytes = undefined;
+        this.resize(entry, textCost(entry.text));
+      }
+      return entry.text;
+    }
+
+    this.recordLookup(false);
+    const text = await read();
+    if (identity && this.isCacheable(identity)) {
+      this.store(key, {
+        ...identity,
+        text,
+        isBinary: entry?.isBinary,
+        cost: textCost(text),
+      });
+    }
+    return text;
+  }
+
+  /**
+   * Decides whether `filePath` is binary by sampling its first bytes. Small
+   * files are read whole through the same handle, so a following
+   * {@link readText} is served without opening the file again.
+   */
+  async sniff(filePath: string): Promise<SniffResult> {
+    const key = path.resolve(filePath);
+    const handle = await fs.open(key, 'r');
+    try {
+      const stats = await handle.stat({ bigint: true });
+      const identity: FileIdentity = {
+        mtimeNs: stats.mtimeNs,
+        size: stats.size,
+        ino: stats.ino,
+      };
+      const size = Number(stats.size);
+      const entry = this.lookup(key, identity);
+      if (entry?.isBinary !== undefined) {
+        this.recordLookup(true);
+        return { isBinary: entry.isBinary, size };
+      }
+      if (entry?.text !== undefined) {
+        // Only text content is ever decoded and cached.
+        this.recordLookup(true);
+        entry.isBinary = false;
+        return { isBinary: false, size };
+      }
+
+      this.recordLookup(false);
+      if (size === 0) {
+        return { isBinary: false, size };
+      }
+      const cacheable = this.isCacheable(identity);
+      const readWhole = cacheable && size <= this.maxEntryBytes;
+      const buffer = Buffer.alloc(
+        readWhole ? size : Math.min(SNIFF_BYTES, size),
+      );
+      const { bytesRead } = await handle.read(buffer, 0, buffer.length, 0);
+      const isBinary = looksBinary(
+        buffer.subarray(0, Math.min(bytesRead, SNIFF_BYTES)),
+      );
+
+      if (readWhole && bytesRead === size) {
+        this.store(key, {
+          ...identity,
+          bytes: isBinary ? undefined : buffer,
+          isBinary,
+          cost: isBinary ? 0 : buffer.length,
+        });
+      } else if (cacheable) {
+        this.store(key, { ...identity, isBinary, cost: 0 });
+      }
+      return { isBinary, size };
+    } finally {
+      await handle.close();
+    }
+  }
+
+  /** Drops the entry for `filePath`, e.g. after writing to it. */
+  invalidate(filePath: string): void {
+    const key = path.resolve(filePath);
+    const entry = this.entries.get(key);
+    if (entry) {
+      this.entries.delete(key);
+      this.totalBytes -= entry.cost;
+    }
+  }
+
+  clear(): void {
+    this.entries.clear();
+    this.totalBytes = 0;
+  }
+
+  getStats(): FileContentCacheStats {
+    return {
+      hits: this.hits,
+      misses: this.misses,
+      evictions: this.evictions,
+      entries: this.entries.size,
+      bytes: this.totalBytes,
+    };
+  }
+
+  resetStats(): void {
+    this.hits = 0;
+    this.misses = 0;
+    this.evictions = 0;
+  }
+
+  /** Registers a callback invoked on every lookup, used for telemetry. */
+  setLookupListener(listener: ((hit: boolean) => void) | undefined): void {
+    this.lookupListener = listener;
+  }
+
+  private recordLookup(hit: boolean): void {
+    if (hit) {
+      this.hits++;
+    } else {
+      this.misses++;
+    }
+    this.lookupListener?.(hit);
+  }
+
+  private lookup(
+    key: string,
+    identity: FileIdentity | undefined,
+  ): CacheEntry | undefined {
+    const entry = this.entries.get(key);
+    if (!entry) {
+      return undefined;
+    }
+    if (
+      !identity ||
+      entry.mtimeNs !== identity.mtimeNs ||
+      entry.size !== identity.size ||
+      entry.ino !== identity.ino
+    ) {
+      this.invalidate(key);
+      return undefined;
+    }
+    // Refresh the entry's position in the LRU order.
+    this.entries.delete(key);
+    this.entries.set(key, entry);
+    return entry;
+  }
+
+  private isCacheable(identity: FileIdentity): boolean {
+    const mtimeMs = Number(identity.mtimeNs / 1_000_000n);
+    return Date.now() - mtimeMs >= RACY_WINDOW_MS;
+  }
+
+  private store(key: string, entry: CacheEntry): void {
+    this.invalidate(key);
+    if (entry.cost > this.maxEntryBytes) {
+      return;
+    }
+    this.entries.set(key, entry);
+    this.totalBytes += entry.cost;
+    this.evict();
+  }
+
+  private resize(entry: CacheEntry, cost: number): void {
+    this.totalBytes += cost - entry.cost;
+    entry.cost = cost;
+    this.evict();
+  }
+
+  private evict(): void {
+    for (const [key, entry] of this.entries) {
+      if (this.totalBytes <= this.maxTotalBytes) {
+        break;
+      }
+      this.entries.delete(key);
+      this.totalBytes -= entry.cost;
+      this.evictions++;
+    }
+  }
+}
+
+async function statIdentity(
+  filePath: string,
+): Promise<FileIdentity | undefined> {
+  try {
+    const stats = await fs.stat(filePath, { bigint: true });
+    if (!stats || typeof stats.mtimeNs !== 'bigint') {
+      return undefined;
+    }
+    return { mtimeNs: stats.mtimeNs, size: stats.size, ino: stats.ino };
+  } catch {
+    return undefined;
+  }
+}
+
+/**
+ * Heuristic used by `isBinaryFile`: a null byte, or more than 30%
+ * non-printable characters, marks the sample as binary. Callers pass at most
+ * {@link SNIFF_BYTES} from the start of the file.
+ */
+export function looksBinary(sample: Uint8Array): boolean {
+  if (sample.length === 0) return false;
+
+  let nonPrintableCount = 0;
+  for (let i = 0; i < sample.length; i++) {
+    if (sample[i] === 0) return true;
+    if (sample[i] < 9 || (sample[i] > 13 && sample[i] < 32)) {
+      nonPrintableCount++;
+    }
+  }
+  return nonPrintableCount / sample.length > 0.3;
+}
+
+// JavaScript strings use two bytes per UTF-16 code unit.
+function textCost(text: string): number {
+  return text.length * 2;
+}
+
+export const fileContentCache = new FileContentCache();
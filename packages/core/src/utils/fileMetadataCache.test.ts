@@ -0,0 +1,126 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { FileMetadataCache } from './fileMetadataCache.js';
+
+describe('FileMetadataCache', () => {
+  let tmpDir: string;
+  let cacheFile: string;
+
+  beforeEach(async () => {
+    tmpDir = await fs.mkdtemp(path.join(os.tmpdir(), 'file-metadata-cache-'));
+    cacheFile = path.join(tmpDir, 'cache', 'test.json');
+  });
+
+  afterEach(async () => {
+    await fs.rm(tmpDir, { recursive: true, force: true });
+  });
+
+  it('should only return values recorded with the same stamp', () => {
+    const cache = new FileMetadataCache<string>('test', {
+      filePath: cacheFile,
+    });
+    cache.set('/a.md', { mtimeMs: 1, size: 10 }, 'parsed');
+
+    expect(cache.get('/a.md', { mtimeMs: 1, size: 10 })).toBe('parsed');
+    expect(cache.get('/a.md', { mtimeMs: 2, size: 10 })).toBeUndefined();
+    expect(cache.get('/a.md', { mtimeMs: 1, size: 11 })).toBeUndefined();
+    expect(cache.get('/a.md', undefined)).toBeUndefined();
+  });
+
+  it('should not record values without a stamp', () => {
+    const cache = new FileMetadataCache<string>('test', {
+      filePath: cacheFile,
+    });
+    cache.set('/a.md', undefined, 'parsed');
+    cache.saveSync();
+
+    expect(cache.get('/a.md', { mtimeMs: 1, size: 10 })).toBeUndefined();
+  });
+
+  it('should persist records across instances', async () => {
+    const stamp = { mtimeMs: 1, size: 10 };
+    const first = new FileMetadataCache<{ name: string }>('test', {
+      filePath: cacheFile,
+    });
+    first.set('/a.md', stamp, { name: 'a' });
+    await first.save();
+
+    const second = new FileMetadataCache<{ name: string }>('test', {
+      filePath: cacheFile,
+    });
+    await second.load();
+    expect(second.get('/a.md', stamp)).toEqual({ name: 'a' });
+  });
+
+  it('should discard records written with another version', () => {
+    const stamp = { mtimeMs: 1, size: 10 };
+    const first = new FileMetadataCache<string>('test', {
+      filePath: cacheFile,
+    });
+    first.set('/a.md', stamp, 'parsed');
+    first.saveSync();
+
+    const second = new FileMetadataCache<string>('test', {
+      filePath: cacheFile,
+      version: 2,
+    });
+    expect(second.get('/a.md', stamp)).toBeUndefined();
+  });
+
+  it('should prune records for files no longer in a directory', () => {
+    const stamp = { mtimeMs: 1, size: 10 };
+    const cache = new FileMetadataCache<string>('test', {
+      filePath: cacheFile,
+    });
+    cache.set('/dir/a.md', stamp, 'a');
+    cache.set('/dir/b.md', stamp, 'b');
+    cache.set('/other/c.md', stamp, 'c');
+
+    cache.pruneDirectory('/dir', ['/dir/a.md']);
+
+    expect(cache.get('/dir/a.md', stamp)).toBe('a');
+    expect(cache.get('/dir/b.md', stamp)).toBeUndefined();
+    expect(cache.get('/other/c.md', stamp)).toBe('c');
+  });
+
+  it('should drop the least recently used records past the entry limit', () => {
+    const stamp = { mtimeMs: 1, size: 10 };
+    const cache = new FileMetadataCache<string>('test', {
+      filePath: cacheFile,
+      maxEntries: 2,
+    });
+    cache.set('/a.md', stamp, 'a');
+    cache.set('/b.md', stamp, 'b');
+    expect(cache.get('/a.md', stamp)).toBe('a');
+    cache.set('/c.md', stamp, 'c');
+
+    expect(cache.get('/a.md', stamp)).toBe('a');
+    expect(cache.get('/b.md', stamp)).toBeUndefined();
+    expect(cache.get('/c.md', stamp)).toBe('c');
+  });
+
+  it('should keep the persisted records within the byte limit', async () => {
+    const stamp = { mtimeMs: 1, size: 10 };
+    const options = { filePath: cacheFile, maxBytes: 250 };
+    const first = new FileMetadataCache<string>('test', options);
+    for (const name of ['a', 'b', 'c']) {
+      first.set(`/${name}.md`, stamp, name.repeat(100));
+    }
+    await first.save();
+
+    const second = new FileMetadataCache<string>('test', options);
+    await second.load();
+    expect(second.get('/a.md', stamp)).toBeUndefined();
+    expect(second.get('/b.md', stamp)).toBe('b'.repeat(100));
+    expect(second.get('/c.md', stamp)).toBe('c'.repeat(100));
+    expect((await fs.stat(cacheFile)).size).toBeLessThan(400);
+  });
+});
@@ -0,0 +1,293 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import * as fs from 'node:fs';
+import * as path from 'node:path';
+import { Storage } from '../config/storage.js';
+
+/**
+ * The parts of `fs.Stats` used to decide whether a cached record is still
+ * valid. Any `fs.Stats` object satisfies this interface.
+ */
+export interface FileStamp {
+  mtimeMs: number;
+  size: number;
+}
+
+interface CacheEntry<T> {
+  mtimeMs: number;
+  size: number;
+  value: T;
+}
+
+interface CacheFile<T> {
+  version: number;
+  entries: Record<string, CacheEntry<T>>;
+}
+
+export interface FileMetadataCacheOptions {
+  /**
+   * Bumped by the owner whenever the shape of the cached value changes, so
+   * records written by older versions are discarded.
+   */
+  version?: number;
+  /** Overrides the location of the persisted cache file. */
+  filePath?: string;
+  /** Most records kept; the least recently used are dropped first. */
+  maxEntries?: number;
+  /**
+   * Most bytes of serialized values kept; the least recently used records
+   * are dropped first.
+   */
+  maxBytes?: number;
+}
+
+/**
+ * Holds values parsed from files (subagent definitions, extension configs,
+ * context files), keyed by absolute path and stamped with the file's mtime and
+ * size. A record is only returned while the file on disk still matches its
+ * stamp, so callers re-parse just the files that changed. Records are
+ * persisted under `~/.kolosal/cache` so a cold start can skip parsing too.
+ * Optional entry and byte limits bound the cache, evicting the least recently
+ * used records.
+ *
+ * Cached values must be JSON-serializable.
+ */
+export class FileMetadataCache<T> {
+  private readonly version: number;
+  private readonly maxEntries: number;
+  private readonly maxBytes: number;
+  private filePath: string | undefined;
+  /** Records in least to most recently used order. */
+  private entries: Map<string, CacheEntry<T>> | undefined;
+  /** Serialized size of each record's value, tracked when bytes are capped. */
+  private readonly sizes = new Map<string, number>();
+  private totalBytes = 0;
+  private loading: Promise<void> | undefined;
+  private dirty = false;
+  private saveQueue: Promise<void> = Promise.resolve();
+
+  constructor(
+    private readonly name: string,
+    options: FileMetadataCacheOptions = {},
+  ) {
+    this.version = options.version ?? 1;
+    this.filePath = options.filePath;
+    this.maxEntries = options.maxEntries ?? Infinity;
+    this.maxBytes = options.maxBytes ?? Infinity;
+  }
+
+  /**
+   * Reads the persisted records. Safe to call repeatedly; only the first call
+   * touches the disk.
+   */
+  load(): Promise<void> {
+    if (this.entries) {
+      return Promise.resolve();
+    }
+    if (!this.loading) {
+      this.loading = Promise.resolve()
+        .then(() => fs.promises.readFile(this.getFilePath(), 'utf-8'))
+        .then((content) => this.hydrate(content))
+        .catch(() => this.hydrate(undefined));
+    }
+    return this.loading;
+  }
+
+  /**
+   * Synchronous variant of {@link load} for callers that cannot be async.
+   */
+  loadSync(): void {
+    if (this.entries) {
+      return;
+    }
+    let content: string | undefined;
+    try {
+      content = fs.readFileSync(this.getFilePath(), 'utf-8');
+    } catch {
+      content = undefined;
+    }
+    this.hydrate(content);
+  }
+
+  /**
+   * Returns the cached value for `filePath` if it was recorded with the same
+   * stamp, otherwise undefined.
+   */
+  get(filePath: string, stamp: FileStamp | undefined): T | undefined {
+    if (!isValidStamp(stamp)) {
+      return undefined;
+    }
+    const entries = this.getEntries();
+    const entry = entries.get(filePath);
+    if (entry && entry.mtimeMs === stamp.mtimeMs && entry.size === stamp.size) {
+      if (this.isBounded()) {
+        // Mark as most recently used. The order alone is not worth a write.
+        entries.delete(filePath);
+        entries.set(filePath, entry);
+      }
+      return entry.value;
+    }
+    return undefined;
+  }
+
+  /**
+   * Records the value parsed from `filePath`. Without a stamp the value cannot
+   * be validated later, so it is not recorded.
+   */
+  set(filePath: string, stamp: FileStamp | undefined, value: T): void {
+    if (!isValidStamp(stamp)) {
+      return;
+    }
+    const entries = this.getEntries();
+    this.delete(filePath);
+    entries.set(filePath, {
+      mtimeMs: stamp.mtimeMs,
+      size: stamp.size,
+      value,
+    });
+    this.track(filePath, value);
+    this.dirty = true;
+    this.evict();
+  }
+
+  delete(filePath: string): void {
+    if (this.getEntries().delete(filePath)) {
+      this.totalBytes -= this.sizes.get(filePath) ?? 0;
+      this.sizes.delete(filePath);
+      this.dirty = true;
+    }
+  }
+
+  /**
+   * Drops records for files directly inside `dir` that are not in `present`,
+   * so deleted files do not accumulate in the persisted cache.
+   */
+  pruneDirectory(dir: string, present: Iterable<string>): void {
+    const keep = new Set(present);
+    for (const filePath of this.getEntries().keys()) {
+      if (path.dirname(filePath) === dir && !keep.has(filePath)) {
+        this.delete(filePath);
+      }
+    }
+  }
+
+  /**
+   * Writes the records to disk if anything changed since the last save.
+   * Failures are ignored; the cache is only an optimization.
+   */
+  save(): Promise<void> {
+    if (!this.dirty) {
+      return this.saveQueue;
+    }
+    this.dirty = false;
+    this.saveQueue = this.saveQueue.then(async () => {
+      try {
+        const filePath = this.getFilePath();
+        await fs.promises.mkdir(path.dirname(filePath), { recursive: true });
+        await fs.promises.writeFile(filePath, this.serialize(), 'utf-8');
+      } catch (error) {
+        console.debug('Failed to write file metadata cache:', error);
+      }
+    });
+    return this.saveQueue;
+  }
+
+  /**
+   * Synchronous variant of {@link save}.
+   */
+  saveSync(): void {
+    if (!this.dirty) {
+      return;
+    }
+    this.dirty = false;
+    try {
+      const filePath = this.getFilePath();
+      fs.mkdirSync(path.dirname(filePath), { recursive: true });
+      fs.writeFileSync(filePath, this.serialize(), 'utf-8');
+    } catch (error) {
+      console.debug('Failed to write file metadata cache:', error);
+    }
+  }
+
+  private getFilePath(): string {
+    // Resolved lazily so constructing a cache never touches the environment.
+    this.filePath ??= path.join(
+      Storage.getGlobalCacheDir(),
+      `${this.name}.json`,
+    );
+    return this.filePath;
+  }
+
+  private getEntries(): Map<string, CacheEntry<T>> {
+    if (!this.entries) {
+      this.loadSync();
+    }
+    return this.entries!;
+  }
+
+  private hydrate(content: string | undefined): void {
+    if (this.entries) {
+      return;
+    }
+    this.entries = new Map();
+    if (!content) {
+      return;
+    }
+    try {
+      const parsed = JSON.parse(content) as CacheFile<T>;
+      if (parsed?.version === this.version && parsed.entries) {
+        this.entries = new Map(Object.entries(parsed.entries));
+      }
+    } catch {
+      // A corrupt cache simply means a cold start.
+    }
+    for (const [filePath, entry] of this.entries) {
+      this.track(filePath, entry.value);
+    }
+    this.evict();
+  }
+
+  private isBounded(): boolean {
+    return this.maxEntries !== Infinity || this.maxBytes !== Infinity;
+  }
+
+  private track(filePath: string, value: T): void {
+    if (this.maxBytes === Infinity) {
+      return;
+    }
+    const bytes = Buffer.byteLength(JSON.stringify(value) ?? '');
+    this.sizes.set(filePath, bytes);
+    this.totalBytes += bytes;
+  }
+
+  /** Drops the least recently used records until within the limits. */
+  private evict(): void {
+    const entries = this.entries!;
+    while (
+      entries.size > 0 &&
+      (entries.size > this.maxEntries || this.totalBytes > this.maxBytes)
+    ) {
+      this.delete(entries.keys().next().value!);
+    }
+  }
+
+  private serialize(): string {
+    const data: CacheFile<T> = {
+      version: this.version,
+      entries: Object.fromEntries(this.entries ?? []),
+    };
+    return JSON.stringify(data);
+  }
+}
+
+function isValidStamp(stamp: FileStamp | undefined): stamp is FileStamp {
+  return (
+    !!stamp &&
+    typeof stamp.mtimeMs === 'number' &&
+    typeof stamp.size === 'number'
+  );
+}
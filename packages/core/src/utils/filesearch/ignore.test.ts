@@ -6,6 +6,7 @@
 
 import { describe, it, expect, afterEach } from 'vitest';
 import { Ignore, loadIgnoreRules } from './ignore.js';
+import { WorkspaceIgnoreService } from '../../services/workspaceIgnoreService.js';
 import { createTmpDir, cleanupTmpDir } from '@kolosal-ai/kolosal-ai-test-utils';
 
 describe('Ignore', () => {
@@ -69,6 +70,7 @@ describe('loadIgnoreRules', () => {
   let tmpDir: string;
 
   afterEach(async () => {
+    WorkspaceIgnoreService.reset();
     if (tmpDir) {
       await cleanupTmpDir(tmpDir);
     }
@@ -4,10 +4,13 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-import fs from 'node:fs';
-import path from 'node:path';
 import ignore from 'ignore';
 import picomatch from 'picomatch';
+import {
+  GIT_IGNORE_FILE_NAME,
+  QWEN_IGNORE_FILE_NAME,
+  WorkspaceIgnoreService,
+} from '../../services/workspaceIgnoreService.js';
 
 const hasFileExtension = picomatch('**/*[*.]*');
 
@@ -19,19 +22,15 @@ export interface LoadIgnoreRulesOptions {
 }
 
 export function loadIgnoreRules(options: LoadIgnoreRulesOptions): Ignore {
+  // The ignore files are parsed once per root and shared with the file tools.
+  const ignoreService = WorkspaceIgnoreService.forRoot(options.projectRoot);
   const ignorer = new Ignore();
   if (options.useGitignore) {
-    const gitignorePath = path.join(options.projectRoot, '.gitignore');
-    if (fs.existsSync(gitignorePath)) {
-      ignorer.add(fs.readFileSync(gitignorePath, 'utf8'));
-    }
+    ignorer.add(ignoreService.getFilePatterns(GIT_IGNORE_FILE_NAME));
   }
 
   if (options.useGeminiignore) {
-    const geminiignorePath = path.join(options.projectRoot, '.qwenignore');
-    if (fs.existsSync(geminiignorePath)) {
-      ignorer.add(fs.readFileSync(geminiignorePath, 'utf8'));
-    }
+    ignorer.add(ignoreService.getFilePatterns(QWEN_IGNORE_FILE_NAME));
   }
 
   const ignoreDirs = ['.git', ...options.ignoreDirs];
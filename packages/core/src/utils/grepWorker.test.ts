@@ -0,0 +1,80 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import { once } from 'node:events';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { MessageChannel } from 'node:worker_threads';
+import type { WorkerMatch } from './grepWorker.js';
+import { serve } from './grepWorker.js';
+
+describe('grepWorker', () => {
+  let tempDir: string;
+  let channel: MessageChannel;
+
+  beforeEach(async () => {
+    tempDir = await fs.mkdtemp(path.join(os.tmpdir(), 'grep-worker-'));
+    channel = new MessageChannel();
+  });
+
+  afterEach(async () => {
+    channel.port1.close();
+    await fs.rm(tempDir, { recursive: true, force: true });
+  });
+
+  async function search(files: string[], maxMatches = 100) {
+    const found = new SharedArrayBuffer(4);
+    serve(channel.port1, {
+      pattern: 'needle',
+      maxMatches,
+      found,
+      sniffBytes: 16,
+      readConcurrency: 2,
+    });
+    channel.port2.postMessage(files);
+    const [matches] = (await once(channel.port2, 'message')) as [
+      WorkerMatch[],
+    ];
+    return { matches, found: Atomics.load(new Int32Array(found), 0) };
+  }
+
+  it('should reply with the matching lines of a batch', async () => {
+    const text = path.join(tempDir, 'text.txt');
+    const long = path.join(tempDir, 'long.txt');
+    await fs.writeFile(text, 'one\nNeedle here\r\nthree');
+    await fs.writeFile(long, `${'x'.repeat(40)}\nneedle`);
+
+    const { matches, found } = await search([
+      text,
+      long,
+      path.join(tempDir, 'missing.txt'),
+    ]);
+
+    expect(matches.sort()).toEqual([
+      [long, 2, 'needle'],
+      [text, 2, 'Needle here'],
+    ]);
+    expect(found).toBe(2);
+  });
+
+  it('should skip binary files', async () => {
+    const binary = path.join(tempDir, 'binary.bin');
+    await fs.writeFile(binary, Buffer.from('needle\0'));
+
+    expect((await search([binary])).matches).toEqual([]);
+  });
+
+  it('should stop at the shared match limit', async () => {
+    const file = path.join(tempDir, 'many.txt');
+    await fs.writeFile(file, 'needle\n'.repeat(10));
+
+    const { matches } = await search([file], 3);
+
+    expect(matches).toHaveLength(3);
+  });
+});
@@ -0,0 +1,81 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Worker thread of the grep worker pool. Each message is a batch of file
+// paths; the reply lists the matches found in them.
+
+import fs from 'node:fs/promises';
+import type { MessagePort } from 'node:worker_threads';
+import { parentPort, workerData } from 'node:worker_threads';
+import { looksBinary } from './fileContentCache.js';
+
+export interface GrepWorkerData {
+  /** Regular expression source, matched case-insensitively per line. */
+  pattern: string;
+  maxMatches: number;
+  /** Int32 match counter shared by every worker of one search. */
+  found: SharedArrayBuffer;
+  sniffBytes: number;
+  /** Files read at once. */
+  readConcurrency: number;
+}
+
+export type WorkerMatch = [filePath: string, lineNumber: number, line: string];
+
+async function readText(
+  filePath: string,
+  sniffBytes: number,
+): Promise<string | undefined> {
+  const handle = await fs.open(filePath, 'r');
+  try {
+    const sample = Buffer.alloc(sniffBytes);
+    const { bytesRead } = await handle.read(sample, 0, sniffBytes, 0);
+    if (looksBinary(sample.subarray(0, bytesRead))) return undefined;
+    if (bytesRead < sniffBytes) return sample.toString('utf8', 0, bytesRead);
+    return (await handle.readFile()).toString('utf8');
+  } finally {
+    await handle.close();
+  }
+}
+
+/** Answers each batch of file paths posted to `port` with its matches. */
+export function serve(port: MessagePort, data: GrepWorkerData): void {
+  const { maxMatches, sniffBytes, readConcurrency } = data;
+  const found = new Int32Array(data.found);
+  const regex = new RegExp(data.pattern, 'i');
+
+  const searchFile = async (filePath: string, matches: WorkerMatch[]) => {
+    if (Atomics.load(found, 0) >= maxMatches) return;
+    let content: string | undefined;
+    try {
+      content = await readText(filePath, sniffBytes);
+    } catch {
+      return;
+    }
+    if (content === undefined) return;
+    const lines = content.split(/\r?\n/);
+    for (let i = 0; i < lines.length; i++) {
+      if (!regex.test(lines[i])) continue;
+      if (Atomics.add(found, 0, 1) >= maxMatches) return;
+      matches.push([filePath, i + 1, lines[i]]);
+    }
+  };
+
+  port.on('message', async (files: string[]) => {
+    const matches: WorkerMatch[] = [];
+    let next = 0;
+    const drain = async () => {
+      while (next < files.length) await searchFile(files[next++], matches);
+    };
+    await Promise.all(Array.from({ length: readConcurrency }, drain));
+    port.postMessage(matches);
+  });
+}
+
+// Only when started by the pool, not when imported on a test runner thread.
+if (parentPort && (workerData as GrepWorkerData | null)?.found) {
+  serve(parentPort, workerData as GrepWorkerData);
+}
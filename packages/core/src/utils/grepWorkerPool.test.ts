@@ -0,0 +1,183 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it } from 'vitest';
+import * as fs from 'node:fs/promises';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import { pathToFileURL } from 'node:url';
+import { grepFilesInParallel } from './grepWorkerPool.js';
+
+async function* iterate(files: string[], consumed: string[] = []) {
+  for (const file of files) {
+    consumed.push(file);
+    yield file;
+  }
+}
+
+describe('grepFilesInParallel', () => {
+  let tempDir: string;
+
+  beforeEach(async () => {
+    tempDir = await fs.mkdtemp(path.join(os.tmpdir(), 'grep-worker-pool-'));
+  });
+
+  afterEach(async () => {
+    await fs.rm(tempDir, { recursive: true, force: true });
+  });
+
+  async function writeFiles(count: number, content: (i: number) => string) {
+    const files: string[] = [];
+    for (let i = 0; i < count; i++) {
+      const file = path.join(tempDir, `file${String(i).padStart(4, '0')}.txt`);
+      await fs.writeFile(file, content(i));
+      files.push(file);
+    }
+    return files;
+  }
+
+  it('should search a few files on the calling thread', async () => {
+    const files = await writeFiles(3, (i) => `one\nHello ${i}\r\nthree`);
+
+    const matches = await grepFilesInParallel(iterate(files), {
+      pattern: 'hello',
+      maxMatches: 10,
+    });
+
+    expect(matches).toEqual(
+      files.map((filePath, i) => ({
+        filePath,
+        lineNumber: 2,
+        line: `Hello ${i}`,
+      })),
+    );
+  });
+
+  it('should shard many files across workers and sort the matches', async () => {
+    const files = await writeFiles(600, (i) =>
+      i % 50 === 0 ? `skip\nneedle ${i}\nneedle again` : 'nothing here',
+    );
+
+    const matches = await grepFilesInParallel(iterate(files), {
+      pattern: 'NEEDLE',
+      maxMatches: 1000,
+      workers: 2,
+    });
+
+    expect(matches).toHaveLength(24);
+    expect(matches[0]).toEqual({
+      filePath: files[0],
+      lineNumber: 2,
+      line: 'needle 0',
+    });
+    expect(matches[23]).toMatchObject({ filePath: files[550], lineNumber: 3 });
+  });
+
+  async function writeWorker(name: string, onMessage: string) {
+    const script = path.join(tempDir, name);
+    await fs.writeFile(
+      script,
+      [
+        "import { parentPort } from 'node:worker_threads';",
+        'let batches = 0;',
+        `parentPort.on('message', (files) => { batches++; ${onMessage} });`,
+      ].join('\n'),
+    );
+    return pathToFileURL(script);
+  }
+
+  it('should search batches on worker threads', async () => {
+    const files = await writeFiles(300, () => 'needle');
+    const workerScript = await writeWorker(
+      'worker.mjs',
+      "parentPort.postMessage(files.map((file) => [file, 1, 'from worker']));",
+    );
+
+    const matches = await grepFilesInParallel(iterate(files), {
+      pattern: 'needle',
+      maxMatches: 1000,
+      workers: 2,
+      workerScript,
+    });
+
+    expect(matches).toHaveLength(300);
+    expect(matches.every((match) => match.line === 'from worker')).toBe(true);
+  });
+
+  it('should search on the calling thread when a worker exits', async () => {
+    const files = await writeFiles(300, () => 'needle');
+    const workerScript = await writeWorker(
+      'exiting-worker.mjs',
+      'process.exit(1);',
+    );
+
+    const matches = await grepFilesInParallel(iterate(files), {
+      pattern: 'needle',
+      maxMatches: 1000,
+      workers: 2,
+      workerScript,
+    });
+
+    expect(matches).toEqual(
+      files.map((filePath) => ({ filePath, lineNumber: 1, line: 'needle' })),
+    );
+  });
+
+  it('should replace a worker that exits after completing a batch', async () => {
+    const files = await writeFiles(300, () => 'needle');
+    const workerScript = await writeWorker(
+      'flaky-worker.mjs',
+      "if (batches === 2) process.exit(1); parentPort.postMessage(files.map((file) => [file, 1, 'from worker']));",
+    );
+
+    const matches = await grepFilesInParallel(iterate(files), {
+      pattern: 'needle',
+      maxMatches: 1000,
+      workers: 1,
+      workerScript,
+    });
+
+    // Five batches: the worker's second batch is searched here, and so is
+    // the second batch of its replacement.
+    expect(matches).toHaveLength(300);
+    expect(matches.filter((match) => match.line === 'needle')).toHaveLength(
+      128,
+    );
+  });
+
+  it('should skip binary files', async () => {
+    const files = await writeFiles(300, () => 'needle');
+    await fs.writeFile(files[0], Buffer.from([0x6e, 0x65, 0x65, 0, 1, 2]));
+    await fs.writeFile(files[1], Buffer.from('needle\0'));
+
+    const matches = await grepFilesInParallel(iterate(files), {
+      pattern: 'needle',
+      maxMatches: 1000,
+      workers: 2,
+    });
+    const inline = await grepFilesInParallel(iterate(files.slice(0, 3)), {
+      pattern: 'needle',
+      maxMatches: 1000,
+    });
+
+    expect(matches).toHaveLength(298);
+    expect(inline.map((m) => m.filePath)).toEqual([files[2]]);
+  });
+
+  it('should stop reading files once enough matches are found', async () => {
+    const files = await writeFiles(2000, () => 'needle');
+    const consumed: string[] = [];
+
+    const matches = await grepFilesInParallel(iterate(files, consumed), {
+      pattern: 'needle',
+      maxMatches: 5,
+      workers: 2,
+    });
+
+    expect(matches).toHaveLength(5);
+    expect(consumed.length).toBeLessThan(files.length);
+  });
+});
@@ -0,0 +1,294 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { existsSync } from 'node:fs';
+import fsPromises from 'node:fs/promises';
+import os from 'node:os';
+import { fileURLToPath } from 'node:url';
+import { Worker } from 'node:worker_threads';
+import { fileContentCache, SNIFF_BYTES } from './fileContentCache.js';
+import { getErrorMessage, isNodeError } from './errors.js';
+import type { GrepWorkerData, WorkerMatch } from './grepWorker.js';
+
+/** Searches over fewer files than this stay on the calling thread. */
+const WORKER_MIN_FILES = 256;
+/** Files handed to a worker at a time. */
+const BATCH_SIZE = 64;
+/** Files each worker reads at once. */
+const READ_CONCURRENCY = 8;
+const MAX_WORKERS = 8;
+
+export interface FileGrepMatch {
+  /** Absolute path of the matching file. */
+  filePath: string;
+  lineNumber: number;
+  line: string;
+}
+
+export interface ParallelGrepOptions {
+  /** Regular expression source, matched case-insensitively per line. */
+  pattern: string;
+  /** The search stops once this many matches are found. */
+  maxMatches: number;
+  signal?: AbortSignal;
+  /** Number of worker threads; defaults to one per spare core. */
+  workers?: number;
+  /** Script run by the worker threads; defaults to the built grepWorker.js. */
+  workerScript?: URL;
+}
+
+/**
+ * Script of the worker threads, built next to this module and, by esbuild,
+ * next to the CLI bundle. Where it is missing, as in single-file executables,
+ * batches are searched on the calling thread instead.
+ */
+let workerScript: URL | null | undefined;
+
+function findWorkerScript(): URL | null {
+  if (workerScript === undefined) {
+    try {
+      const url = new URL('./grepWorker.js', import.meta.url);
+      workerScript = existsSync(fileURLToPath(url)) ? url : null;
+    } catch {
+      workerScript = null;
+    }
+  }
+  return workerScript;
+}
+
+function defaultWorkerCount(): number {
+  return Math.max(1, Math.min(MAX_WORKERS, os.availableParallelism() - 1));
+}
+
+function compareMatches(a: FileGrepMatch, b: FileGrepMatch): number {
+  if (a.filePath !== b.filePath) return a.filePath < b.filePath ? -1 : 1;
+  return a.lineNumber - b.lineNumber;
+}
+
+async function searchInline(
+  files: string[],
+  regex: RegExp,
+  maxMatches: number,
+): Promise<FileGrepMatch[]> {
+  const matches: FileGrepMatch[] = [];
+  for (const filePath of files) {
+    if (matches.length >= maxMatches) break;
+    try {
+      if ((await fileContentCache.sniff(filePath)).isBinary) continue;
+      const content = await fileContentCache.readText(filePath, () =>
+        fsPromises.readFile(filePath, 'utf8'),
+      );
+      const lines = content.split(/\r?\n/);
+      for (let i = 0; i < lines.length && matches.length < maxMatches; i++) {
+        if (regex.test(lines[i])) {
+          matches.push({ filePath, lineNumber: i + 1, line: lines[i] });
+        }
+      }
+    } catch (readError: unknown) {
+      // Ignore errors like permission denied or file gone during read
+      if (!isNodeError(readError) || readError.code !== 'ENOENT') {
+        console.debug(
+          `GrepLogic: Could not read/process ${filePath}: ${getErrorMessage(
+            readError,
+          )}`,
+        );
+      }
+    }
+  }
+  return matches;
+}
+
+function runBatch(worker: Worker, files: string[]): Promise<WorkerMatch[]> {
+  return new Promise((resolve, reject) => {
+    const cleanup = () => {
+      worker.off('message', onMessage);
+      worker.off('error', onError);
+      worker.off('exit', onExit);
+    };
+    const onMessage = (matches: WorkerMatch[]) => {
+      cleanup();
+      resolve(matches);
+    };
+    const onError = (error: Error) => {
+      cleanup();
+      reject(error);
+    };
+    const onExit = (code: number) => {
+      cleanup();
+      reject(new Error(`Grep worker exited with code ${code}`));
+    };
+    worker.on('message', onMessage);
+    worker.on('error', onError);
+    worker.on('exit', onExit);
+    worker.postMessage(files);
+  });
+}
+
+/**
+ * One worker thread of a search. A worker that dies during a batch is
+ * replaced, and the batch is searched on the calling thread instead; matches
+ * the dead worker had counted are lost, so such a search may return fewer
+ * than it could. A worker that dies before finishing any batch is not
+ * replaced, as its replacement would likely fail the same way.
+ */
+class WorkerSlot {
+  private worker: Worker | undefined;
+  private exited = false;
+  private completedBatch = false;
+
+  constructor(private readonly spawn: () => Worker | undefined) {
+    this.start();
+  }
+
+  async search(
+    files: string[],
+    searchHere: (files: string[]) => Promise<FileGrepMatch[]>,
+  ): Promise<FileGrepMatch[]> {
+    const worker = this.worker;
+    if (!worker) return searchHere(files);
+    try {
+      if (this.exited) throw new Error('Grep worker exited between batches');
+      const matches = await runBatch(worker, files);
+      this.completedBatch = true;
+      return matches.map(([filePath, lineNumber, line]) => ({
+        filePath,
+        lineNumber,
+        line,
+      }));
+    } catch (error: unknown) {
+      console.debug(
+        `GrepLogic: Worker failed, searching on the main thread: ${getErrorMessage(
+          error,
+        )}`,
+      );
+      void worker.terminate();
+      if (this.completedBatch) {
+        this.start();
+      } else {
+        this.worker = undefined;
+      }
+      return searchHere(files);
+    }
+  }
+
+  async terminate(): Promise<void> {
+    await this.worker?.terminate();
+  }
+
+  private start(): void {
+    const worker = this.spawn();
+    this.worker = worker;
+    this.exited = false;
+    this.completedBatch = false;
+    // Errors between batches would otherwise crash the process; the exit
+    // that follows them fails the next batch.
+    worker?.on('error', () => {});
+    worker?.once('exit', () => {
+      if (this.worker === worker) this.exited = true;
+    });
+  }
+}
+
+/**
+ * Searches `files` for lines matching `options.pattern`, skipping binary
+ * files. Large searches are sharded in batches across a pool of worker
+ * threads that share one match counter, so every worker stops reading once
+ * `maxMatches` is reached; `files` is not consumed past that point. Matches
+ * are returned sorted by file and line.
+ */
+export async function grepFilesInParallel(
+  files: AsyncIterable<string>,
+  options: ParallelGrepOptions,
+): Promise<FileGrepMatch[]> {
+  const { pattern, maxMatches, signal } = options;
+  const regex = new RegExp(pattern, 'i');
+  const iterator = files[Symbol.asyncIterator]();
+  let exhausted = false;
+
+  try {
+    // Starting workers costs more than small searches take.
+    const pending: string[] = [];
+    while (pending.length < WORKER_MIN_FILES) {
+      const next = await iterator.next();
+      if (next.done) {
+        exhausted = true;
+        return (await searchInline(pending, regex, maxMatches)).sort(
+          compareMatches,
+        );
+      }
+      pending.push(next.value);
+    }
+
+    const counter = new SharedArrayBuffer(4);
+    const found = new Int32Array(counter);
+    const limitReached = () =>
+      Atomics.load(found, 0) >= maxMatches || signal?.aborted === true;
+
+    const nextBatch = async (): Promise<string[]> => {
+      const batch = pending.splice(0, BATCH_SIZE);
+      while (batch.length < BATCH_SIZE && !exhausted && !limitReached()) {
+        const next = await iterator.next();
+        if (next.done) {
+          exhausted = true;
+        } else {
+          batch.push(next.value);
+        }
+      }
+      return limitReached() ? [] : batch;
+    };
+
+    const workerData: GrepWorkerData = {
+      pattern,
+      maxMatches,
+      found: counter,
+      sniffBytes: SNIFF_BYTES,
+      readConcurrency: READ_CONCURRENCY,
+    };
+    const spawn = () => {
+      const script = options.workerScript ?? findWorkerScript();
+      if (!script) return undefined;
+      try {
+        return new Worker(script, { workerData });
+      } catch {
+        return undefined;
+      }
+    };
+    const searchHere = async (batch: string[]) => {
+      const batchMatches = await searchInline(
+        batch,
+        regex,
+        maxMatches - Atomics.load(found, 0),
+      );
+      Atomics.add(found, 0, batchMatches.length);
+      return batchMatches;
+    };
+
+    const slots = Array.from(
+      { length: options.workers ?? defaultWorkerCount() },
+      () => new WorkerSlot(spawn),
+    );
+    const matches: FileGrepMatch[] = [];
+    try {
+      await Promise.all(
+        slots.map(async (slot) => {
+          for (;;) {
+            const batch = await nextBatch();
+            if (batch.length === 0) return;
+            matches.push(...(await slot.search(batch, searchHere)));
+          }
+        }),
+      );
+    } finally {
+      await Promise.all(slots.map((slot) => slot.terminate()));
+    }
+    return matches.sort(compareMatches).slice(0, maxMatches);
+  } finally {
+    if (!exhausted) {
+      // Stops the producer, e.g. a glob walk, from reading further.
+      await iterator.return?.();
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { afterEach, beforeEach, describe, expect, it, vi } from 'vitest';
+import http from 'node:http';
+import type { AddressInfo } from 'node:net';
+import { HttpConnectionPool } from './httpPool.js';
+
+describe('HttpConnectionPool', () => {
+  let server: http.Server;
+  let baseUrl: string;
+  let pool: HttpConnectionPool;
+  const sockets = new Set<unknown>();
+
+  beforeEach(async () => {
+    sockets.clear();
+    server = http.createServer((req, res) => {
+      sockets.add(req.socket);
+      const delay = req.url === '/slow' ? 50 : 0;
+      setTimeout(() => {
+        res.setHeader('Content-Type', 'application/json');
+        res.end(JSON.stringify({ status: 'healthy' }));
+      }, delay);
+    });
+    await new Promise<void>((resolve) => server.listen(0, '127.0.0.1', resolve));
+    baseUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+  });
+
+  afterEach(async () => {
+    await pool.close();
+    server.closeAllConnections();
+    await new Promise((resolve) => server.close(resolve));
+  });
+
+  it('should reuse one keep-alive socket for sequential requests', async () => {
+    pool = new HttpConnectionPool({ connections: 4 });
+
+    for (let i = 0; i < 3; i++) {
+      const response = await pool.fetch(`${baseUrl}/health`);
+      expect(await response.json()).toEqual({ status: 'healthy' });
+    }
+
+    expect(sockets.size).toBe(1);
+    expect(pool.getStats()).toMatchObject({
+      requests: 3,
+      reusedConnections: 2,
+      newConnections: 1,
+      queuedRequests: 0,
+      inFlight: 0,
+    });
+  });
+
+  it('should queue requests beyond the per-origin socket limit', async () => {
+    pool = new HttpConnectionPool({ connections: 1 });
+    await (await pool.fetch(`${baseUrl}/health`)).text();
+
+    await Promise.all(
+      [1, 2, 3].map(async () => (await pool.fetch(`${baseUrl}/slow`)).text()),
+    );
+
+    expect(sockets.size).toBe(1);
+    expect(pool.getStats()).toMatchObject({
+      requests: 4,
+      newConnections: 1,
+      queuedRequests: 2,
+      inFlight: 0,
+    });
+  });
+
+  it('should report each request to the listener', async () => {
+    pool = new HttpConnectionPool();
+    const listener = vi.fn();
+    pool.setRequestListener(listener);
+
+    await (await pool.fetch(`${baseUrl}/health`)).text();
+    await (await pool.fetch(`${baseUrl}/health`)).text();
+
+    expect(listener.mock.calls).toEqual([
+      [{ origin: baseUrl, reused: false, queued: false }],
+      [{ origin: baseUrl, reused: true, queued: false }],
+    ]);
+  });
+});
@@ -0,0 +1,279 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { Agent, ProxyAgent, fetch as undiciFetch } from 'undici';
+import type { Dispatcher, RequestInit as UndiciRequestInit } from 'undici';
+
+export interface HttpPoolOptions {
+  /** Maximum number of sockets per origin. */
+  connections?: number;
+  /** How long an idle socket is kept open for reuse. */
+  keepAliveTimeoutMs?: number;
+  /** Requests sent on one HTTP/1.1 socket before waiting for responses. */
+  pipelining?: number;
+  /** Negotiate HTTP/2 over TLS where the server supports it. */
+  allowH2?: boolean;
+  /** Route every request through this proxy. */
+  proxy?: string;
+}
+
+export interface HttpPoolStats {
+  requests: number;
+  /** Requests dispatched while an open socket to the origin was idle. */
+  reusedConnections: number;
+  /** Sockets opened by the pool. */
+  newConnections: number;
+  /** Requests that had to wait because every socket to the origin was busy. */
+  queuedRequests: number;
+  inFlight: number;
+  openConnections: number;
+}
+
+export interface HttpRequestInfo {
+  origin: string;
+  reused: boolean;
+  queued: boolean;
+}
+
+type RequestListener = (info: HttpRequestInfo) => void;
+
+interface OriginState {
+  open: number;
+  active: number;
+}
+
+const envNumber = (name: string): number | undefined => {
+  const value = Number(process.env[name]);
+  return Number.isFinite(value) && value > 0 ? value : undefined;
+};
+
+const DEFAULT_OPTIONS: Required<Omit<HttpPoolOptions, 'proxy'>> = {
+  connections: envNumber('KOLOSAL_HTTP_MAX_CONNECTIONS') ?? 8,
+  keepAliveTimeoutMs: envNumber('KOLOSAL_HTTP_KEEP_ALIVE_MS') ?? 30_000,
+  pipelining: envNumber('KOLOSAL_HTTP_PIPELINING') ?? 1,
+  // undici's HTTP/2 support is still experimental, so it is opt-in.
+  allowH2: process.env['KOLOSAL_HTTP2'] === 'true',
+};
+
+// Hooks of both the legacy and the current undici handler interfaces.
+const HANDLER_HOOKS = [
+  'onConnect',
+  'onUpgrade',
+  'onResponseStarted',
+  'onHeaders',
+  'onData',
+  'onBodySent',
+  'onRequestStart',
+  'onRequestUpgrade',
+  'onResponseStart',
+  'onResponseData',
+] as const;
+const HANDLER_END_HOOKS = [
+  'onComplete',
+  'onError',
+  'onResponseEnd',
+  'onResponseError',
+] as const;
+
+function normalizeOrigin(origin: unknown): string {
+  try {
+    return new URL(String(origin)).origin;
+  } catch {
+    return String(origin);
+  }
+}
+
+/**
+ * Connection pool shared by the model providers and the local server health
+ * checks. Requests to the same origin reuse keep-alive sockets instead of
+ * paying a new TCP (and TLS) handshake for every call, and the pool records
+ * how often sockets are reused and how often requests queue behind each other.
+ */
+export class HttpConnectionPool {
+  private options: HttpPoolOptions;
+  private dispatcher: Dispatcher | undefined;
+  private readonly origins = new Map<string, OriginState>();
+  private stats = {
+    requests: 0,
+    reusedConnections: 0,
+    newConnections: 0,
+    queuedRequests: 0,
+  };
+  private requestListener: RequestListener | undefined;
+
+  constructor(options: HttpPoolOptions = {}) {
+    this.options = { ...DEFAULT_OPTIONS, ...options };
+  }
+
+  /**
+   * Updates the pool options. Sockets of the previous dispatcher are closed
+   * once their in-flight requests finish.
+   */
+  configure(options: HttpPoolOptions): void {
+    this.options = { ...this.options, ...options };
+    const previous = this.dispatcher;
+    this.dispatcher = undefined;
+    this.origins.clear();
+    void previous?.close().catch(() => {});
+  }
+
+  getDispatcher(): Dispatcher {
+    if (!this.dispatcher) {
+      this.dispatcher = this.createDispatcher();
+    }
+    return this.dispatcher;
+  }
+
+  /** `fetch` bound to the pool, compatible with the OpenAI SDK `fetch` option. */
+  readonly fetch = (
+    input: string | URL | Request,
+    init?: RequestInit,
+  ): Promise<Response> => {
+    const options = {
+      ...init,
+      dispatcher: this.getDispatcher(),
+    } as unknown as UndiciRequestInit;
+    return undiciFetch(
+      input as unknown as Parameters<typeof undiciFetch>[0],
+      options,
+    ) as unknown as Promise<Response>;
+  };
+
+  getStats(): HttpPoolStats {
+    let inFlight = 0;
+    let openConnections = 0;
+    for (const state of this.origins.values()) {
+      inFlight += state.active;
+      openConnections += state.open;
+    }
+    return { ...this.stats, inFlight, openConnections };
+  }
+
+  resetStats(): void {
+    this.stats = {
+      requests: 0,
+      reusedConnections: 0,
+      newConnections: 0,
+      queuedRequests: 0,
+    };
+  }
+
+  setRequestListener(listener: RequestListener | undefined): void {
+    this.requestListener = listener;
+  }
+
+  async close(): Promise<void> {
+    const dispatcher = this.dispatcher;
+    this.dispatcher = undefined;
+    this.origins.clear();
+    await dispatcher?.close();
+  }
+
+  private createDispatcher(): Dispatcher {
+    const { proxy, connections, keepAliveTimeoutMs, pipelining, allowH2 } =
+      this.options;
+    const agentOptions = {
+      connections,
+      pipelining,
+      allowH2,
+      keepAliveTimeout: keepAliveTimeoutMs,
+      keepAliveMaxTimeout: Math.max(keepAliveTimeoutMs ?? 0, 600_000),
+    };
+    const base: Dispatcher = proxy
+      ? new ProxyAgent({ ...agentOptions, uri: proxy })
+      : new Agent(agentOptions);
+
+    base.on('connect', (origin) => {
+      this.originState(normalizeOrigin(origin)).open++;
+      this.stats.newConnections++;
+    });
+    base.on('disconnect', (origin) => {
+      const state = this.originState(normalizeOrigin(origin));
+      state.open = Math.max(0, state.open - 1);
+    });
+
+    return base.compose(
+      (dispatch) => (opts, handler) => {
+        const done = this.trackRequest(normalizeOrigin(opts.origin));
+        try {
+          return dispatch(opts, this.wrapHandler(handler, done));
+        } catch (error) {
+          done();
+          throw error;
+        }
+      },
+    );
+  }
+
+  private originState(origin: string): OriginState {
+    let state = this.origins.get(origin);
+    if (!state) {
+      state = { open: 0, active: 0 };
+      this.origins.set(origin, state);
+    }
+    return state;
+  }
+
+  /**
+   * Classifies a request when it is dispatched and returns the callback that
+   * marks it finished.
+   */
+  private trackRequest(origin: string): () => void {
+    const state = this.originState(origin);
+    const capacity = state.open * (this.options.pipelining ?? 1);
+    const reused = state.active < capacity;
+    const queued = !reused && state.open >= (this.options.connections ?? 1);
+
+    this.stats.requests++;
+    if (reused) {
+      this.stats.reusedConnections++;
+    }
+    if (queued) {
+      this.stats.queuedRequests++;
+    }
+    state.active++;
+    this.requestListener?.({ origin, reused, queued });
+
+    let finished = false;
+    return () => {
+      if (!finished) {
+        finished = true;
+        state.active = Math.max(0, state.active - 1);
+      }
+    };
+  }
+
+  private wrapHandler(
+    handler: Dispatcher.DispatchHandler,
+    done: () => void,
+  ): Dispatcher.DispatchHandler {
+    const source = handler as unknown as Record<
+      string,
+      ((...args: unknown[]) => unknown) | undefined
+    >;
+    const wrapped: Record<string, (...args: unknown[]) => unknown> = {};
+    // Only hooks the handler implements are forwarded, so undici keeps
+    // treating it as the same kind of handler.
+    for (const hook of HANDLER_HOOKS) {
+      const fn = source[hook];
+      if (typeof fn === 'function') {
+        wrapped[hook] = (...args) => fn.apply(handler, args);
+      }
+    }
+    for (const hook of HANDLER_END_HOOKS) {
+      const fn = source[hook];
+      if (typeof fn === 'function') {
+        wrapped[hook] = (...args) => {
+          done();
+          return fn.apply(handler, args);
+        };
+      }
+    }
+    return wrapped as unknown as Dispatcher.DispatchHandler;
+  }
+}
+
+export const httpPool = new HttpConnectionPool();
@@ -439,4 +439,38 @@ describe('loadServerHierarchicalMemory', () => {
     expect(parentOccurrences).toBe(1);
     expect(childOccurrences).toBe(1);
   });
+
+  it('should pick up changes to imported files on reload', async () => {
+    await createTestFile(
+      path.join(cwd, DEFAULT_CONTEXT_FILENAME),
+      'Main content\n@./extra.md',
+    );
+    const extraPath = path.join(cwd, 'extra.md');
+
+    const first = await loadServerHierarchicalMemory(
+      cwd,
+      [],
+      false,
+      new FileDiscoveryService(projectRoot),
+    );
+    expect(first.memoryContent).toContain('Import failed: ./extra.md');
+
+    await createTestFile(extraPath, 'Extra content');
+    const second = await loadServerHierarchicalMemory(
+      cwd,
+      [],
+      false,
+      new FileDiscoveryService(projectRoot),
+    );
+    expect(second.memoryContent).toContain('Extra content');
+
+    await createTestFile(extraPath, 'Updated extra content');
+    const third = await loadServerHierarchicalMemory(
+      cwd,
+      [],
+      false,
+      new FileDiscoveryService(projectRoot),
+    );
+    expect(third.memoryContent).toContain('Updated extra content');
+  });
 });
@@ -17,6 +17,8 @@ import type { FileDiscoveryService } from '../services/fileDiscoveryService.js';
 import { processImports } from './memoryImportProcessor.js';
 import type { FileFilteringOptions } from '../config/config.js';
 import { DEFAULT_MEMORY_FILE_FILTERING_OPTIONS } from '../config/config.js';
+import { FileMetadataCache } from './fileMetadataCache.js';
+import type { FileStamp } from './fileMetadataCache.js';
 
 // Simple console logger, similar to the one previously in CLI's config.ts
 // TODO: Integrate with a more robust server-side logger if available/appropriate.
@@ -36,6 +38,81 @@ interface GeminiFileContent {
   content: string | null;
 }
 
+interface DependencyStamp {
+  path: string;
+  /** -1 when the file did not exist. */
+  mtimeMs: number;
+  size: number;
+}
+
+interface ContextFileRecord {
+  importFormat: 'flat' | 'tree';
+  content: string;
+  dependencies: DependencyStamp[];
+}
+
+/**
+ * Persistent index of processed context files. A record is reused while the
+ * context file and every file it imports are unchanged, so a refresh only
+ * re-reads files that changed and the files that import them. The index is
+ * shared by every workspace, so it keeps only the most recently used records.
+ */
+const contextFileIndex = new FileMetadataCache<ContextFileRecord>(
+  'context-files',
+  { maxEntries: 256, maxBytes: 4 * 1024 * 1024 },
+);
+
+async function statFile(filePath: string): Promise<FileStamp | undefined> {
+  try {
+    return await fs.stat(filePath);
+  } catch {
+    return undefined;
+  }
+}
+
+async function stampDependencies(
+  filePaths: string[],
+): Promise<DependencyStamp[]> {
+  const unique = Array.from(new Set(filePaths));
+  return Promise.all(
+    unique.map(async (filePath) => {
+      const stamp = await statFile(filePath);
+      return {
+        path: filePath,
+        mtimeMs: stamp?.mtimeMs ?? -1,
+        size: stamp?.size ?? -1,
+      };
+    }),
+  );
+}
+
+async function areDependenciesUnchanged(
+  dependencies: DependencyStamp[],
+): Promise<boolean> {
+  const current = await stampDependencies(dependencies.map((d) => d.path));
+  return current.every(
+    (stamp, i) =>
+      stamp.mtimeMs === dependencies[i].mtimeMs &&
+      stamp.size === dependencies[i].size,
+  );
+}
+
+async function getIndexedContent(
+  filePath: string,
+  stamp: FileStamp | undefined,
+  importFormat: 'flat' | 'tree',
+): Promise<string | undefined> {
+  const record = contextFileIndex.get(filePath, stamp);
+  if (
+    !record ||
+    record.importFormat !== importFormat ||
+    !(await areDependenciesUnchanged(record.dependencies))
+  ) {
+    return undefined;
+  }
+  return record.content;
+}
+
 async function findProjectRoot(startDir: string): Promise<string | null> {
   let currentDir = path.resolve(startDir);
   while (true) {
@@ -143,9 +220,45 @@ async function getGeminiMdFilePathsInternalForEachDir(
 ): Promise<string[]> {
   const allPaths = new Set<string>();
   const geminiMdFilenames = getAllGeminiMdFilenames();
+  const resolvedHome = path.resolve(userHomePath);
+
+  // Handle the case where we're in the home directory (dir is empty string or home path)
+  const resolvedDir = dir ? path.resolve(dir) : resolvedHome;
+  const isHomeDirectory = resolvedDir === resolvedHome;
+
+  // FIX: Only perform the workspace search (upward and downward scans)
+  // if a valid currentWorkingDirectory is provided and it's not the home directory.
+  const searchWorkspace = !isHomeDirectory && !!dir;
+  let projectRoot: string | null = null;
+  const downwardPathsByName = new Map<string, string[]>();
+  if (searchWorkspace) {
+    projectRoot = await findProjectRoot(resolvedDir);
+    if (debugMode)
+      logger.debug(`Determined project root: ${projectRoot ?? 'None'}`);
+
+    const mergedOptions = {
+      ...DEFAULT_MEMORY_FILE_FILTERING_OPTIONS,
+      ...fileFilteringOptions,
+    };
+
+    // A single downward scan finds every configured context file name.
+    const downwardPaths = await bfsFileSearch(resolvedDir, {
+      fileName: geminiMdFilenames,
+      maxDirs,
+      debug: debugMode,
+      fileService,
+      fileFilteringOptions: mergedOptions,
+    });
+    downwardPaths.sort();
+    for (const dPath of downwardPaths) {
+      const name = path.basename(dPath);
+      const paths = downwardPathsByName.get(name) ?? [];
+      paths.push(dPath);
+      downwardPathsByName.set(name, paths);
+    }
+  }
 
   for (const geminiMdFilename of geminiMdFilenames) {
-    const resolvedHome = path.resolve(userHomePath);
     const globalMemoryPath = path.join(
       resolvedHome,
       GEMINI_CONFIG_DIR,
@@ -164,10 +277,6 @@ async function getGeminiMdFilePathsInternalForEachDir(
       // It's okay if it's not found.
     }
 
-    // Handle the case where we're in the home directory (dir is empty string or home path)
-    const resolvedDir = dir ? path.resolve(dir) : resolvedHome;
-    const isHomeDirectory = resolvedDir === resolvedHome;
-
     if (isHomeDirectory) {
       // For home directory, only check for KOLOSAL.md directly in the home directory
       const homeContextPath = path.join(resolvedHome, geminiMdFilename);
@@ -183,19 +292,13 @@ async function getGeminiMdFilePathsInternalForEachDir(
       } catch {
         // Not found, which is okay
       }
-    } else if (dir) {
-      // FIX: Only perform the workspace search (upward and downward scans)
-      // if a valid currentWorkingDirectory is provided and it's not the home directory.
-      const resolvedCwd = path.resolve(dir);
+    } else if (searchWorkspace) {
+      const resolvedCwd = resolvedDir;
       if (debugMode)
         logger.debug(
           `Searching for ${geminiMdFilename} starting from CWD: ${resolvedCwd}`,
         );
 
-      const projectRoot = await findProjectRoot(resolvedCwd);
-      if (debugMode)
-        logger.debug(`Determined project root: ${projectRoot ?? 'None'}`);
-
       const upwardPaths: string[] = [];
       let currentDir = resolvedCwd;
       const ultimateStopDir = projectRoot
@@ -225,20 +328,7 @@ async function getGeminiMdFilePathsInternalForEachDir(
       }
       upwardPaths.forEach((p) => allPaths.add(p));
 
-      const mergedOptions = {
-        ...DEFAULT_MEMORY_FILE_FILTERING_OPTIONS,
-        ...fileFilteringOptions,
-      };
-
-      const downwardPaths = await bfsFileSearch(resolvedCwd, {
-        fileName: geminiMdFilename,
-        maxDirs,
-        debug: debugMode,
-        fileService,
-        fileFilteringOptions: mergedOptions,
-      });
-      downwardPaths.sort();
-      for (const dPath of downwardPaths) {
+      for (const dPath of downwardPathsByName.get(geminiMdFilename) ?? []) {
         allPaths.add(dPath);
       }
     }
@@ -268,12 +358,27 @@ async function readGeminiMdFiles(
   // Process files in parallel with concurrency limit to prevent EMFILE errors
   const CONCURRENT_LIMIT = 20; // Higher limit for file reads as they're typically faster
   const results: GeminiFileContent[] = [];
+  await contextFileIndex.load();
 
   for (let i = 0; i < filePaths.length; i += CONCURRENT_LIMIT) {
     const batch = filePaths.slice(i, i + CONCURRENT_LIMIT);
     const batchPromises = batch.map(
       async (filePath): Promise<GeminiFileContent> => {
         try {
+          const stamp = await statFile(filePath);
+          const indexedContent = await getIndexedContent(
+            filePath,
+            stamp,
+            importFormat,
+          );
+          if (indexedContent !== undefined) {
+            if (debugMode)
+              logger.debug(
+                `Unchanged, reusing processed content: ${filePath}`,
+              );
+            return { filePath, content: indexedContent };
+          }
+
           const content = await fs.readFile(filePath, 'utf-8');
 
           // Process imports in the content
@@ -290,6 +395,14 @@ async function readGeminiMdFiles(
               `Successfully read and processed imports: ${filePath} (Length: ${processedResult.content.length})`,
             );
 
+          contextFileIndex.set(filePath, stamp, {
+            importFormat,
+            content: processedResult.content,
+            dependencies: await stampDependencies(
+              processedResult.importedFiles ?? [],
+            ),
+          });
+
           return { filePath, content: processedResult.content };
         } catch (error: unknown) {
           const isTestEnv =
@@ -322,6 +435,7 @@ async function readGeminiMdFiles(
     }
   }
 
+  void contextFileIndex.save();
   return results;
 }
 
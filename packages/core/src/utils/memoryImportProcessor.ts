@@ -45,6 +45,11 @@ export interface MemoryFile {
 export interface ProcessImportsResult {
   content: string;
   importTree: MemoryFile;
+  /**
+   * Every file the content depends on, excluding the root file. Includes
+   * imports that could not be read, since creating them changes the result.
+   */
+  importedFiles: string[];
 }
 
 // Helper to find the project root (looks for .git directory)
@@ -252,6 +257,7 @@ export async function processImports(
     return {
       content,
       importTree: { path: importState.currentFile || 'unknown' },
+      importedFiles: [],
     };
   }
 
@@ -259,6 +265,7 @@ export async function processImports(
   if (importFormat === 'flat') {
     // Use a queue to process files in order of first encounter, and a set to avoid duplicates
     const flatFiles: Array<{ path: string; content: string }> = [];
+    const failedImports: string[] = [];
     // Track processed files across the entire operation
     const processedFiles = new Set<string>();
 
@@ -324,6 +331,7 @@ export async function processImports(
             depth + 1,
           );
         } catch (error) {
+          failedImports.push(normalizedFullPath);
           if (debugMode) {
             logger.warn(
               `Failed to import ${fullPath}: ${hasMessage(error) ? error.message : 'Unknown error'}`,
@@ -351,6 +359,10 @@ export async function processImports(
     return {
       content: flatContent,
       importTree: { path: rootPath }, // Tree not meaningful in flat mode
+      importedFiles: [
+        ...flatFiles.slice(1).map((f) => f.path),
+        ...failedImports,
+      ],
     };
   }
 
@@ -359,6 +371,7 @@ export async function processImports(
   let result = '';
   let lastIndex = 0;
   const imports: MemoryFile[] = [];
+  const importedFiles: string[] = [];
   const importsList = findImports(content);
 
   for (const { start, _end, path: importPath } of importsList) {
@@ -402,6 +415,7 @@ export async function processImports(
       );
       result += `<!-- Imported from: ${importPath} -->\n${imported.content}\n<!-- End of import from: ${importPath} -->`;
       imports.push(imported.importTree);
+      importedFiles.push(fullPath, ...imported.importedFiles);
     } catch (err: unknown) {
       let message = 'Unknown error';
       if (hasMessage(err)) {
@@ -411,6 +425,7 @@ export async function processImports(
       }
       logger.error(`Failed to import ${importPath}: ${message}`);
       result += `<!-- Import failed: ${importPath} - ${message} -->`;
+      importedFiles.push(fullPath);
     }
   }
   // Add any remaining content after the last match
@@ -422,6 +437,7 @@ export async function processImports(
       path: importState.currentFile || 'unknown',
       imports: imports.length > 0 ? imports : undefined,
     },
+    importedFiles,
   };
 }
 
@@ -14,11 +14,17 @@ import {
   afterEach,
 } from 'vitest';
 import type { Content, GoogleGenAI, Models } from '@google/genai';
+import { FinishReason } from '@google/genai';
 import { DEFAULT_QWEN_FLASH_MODEL } from '../config/models.js';
 import { GeminiClient } from '../core/client.js';
 import { Config } from '../config/config.js';
 import type { NextSpeakerResponse } from './nextSpeakerChecker.js';
-import { checkNextSpeaker } from './nextSpeakerChecker.js';
+import {
+  checkNextSpeaker,
+  classifyNextSpeaker,
+  getNextSpeakerCheckStats,
+  resetNextSpeakerCheckStats,
+} from './nextSpeakerChecker.js';
 import { GeminiChat } from '../core/geminiChat.js';
 
 // Mock GeminiClient and Config constructor
@@ -259,4 +265,86 @@ describe('checkNextSpeaker', () => {
       .calls[0];
     expect(generateJsonCall[3]).toBe(DEFAULT_QWEN_FLASH_MODEL);
   });
+
+  it('should resolve clear cases locally when the finish reason is known', async () => {
+    resetNextSpeakerCheckStats();
+    (chatInstance.getHistory as Mock).mockReturnValue([
+      { role: 'model', parts: [{ text: 'All tests pass now.' }] },
+    ] as Content[]);
+
+    const result = await checkNextSpeaker(
+      chatInstance,
+      mockGeminiClient,
+      abortSignal,
+      FinishReason.STOP,
+    );
+
+    expect(result?.next_speaker).toBe('user');
+    expect(mockGeminiClient.generateJson).not.toHaveBeenCalled();
+    expect(getNextSpeakerCheckStats()).toEqual({
+      rule: 0,
+      heuristic: 1,
+      llm: 0,
+      undecided: 0,
+    });
+  });
+
+  it('should fall back to the model when the heuristic is unsure', async () => {
+    resetNextSpeakerCheckStats();
+    (chatInstance.getHistory as Mock).mockReturnValue([
+      { role: 'model', parts: [{ text: 'Some model output' }] },
+    ] as Content[]);
+    (mockGeminiClient.generateJson as Mock).mockResolvedValue({
+      reasoning: 'Statement.',
+      next_speaker: 'user',
+    });
+
+    await checkNextSpeaker(
+      chatInstance,
+      mockGeminiClient,
+      abortSignal,
+      FinishReason.STOP,
+    );
+
+    expect(mockGeminiClient.generateJson).toHaveBeenCalledTimes(1);
+    expect(getNextSpeakerCheckStats().llm).toBe(1);
+  });
+});
+
+describe('classifyNextSpeaker', () => {
+  const message = (text: string): Content => ({
+    role: 'model',
+    parts: [{ text }],
+  });
+
+  it.each([
+    ['Here is the fix.', 'user'],
+    ['Which file should I change?', 'user'],
+    ['Done. Let me know if you need anything else.', 'user'],
+    ['I updated the config. Next, I will run the tests.', 'model'],
+    ['Let me check the logs.', 'model'],
+    ['The remaining steps are:', 'model'],
+    ['Here is the script:\n```bash\nnpm test', 'model'],
+    ['Here is the script:\n```bash\nnpm test\n```', 'user'],
+  ])('should classify %j as %s', (text, expected) => {
+    expect(
+      classifyNextSpeaker(message(text), FinishReason.STOP)?.next_speaker,
+    ).toBe(expected);
+  });
+
+  it('should continue when the output token limit was hit', () => {
+    expect(
+      classifyNextSpeaker(message('Done.'), FinishReason.MAX_TOKENS)
+        ?.next_speaker,
+    ).toBe('model');
+  });
+
+  it('should return null for ambiguous responses', () => {
+    expect(
+      classifyNextSpeaker(message('Some model output'), FinishReason.STOP),
+    ).toBeNull();
+    expect(
+      classifyNextSpeaker(message('Done.'), FinishReason.SAFETY),
+    ).toBeNull();
+  });
 });
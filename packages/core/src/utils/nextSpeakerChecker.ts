@@ -5,6 +5,7 @@
  */
 
 import type { Content } from '@google/genai';
+import { FinishReason } from '@google/genai';
 import { DEFAULT_QWEN_FLASH_MODEL } from '../config/models.js';
 import type { GeminiClient } from '../core/client.js';
 import type { GeminiChat } from '../core/geminiChat.js';
@@ -39,11 +40,152 @@ export interface NextSpeakerResponse {
   next_speaker: 'user' | 'model';
 }
 
+/**
+ * How often each stage of the next speaker check produced the decision.
+ * `rule` covers the structural checks on the history, `heuristic` the local
+ * classifier and `llm` the model request. `undecided` counts checks that
+ * returned null.
+ */
+export interface NextSpeakerCheckStats {
+  rule: number;
+  heuristic: number;
+  llm: number;
+  undecided: number;
+}
+
+interface NextSpeakerDecision {
+  stage: 'rule' | 'heuristic' | 'llm';
+  response: NextSpeakerResponse;
+}
+
+const nextSpeakerCheckStats: NextSpeakerCheckStats = {
+  rule: 0,
+  heuristic: 0,
+  llm: 0,
+  undecided: 0,
+};
+
+export function getNextSpeakerCheckStats(): NextSpeakerCheckStats {
+  return { ...nextSpeakerCheckStats };
+}
+
+export function resetNextSpeakerCheckStats(): void {
+  nextSpeakerCheckStats.rule = 0;
+  nextSpeakerCheckStats.heuristic = 0;
+  nextSpeakerCheckStats.llm = 0;
+  nextSpeakerCheckStats.undecided = 0;
+}
+
+// Phrases in the closing sentence that announce an action the model has not
+// taken yet. "Let me know" is an invitation to the user and is excluded.
+const CONTINUATION_PATTERN =
+  /\b(next,? i(?:'ll| will)|now,? i(?:'ll| will)|i(?:'ll| will) now|let me (?!know\b)|moving on to|i(?:'m| am) going to|proceeding to)/i;
+
+// Phrases that hand the turn back to the user.
+const HANDOFF_PATTERN =
+  /\b(let me know|feel free to|would you like|do you want|if you(?:'d| would) like|anything else)\b/i;
+
+/**
+ * Decides the next speaker from the shape of the model's last message without
+ * asking the model. Returns null when the message is ambiguous.
+ *
+ * @param lastMessage The model's last message in the curated history.
+ * @param finishReason Why the model stopped generating the message.
+ */
+export function classifyNextSpeaker(
+  lastMessage: Content,
+  finishReason: FinishReason,
+): NextSpeakerResponse | null {
+  if (finishReason === FinishReason.MAX_TOKENS) {
+    return {
+      reasoning: 'The response was cut off by the output token limit.',
+      next_speaker: 'model',
+    };
+  }
+  if (finishReason !== FinishReason.STOP) {
+    // Safety stops, malformed calls etc. are not something to continue from.
+    return null;
+  }
+
+  const text = (lastMessage.parts ?? [])
+    .filter((part) => !part.thought && typeof part.text === 'string')
+    .map((part) => part.text)
+    .join('')
+    .trim();
+  if (!text) {
+    return null;
+  }
+
+  const fenceCount = text.match(/^[ \t]*```/gm)?.length ?? 0;
+  if (fenceCount % 2 === 1) {
+    return {
+      reasoning: 'The response ends inside an unclosed code block.',
+      next_speaker: 'model',
+    };
+  }
+
+  // Only the closing sentence matters for intent; earlier mentions of what
+  // the model did or will do are usually already resolved.
+  const lastLine = text.split('\n').pop()!.trim();
+  const sentences = lastLine.split(/(?<=[.!?])\s+/);
+  const lastSentence = sentences[sentences.length - 1];
+
+  if (HANDOFF_PATTERN.test(lastSentence) || lastLine.endsWith('?')) {
+    return {
+      reasoning: 'The response ends by handing the turn to the user.',
+      next_speaker: 'user',
+    };
+  }
+  if (CONTINUATION_PATTERN.test(lastSentence)) {
+    return {
+      reasoning: 'The response ends by announcing an action not yet taken.',
+      next_speaker: 'model',
+    };
+  }
+  if (lastLine.endsWith(':') || lastLine.endsWith(',')) {
+    return {
+      reasoning: 'The response ends mid-thought.',
+      next_speaker: 'model',
+    };
+  }
+  if (/[.!)\]`*|]$/.test(lastLine)) {
+    return {
+      reasoning: 'The response ends with a completed statement.',
+      next_speaker: 'user',
+    };
+  }
+  return null;
+}
+
+/**
+ * Determines whether the model should keep going after its last turn.
+ *
+ * Clear cases are resolved locally: structural checks on the history first,
+ * then, when the turn's finish reason is known, {@link classifyNextSpeaker}.
+ * Only ambiguous responses cost a request to the model.
+ */
 export async function checkNextSpeaker(
   chat: GeminiChat,
   geminiClient: GeminiClient,
   abortSignal: AbortSignal,
+  finishReason?: FinishReason,
 ): Promise<NextSpeakerResponse | null> {
+  const result = await determineNextSpeaker(
+    chat,
+    geminiClient,
+    abortSignal,
+    finishReason,
+  );
+  nextSpeakerCheckStats[result?.stage ?? 'undecided']++;
+  return result?.response ?? null;
+}
+
+async function determineNextSpeaker(
+  chat: GeminiChat,
+  geminiClient: GeminiClient,
+  abortSignal: AbortSignal,
+  finishReason: FinishReason | undefined,
+): Promise<NextSpeakerDecision | null> {
   // We need to capture the curated history because there are many moments when the model will return invalid turns
   // that when passed back up to the endpoint will break subsequent calls. An example of this is when the model decides
   // to respond with an empty part collection if you were to send that message back to the server it will respond with
@@ -73,9 +215,12 @@ export async function checkNextSpeaker(
     isFunctionResponse(lastComprehensiveMessage)
   ) {
     return {
-      reasoning:
-        'The last message was a function response, so the model should speak next.',
-      next_speaker: 'model',
+      stage: 'rule',
+      response: {
+        reasoning:
+          'The last message was a function response, so the model should speak next.',
+        next_speaker: 'model',
+      },
     };
   }
 
@@ -87,9 +232,12 @@ export async function checkNextSpeaker(
   ) {
     lastComprehensiveMessage.parts.push({ text: '' });
     return {
-      reasoning:
-        'The last message was a filler model message with no content (nothing for user to act on), model should speak next.',
-      next_speaker: 'model',
+      stage: 'rule',
+      response: {
+        reasoning:
+          'The last message was a filler model message with no content (nothing for user to act on), model should speak next.',
+        next_speaker: 'model',
+      },
     };
   }
 
@@ -102,6 +250,13 @@ export async function checkNextSpeaker(
     return null;
   }
 
+  if (finishReason !== undefined) {
+    const classified = classifyNextSpeaker(lastMessage, finishReason);
+    if (classified) {
+      return { stage: 'heuristic', response: classified };
+    }
+  }
+
   const contents: Content[] = [
     ...curatedHistory,
     { role: 'user', parts: [{ text: CHECK_PROMPT }] },
@@ -120,7 +275,7 @@ export async function checkNextSpeaker(
       parsedResponse.next_speaker &&
       ['user', 'model'].includes(parsedResponse.next_speaker)
     ) {
-      return parsedResponse;
+      return { stage: 'llm', response: parsedResponse };
     }
     return null;
   } catch (error) {
@@ -0,0 +1,52 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import { PromptHistoryIndex } from './promptHistoryIndex.js';
+
+describe('PromptHistoryIndex', () => {
+  const index = new PromptHistoryIndex([
+    'Fix the failing test',
+    'explain this function',
+    'Run the tests again',
+    'ls',
+  ]);
+
+  it('should find substrings ignoring case, in index order', () => {
+    expect(index.search('TEST')).toEqual([
+      { text: 'Fix the failing test', matchedIndex: 16 },
+      { text: 'Run the tests again', matchedIndex: 8 },
+    ]);
+  });
+
+  it('should match short queries and prefixes', () => {
+    expect(index.search('ls').map((m) => m.text)).toEqual(['ls']);
+    expect(index.search('run').map((m) => m.matchedIndex)).toEqual([0]);
+  });
+
+  it('should return every entry for an empty query', () => {
+    expect(index.search('')).toHaveLength(4);
+  });
+
+  it('should return nothing when a trigram of the query is unknown', () => {
+    expect(index.search('xyz')).toEqual([]);
+  });
+
+  it('should verify candidates that contain every trigram but not the query', () => {
+    expect(index.search('the tests fail')).toEqual([]);
+  });
+
+  it('should stop at the limit', () => {
+    expect(index.search('t', 2)).toHaveLength(2);
+  });
+
+  it('should index entries added later', () => {
+    const grown = new PromptHistoryIndex(['first']);
+    grown.add('second test');
+    expect(grown.size).toBe(2);
+    expect(grown.search('test').map((m) => m.text)).toEqual(['second test']);
+  });
+});
@@ -0,0 +1,89 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+const GRAM_LENGTH = 3;
+
+export interface PromptHistoryMatch {
+  text: string;
+  /** Position of the query in `text`, ignoring case. */
+  matchedIndex: number;
+}
+
+function gramsOf(text: string): Set<string> {
+  const grams = new Set<string>();
+  for (let i = 0; i + GRAM_LENGTH <= text.length; i++) {
+    grams.add(text.slice(i, i + GRAM_LENGTH));
+  }
+  return grams;
+}
+
+/**
+ * Case-insensitive substring index over a prompt or command history. Entries
+ * keep the order they were added in, which is the order matches are returned
+ * in. Queries of three or more characters only compare the entries that
+ * contain the query's rarest trigram, instead of scanning the whole history.
+ */
+export class PromptHistoryIndex {
+  private readonly entries: string[] = [];
+  private readonly lowered: string[] = [];
+  private readonly postings = new Map<string, number[]>();
+
+  constructor(entries: Iterable<string> = []) {
+    for (const entry of entries) {
+      this.add(entry);
+    }
+  }
+
+  get size(): number {
+    return this.entries.length;
+  }
+
+  /** Adds an entry after the ones already indexed. */
+  add(entry: string): void {
+    const id = this.entries.length;
+    const lowered = entry.toLowerCase();
+    this.entries.push(entry);
+    this.lowered.push(lowered);
+    for (const gram of gramsOf(lowered)) {
+      let ids = this.postings.get(gram);
+      if (!ids) {
+        ids = [];
+        this.postings.set(gram, ids);
+      }
+      ids.push(id);
+    }
+  }
+
+  /**
+   * Returns up to `limit` entries containing `query`, in index order. An
+   * empty query matches every entry.
+   */
+  search(query: string, limit = Infinity): PromptHistoryMatch[] {
+    const q = query.toLowerCase();
+    const matches: PromptHistoryMatch[] = [];
+    for (const id of this.candidates(q)) {
+      if (matches.length >= limit) break;
+      const matchedIndex = this.lowered[id].indexOf(q);
+      if (matchedIndex !== -1) {
+        matches.push({ text: this.entries[id], matchedIndex });
+      }
+    }
+    return matches;
+  }
+
+  private candidates(q: string): Iterable<number> {
+    if (q.length < GRAM_LENGTH) {
+      return this.entries.keys();
+    }
+    let rarest: number[] | undefined;
+    for (const gram of gramsOf(q)) {
+      const ids = this.postings.get(gram);
+      if (!ids) return [];
+      if (!rarest || ids.length < rarest.length) rarest = ids;
+    }
+    return rarest ?? [];
+  }
+}
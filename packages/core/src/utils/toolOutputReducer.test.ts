@@ -0,0 +1,167 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import { describe, expect, it } from 'vitest';
+import { reduceToolOutput } from './toolOutputReducer.js';
+
+describe('reduceToolOutput', () => {
+  it('should leave small, clean output unchanged', () => {
+    const text = 'line one\nline two\nline three';
+    const reduction = reduceToolOutput(text);
+    expect(reduction.text).toBe(text);
+    expect(reduction.reducedBytes).toBe(reduction.originalBytes);
+    expect(reduction.fitsBudget).toBe(true);
+  });
+
+  it('should return output that fits the budget exactly', () => {
+    const text = [
+      '\x1b[32mstart\x1b[0m\n[==   ] 40%\r[=====] 100%',
+      ...Array.from({ length: 5 }, (_, i) => `Downloaded chunk ${i} of 5`),
+      ...Array(3).fill('retrying connection'),
+    ].join('\n');
+    const reduction = reduceToolOutput(text);
+    expect(reduction.text).toBe(text);
+    expect(reduction.condensed).toBe(text);
+  });
+
+  it('should keep only the final redraw of progress bars and strip colours', () => {
+    const text =
+      '\x1b[32mstart\x1b[0m\n[==   ] 40%\r[==== ] 80%\r[=====] 100%\ndone';
+    expect(reduceToolOutput(text, { tokenBudget: 10 }).text).toBe(
+      'start\n[=====] 100%\ndone',
+    );
+  });
+
+  it('should collapse repeated and near-identical lines', () => {
+    const text = [
+      'compiling',
+      ...Array(5).fill('retrying connection'),
+      ...Array.from({ length: 50 }, (_, i) => `Downloaded chunk ${i} of 50`),
+      'done',
+    ].join('\n');
+
+    expect(reduceToolOutput(text, { tokenBudget: 100 }).text).toBe(
+      [
+        'compiling',
+        'retrying connection',
+        '... (previous line repeated 4 more times)',
+        'Downloaded chunk 0 of 50',
+        '... (48 similar lines omitted)',
+        'Downloaded chunk 49 of 50',
+        'done',
+      ].join('\n'),
+    );
+  });
+
+  it('should merge similar lines only while over budget', () => {
+    const lines = Array.from({ length: 50 }, (_, i) => `L${i}: match`);
+    const text = [...lines, ...Array(50).fill('same')].join('\n');
+
+    const reduction = reduceToolOutput(text, { tokenBudget: 150 });
+    expect(reduction.text).toBe(
+      [...lines, 'same', '... (previous line repeated 49 more times)'].join(
+        '\n',
+      ),
+    );
+    expect(
+      reduceToolOutput(text, { tokenBudget: 100 }).text.split('\n'),
+    ).toHaveLength(5);
+  });
+
+  it('should not merge similar lines when asked not to', () => {
+    const text = Array.from({ length: 500 }, (_, i) => `L${i}: match`).join(
+      '\n',
+    );
+    const reduction = reduceToolOutput(text, {
+      tokenBudget: 100,
+      collapseSimilar: false,
+    });
+    expect(reduction.condensed).toBe(text);
+    expect(reduction.text.startsWith('L0: match\nL1: match\nL2: match')).toBe(
+      true,
+    );
+  });
+
+  it('should not merge similar error and warning lines', () => {
+    const diagnostics = Array.from(
+      { length: 10 },
+      (_, i) =>
+        `  ${i + 10}:5  ${i < 5 ? 'error' : 'warning'}  Unexpected any  no-explicit-any`,
+    );
+    const text = [
+      ...Array.from({ length: 200 }, (_, i) => `Linted file ${i} of 200`),
+      '/src/app.ts',
+      ...diagnostics,
+    ].join('\n');
+
+    const reduction = reduceToolOutput(text, { tokenBudget: 150 });
+
+    expect(reduction.condensed).toBe(
+      [
+        'Linted file 0 of 200',
+        '... (198 similar lines omitted)',
+        'Linted file 199 of 200',
+        '/src/app.ts',
+        ...diagnostics,
+      ].join('\n'),
+    );
+    expect(reduction.text).toBe(reduction.condensed);
+  });
+
+  it('should replace a repeated stack trace with a reference', () => {
+    const trace = [
+      'Error: boom',
+      '    at parse (src/parser.ts:10:5)',
+      '    at load (src/loader.ts:22:3)',
+    ];
+    const text = [...trace, 'retry', ...trace].join('\n');
+
+    expect(reduceToolOutput(text, { tokenBudget: 40 }).text).toBe(
+      [
+        ...trace,
+        'retry',
+        'Error: boom',
+        '    ... (same 2 stack lines as above)',
+      ].join('\n'),
+    );
+  });
+
+  it('should keep head, tail and error context when over budget', () => {
+    const lines = Array.from(
+      { length: 2000 },
+      (_, i) => `step ${'abcdefghij'[i % 10]}${i} ok`,
+    );
+    lines[1000] = 'src/app.ts(12,3): error TS2322: Type mismatch';
+    const reduction = reduceToolOutput(lines.join('\n'), {
+      tokenBudget: 500,
+      collapseSimilar: false,
+    });
+
+    expect(reduction.fitsBudget).toBe(true);
+    expect(reduction.text.length).toBeLessThanOrEqual(500 * 4);
+    expect(reduction.text.startsWith('step a0 ok')).toBe(true);
+    expect(reduction.text.endsWith('step j1999 ok')).toBe(true);
+    expect(reduction.text).toContain(
+      'step j999 ok\nsrc/app.ts(12,3): error TS2322: Type mismatch\nstep b1001 ok',
+    );
+    expect(reduction.text).toMatch(/\.\.\. \[\d+ lines omitted\] \.\.\./);
+    expect(reduction.reducedBytes).toBeLessThan(reduction.originalBytes);
+  });
+
+  it('should report when error lines cannot all fit the budget', () => {
+    const text = Array.from(
+      { length: 400 },
+      (_, i) => `error: failure number ${i} in ${'x'.repeat(20)}${i}`,
+    ).join('\n');
+    const reduction = reduceToolOutput(text, {
+      tokenBudget: 200,
+      collapseSimilar: false,
+    });
+
+    expect(reduction.fitsBudget).toBe(false);
+    expect(reduction.condensed).toBe(text);
+  });
+});
@@ -0,0 +1,309 @@
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+import type { Config } from '../config/config.js';
+import { recordToolOutputReduction } from '../telemetry/metrics.js';
+import { summarizeToolOutput } from './summarizer.js';
+
+/** Budget applied to tools that have no summarizeToolOutput setting. */
+export const DEFAULT_TOOL_OUTPUT_TOKEN_BUDGET = 16000;
+/** Budget for tools configured without one; matches the summarizer's. */
+export const CONFIGURED_TOOL_OUTPUT_TOKEN_BUDGET = 2000;
+const CHARS_PER_TOKEN = 4;
+const MAX_LINE_CHARS = 2000;
+const SIMILAR_RUN_MIN = 3;
+const CONTEXT_BEFORE = 3;
+const CONTEXT_AFTER = 5;
+
+const ANSI_PATTERN =
+  // eslint-disable-next-line no-control-regex
+  /\x1b(?:\[[0-9;?]*[ -/]*[@-~]|\][^\x07\x1b]*(?:\x07|\x1b\\))/g;
+const FRAME_PATTERN = /^\s+(?:at\s+\S|File ".*", line \d+)/;
+const ERROR_PATTERN =
+  /\b(?:error|errors|fail|failed|failure|fatal|panic|exception|traceback|assertion)\b|^E\s/i;
+const WARNING_PATTERN = /\b(?:warn|warning|warnings|deprecated)\b/i;
+
+export interface ReduceToolOutputOptions {
+  /** Approximate size the reduced text should fit, in tokens. */
+  tokenBudget?: number;
+  /**
+   * Collapse runs of lines that differ only in numbers or bar lengths when the
+   * output is still over budget otherwise. Error and warning lines are never
+   * merged. Off for output where every line is a distinct result, such as
+   * search matches and file contents.
+   */
+  collapseSimilar?: boolean;
+}
+
+export interface ToolOutputReduction {
+  /** The reduced text. */
+  text: string;
+  /**
+   * The text after collapsing progress bars, repeated lines and duplicate
+   * stack traces, before anything was elided to fit the budget.
+   */
+  condensed: string;
+  originalBytes: number;
+  reducedBytes: number;
+  /** False when error or warning lines had to be dropped to fit. */
+  fitsBudget: boolean;
+}
+
+/**
+ * Deterministically shrinks command, search and file output. Output that fits
+ * the budget is returned exactly. Otherwise progress bar redraws, repeated
+ * lines and repeated stack traces are collapsed first, then runs of
+ * near-identical lines. If the result is still over budget, the head and tail
+ * are kept along with error and warning lines and their surrounding context.
+ */
+export function reduceToolOutput(
+  text: string,
+  options: ReduceToolOutputOptions = {},
+): ToolOutputReduction {
+  const budgetChars =
+    (options.tokenBudget ?? DEFAULT_TOOL_OUTPUT_TOKEN_BUDGET) * CHARS_PER_TOKEN;
+  const originalBytes = Buffer.byteLength(text);
+  if (text.length <= budgetChars) {
+    return {
+      text,
+      condensed: text,
+      originalBytes,
+      reducedBytes: originalBytes,
+      fitsBudget: true,
+    };
+  }
+
+  let lines = collapseRuns(dedupeStackTraces(splitLines(text)), false);
+  let condensed = lines.join('\n');
+  if (condensed.length > budgetChars && (options.collapseSimilar ?? true)) {
+    lines = collapseRuns(lines, true);
+    condensed = lines.join('\n');
+  }
+  let reduced = condensed;
+  let fitsBudget = true;
+  if (condensed.length > budgetChars) {
+    ({ text: reduced, fitsBudget } = selectWithinBudget(
+      lines.map((line) => truncateLine(line, budgetChars)),
+      budgetChars,
+    ));
+  }
+
+  return {
+    text: reduced,
+    condensed,
+    originalBytes,
+    reducedBytes: Buffer.byteLength(reduced),
+    fitsBudget,
+  };
+}
+
+/**
+ * Reduces a tool's text output before it enters the history. Tools with a
+ * summarizeToolOutput setting fall back to the LLM summarizer when the local
+ * pass cannot keep their error context within the budget.
+ */
+export async function compactToolOutput(
+  config: Config,
+  toolName: string,
+  text: string,
+  abortSignal: AbortSignal,
+  options: ReduceToolOutputOptions = {},
+): Promise<string> {
+  const settings = config.getSummarizeToolOutputConfig()?.[toolName];
+  const tokenBudget =
+    options.tokenBudget ??
+    (settings
+      ? (settings.tokenBudget ?? CONFIGURED_TOOL_OUTPUT_TOKEN_BUDGET)
+      : DEFAULT_TOOL_OUTPUT_TOKEN_BUDGET);
+
+  const reduction = reduceToolOutput(text, { ...options, tokenBudget });
+  if (settings && !reduction.fitsBudget) {
+    const summary = await summarizeToolOutput(
+      reduction.condensed,
+      config.getGeminiClient(),
+      abortSignal,
+      tokenBudget,
+    );
+    recordToolOutputReduction(config, {
+      tool_name: toolName,
+      stage: 'llm',
+      bytes_saved: reduction.originalBytes - Buffer.byteLength(summary),
+    });
+    return summary;
+  }
+
+  if (reduction.reducedBytes < reduction.originalBytes) {
+    recordToolOutputReduction(config, {
+      tool_name: toolName,
+      stage: 'local',
+      bytes_saved: reduction.originalBytes - reduction.reducedBytes,
+    });
+  }
+  return reduction.text;
+}
+
+// Splits into lines, keeping only the final redraw of carriage-return
+// progress bars and dropping terminal escape sequences.
+function splitLines(text: string): string[] {
+  return text
+    .replace(ANSI_PATTERN, '')
+    .split('\n')
+    .map((line) => {
+      if (!line.includes('\r')) return line;
+      const frames = line.split('\r').filter((frame) => frame.length > 0);
+      return frames.length > 0 ? frames[frames.length - 1] : '';
+    });
+}
+
+// Replaces a stack trace already printed earlier with a one-line reference.
+function dedupeStackTraces(lines: string[]): string[] {
+  const seen = new Set<string>();
+  const out: string[] = [];
+  let i = 0;
+  while (i < lines.length) {
+    if (!FRAME_PATTERN.test(lines[i])) {
+      out.push(lines[i++]);
+      continue;
+    }
+    const start = i;
+    while (
+      i < lines.length &&
+      (FRAME_PATTERN.test(lines[i]) ||
+        // Python prints each frame's source line under it.
+        (/^\s{4,}\S/.test(lines[i]) && /File ".*"/.test(lines[i - 1])))
+    ) {
+      i++;
+    }
+    const frames = lines.slice(start, i);
+    const key = frames.map((line) => line.trim()).join('\n');
+    if (frames.length > 1 && seen.has(key)) {
+      const indent = /^\s*/.exec(frames[0])![0];
+      out.push(`${indent}... (same ${frames.length} stack lines as above)`);
+    } else {
+      seen.add(key);
+      out.push(...frames);
+    }
+  }
+  return out;
+}
+
+// Lines that differ only in numbers or the length of a bar are "similar".
+function similarityKey(line: string): string {
+  return line.replace(/\d+/g, '#').replace(/(.)\1{2,}/g, '$1$1');
+}
+
+function collapseRuns(lines: string[], collapseSimilar: boolean): string[] {
+  const out: string[] = [];
+  let i = 0;
+  while (i < lines.length) {
+    const line = lines[i];
+    let end = i + 1;
+    while (end < lines.length && lines[end] === line) end++;
+    if (end - i >= SIMILAR_RUN_MIN) {
+      out.push(line);
+      if (line.trim()) {
+        out.push(`... (previous line repeated ${end - i - 1} more times)`);
+      }
+      i = end;
+      continue;
+    }
+
+    // Stack frames are only merged when identical, never when merely similar,
+    // and error and warning lines are left for selectWithinBudget to pick:
+    // each lint or compiler diagnostic differs only in its position.
+    if (
+      collapseSimilar &&
+      line.trim() &&
+      !FRAME_PATTERN.test(line) &&
+      !ERROR_PATTERN.test(line) &&
+      !WARNING_PATTERN.test(line)
+    ) {
+      const key = similarityKey(line);
+      while (end < lines.length && similarityKey(lines[end]) === key) end++;
+      if (end - i >= SIMILAR_RUN_MIN) {
+        out.push(
+          line,
+          `... (${end - i - 2} similar lines omitted)`,
+          lines[end - 1],
+        );
+        i = end;
+        continue;
+      }
+    }
+    out.push(line);
+    i++;
+  }
+  return out;
+}
+
+function truncateLine(line: string, budgetChars: number): string {
+  const max = Math.max(
+    200,
+    Math.min(MAX_LINE_CHARS, Math.floor(budgetChars / 8)),
+  );
+  if (line.length <= max) return line;
+  return `${line.slice(0, max)}... [${line.length - max} characters truncated]`;
+}
+
+// Keeps the head, the tail and error/warning context, in that priority
+// order for the budget shares below, and marks each gap.
+function selectWithinBudget(
+  lines: string[],
+  budgetChars: number,
+): { text: string; fitsBudget: boolean } {
+  const keep = new Uint8Array(lines.length);
+  let used = 0;
+  const take = (index: number, limit: number): boolean => {
+    if (keep[index]) return true;
+    const cost = lines[index].length + 1;
+    if (used + cost > limit) return false;
+    keep[index] = 1;
+    used += cost;
+    return true;
+  };
+
+  // 20% head, 30% tail, 40% error and warning context; the rest is left for
+  // the omission markers.
+  const headLimit = budgetChars * 0.2;
+  for (let i = 0; i < lines.length && take(i, headLimit); i++);
+  const tailLimit = used + budgetChars * 0.3;
+  for (let i = lines.length - 1; i >= 0 && take(i, tailLimit); i--);
+
+  const errors: number[] = [];
+  const warnings: number[] = [];
+  lines.forEach((line, index) => {
+    if (ERROR_PATTERN.test(line)) errors.push(index);
+    else if (WARNING_PATTERN.test(line)) warnings.push(index);
+  });
+  const contextLimit = used + budgetChars * 0.4;
+  let fitsBudget = true;
+  for (const index of [...errors, ...warnings]) {
+    const from = Math.max(0, index - CONTEXT_BEFORE);
+    const to = Math.min(lines.length - 1, index + CONTEXT_AFTER);
+    // The matching line first, so it survives even if its context does not.
+    if (!take(index, contextLimit)) {
+      fitsBudget = false;
+      continue;
+    }
+    for (let i = from; i <= to; i++) {
+      take(i, contextLimit);
+    }
+  }
+
+  const out: string[] = [];
+  let omitted = 0;
+  for (let i = 0; i < lines.length; i++) {
+    if (keep[i]) {
+      if (omitted > 0) out.push(`... [${omitted} lines omitted] ...`);
+      omitted = 0;
+      out.push(lines[i]);
+    } else {
+      omitted++;
+    }
+  }
+  if (omitted > 0) out.push(`... [${omitted} lines omitted] ...`);
+  return { text: out.join('\n'), fitsBudget };
+}
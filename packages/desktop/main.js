@@ -5,11 +5,13 @@ class KolosalDesktop {
   constructor() {
     this.messages = [];
     this.serverRunning = false;
+    this.activeRequest = null;
     this.init();
   }
 
   async init() {
     this.setupEventListeners();
+    await this.setupStreamListeners();
     await this.checkServerStatus();
     this.addMessage('system', 'Welcome to Kolosal Desktop! Click "Start Server" to begin.');
   }
@@ -32,6 +34,49 @@ class KolosalDesktop {
     stopServerBtn.addEventListener('click', () => this.stopServer());
   }
 
+  async setupStreamListeners() {
+    // Events are tagged with the request they belong to, so late events from
+    // an earlier message never leak into the current one.
+    const isActive = (payload) =>
+      this.activeRequest && payload.request_id === this.activeRequest.id;
+
+    await appWindow.listen('chat-first-token', ({ payload }) => {
+      if (!isActive(payload)) return;
+      this.updateLatency(`First token: ${payload.ttft_ms} ms`);
+    });
+
+    await appWindow.listen('chat-token', ({ payload }) => {
+      if (!isActive(payload)) return;
+      const request = this.activeRequest;
+      if (!request.message) {
+        this.removeLastMessage();
+        request.message = this.addMessage('assistant', '');
+        request.streamed = true;
+      }
+      request.message.content += payload.text;
+      this.renderMessage(request.message);
+    });
+
+    await appWindow.listen('chat-tool', ({ payload }) => {
+      if (!isActive(payload)) return;
+      const { event } = payload;
+      this.removeLastMessage();
+      if (event.type === 'tool_call') {
+        this.addMessage('tool', `Called: ${event.name}`);
+      } else {
+        const outcome = event.ok ? 'finished' : `failed: ${event.error || 'unknown error'}`;
+        this.addMessage('tool', `${event.name} ${outcome}`);
+      }
+      // Text after a tool event starts a new assistant message
+      this.activeRequest.message = null;
+      this.addMessage('assistant', 'Thinking...', true);
+    });
+  }
+
+  updateLatency(text) {
+    document.getElementById('latency').textContent = text;
+  }
+
   async checkServerStatus() {
     try {
       const status = await invoke('check_server_status');
@@ -89,6 +134,8 @@ class KolosalDesktop {
     const message = input.value.trim();
     
     if (!message) return;
+    // Wait for the current reply to finish before sending another message
+    if (this.activeRequest) return;
     if (!this.serverRunning) {
       this.addMessage('error', 'Please start the server first.');
       return;
@@ -98,23 +145,26 @@ class KolosalDesktop {
     this.addMessage('user', message);
     input.value = '';
 
+    const requestId = crypto.randomUUID();
+    this.activeRequest = { id: requestId, message: null, streamed: false };
+    this.updateLatency('');
+
     try {
-      // Send message to server
+      // Tokens and tool progress arrive as events while the request runs
       this.addMessage('assistant', 'Thinking...', true);
-      const response = await invoke('send_message', { message });
-      
-      // Remove thinking message and add actual response
+      const response = await invoke('send_message', { message, requestId });
+
       this.removeLastMessage();
-      this.addMessage('assistant', response.content);
-      
-      if (response.tool_calls) {
-        response.tool_calls.forEach(tool_call => {
-          this.addMessage('tool', `Called: ${tool_call.name}`);
-        });
+      if (!this.activeRequest.streamed) {
+        this.addMessage('assistant', response.content);
       }
+      const ttft = response.ttft_ms != null ? `First token: ${response.ttft_ms} ms · ` : '';
+      this.updateLatency(`${ttft}Total: ${response.total_ms} ms`);
     } catch (error) {
       this.removeLastMessage();
       this.addMessage('error', `Failed to send message: ${error}`);
+    } finally {
+      this.activeRequest = null;
     }
   }
 
@@ -123,7 +173,15 @@ class KolosalDesktop {
     const messageElement = document.createElement('div');
     messageElement.className = `message ${type}`;
     if (isTemporary) messageElement.classList.add('temporary');
-    
+    messagesContainer.appendChild(messageElement);
+
+    const message = { type, content, element: messageElement };
+    this.messages.push(message);
+    this.renderMessage(message);
+    return message;
+  }
+
+  renderMessage({ type, content, element }) {
     let contentHtml = '';
     switch (type) {
       case 'user':
@@ -142,12 +200,10 @@ class KolosalDesktop {
         contentHtml = `<span style="color: blue;">🔧 ${content}</span>`;
         break;
     }
-    
-    messageElement.innerHTML = contentHtml;
-    messagesContainer.appendChild(messageElement);
+
+    element.innerHTML = contentHtml;
+    const messagesContainer = document.getElementById('messages');
     messagesContainer.scrollTop = messagesContainer.scrollHeight;
-    
-    this.messages.push({ type, content, element: messageElement });
   }
 
   removeLastMessage() {
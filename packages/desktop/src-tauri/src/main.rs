@@ -5,7 +5,9 @@ use serde::{Deserialize, Serialize};
 use std::process::{Command, Child, Stdio};
 use std::sync::{Arc, Mutex};
 use std::thread;
-use std::time::Duration;
+use std::time::{Duration, Instant};
+
+const API_BASE_URL: &str = "http://127.0.0.1:38080";
 
 #[derive(Debug, Serialize, Deserialize)]
 struct ServerStatus {
@@ -18,6 +20,8 @@ struct ServerStatus {
 struct ChatMessage {
     content: String,
     tool_calls: Option<Vec<ToolCall>>,
+    ttft_ms: Option<u64>,
+    total_ms: u64,
 }
 
 #[derive(Debug, Serialize, Deserialize)]
@@ -31,8 +35,120 @@ struct ServerState {
     port: u16,
 }
 
+// A single pooled client shared by all commands, so requests to the local
+// server reuse keep-alive connections instead of reconnecting every time.
+struct ApiClient {
+    http: reqwest::Client,
+}
+
+impl ApiClient {
+    fn new() -> Self {
+        let http = reqwest::Client::builder()
+            .pool_idle_timeout(Duration::from_secs(90))
+            .pool_max_idle_per_host(4)
+            .tcp_keepalive(Duration::from_secs(60))
+            .tcp_nodelay(true)
+            .connect_timeout(Duration::from_secs(5))
+            .build()
+            .expect("failed to build HTTP client");
+        Self { http }
+    }
+}
+
+// Payloads forwarded to the webview while a response is streaming
+#[derive(Clone, Serialize)]
+struct TokenEvent {
+    request_id: String,
+    text: String,
+}
+
+#[derive(Clone, Serialize)]
+struct FirstTokenEvent {
+    request_id: String,
+    ttft_ms: u64,
+}
+
+#[derive(Clone, Serialize)]
+struct ToolEvent {
+    request_id: String,
+    event: serde_json::Value,
+}
+
+struct SseEvent {
+    event: String,
+    data: String,
+}
+
+// Incremental parser for the server-sent events written by the API server.
+// Bytes are buffered until a blank line ends an event, so chunks that split
+// an event (or a UTF-8 sequence) are handled.
+#[derive(Default)]
+struct SseParser {
+    buffer: Vec<u8>,
+    // Length of the buffer already searched for a blank line, so each chunk
+    // only scans the bytes it added
+    scanned: usize,
+}
+
+impl SseParser {
+    fn push(&mut self, chunk: &[u8]) -> Vec<SseEvent> {
+        self.buffer.extend_from_slice(chunk);
+        let mut events = Vec::new();
+        let mut start = 0;
+        // A terminator may straddle the previous chunk boundary
+        let mut from = self.scanned.saturating_sub(3);
+        while let Some(end) = find_event_end(&self.buffer, from) {
+            if let Some(event) = parse_sse_block(&String::from_utf8_lossy(&self.buffer[start..end])) {
+                events.push(event);
+            }
+            start = end;
+            from = end;
+        }
+        // Drop the parsed events at once rather than shifting the rest per event
+        self.buffer.drain(..start);
+        self.scanned = self.buffer.len();
+        events
+    }
+}
+
+// Returns the index just past the first blank line at or after `from`
+fn find_event_end(buffer: &[u8], from: usize) -> Option<usize> {
+    for i in from..buffer.len() {
+        if buffer[i..].starts_with(b"\n\n") {
+            return Some(i + 2);
+        }
+        if buffer[i..].starts_with(b"\r\n\r\n") {
+            return Some(i + 4);
+        }
+    }
+    None
+}
+
+fn parse_sse_block(block: &str) -> Option<SseEvent> {
+    let mut event = String::from("message");
+    let mut data_lines = Vec::new();
+    for line in block.lines() {
+        let line = line.trim_end_matches('\r');
+        if let Some(value) = line.strip_prefix("event:") {
+            event = value.trim().to_string();
+        } else if let Some(value) = line.strip_prefix("data:") {
+            data_lines.push(value.strip_prefix(' ').unwrap_or(value));
+        }
+    }
+    if data_lines.is_empty() {
+        return None;
+    }
+    Some(SseEvent {
+        event,
+        data: data_lines.join("\n"),
+    })
+}
+
 #[tauri::command]
-async fn start_server(state: tauri::State<'_, Arc<Mutex<ServerState>>>) -> Result<String, String> {
+async fn start_server(
+    state: tauri::State<'_, Arc<Mutex<ServerState>>>,
+    client: tauri::State<'_, ApiClient>,
+) -> Result<String, String> {
     // Check if server is already running
     {
         let server_state = state.lock().map_err(|e| format!("Failed to lock state: {}", e))?;
@@ -79,7 +195,7 @@ async fn start_server(state: tauri::State<'_, Arc<Mutex<ServerState>>>) -> Resul
     thread::sleep(Duration::from_secs(3));
 
     // Check if server is responsive
-    if check_server_health().await {
+    if check_server_health(&client.http).await {
         Ok(format!("Server started successfully (PID: {})", pid))
     } else {
         // If server is not responsive, kill it and return error
@@ -112,14 +228,17 @@ async fn stop_server(state: tauri::State<'_, Arc<Mutex<ServerState>>>) -> Result
 }
 
 #[tauri::command]
-async fn check_server_status(state: tauri::State<'_, Arc<Mutex<ServerState>>>) -> Result<ServerStatus, String> {
+async fn check_server_status(
+    state: tauri::State<'_, Arc<Mutex<ServerState>>>,
+    client: tauri::State<'_, ApiClient>,
+) -> Result<ServerStatus, String> {
     let has_process = {
         let server_state = state.lock().map_err(|e| format!("Failed to lock state: {}", e))?;
         server_state.process.is_some()
     };
 
     let running = if has_process {
-        check_server_health().await
+        check_server_health(&client.http).await
     } else {
         false
     };
@@ -136,17 +255,26 @@ async fn check_server_status(state: tauri::State<'_, Arc<Mutex<ServerState>>>) -
     })
 }
 
+// Sends a message and streams the reply. Tokens and tool progress are
+// emitted to the calling window as they arrive; the assembled message is
+// returned once the server reports `done`.
 #[tauri::command]
-async fn send_message(message: String) -> Result<ChatMessage, String> {
-    let client = reqwest::Client::new();
-    
+async fn send_message(
+    window: tauri::Window,
+    client: tauri::State<'_, ApiClient>,
+    message: String,
+    request_id: String,
+) -> Result<ChatMessage, String> {
     let request_body = serde_json::json!({
         "input": message,
-        "stream": false
+        "stream": true
     });
 
-    let response = client
-        .post("http://127.0.0.1:38080/v1/generate")
+    let started = Instant::now();
+    let mut response = client
+        .http
+        .post(format!("{}/v1/generate", API_BASE_URL))
+        .header("Accept", "text/event-stream")
         .json(&request_body)
         .send()
         .await
@@ -156,54 +284,97 @@ async fn send_message(message: String) -> Result<ChatMessage, String> {
         return Err(format!("Server returned error: {}", response.status()));
     }
 
-    let response_json: serde_json::Value = response
-        .json()
-        .await
-        .map_err(|e| format!("Failed to parse response: {}", e))?;
-
-    let content = response_json
-        .get("output")
-        .and_then(|v| v.as_str())
-        .unwrap_or("No response")
-        .to_string();
+    let mut parser = SseParser::default();
+    let mut content = String::new();
+    let mut tool_calls = Vec::new();
+    let mut ttft_ms = None;
 
-    // Extract tool calls if present
-    let tool_calls = response_json
-        .get("messages")
-        .and_then(|messages| messages.as_array())
-        .and_then(|arr| {
-            let mut calls = Vec::new();
-            for msg in arr {
-                if let Some(_tool_call) = msg.get("type").and_then(|t| t.as_str()).filter(|&t| t == "tool_call") {
-                    if let (Some(name), Some(args)) = (
-                        msg.get("name").and_then(|n| n.as_str()),
-                        msg.get("arguments")
-                    ) {
-                        calls.push(ToolCall {
-                            name: name.to_string(),
-                            arguments: args.clone(),
-                        });
+    'stream: while let Some(chunk) = response
+        .chunk()
+        .await
+        .map_err(|e| format!("Failed to read response: {}", e))?
+    {
+        for event in parser.push(&chunk) {
+            match event.event.as_str() {
+                "content" => {
+                    // The server escapes newlines to keep each chunk on one data line
+                    let text = event.data.replace("\\n", "\n");
+                    if ttft_ms.is_none() {
+                        let elapsed = started.elapsed().as_millis() as u64;
+                        ttft_ms = Some(elapsed);
+                        let _ = window.emit(
+                            "chat-first-token",
+                            FirstTokenEvent {
+                                request_id: request_id.clone(),
+                                ttft_ms: elapsed,
+                            },
+                        );
                     }
+                    content.push_str(&text);
+                    let _ = window.emit(
+                        "chat-token",
+                        TokenEvent {
+                            request_id: request_id.clone(),
+                            text,
+                        },
+                    );
                 }
+                "tool_call" | "tool_result" => {
+                    let item: serde_json::Value = match serde_json::from_str(&event.data) {
+                        Ok(item) => item,
+                        Err(_) => continue,
+                    };
+                    if event.event == "tool_call" {
+                        if let Some(name) = item.get("name").and_then(|n| n.as_str()) {
+                            tool_calls.push(ToolCall {
+                                name: name.to_string(),
+                                arguments: item
+                                    .get("arguments")
+                                    .cloned()
+                                    .unwrap_or(serde_json::Value::Null),
+                            });
+                        }
+                    }
+                    let _ = window.emit(
+                        "chat-tool",
+                        ToolEvent {
+                            request_id: request_id.clone(),
+                            event: item,
+                        },
+                    );
+                }
+                "error" => {
+                    let message = serde_json::from_str::<serde_json::Value>(&event.data)
+                        .ok()
+                        .and_then(|v| v.get("message").and_then(|m| m.as_str()).map(String::from))
+                        .unwrap_or(event.data);
+                    return Err(format!("Server error: {}", message));
+                }
+                "done" => break 'stream,
+                _ => {}
             }
-            if !calls.is_empty() {
-                Some(calls)
-            } else {
-                None
-            }
-        });
+        }
+    }
 
     Ok(ChatMessage {
-        content,
-        tool_calls,
+        content: if content.is_empty() {
+            "No response".to_string()
+        } else {
+            content
+        },
+        tool_calls: if tool_calls.is_empty() {
+            None
+        } else {
+            Some(tool_calls)
+        },
+        ttft_ms,
+        total_ms: started.elapsed().as_millis() as u64,
     })
 }
 
-async fn check_server_health() -> bool {
-    let client = reqwest::Client::new();
-    
+async fn check_server_health(client: &reqwest::Client) -> bool {
     match client
-        .get("http://127.0.0.1:38080/healthz")
+        .get(format!("{}/healthz", API_BASE_URL))
         .timeout(Duration::from_secs(2))
         .send()
         .await
@@ -221,6 +392,7 @@ fn main() {
 
     tauri::Builder::default()
         .manage(server_state)
+        .manage(ApiClient::new())
         .invoke_handler(tauri::generate_handler![
             start_server,
             stop_server,
@@ -0,0 +1,143 @@
+#!/usr/bin/env node
+
+/**
+ * @license
+ * Copyright 2025 Kolosal
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Benchmarks the JavaScript fallback of the grep tool on a synthetic tree,
+// against the sequential loop it replaced and against `rg` and `grep` when
+// they are installed. Build the core package first (`npm run build`).
+//
+//   node scripts/bench-grep-fallback.js [--files 100000] [--dir <path>]
+
+import { spawnSync } from 'node:child_process';
+import { existsSync } from 'node:fs';
+import fs from 'node:fs/promises';
+import os from 'node:os';
+import { join } from 'node:path';
+import { parseArgs } from 'node:util';
+import { globStream } from 'glob';
+
+const projectRoot = join(import.meta.dirname, '..');
+const { grepFilesInParallel } = await import(
+  join(projectRoot, 'packages/core/dist/src/utils/grepWorkerPool.js')
+);
+
+const { values } = parseArgs({
+  options: {
+    files: { type: 'string', default: '100000' },
+    dir: { type: 'string' },
+  },
+});
+const fileCount = Number(values.files);
+const FILES_PER_DIR = 500;
+const RARE = 'needle_rare';
+const COMMON = 'import';
+const MAX_MATCHES = 21;
+
+async function createTree(root) {
+  const marker = join(root, `.tree-${fileCount}`);
+  if (existsSync(marker)) return;
+  console.log(`Creating ${fileCount} files in ${root}...`);
+  const body = Array.from(
+    { length: 60 },
+    (_, i) => `import { thing${i} } from './module${i}.js'; // line ${i}`,
+  ).join('\n');
+  const binary = Buffer.alloc(8192, 0);
+  for (let dir = 0; dir * FILES_PER_DIR < fileCount; dir++) {
+    const dirPath = join(root, `dir${dir}`);
+    await fs.mkdir(dirPath, { recursive: true });
+    const writes = [];
+    for (let i = 0; i < FILES_PER_DIR; i++) {
+      const n = dir * FILES_PER_DIR + i;
+      if (n >= fileCount) break;
+      const file = join(dirPath, `file${i}.ts`);
+      if (n % 997 === 0) {
+        writes.push(fs.writeFile(`${file}.bin`, binary));
+      } else {
+        writes.push(
+          fs.writeFile(file, n % 1000 === 1 ? `${body}\n// ${RARE}\n` : body),
+        );
+      }
+    }
+    await Promise.all(writes);
+  }
+  await fs.writeFile(marker, '');
+}
+
+function walk(root) {
+  return globStream('**/*', {
+    cwd: root,
+    dot: true,
+    absolute: true,
+    nodir: true,
+  });
+}
+
+async function sequential(root, pattern) {
+  const regex = new RegExp(pattern, 'i');
+  let matches = 0;
+  for await (const file of walk(root)) {
+    const content = await fs.readFile(file, 'utf8');
+    for (const line of content.split(/\r?\n/)) {
+      if (regex.test(line)) matches++;
+    }
+  }
+  return matches;
+}
+
+async function pooled(root, pattern, maxMatches) {
+  const matches = await grepFilesInParallel(walk(root), {
+    pattern,
+    maxMatches,
+  });
+  return matches.length;
+}
+
+function external(command, args) {
+  const result = spawnSync(command, args, { maxBuffer: 2 ** 31 });
+  if (result.error) return undefined;
+  let lines = 0;
+  for (const byte of result.stdout) {
+    if (byte === 0x0a) lines++;
+  }
+  return lines;
+}
+
+async function time(label, run) {
+  const start = performance.now();
+  const matches = await run();
+  if (matches === undefined) {
+    console.log(`  ${label.padEnd(34)} not installed`);
+    return;
+  }
+  const ms = performance.now() - start;
+  console.log(
+    `  ${label.padEnd(34)} ${ms.toFixed(0).padStart(7)} ms  ${matches} matches`,
+  );
+}
+
+const root =
+  values.dir ?? join(os.tmpdir(), `kolosal-grep-bench-${fileCount}`);
+await createTree(root);
+console.log(`${os.availableParallelism()} cores\n`);
+
+for (const [pattern, note] of [
+  [RARE, 'few matches, whole tree'],
+  [COMMON, 'every line matches'],
+]) {
+  console.log(`/${pattern}/ (${note})`);
+  await time('sequential fallback (before)', () => sequential(root, pattern));
+  await time(`worker pool, first ${MAX_MATCHES}`, () =>
+    pooled(root, pattern, MAX_MATCHES),
+  );
+  await time('rg', async () =>
+    external('rg', ['-i', '-n', '--no-messages', '--hidden', pattern, root]),
+  );
+  await time('grep -r', async () =>
+    external('grep', ['-r', '-I', '-i', '-n', '-E', pattern, root]),
+  );
+  console.log();
+}